@@ -0,0 +1,159 @@
+// Compares CsvTokenizer against the QTextStream::readLine() + split(",") +
+// toDouble() path the results view used to parse benchmark CSVs.
+//
+// Usage: csv_tokenizer_benchmark [file.csv ...]
+//   Pass run files from benchmark_results or leader_*/server_* files from
+//   comparison_data. With no arguments, run-shaped files are synthesized.
+//
+// Files are read into memory first so only parsing is timed.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include <QByteArray>
+#include <QFile>
+#include <QFileInfo>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+
+#include "network/serialization/CsvTokenizer.h"
+
+namespace {
+
+struct Sample {
+  QString name;
+  QByteArray bytes;
+};
+
+// Mirrors a benchmark_results run: Time, FPS, frame times, per-core columns...
+QByteArray synthesizeRun(int rows, int columns, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> value(0.0, 200.0);
+
+  QByteArray out;
+  out += "Time,FPS,Frame Time";
+  for (int c = 3; c < columns; ++c) {
+    out += ",Metric " + QByteArray::number(c);
+  }
+  out += '\n';
+  for (int r = 0; r < rows; ++r) {
+    out += QByteArray::number(r + 1);
+    for (int c = 1; c < columns; ++c) {
+      out += ',';
+      if (c % 37 == 0) continue;  // some empty cells
+      out += QByteArray::number(value(rng), 'f', c % 3 == 0 ? 1 : 2);
+    }
+    out += '\n';
+  }
+  return out;
+}
+
+using Columns = std::vector<std::vector<double>>;
+
+// The old path: one QString per line, a QStringList per row, toDouble(&ok)
+Columns parseWithQt(const QByteArray& bytes) {
+  QTextStream in(bytes, QIODevice::ReadOnly);
+  const QStringList headers = in.readLine().split(",");
+  Columns columns(headers.size());
+  while (!in.atEnd()) {
+    const QStringList fields = in.readLine().split(",");
+    for (int c = 0; c < headers.size(); ++c) {
+      bool ok = false;
+      double value = c < fields.size() ? fields[c].toDouble(&ok) : 0.0;
+      columns[c].push_back(ok ? value : std::nan(""));
+    }
+  }
+  return columns;
+}
+
+bool sameValues(const Columns& expected, const CsvTokenizer::Table& table) {
+  if (expected.size() != table.columnNames.size()) return false;
+  for (size_t c = 0; c < expected.size(); ++c) {
+    auto column = table.column(c);
+    if (column.size() != expected[c].size()) return false;
+    for (size_t r = 0; r < column.size(); ++r) {
+      const double a = expected[c][r];
+      const double b = column[r];
+      if (std::isnan(a) != std::isnan(b) || (!std::isnan(a) && a != b)) return false;
+    }
+  }
+  return true;
+}
+
+// Median microseconds per call over enough repetitions to fill ~0.3 s
+template <typename Fn>
+double medianMicros(Fn&& fn) {
+  using Clock = std::chrono::steady_clock;
+  std::vector<double> timings;
+  const auto budgetEnd = Clock::now() + std::chrono::milliseconds(300);
+  while (timings.size() < 5 || (Clock::now() < budgetEnd && timings.size() < 10000)) {
+    const auto start = Clock::now();
+    fn();
+    timings.push_back(
+      std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+  }
+  std::nth_element(timings.begin(), timings.begin() + timings.size() / 2, timings.end());
+  return timings[timings.size() / 2];
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::vector<Sample> samples;
+  for (int i = 1; i < argc; ++i) {
+    QFile file(QString::fromLocal8Bit(argv[i]));
+    if (!file.open(QIODevice::ReadOnly)) {
+      std::fprintf(stderr, "Cannot open %s\n", argv[i]);
+      continue;
+    }
+    samples.push_back({QFileInfo(file.fileName()).fileName(), file.readAll()});
+  }
+  if (samples.empty()) {
+    samples.push_back({"synthetic run (124 x 150)", synthesizeRun(124, 150, 1)});
+    samples.push_back({"synthetic long run (1240 x 150)", synthesizeRun(1240, 150, 2)});
+  }
+
+  const CsvTokenizer::ScanPath best = CsvTokenizer::bestScanPath();
+  std::vector<CsvTokenizer::ScanPath> paths = {CsvTokenizer::ScanPath::Scalar};
+  if (best >= CsvTokenizer::ScanPath::SSE2) paths.push_back(CsvTokenizer::ScanPath::SSE2);
+  if (best >= CsvTokenizer::ScanPath::AVX2) paths.push_back(CsvTokenizer::ScanPath::AVX2);
+
+  bool allMatch = true;
+  for (const Sample& sample : samples) {
+    const std::string_view text(sample.bytes.constData(),
+                                static_cast<size_t>(sample.bytes.size()));
+    const double megabytes = sample.bytes.size() / (1024.0 * 1024.0);
+    const Columns reference = parseWithQt(sample.bytes);
+
+    std::printf("%s: %.1f KB, %zu columns\n", qPrintable(sample.name),
+                sample.bytes.size() / 1024.0, reference.size());
+
+    static volatile size_t sink = 0;
+    const double qtMicros =
+      medianMicros([&] { sink = parseWithQt(sample.bytes).size(); });
+    std::printf("  %-28s %10.1f us  %8.1f MB/s\n", "QTextStream + split", qtMicros,
+                megabytes / (qtMicros / 1e6));
+
+    for (CsvTokenizer::ScanPath path : paths) {
+      const CsvTokenizer tokenizer(path);
+      CsvTokenizer::Table table;
+      tokenizer.tokenize(text, table);
+      const bool match = sameValues(reference, table);
+      allMatch = allMatch && match;
+
+      const double micros = medianMicros([&] { tokenizer.tokenize(text, table); });
+      std::printf("  CsvTokenizer %-15s %10.1f us  %8.1f MB/s  x%.1f%s\n",
+                  CsvTokenizer::scanPathName(path), micros,
+                  megabytes / (micros / 1e6), qtMicros / micros,
+                  match ? "" : "  (VALUES DIFFER)");
+    }
+  }
+
+  return allMatch ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+// Compares the packed FullRun columns (FullRunCodec) against the string form,
+// one FullSample of strings per CSV row: wire size, CSV -> bytes encode time
+// and bytes -> column decode time.
+//
+// Usage: full_run_codec_benchmark [file.csv ...]
+//   Pass run files from benchmark_results. With no arguments, run-shaped
+//   files are synthesized (one row per second, 150 columns).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <QByteArray>
+#include <QFile>
+#include <QFileInfo>
+#include <QString>
+
+#include "benchmark_full.pb.h"
+#include "network/serialization/FullRunCodec.h"
+
+using checkmark::benchmarks::FullRun;
+
+namespace {
+
+struct Sample {
+  QString name;
+  QByteArray bytes;
+};
+
+// Mirrors a benchmark_results run: a Time counter, sensors printed with 2 or
+// 4 decimals, integer readings, -1 for missing and a few unused columns
+QByteArray synthesizeRun(int rows, int columns, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> noise(0.0, 1.0);
+
+  QByteArray out = "Time,FPS,Frame Time";
+  for (int c = 3; c < columns; ++c) {
+    out += ",Metric " + QByteArray::number(c);
+  }
+  out += '\n';
+
+  std::vector<double> level(columns);
+  for (int c = 0; c < columns; ++c) level[c] = 10.0 + c * 3.7;
+  for (int r = 0; r < rows; ++r) {
+    out += QByteArray::number(1700000000 + r);
+    for (int c = 1; c < columns; ++c) {
+      out += ',';
+      level[c] = std::max(0.0, level[c] + noise(rng));
+      if (c % 41 == 0) {
+        out += "-1";  // sensor not available on this system
+      } else if (c % 5 == 0) {
+        out += QByteArray::number(static_cast<long long>(level[c]));
+      } else if (c % 7 == 0) {
+        out += QByteArray::number(level[c] * 1024.0, 'f', 4);  // GPU Mem in MB
+      } else if (r % 97 != 13) {
+        out += QByteArray::number(level[c], 'f', 2);
+      }
+    }
+    out += '\n';
+  }
+  return out;
+}
+
+// The string form: every cell a string in a FullSample
+void encodeStrings(std::string_view text, FullRun* run) {
+  run->Clear();
+  std::vector<std::string_view> fields;
+  std::string unquoted;
+  size_t pos = 0;
+  bool header = true;
+  while (pos < text.size()) {
+    size_t end = text.find('\n', pos);
+    if (end == std::string_view::npos) end = text.size();
+    const std::string_view line = text.substr(pos, end - pos);
+    pos = end + 1;
+    if (line.empty()) continue;
+    FullRunCodec::splitCsvLine(line, fields, unquoted);
+    if (header) {
+      for (std::string_view field : fields) run->add_headers(field.data(), field.size());
+      header = false;
+      continue;
+    }
+    auto* values = run->add_samples()->mutable_values();
+    values->Reserve(static_cast<int>(fields.size()));
+    for (std::string_view field : fields) values->Add(std::string(field));
+  }
+}
+
+bool sameColumns(const FullRunCodec::DecodedRun& a, const FullRunCodec::DecodedRun& b) {
+  if (a.rowCount != b.rowCount || a.columns.size() != b.columns.size()) return false;
+  for (size_t c = 0; c < a.columns.size(); ++c) {
+    if (a.texts[c] != b.texts[c]) return false;
+    for (size_t r = 0; r < a.rowCount; ++r) {
+      const double x = a.columns[c][r];
+      const double y = b.columns[c][r];
+      if (std::isnan(x) != std::isnan(y) || (!std::isnan(x) && x != y)) return false;
+    }
+  }
+  return true;
+}
+
+// Median microseconds per call over enough repetitions to fill ~0.3 s
+template <typename Fn>
+double medianMicros(Fn&& fn) {
+  using Clock = std::chrono::steady_clock;
+  std::vector<double> timings;
+  const auto budgetEnd = Clock::now() + std::chrono::milliseconds(300);
+  while (timings.size() < 5 || (Clock::now() < budgetEnd && timings.size() < 10000)) {
+    const auto start = Clock::now();
+    fn();
+    timings.push_back(
+      std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+  }
+  std::nth_element(timings.begin(), timings.begin() + timings.size() / 2, timings.end());
+  return timings[timings.size() / 2];
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::vector<Sample> samples;
+  for (int i = 1; i < argc; ++i) {
+    QFile file(QString::fromLocal8Bit(argv[i]));
+    if (!file.open(QIODevice::ReadOnly)) {
+      std::fprintf(stderr, "Cannot open %s\n", argv[i]);
+      continue;
+    }
+    samples.push_back({QFileInfo(file.fileName()).fileName(), file.readAll()});
+  }
+  if (samples.empty()) {
+    samples.push_back({"synthetic run (124 x 150)", synthesizeRun(124, 150, 1)});
+    samples.push_back({"synthetic 10 minute run (600 x 150)", synthesizeRun(600, 150, 2)});
+  }
+
+  bool allMatch = true;
+  for (const Sample& sample : samples) {
+    const std::string_view text(sample.bytes.constData(),
+                                static_cast<size_t>(sample.bytes.size()));
+    std::printf("%s: %.1f KB of CSV\n", qPrintable(sample.name), sample.bytes.size() / 1024.0);
+
+    FullRun stringRun;
+    encodeStrings(text, &stringRun);
+    const std::string stringBytes = stringRun.SerializeAsString();
+    FullRunCodec::DecodedRun reference;
+    FullRunCodec::decode(stringRun, reference);
+
+    struct Variant {
+      const char* name;
+      bool packed;
+      bool compress;
+      FullRunCodec::Layout layout;
+    };
+    const Variant variants[] = {
+      {"strings (FullSample)", false, false, FullRunCodec::Layout::Packed},
+      {"packed", true, false, FullRunCodec::Layout::Packed},
+      {"packed + zlib", true, true, FullRunCodec::Layout::Packed},
+      {"upload layout", true, true, FullRunCodec::UPLOAD_LAYOUT},
+    };
+
+    double baseEncode = 0.0;
+    double baseDecode = 0.0;
+    for (const Variant& variant : variants) {
+      FullRun run;
+      auto encode = [&] {
+        if (variant.packed) {
+          FullRunCodec::encodeCsv(text, &run, variant.compress, variant.layout);
+        } else {
+          encodeStrings(text, &run);
+        }
+        return run.SerializeAsString();
+      };
+      const std::string bytes = encode();
+
+      FullRun parsed;
+      FullRunCodec::DecodedRun decoded;
+      auto decode = [&] {
+        parsed.ParseFromString(bytes);
+        return FullRunCodec::decode(parsed, decoded);
+      };
+      const bool match = decode() && sameColumns(reference, decoded);
+      allMatch = allMatch && match;
+
+      const double encodeMicros = medianMicros([&] { encode(); });
+      const double decodeMicros = medianMicros([&] { decode(); });
+      if (!variant.packed) {
+        baseEncode = encodeMicros;
+        baseDecode = decodeMicros;
+      }
+      std::printf("  %-22s %9zu bytes  %5.1f%%  encode %9.1f us (x%.1f)  decode %9.1f us (x%.1f)%s\n",
+                  variant.name, bytes.size(), 100.0 * bytes.size() / stringBytes.size(),
+                  encodeMicros, baseEncode / encodeMicros, decodeMicros, baseDecode / decodeMicros,
+                  match ? "" : "  (VALUES DIFFER)");
+    }
+  }
+
+  return allMatch ? 0 : 1;
+}
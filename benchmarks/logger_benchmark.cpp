@@ -0,0 +1,119 @@
+// Measures the per-call cost of the logging macros on the calling thread.
+//
+// Usage: logger_benchmark [iterations] > NUL   (or > /dev/null)
+//   Enabled calls are written to stdout by the worker thread; redirect it so
+//   the console doesn't become the bottleneck. Results go to stderr.
+//
+// Enabled calls are timed in batches smaller than the logger's queue, with a
+// pause between batches for the worker to drain it, so no call should be
+// dropped; the drop count is printed at the end to confirm.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "logging/Logger.h"
+
+namespace {
+
+constexpr size_t QUEUE_SIZE = 16384;
+constexpr int BATCH = 8192;
+
+volatile int sink = 0;  // keeps the arguments from being optimized out
+
+template <typename Fn>
+double timeCalls(int iterations, bool enabled, Fn&& fn) {
+  using clock = std::chrono::steady_clock;
+  const int batch = enabled ? BATCH : iterations;
+  double totalNs = 0.0;
+  for (int done = 0; done < iterations; done += batch) {
+    const int n = std::min(batch, iterations - done);
+    const auto start = clock::now();
+    for (int i = 0; i < n; ++i) {
+      fn(done + i);
+    }
+    totalNs += std::chrono::duration<double, std::nano>(clock::now() - start).count();
+    if (enabled) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+  }
+  return totalNs / iterations;
+}
+
+// Wall time per call with `threads` producers logging at once
+template <typename Fn>
+double timeContended(int iterations, int threads, Fn&& fn) {
+  using clock = std::chrono::steady_clock;
+  const int perThread = BATCH / threads;
+  double totalNs = 0.0;
+  int done = 0;
+  while (done < iterations) {
+    std::vector<std::thread> workers;
+    const auto start = clock::now();
+    for (int t = 0; t < threads; ++t) {
+      workers.emplace_back([&, t] {
+        for (int i = 0; i < perThread; ++i) {
+          fn(t * perThread + i);
+        }
+      });
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    totalNs += std::chrono::duration<double, std::nano>(clock::now() - start).count();
+    done += perThread * threads;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
+  return totalNs / done;
+}
+
+void report(const char* name, double nsPerCall) {
+  std::fprintf(stderr, "%-34s %10.1f ns/call\n", name, nsPerCall);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200000;
+
+  Logger::instance().init("", "", INFO_LEVEL, QUEUE_SIZE);
+  const double frameTime = 16.67;
+  const std::string gpu = "NVIDIA GeForce RTX 4070";
+
+  std::fprintf(stderr, "%d iterations, level INFO\n", iterations);
+
+  report("LOG_DEBUG << (disabled)", timeCalls(iterations, false, [&](int i) {
+           LOG_DEBUG << "frame " << i << " took " << frameTime << "ms on " << gpu;
+         }));
+  report("LOG_DEBUGF (disabled)", timeCalls(iterations, false, [&](int i) {
+           LOG_DEBUGF("frame {} took {}ms on {}", i, frameTime, gpu);
+         }));
+  report("LOG_INFO << (enabled)", timeCalls(iterations, true, [&](int i) {
+           LOG_INFO << "frame " << i << " took " << frameTime << "ms on " << gpu;
+         }));
+  report("LOG_INFOF (enabled)", timeCalls(iterations, true, [&](int i) {
+           LOG_INFOF("frame {} took {}ms on {}", i, frameTime, gpu);
+         }));
+  report("LOG_INFOF, numbers only (enabled)", timeCalls(iterations, true, [&](int i) {
+           LOG_INFOF("frame {} took {}ms", i, frameTime);
+         }));
+
+  report("LOG_INFOF, 8 threads (enabled)", timeContended(iterations, 8, [&](int i) {
+           LOG_INFOF("frame {} took {}ms on {}", i, frameTime, gpu);
+         }));
+  report("LOG_INFO <<, 8 threads (enabled)", timeContended(iterations, 8, [&](int i) {
+           LOG_INFO << "frame " << i << " took " << frameTime << "ms on " << gpu;
+         }));
+
+  // Level checks are a relaxed atomic load; make sure the loop isn't dropped
+  sink = Logger::isEnabled(DEBUG_LEVEL);
+
+  Logger::instance().shutdown();
+  std::fprintf(stderr, "dropped: %llu\n",
+               static_cast<unsigned long long>(Logger::instance().droppedCount()));
+  return 0;
+}
@@ -0,0 +1,194 @@
+// Replays a synthetic 1000 FPS frame stream through the 1-second rolling
+// window of FrameDataCollector and compares the old per-snapshot work (copy
+// and sort the window once per percentile, rescan for extrema and stddev)
+// against the incremental structures in SlidingWindowStats.h.
+//
+// Usage: sliding_window_stats_benchmark [seconds [fps]]
+//   Defaults to 60 seconds at 1000 FPS, with a snapshot after every frame as
+//   the ETW processing thread did. Exits non-zero if the two disagree.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "benchmark/SlidingWindowStats.h"
+
+namespace {
+
+struct Frame {
+  float frameTime;
+  uint64_t timestampUs;
+};
+
+struct Snapshot {
+  float p95 = 0, p99 = 0, p995 = 0;
+  float min = 0, max = 0;
+  double stdDev = 0;
+};
+
+// Mostly ~1 ms frames with jitter and an occasional stutter
+std::vector<Frame> synthesizeFrames(int seconds, int fps) {
+  std::mt19937 rng(42);
+  std::normal_distribution<float> jitter(1000.0f / fps, 0.08f * 1000.0f / fps);
+  std::uniform_real_distribution<float> spike(0.0f, 1.0f);
+  std::vector<Frame> frames;
+  frames.reserve(static_cast<size_t>(seconds) * fps);
+  uint64_t timestampUs = 0;
+  while (timestampUs < static_cast<uint64_t>(seconds) * 1000000) {
+    float frameTime = std::max(0.1f, jitter(rng));
+    if (spike(rng) < 0.002f) frameTime *= 8.0f + 30.0f * spike(rng);
+    timestampUs += static_cast<uint64_t>(frameTime * 1000.0f);
+    frames.push_back({frameTime, timestampUs});
+  }
+  return frames;
+}
+
+// The collector before SlidingWindowStats
+class SortingWindow {
+ public:
+  void add(const Frame& frame) {
+    m_window.push_back(frame);
+    bool evicted = false;
+    while (m_window.front().timestampUs + 1000000 < frame.timestampUs) {
+      m_window.pop_front();
+      evicted = true;
+    }
+    if (evicted) {
+      m_min = m_max = m_window.front().frameTime;
+      for (const Frame& f : m_window) {
+        m_min = std::min(m_min, f.frameTime);
+        m_max = std::max(m_max, f.frameTime);
+      }
+    } else {
+      m_min = m_window.size() == 1 ? frame.frameTime : std::min(m_min, frame.frameTime);
+      m_max = m_window.size() == 1 ? frame.frameTime : std::max(m_max, frame.frameTime);
+    }
+  }
+
+  Snapshot snapshot() {
+    Snapshot s;
+    s.p95 = percentile(95.0f);
+    s.p99 = percentile(99.0f);
+    s.p995 = percentile(99.5f);
+    s.min = m_min;
+    s.max = m_max;
+    double sum = 0;
+    for (const Frame& f : m_window) sum += f.frameTime;
+    const double mean = sum / m_window.size();
+    double squares = 0;
+    for (const Frame& f : m_window) squares += (f.frameTime - mean) * (f.frameTime - mean);
+    s.stdDev = std::sqrt(squares / m_window.size());
+    return s;
+  }
+
+ private:
+  float percentile(float percentile) {
+    m_scratch.clear();
+    for (const Frame& f : m_window) m_scratch.push_back(f.frameTime);
+    std::sort(m_scratch.begin(), m_scratch.end());
+    size_t index = static_cast<size_t>(m_scratch.size() * (percentile / 100.0f));
+    return m_scratch[std::min(index, m_scratch.size() - 1)];
+  }
+
+  std::deque<Frame> m_window;
+  std::vector<float> m_scratch;
+  float m_min = 0, m_max = 0;
+};
+
+// Same bins as PresentDataExports' FrameDataCollector
+class IncrementalWindow {
+ public:
+  void add(const Frame& frame) {
+    m_window.push_back(frame);
+    const uint64_t seq = m_nextSeq++;
+    m_min.push(seq, frame.frameTime);
+    m_max.push(seq, frame.frameTime);
+    m_quantiles.add(frame.frameTime);
+    m_moments.add(frame.frameTime);
+    while (m_window.front().timestampUs + 1000000 < frame.timestampUs) {
+      const uint64_t removedSeq = m_nextSeq - m_window.size();
+      m_min.evict(removedSeq);
+      m_max.evict(removedSeq);
+      m_quantiles.remove(m_window.front().frameTime);
+      m_moments.remove(m_window.front().frameTime);
+      m_window.pop_front();
+    }
+  }
+
+  Snapshot snapshot() const {
+    Snapshot s;
+    s.min = m_min.value();
+    s.max = m_max.value();
+    s.p95 = std::clamp(m_quantiles.percentile(95.0f), s.min, s.max);
+    s.p99 = std::clamp(m_quantiles.percentile(99.0f), s.min, s.max);
+    s.p995 = std::clamp(m_quantiles.percentile(99.5f), s.min, s.max);
+    s.stdDev = m_moments.stdDev();
+    return s;
+  }
+
+ private:
+  std::deque<Frame> m_window;
+  uint64_t m_nextSeq = 0;
+  WindowedQuantiles m_quantiles{0.01f, 1000.0f};
+  WindowedMoments m_moments;
+  MonotonicExtremum<std::less<float>> m_min;
+  MonotonicExtremum<std::greater<float>> m_max;
+};
+
+template <typename Window>
+double replayMicrosPerFrame(const std::vector<Frame>& frames, std::vector<Snapshot>& snapshots) {
+  using Clock = std::chrono::steady_clock;
+  Window window;
+  snapshots.clear();
+  snapshots.reserve(frames.size());
+  const auto start = Clock::now();
+  for (const Frame& frame : frames) {
+    window.add(frame);
+    snapshots.push_back(window.snapshot());
+  }
+  const double micros = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+  return micros / frames.size();
+}
+
+// Percentiles may differ by a bin, stddev by accumulated rounding
+bool agrees(const Snapshot& a, const Snapshot& b) {
+  const float bin = 0.011f;
+  return a.min == b.min && a.max == b.max && std::fabs(a.p95 - b.p95) <= bin &&
+         std::fabs(a.p99 - b.p99) <= bin && std::fabs(a.p995 - b.p995) <= bin &&
+         std::fabs(a.stdDev - b.stdDev) <= 1e-3 * std::max(1.0, a.stdDev);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int seconds = argc > 1 ? std::max(2, std::atoi(argv[1])) : 60;
+  const int fps = argc > 2 ? std::max(1, std::atoi(argv[2])) : 1000;
+
+  const std::vector<Frame> frames = synthesizeFrames(seconds, fps);
+  std::printf("%zu frames over %d s (~%d FPS), snapshot every frame\n", frames.size(), seconds, fps);
+
+  std::vector<Snapshot> sorted;
+  std::vector<Snapshot> incremental;
+  const double sortedMicros = replayMicrosPerFrame<SortingWindow>(frames, sorted);
+  const double incrementalMicros = replayMicrosPerFrame<IncrementalWindow>(frames, incremental);
+  std::printf("  sort per snapshot  %9.3f us/frame\n", sortedMicros);
+  std::printf("  incremental        %9.3f us/frame  (%.1fx)\n", incrementalMicros,
+              sortedMicros / incrementalMicros);
+
+  size_t mismatches = 0;
+  for (size_t i = 0; i < frames.size(); ++i) {
+    if (!agrees(sorted[i], incremental[i]) && mismatches++ < 5) {
+      std::printf("  frame %zu: p99 %.3f vs %.3f, max %.3f vs %.3f, stddev %.4f vs %.4f\n", i,
+                  sorted[i].p99, incremental[i].p99, sorted[i].max, incremental[i].max,
+                  sorted[i].stdDev, incremental[i].stdDev);
+    }
+  }
+  if (mismatches > 0) std::printf("  %zu SNAPSHOTS DIFFER\n", mismatches);
+  return mismatches == 0 ? 0 : 1;
+}
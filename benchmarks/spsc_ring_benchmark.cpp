@@ -0,0 +1,124 @@
+// Measures producer -> consumer throughput of SpscRing against a
+// mutex-guarded std::deque for the per-frame hand-off from the PresentMon
+// event thread to the metrics processor.
+//
+// Usage: spsc_ring_benchmark [records]
+//   One producer thread pushes `records` frame-sized records as fast as it
+//   can, retrying while the queue is full; one consumer drains in batches.
+//   Every record carries its sequence number and the consumer checks them,
+//   so a lost, duplicated or reordered record fails the run.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchmark/SpscRing.h"
+
+namespace {
+
+// Same size as ProcessMonitor::FrameRecord
+struct Record {
+  uint64_t seq;
+  std::array<float, 8> values;
+};
+
+constexpr size_t RING_CAPACITY = 2048;
+constexpr size_t BATCH = 256;
+
+struct Result {
+  double millis = 0;
+  bool ordered = true;
+};
+
+// A capped deque behind one mutex, like the metrics queue before SpscRing
+class LockedQueue {
+ public:
+  bool tryPush(const Record& record) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_queue.size() >= RING_CAPACITY) return false;
+    m_queue.push_back(record);
+    return true;
+  }
+
+  size_t popBatch(Record* out, size_t maxItems) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const size_t count = std::min(maxItems, m_queue.size());
+    std::copy_n(m_queue.begin(), count, out);
+    m_queue.erase(m_queue.begin(), m_queue.begin() + count);
+    return count;
+  }
+
+ private:
+  std::mutex m_mutex;
+  std::deque<Record> m_queue;
+};
+
+template <typename Queue>
+Result transfer(Queue& queue, uint64_t records) {
+  using Clock = std::chrono::steady_clock;
+  Result result;
+  const auto start = Clock::now();
+
+  std::thread producer([&] {
+    Record record{};
+    for (uint64_t seq = 0; seq < records; ++seq) {
+      record.seq = seq;
+      record.values[0] = static_cast<float>(seq);
+      while (!queue.tryPush(record)) std::this_thread::yield();
+    }
+  });
+
+  std::vector<Record> batch(BATCH);
+  uint64_t expected = 0;
+  while (expected < records) {
+    const size_t n = queue.popBatch(batch.data(), batch.size());
+    if (n == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      if (batch[i].seq != expected || batch[i].values[0] != static_cast<float>(expected)) {
+        result.ordered = false;
+      }
+      ++expected;
+    }
+  }
+  producer.join();
+
+  result.millis = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  return result;
+}
+
+void report(const char* name, uint64_t records, const Result& result) {
+  std::printf("  %-16s %9.1f ms  %8.2f M records/s%s\n", name, result.millis,
+              records / result.millis / 1000.0, result.ordered ? "" : "  OUT OF ORDER");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const uint64_t records = argc > 1 ? std::max(1ll, std::atoll(argv[1])) : 20000000;
+  std::printf("%llu records of %zu bytes, capacity %zu, batches of %zu\n",
+              static_cast<unsigned long long>(records), sizeof(Record), RING_CAPACITY, BATCH);
+
+  LockedQueue locked;
+  const Result lockedResult = transfer(locked, records);
+  report("mutex + deque", records, lockedResult);
+
+  // Heap allocated, the slots alone are a few hundred KB
+  auto ring = std::make_unique<SpscRing<Record, RING_CAPACITY>>();
+  const Result ringResult = transfer(*ring, records);
+  report("SpscRing", records, ringResult);
+  std::printf("  speedup %.1fx, %llu full-ring retries\n", lockedResult.millis / ringResult.millis,
+              static_cast<unsigned long long>(ring->droppedCount()));
+
+  return lockedResult.ordered && ringResult.ordered &&
+             ring->pushedCount() == records ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+// Compares the parallel StorageAnalysis scanner against a one-thread
+// recursive std::filesystem walk, the shape of the old traverseFolder.
+//
+// Usage: storage_scanner_benchmark [directory] [files]
+//   With a directory, scans it. Without, builds a synthetic tree of `files`
+//   files (default 1,000,000: 1,000 leaf folders three levels deep) under the
+//   temp directory, or reuses the one a previous run left there. Files are
+//   sparse, so the tree takes inodes but hardly any space.
+//
+// Every variant runs three times and the best is kept, so these are
+// warm-cache numbers: they measure the walk, not the disk.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "diagnostic/storage_scanner.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int FANOUT = 10;  // folders per level, three levels
+constexpr int RUNS = 3;
+
+struct Walk {
+  unsigned long long bytes = 0;
+  unsigned long long files = 0;
+  double seconds = 0.0;
+};
+
+uint32_t xorshift32(uint32_t& state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+bool buildTree(const fs::path& root, long files) {
+  const fs::path marker = root / "tree_files.txt";
+  {
+    std::ifstream in(marker);
+    long existing = 0;
+    if (in >> existing && existing == files) return true;
+  }
+  std::error_code error;
+  fs::remove_all(root, error);
+
+  const int leaves = FANOUT * FANOUT * FANOUT;
+  const long perLeaf = (files + leaves - 1) / leaves;
+  std::fprintf(stderr, "Building %ld files under %s...\n", files, root.string().c_str());
+  uint32_t state = 12345;
+  long made = 0;
+  for (int leaf = 0; leaf < leaves && made < files; leaf++) {
+    const fs::path dir = root / ("d" + std::to_string(leaf / 100)) /
+                         ("d" + std::to_string(leaf / 10 % 10)) /
+                         ("d" + std::to_string(leaf % 10));
+    fs::create_directories(dir, error);
+    if (error) {
+      std::fprintf(stderr, "Can't create %s\n", dir.string().c_str());
+      return false;
+    }
+    for (long i = 0; i < perLeaf && made < files; i++, made++) {
+      const fs::path file = dir / ("f" + std::to_string(i) + ".dat");
+      std::ofstream(file).close();
+      // Mostly small, now and then large, like a game library
+      const uint32_t r = xorshift32(state);
+      const uintmax_t size = (r & 1023) == 0 ? xorshift32(state) % (1u << 30) : r % 65536;
+      fs::resize_file(file, size, error);
+    }
+  }
+  std::ofstream(marker) << files;
+  return true;
+}
+
+Walk walkRecursive(const fs::path& root) {
+  Walk walk;
+  const auto start = std::chrono::steady_clock::now();
+  std::error_code error;
+  fs::recursive_directory_iterator it(
+    root, fs::directory_options::skip_permission_denied, error);
+  for (; !error && it != fs::recursive_directory_iterator(); it.increment(error)) {
+    if (it->is_symlink(error)) {
+      it.disable_recursion_pending();
+      continue;
+    }
+    if (it->is_regular_file(error)) {
+      walk.bytes += it->file_size(error);
+      walk.files++;
+    }
+  }
+  walk.seconds =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return walk;
+}
+
+Walk walkScanner(const fs::path& root, int threads) {
+  StorageAnalysis::ScanOptions options;
+  options.threads = threads;
+  options.timeout = std::chrono::seconds(3600);
+  const auto start = std::chrono::steady_clock::now();
+  const StorageAnalysis::ScanResults results = StorageAnalysis::scanTree(root, options);
+  Walk walk;
+  walk.seconds =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  walk.bytes = results.totalBytes;
+  walk.files = results.filesScanned;
+  return walk;
+}
+
+template <typename Fn>
+Walk best(Fn&& fn) {
+  Walk result;
+  for (int run = 0; run < RUNS; run++) {
+    const Walk walk = fn();
+    if (run == 0 || walk.seconds < result.seconds) result = walk;
+  }
+  return result;
+}
+
+void report(const char* name, const Walk& walk, const Walk& baseline) {
+  std::printf("%-28s %8.3f s %12.0f files/s  %6.2fx  %llu files, %llu bytes%s\n", name,
+              walk.seconds, walk.files / walk.seconds, baseline.seconds / walk.seconds,
+              walk.files, walk.bytes,
+              walk.bytes == baseline.bytes && walk.files == baseline.files
+                ? ""
+                : "  (MISMATCH)");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  fs::path root;
+  if (argc > 1 && fs::is_directory(argv[1])) {
+    root = argv[1];
+  } else {
+    const long files = argc > 2 ? std::atol(argv[2]) : 1'000'000;
+    root = fs::temp_directory_path() / "checkmark_scan_tree";
+    if (!buildTree(root, files)) return 1;
+  }
+
+  const int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  std::printf("Scanning %s\n", root.string().c_str());
+
+  const Walk baseline = best([&] { return walkRecursive(root); });
+  report("recursive_directory_iterator", baseline, baseline);
+  report("scanTree, 1 thread", best([&] { return walkScanner(root, 1); }), baseline);
+  if (cores > 1) {
+    const std::string name = "scanTree, " + std::to_string(cores) + " threads";
+    report(name.c_str(), best([&] { return walkScanner(root, cores); }), baseline);
+  }
+  return 0;
+}
@@ -0,0 +1,55 @@
+// Runs the diagnostics' STREAM suite (memory_tests/stream_bandwidth) on its
+// own, outside the application, so kernel or sizing changes can be checked
+// on any machine, Linux included.
+//
+// Usage: stream_bandwidth_benchmark [arrayMB [repetitions]]
+//   Defaults to the diagnostics' configuration: three 256 MB arrays and ten
+//   timed passes, on every KernelRunner worker, followed by the Triad thread
+//   sweep. Exits non-zero if the arrays can't be allocated or their contents
+//   don't match the expected values afterwards.
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "diagnostic/memory_tests/stream_bandwidth.h"
+
+int main(int argc, char** argv) {
+  StreamConfig config;
+  if (argc > 1) {
+    config.arrayElements = std::strtoull(argv[1], nullptr, 10) * 1024 * 1024 / sizeof(double);
+  }
+  if (argc > 2) {
+    config.repetitions = std::atoi(argv[2]);
+  }
+  if (config.arrayElements == 0 || config.repetitions < 1) {
+    std::fprintf(stderr, "usage: %s [arrayMB [repetitions]]\n", argv[0]);
+    return 2;
+  }
+
+  const StreamResults results = runStreamBenchmark(config);
+  if (!results.testPerformed) {
+    std::fprintf(stderr, "could not allocate 3 x %d MB\n", results.arrayMB);
+    return 1;
+  }
+
+  std::printf("3 arrays of %d MB, %d threads, %d passes\n\n", results.arrayMB,
+              results.threads, config.repetitions);
+  std::printf("%-8s %-6s %10s %10s\n", "kernel", "stores", "best GB/s", "median");
+  for (const StreamKernelResult& kernel : results.kernels) {
+    std::printf("%-8s %-6s %10.2f %10.2f\n", kernel.kernel.c_str(),
+                kernel.nonTemporal ? "nt" : "normal", kernel.bestGBs, kernel.medianGBs);
+  }
+
+  std::printf("\ntriad on 1 thread: %.2f GB/s\n", results.singleThreadTriadGBs);
+  std::printf("\n%-8s %10s\n", "threads", "triad GB/s");
+  for (size_t i = 0; i < results.triadByThreads.size(); i++) {
+    std::printf("%-8zu %10.2f\n", i + 1, results.triadByThreads[i]);
+  }
+  std::printf("%d threads reach 90%% of the peak\n", results.saturationThreads);
+
+  if (!results.validated) {
+    std::fprintf(stderr, "array contents don't match the expected values\n");
+    return 1;
+  }
+  return 0;
+}
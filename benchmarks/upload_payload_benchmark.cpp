@@ -0,0 +1,212 @@
+// Compares building a BenchmarkUploadRequest with attachments the old way
+// (heap message, readAll + set_content per file, SerializeToString, copy into
+// a QByteArray) against an arena message written by UploadPayloadWriter
+// (ByteSizeLong-sized buffer, files read straight into it).
+//
+// Usage: upload_payload_benchmark [--legacy | --writer] [file.csv [attachment ...]]
+//   The first file is the run CSV; it is also attached. With no files, a run
+//   CSV and two large logs are synthesized in the temp directory.
+//   Peak RSS only grows, so compare it between one-mode runs:
+//     upload_payload_benchmark --legacy && upload_payload_benchmark --writer
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QString>
+#include <QStringList>
+
+#include <google/protobuf/arena.h>
+
+#include "benchmark_full.pb.h"
+#include "benchmark_upload.pb.h"
+#include "network/serialization/FullRunCodec.h"
+#include "network/serialization/UploadPayloadWriter.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using checkmark::benchmarks::Attachment;
+using checkmark::benchmarks::BenchmarkUploadRequest;
+
+namespace {
+
+double peakRssMB() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters{};
+  GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+  return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+#elif defined(__APPLE__)
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss / (1024.0 * 1024.0);  // bytes
+#else
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss / 1024.0;  // KB
+#endif
+}
+
+bool writeFile(const QString& path, const QByteArray& bytes) {
+  QFile file(path);
+  return file.open(QIODevice::WriteOnly) && file.write(bytes) == bytes.size();
+}
+
+// A 20 minute run (one row per second, 150 columns) and two ~24 MB logs
+QStringList synthesizeFiles() {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> reading(0.0, 100.0);
+  const QString dir = QDir::temp().filePath("checkmark_upload_benchmark");
+  QDir().mkpath(dir);
+
+  QByteArray csv = "Time,FPS,Frame Time";
+  for (int c = 3; c < 150; ++c) csv += ",Metric " + QByteArray::number(c);
+  csv += '\n';
+  for (int r = 0; r < 1200; ++r) {
+    csv += QByteArray::number(1700000000 + r);
+    for (int c = 1; c < 150; ++c) {
+      csv += ',';
+      csv += QByteArray::number(reading(rng), 'f', 2);
+    }
+    csv += '\n';
+  }
+
+  // Written a megabyte at a time so the logs don't raise the peak RSS
+  QByteArray chunk;
+  while (chunk.size() < 1024 * 1024) {
+    chunk += "[2024-01-01 00:00:00.000] [info] sample " + QByteArray::number(reading(rng), 'f', 6) + '\n';
+  }
+
+  const QStringList paths = {dir + "/run.csv", dir + "/run_etw.log", dir + "/run_pdh.log"};
+  writeFile(paths[0], csv);
+  for (int i = 1; i < paths.size(); ++i) {
+    QFile file(paths[i]);
+    if (!file.open(QIODevice::WriteOnly)) continue;
+    for (int mb = 0; mb < 24; ++mb) file.write(chunk);
+  }
+  return paths;
+}
+
+void fillRequest(BenchmarkUploadRequest* req, const QByteArray& csvData) {
+  req->mutable_env()->set_client_version("checkmark-client");
+  req->mutable_env()->set_schema_version(FullRunCodec::UPLOAD_SCHEMA_VERSION);
+  req->mutable_meta()->set_run_id("benchmark");
+  if constexpr (FullRunCodec::UPLOAD_LAYOUT == FullRunCodec::Layout::Packed) {
+    FullRunCodec::encodeCsv(std::string_view(csvData.constData(), csvData.size()),
+                            req->mutable_full_run());
+  }
+}
+
+QByteArray readAllBytes(const QString& path) {
+  QFile file(path);
+  return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+// The build before UploadPayloadWriter
+QByteArray buildLegacy(const QString& csvPath, const QStringList& attachmentPaths) {
+  BenchmarkUploadRequest req;
+  const QByteArray csvData = readAllBytes(csvPath);
+  fillRequest(&req, csvData);
+  const QString csvFilePath = QFileInfo(csvPath).absoluteFilePath();
+  for (const QString& p : attachmentPaths) {
+    QFileInfo fi(p);
+    Attachment* a = req.add_attachments();
+    a->set_filename(fi.fileName().toStdString());
+    QString mt = fi.suffix().compare("csv", Qt::CaseInsensitive) == 0 ? "text/csv" :
+                 fi.suffix().compare("json", Qt::CaseInsensitive) == 0 ? "application/json" :
+                 "text/plain";
+    a->set_mime_type(mt.toStdString());
+    QByteArray bytes = fi.absoluteFilePath() == csvFilePath ? csvData : readAllBytes(p);
+    if (!bytes.isEmpty()) a->set_content(bytes.constData(), bytes.size());
+  }
+  std::string out;
+  req.SerializeToString(&out);
+  return QByteArray(out.data(), static_cast<qsizetype>(out.size()));
+}
+
+QByteArray buildWithWriter(const QString& csvPath, const QStringList& attachmentPaths) {
+  google::protobuf::ArenaOptions arenaOptions;
+  arenaOptions.start_block_size = 64 * 1024;
+  arenaOptions.max_block_size = 4 * 1024 * 1024;
+  google::protobuf::Arena arena(arenaOptions);
+  auto* req = google::protobuf::Arena::Create<BenchmarkUploadRequest>(&arena);
+  const QByteArray csvData = readAllBytes(csvPath);
+  fillRequest(req, csvData);
+  const QString csvFilePath = QFileInfo(csvPath).absoluteFilePath();
+  UploadPayloadWriter payload;
+  for (const QString& p : attachmentPaths) {
+    payload.addFile(p, QFileInfo(p).absoluteFilePath() == csvFilePath ? csvData : QByteArray());
+  }
+  return payload.serialize(*req);
+}
+
+// Median milliseconds over a few builds
+template <typename Fn>
+double medianMillis(Fn&& fn) {
+  using Clock = std::chrono::steady_clock;
+  std::vector<double> timings;
+  for (int i = 0; i < 7; ++i) {
+    const auto start = Clock::now();
+    fn();
+    timings.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+  }
+  std::nth_element(timings.begin(), timings.begin() + timings.size() / 2, timings.end());
+  return timings[timings.size() / 2];
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  bool runLegacy = true;
+  bool runWriter = true;
+  QStringList files;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--legacy") == 0) {
+      runWriter = false;
+    } else if (std::strcmp(argv[i], "--writer") == 0) {
+      runLegacy = false;
+    } else {
+      files << QString::fromLocal8Bit(argv[i]);
+    }
+  }
+  if (files.isEmpty()) files = synthesizeFiles();
+
+  qint64 attachedBytes = 0;
+  for (const QString& f : files) attachedBytes += QFileInfo(f).size();
+  std::printf("%s + %d attachments, %.1f MB attached\n", qPrintable(QFileInfo(files[0]).fileName()),
+              static_cast<int>(files.size()), attachedBytes / (1024.0 * 1024.0));
+
+  const double baselineRss = peakRssMB();
+  QByteArray reference;
+  if (runLegacy) {
+    reference = buildLegacy(files[0], files);
+    const double millis = medianMillis([&] { buildLegacy(files[0], files); });
+    std::printf("  legacy   %10lld bytes  build %8.1f ms  peak RSS %7.1f MB (+%.1f)\n",
+                static_cast<long long>(reference.size()), millis, peakRssMB(),
+                peakRssMB() - baselineRss);
+  }
+  bool match = true;
+  if (runWriter) {
+    const QByteArray bytes = buildWithWriter(files[0], files);
+    const double millis = medianMillis([&] { buildWithWriter(files[0], files); });
+    std::printf("  writer   %10lld bytes  build %8.1f ms  peak RSS %7.1f MB (+%.1f)%s\n",
+                static_cast<long long>(bytes.size()), millis, peakRssMB(),
+                peakRssMB() - baselineRss, runLegacy ? "  (includes legacy run)" : "");
+    match = !runLegacy || bytes == reference;
+    if (!match) std::printf("  PAYLOADS DIFFER\n");
+  }
+  return match ? 0 : 1;
+}
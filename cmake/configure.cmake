@@ -11,7 +11,7 @@ include("${CMAKE_SOURCE_DIR}/cmake/external/protobuf.cmake")
 
 include("${CMAKE_SOURCE_DIR}/cmake/external/licenses.cmake")
 
-find_package(Qt6 CONFIG REQUIRED COMPONENTS Core Gui Widgets Network)
+find_package(Qt6 CONFIG REQUIRED COMPONENTS Core Gui Widgets Network Concurrent)
 find_package(cpuid CONFIG REQUIRED)
 find_package(spdlog CONFIG REQUIRED)
 find_package(CUDAToolkit REQUIRED)
@@ -0,0 +1,185 @@
+#include "BenchmarkCsvWriter.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "../logging/Logger.h"
+
+BenchmarkCsvWriter::BenchmarkCsvWriter(RowFormatter formatter)
+    : m_formatter(std::move(formatter)) {
+  m_buffer.reserve(WRITE_BLOCK_SIZE);
+  m_thread = std::thread(&BenchmarkCsvWriter::writerLoop, this);
+}
+
+BenchmarkCsvWriter::~BenchmarkCsvWriter() {
+  close();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_workAvailable.notify_one();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+bool BenchmarkCsvWriter::open(const std::wstring& path) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  waitForIdle(lock);
+
+  if (m_file != INVALID_HANDLE_VALUE) {
+    CloseHandle(m_file);
+  }
+  m_file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                       CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  m_buffer.clear();
+  m_writeFailed = false;
+  return m_file != INVALID_HANDLE_VALUE;
+}
+
+bool BenchmarkCsvWriter::sync() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  waitForIdle(lock);
+
+  if (m_file == INVALID_HANDLE_VALUE) return false;
+  if (!FlushFileBuffers(m_file)) {
+    LOG_ERROR << "[ERROR] FlushFileBuffers failed: " << GetLastError();
+    return false;
+  }
+  return !m_writeFailed;
+}
+
+void BenchmarkCsvWriter::close() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  waitForIdle(lock);
+
+  if (m_file != INVALID_HANDLE_VALUE) {
+    CloseHandle(m_file);
+    m_file = INVALID_HANDLE_VALUE;
+  }
+}
+
+bool BenchmarkCsvWriter::isOpen() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_file != INVALID_HANDLE_VALUE;
+}
+
+void BenchmarkCsvWriter::appendText(std::string text) {
+  std::unique_ptr<Job> job;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    job = takeSpareJob();
+  }
+  job->text = std::move(text);
+  enqueue(std::move(job));
+}
+
+void BenchmarkCsvWriter::appendSamples(BenchmarkSampleStore& samples,
+                                       size_t first, size_t last,
+                                       const std::set<std::string>& diskNames) {
+  std::unique_ptr<Job> job;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    job = takeSpareJob();
+  }
+  // The recycled store was cleared by the writer, so the caller gets back an
+  // empty buffer that already has capacity for the next batch
+  std::swap(job->samples, samples);
+  job->first = first;
+  job->last = last;
+  job->diskNames = diskNames;
+  enqueue(std::move(job));
+}
+
+std::unique_ptr<BenchmarkCsvWriter::Job> BenchmarkCsvWriter::takeSpareJob() {
+  if (m_spareJobs.empty()) {
+    return std::make_unique<Job>();
+  }
+  std::unique_ptr<Job> job = std::move(m_spareJobs.back());
+  m_spareJobs.pop_back();
+  return job;
+}
+
+void BenchmarkCsvWriter::enqueue(std::unique_ptr<Job> job) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.push_back(std::move(job));
+  }
+  m_workAvailable.notify_one();
+}
+
+void BenchmarkCsvWriter::waitForIdle(std::unique_lock<std::mutex>& lock) {
+  m_idle.wait(lock, [this] { return m_pending.empty() && !m_busy; });
+}
+
+void BenchmarkCsvWriter::writerLoop() {
+  std::deque<std::unique_ptr<Job>> batch;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_workAvailable.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+      if (m_pending.empty()) break;  // stopping with nothing left to write
+      batch.swap(m_pending);
+      m_busy = true;
+    }
+
+    for (auto& job : batch) {
+      format(*job);
+      if (m_buffer.size() >= WRITE_BLOCK_SIZE) {
+        flushBuffer();
+      }
+    }
+    flushBuffer();
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (auto& job : batch) {
+        job->text.clear();
+        job->samples.clear();
+        job->diskNames.clear();
+        m_spareJobs.push_back(std::move(job));
+      }
+      m_busy = false;
+    }
+    batch.clear();
+    m_idle.notify_all();
+  }
+}
+
+void BenchmarkCsvWriter::format(Job& job) {
+  m_buffer += job.text;
+
+  size_t last = std::min(job.last, job.samples.size());
+  if (job.first >= last) return;
+
+  const auto& presentCounts = job.samples.column(&BenchmarkDataPoint::presentCount);
+  for (size_t i = job.first; i < last; i++) {
+    if (presentCounts[i] > 0) {
+      job.samples.materialize(i, m_row);
+      m_formatter(m_row, job.diskNames, m_buffer);
+    }
+  }
+}
+
+bool BenchmarkCsvWriter::flushBuffer() {
+  if (m_buffer.empty()) return true;
+
+  bool ok = m_file != INVALID_HANDLE_VALUE;
+  size_t offset = 0;
+  while (ok && offset < m_buffer.size()) {
+    DWORD written = 0;
+    DWORD chunk = static_cast<DWORD>(
+      std::min<size_t>(m_buffer.size() - offset, MAXDWORD));
+    ok = WriteFile(m_file, m_buffer.data() + offset, chunk, &written, nullptr) &&
+         written > 0;
+    offset += written;
+  }
+
+  if (!ok && !m_writeFailed) {
+    LOG_ERROR << "[ERROR] Benchmark CSV write failed: " << GetLastError();
+    m_writeFailed = true;
+  }
+  m_buffer.clear();  // keeps capacity
+  return ok;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <windows.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchmarkDataPoint.h"
+#include "BenchmarkSampleStore.h"
+
+/**
+ * @brief BenchmarkCsvWriter - Background writer for benchmark result files
+ *
+ * Keeps CSV formatting and disk I/O off the 1 Hz sampling thread:
+ *
+ * - appendSamples() swaps the caller's batch with an empty recycled store
+ *   (double buffering) and returns immediately; the writer thread formats the
+ *   rows through the RowFormatter into one reused text buffer
+ * - Everything queued is written as one large block that always ends on a
+ *   row boundary, so a crash leaves at most one torn row at the end of the
+ *   file
+ * - Nothing is flushed to the device until sync()
+ *
+ * open()/sync()/close() wait for queued work first. They belong on the owning
+ * thread (start/finalize), never on the sampling tick.
+ */
+class BenchmarkCsvWriter {
+ public:
+  using RowFormatter =
+    std::function<void(const BenchmarkDataPoint& row,
+                       const std::set<std::string>& diskNames, std::string& out)>;
+
+  explicit BenchmarkCsvWriter(RowFormatter formatter);
+  ~BenchmarkCsvWriter();
+
+  bool open(const std::wstring& path);  // creates or truncates
+  bool sync();                          // waits for queued writes, then fsyncs
+  void close();
+  bool isOpen() const;
+
+  void appendText(std::string text);
+
+  // Queues rows [first, last) of samples that have presentCount > 0. The
+  // contents of samples are taken; it is left empty with spare capacity.
+  void appendSamples(BenchmarkSampleStore& samples, size_t first, size_t last,
+                     const std::set<std::string>& diskNames);
+
+ private:
+  struct Job {
+    std::string text;
+    BenchmarkSampleStore samples;
+    size_t first = 0;
+    size_t last = 0;
+    std::set<std::string> diskNames;
+  };
+
+  std::unique_ptr<Job> takeSpareJob();
+  void enqueue(std::unique_ptr<Job> job);
+  void waitForIdle(std::unique_lock<std::mutex>& lock);
+  void writerLoop();
+  void format(Job& job);
+  bool flushBuffer();
+
+  static constexpr size_t WRITE_BLOCK_SIZE = 256 * 1024;
+
+  RowFormatter m_formatter;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_workAvailable;
+  std::condition_variable m_idle;
+  std::deque<std::unique_ptr<Job>> m_pending;
+  std::vector<std::unique_ptr<Job>> m_spareJobs;
+  bool m_busy = false;
+  bool m_stop = false;
+
+  // Owned by the writer thread while jobs are in flight, by the caller of
+  // open()/sync()/close() otherwise
+  HANDLE m_file = INVALID_HANDLE_VALUE;
+  std::string m_buffer;
+  BenchmarkDataPoint m_row;
+  bool m_writeFailed = false;
+
+  std::thread m_thread;
+};
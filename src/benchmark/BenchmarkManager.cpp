@@ -380,6 +380,27 @@ void OnMetricsUpdate(uint32_t processId, const PM_METRICS* metrics) {
 
 // BenchmarkSegment and findValidBenchmarkSegments removed - unused function
 
+void OnFrameTimesUpdate(uint32_t processId, const FrameTimeSketch* frameTimes) {
+  BenchmarkManager* localInstance = instance;
+  if (!localInstance || !frameTimes || frameTimes->empty()) {
+    return;
+  }
+
+  if (localInstance->m_cleanupDone.load(std::memory_order_acquire) ||
+      localInstance->m_benchmarkEndDetected.load(std::memory_order_acquire) ||
+      localInstance->m_stopBenchmarkCalled.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  // Cumulative percentiles only cover frames from the actual benchmark period
+  if (localInstance->currentBenchmarkState != BenchmarkStateTracker::State::RUNNING) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(localInstance->frameTimesMutex);
+  localInstance->frameTimeSketch.merge(*frameTimes);
+}
+
 uint32_t BenchmarkManager::getProcessIdByName(const QString& processName) {
   if (processName.compare("RustClient.exe", Qt::CaseInsensitive) == 0) {
     HWND hwnd = FindWindowW(NULL, L"Rust");
@@ -523,7 +544,7 @@ bool BenchmarkManager::startBenchmark(const QString& processName,
   {
     std::lock_guard<std::mutex> lock(frameTimesMutex);
     allFrameTimePoints.clear();
-    frameTimeHistogram.clear();
+    frameTimeSketch.clear();
   }
 
   {
@@ -622,6 +643,7 @@ bool BenchmarkManager::startBenchmark(const QString& processName,
   RegisterActiveSession(sessionName);
 
   PM_SetMetricsCallback(OnMetricsUpdate);
+  PM_SetFrameTimesCallback(OnFrameTimesUpdate);
 
   status = PM_StartMonitoring(processId, BenchmarkConstants::METRICS_COLLECTION_INTERVAL_MS);
   if (status != PM_STATUS::PM_SUCCESS) {
@@ -769,7 +791,13 @@ bool BenchmarkManager::startBenchmark(const QString& processName,
       saveToFile = true;
       
       int noDataCount = 0;
-      std::vector<BenchmarkDataPoint> batchBuffer;
+      // Columnar buffers, reserved up front so appends don't allocate per second
+      BenchmarkSampleStore batchBuffer;
+      batchBuffer.reserve(BATCH_SIZE_SECONDS + 1);
+      {
+        std::lock_guard<std::recursive_mutex> lock(dataMutex);
+        allData.reserve(static_cast<size_t>(durationSeconds) + 1);
+      }
 
       for (int i = 0; i <= durationSeconds && !m_shouldStop; ++i) {
         emit benchmarkProgress(i * 100 / durationSeconds);
@@ -1108,8 +1136,8 @@ bool BenchmarkManager::startBenchmark(const QString& processName,
           BenchmarkDataPoint csvSample = sample;  // Copy with per-second percentiles for CSV
           
           if (isRunningState) {
-            allData.push_back(csvSample);  // Use per-second percentiles for CSV
-            batchBuffer.push_back(csvSample);
+            allData.append(csvSample);  // Use per-second percentiles for CSV
+            batchBuffer.append(csvSample);
             
             // Log CSV snapshot every 10 seconds during RUNNING state - this matches actual CSV data
             static std::chrono::steady_clock::time_point lastCsvSnapshot;
@@ -1208,12 +1236,8 @@ bool BenchmarkManager::startBenchmark(const QString& processName,
                 }
                 
                 // Find disk names for this batch
-                std::set<std::string> diskNames;
-                for (const auto& data : batchBuffer) {
-                  for (const auto& [diskName, _] : data.perDiskReadRates) {
-                    diskNames.insert(diskName);
-                  }
-                }
+                std::set<std::string> diskNames = batchBuffer.diskNamesWithData(
+                  BenchmarkSampleStore::DiskMetric::ReadRate, 0, batchBuffer.size());
                 
                 m_resultFileManager->writeDataPoints(batchBuffer, diskNames);
               } else {
@@ -1242,12 +1266,8 @@ bool BenchmarkManager::startBenchmark(const QString& processName,
                 }
                 
                 // Find disk names for this batch
-                std::set<std::string> diskNames;
-                for (const auto& data : batchBuffer) {
-                  for (const auto& [diskName, _] : data.perDiskReadRates) {
-                    diskNames.insert(diskName);
-                  }
-                }
+                std::set<std::string> diskNames = batchBuffer.diskNamesWithData(
+                  BenchmarkSampleStore::DiskMetric::ReadRate, 0, batchBuffer.size());
                 
                 m_resultFileManager->writeDataPoints(batchBuffer, diskNames);
               } catch (const std::exception& e) {
@@ -1489,7 +1509,7 @@ void BenchmarkManager::calculateCumulativeFrameTimePercentiles() {
   
 
   // CRITICAL: Only calculate if we're in RUNNING state and have accumulated data
-  if (currentBenchmarkState != BenchmarkStateTracker::State::RUNNING || frameTimeHistogram.totalSamples == 0) {
+  if (currentBenchmarkState != BenchmarkStateTracker::State::RUNNING || frameTimeSketch.empty()) {
     // Initialize to invalid values if not in RUNNING state or no data
     m_cumulativeFrameTime1pct = -1.0f;
     m_cumulativeFrameTime5pct = -1.0f;
@@ -1508,37 +1528,26 @@ void BenchmarkManager::calculateCumulativeFrameTimePercentiles() {
     return;
   }
 
-  // Use histogram to calculate percentiles efficiently - O(buckets) instead of O(n log n)
-  m_cumulativeFrameTime1pct = frameTimeHistogram.calculatePercentile(BenchmarkConstants::FPS_PERCENTILE_1);
-  m_cumulativeFrameTime5pct = frameTimeHistogram.calculatePercentile(BenchmarkConstants::FPS_PERCENTILE_5);
-  m_cumulativeFrameTime05pct = frameTimeHistogram.calculatePercentile(BenchmarkConstants::FPS_PERCENTILE_01);
+  // Sketch holds every RUNNING frame - O(populated buckets) per query
+  m_cumulativeFrameTime1pct = frameTimeSketch.percentile(BenchmarkConstants::FPS_PERCENTILE_1);
+  m_cumulativeFrameTime5pct = frameTimeSketch.percentile(BenchmarkConstants::FPS_PERCENTILE_5);
+  m_cumulativeFrameTime05pct = frameTimeSketch.percentile(BenchmarkConstants::FPS_PERCENTILE_01);
   
   // DEBUG: Log histogram distribution and calculated percentiles each second 
-  if (std::chrono::duration_cast<std::chrono::seconds>(now - lastDebugLog).count() >= 1) {
+  if (Logger::isEnabled(DEBUG_LEVEL) &&
+      std::chrono::duration_cast<std::chrono::seconds>(now - lastDebugLog).count() >= 1) {
     float cumulative1pctFps = (m_cumulativeFrameTime1pct > 0) ? 1000.0f / m_cumulativeFrameTime1pct : 0.0f;
     float cumulative5pctFps = (m_cumulativeFrameTime5pct > 0) ? 1000.0f / m_cumulativeFrameTime5pct : 0.0f;
     float cumulative05pctFps = (m_cumulativeFrameTime05pct > 0) ? 1000.0f / m_cumulativeFrameTime05pct : 0.0f;
     
-    // Log histogram distribution for debugging
-    LOG_DEBUG << "[HISTOGRAM-DEBUG] Total samples: " << frameTimeHistogram.totalSamples 
-              << ", Underflow: " << frameTimeHistogram.underflowCount 
-              << ", Overflow: " << frameTimeHistogram.overflowCount;
+    // Log sketch state for debugging
+    LOG_DEBUGF("[HISTOGRAM-DEBUG] Total frames: {}, Min: {}ms, Max: {}ms, Mean: {}ms",
+               frameTimeSketch.count(), frameTimeSketch.min(), frameTimeSketch.max(),
+               frameTimeSketch.mean());
     
-    LOG_DEBUG << "[HISTOGRAM-DEBUG] Percentiles - 0.1%: " << m_cumulativeFrameTime05pct << "ms (" 
-              << cumulative05pctFps << " FPS), 1%: " << m_cumulativeFrameTime1pct << "ms (" 
-              << cumulative1pctFps << " FPS), 5%: " << m_cumulativeFrameTime5pct << "ms (" 
-              << cumulative5pctFps << " FPS)";
-    
-    // Show distribution of frame times in key buckets
-    LOG_DEBUG << "[HISTOGRAM-DEBUG] Sample distribution - ";
-    const auto& hist = frameTimeHistogram;
-    for (size_t i = 0; i < hist.BUCKET_COUNT; i += 20) { // Sample every 10ms
-      float frameTime = hist.MIN_FRAME_TIME + (i * hist.BUCKET_SIZE);
-      if (hist.buckets[i] > 0) {
-        LOG_DEBUG << frameTime << "ms:" << hist.buckets[i] << " ";
-      }
-    }
-    // Line ending handled by logger
+    LOG_DEBUGF("[HISTOGRAM-DEBUG] Percentiles - 0.1%: {}ms ({} FPS), 1%: {}ms ({} FPS), 5%: {}ms ({} FPS)",
+               m_cumulativeFrameTime05pct, cumulative05pctFps, m_cumulativeFrameTime1pct,
+               cumulative1pctFps, m_cumulativeFrameTime5pct, cumulative5pctFps);
     
     lastDebugLog = now;
   }
@@ -1655,7 +1664,7 @@ bool BenchmarkManager::stopBenchmark() {
       saveToFile = true;
 
       // Use the new file manager for final benchmark processing
-      std::vector<BenchmarkDataPoint> allDataCopy;
+      BenchmarkSampleStore allDataCopy;
       {
         std::lock_guard<std::recursive_mutex> lock(dataMutex);
         allDataCopy = allData;
@@ -1884,26 +1893,7 @@ void BenchmarkManager::accumulateMetrics(const PM_METRICS& metrics) {
     std::lock_guard<std::mutex> frameTimesLock(frameTimesMutex);
     allFrameTimePoints.emplace_back(FrameTimePoint{avgFps, avgFrameTime, timestamp});
     
-    // Feed histogram directly using the per-second stats distribution
-    // This maintains the same statistical profile as the old synthetic method
-    if (metrics.frameTime99Percentile > 0 && metrics.frameTime95Percentile > 0 && metrics.frameTime995Percentile > 0) {
-      int totalFrames = metrics.frameCount;
-      
-      // Calculate frame counts for each percentile bucket
-      int frames995 = std::max(1, (int)(totalFrames * 0.005f)); // 0.5% worst frames
-      int frames99 = std::max(1, (int)(totalFrames * 0.01f));   // 1% worst frames  
-      int frames95 = std::max(1, (int)(totalFrames * 0.05f));   // 5% worst frames
-      int framesNormal = totalFrames - frames995 - frames99 - frames95; // Rest
-      
-      // Add to histogram in batches - much more efficient than per-frame loops
-      frameTimeHistogram.addFrameTime(metrics.frameTime995Percentile, frames995);
-      frameTimeHistogram.addFrameTime(metrics.frameTime99Percentile, frames99);
-      frameTimeHistogram.addFrameTime(metrics.frameTime95Percentile, frames95);
-      frameTimeHistogram.addFrameTime(metrics.frametime, framesNormal);
-    } else {
-      // Fallback: if percentiles are not available, use average frametime
-      frameTimeHistogram.addFrameTime(metrics.frametime, metrics.frameCount);
-    }
+    // Per-frame distribution arrives separately through OnFrameTimesUpdate
   }
 }
 
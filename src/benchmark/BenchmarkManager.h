@@ -14,8 +14,10 @@
 #include "BenchmarkConstants.h"
 #include "BenchmarkDataPoint.h"
 #include "BenchmarkResultFileManager.h"
+#include "BenchmarkSampleStore.h"
 #include "BenchmarkStateTracker.h"
 #include "DemoFileManager.h"  // Add this include
+#include "FrameTimeSketch.h"
 #include "PresentDataExports.h"
 #include "hardware/CPUKernelMetricsTracker.h"
 #include "hardware/DiskPerformanceTracker.h"
@@ -28,6 +30,8 @@ float calculatePercentile(const std::vector<float>& sortedValues, float percenti
 
 // Forward declare the callback function
 extern "C" void OnMetricsUpdate(uint32_t processId, const PM_METRICS* metrics);
+extern "C" void OnFrameTimesUpdate(uint32_t processId,
+                                   const FrameTimeSketch* frameTimes);
 
 /**
  * @brief BenchmarkManager - Central coordinator for automated game benchmarking
@@ -75,7 +79,7 @@ extern "C" void OnMetricsUpdate(uint32_t processId, const PM_METRICS* metrics);
  * 
  * 5. **Data Storage**:
  *    - **currentData** (BenchmarkDataPoint): Latest metrics from all providers
- *    - **allData** (vector): Historical data points, only populated during RUNNING
+ *    - **allData** (BenchmarkSampleStore): Columnar history, only populated during RUNNING
  *    - **CSV File**: Contains only the RUNNING phase data (the actual benchmark)
  *    - **Specs File**: System hardware and software configuration
  *    - **Rust JSON**: Game's internal benchmark data (copied from game folder)
@@ -261,7 +265,7 @@ class BenchmarkManager : public QObject {
 
   BenchmarkDataPoint currentData;  // Now read-only lastCommittedSample
   BenchmarkDataPoint lastCommittedSample;
-  std::vector<BenchmarkDataPoint> allData;
+  BenchmarkSampleStore allData;
   std::chrono::steady_clock::time_point startTime;
   std::chrono::steady_clock::time_point benchmarkStartTime;
   bool saveToFile = false;
@@ -274,6 +278,8 @@ class BenchmarkManager : public QObject {
   void updateBenchmarkState(const PM_METRICS& metrics);
 
   friend void ::OnMetricsUpdate(uint32_t processId, const PM_METRICS* metrics);
+  friend void ::OnFrameTimesUpdate(uint32_t processId,
+                                   const FrameTimeSketch* frameTimes);
 
   // SystemInfoManager removed - using ConstantSystemInfo instead
   std::unique_ptr<BenchmarkStateTracker> m_stateTracker;
@@ -316,79 +322,10 @@ class BenchmarkManager : public QObject {
 
   void calculateCumulativeFrameTimePercentiles();
 
-  // Optimized histogram for frame time percentile calculation
-  struct FrameTimeHistogram {
-    static constexpr float MIN_FRAME_TIME = 1.0f;    // 1ms (1000 FPS)
-    static constexpr float MAX_FRAME_TIME = 200.0f;  // 200ms (5 FPS)
-    static constexpr float BUCKET_SIZE = 0.5f;       // 0.5ms bucket granularity
-    static constexpr size_t BUCKET_COUNT = static_cast<size_t>((MAX_FRAME_TIME - MIN_FRAME_TIME) / BUCKET_SIZE) + 1;
-    
-    std::array<uint32_t, BUCKET_COUNT> buckets{};
-    uint32_t totalSamples = 0;
-    uint32_t underflowCount = 0;  // samples < MIN_FRAME_TIME
-    uint32_t overflowCount = 0;   // samples > MAX_FRAME_TIME
-    
-    void addFrameTime(float frameTime) {
-      if (frameTime < MIN_FRAME_TIME) {
-        underflowCount++;
-      } else if (frameTime > MAX_FRAME_TIME) {
-        overflowCount++;
-      } else {
-        size_t bucketIndex = static_cast<size_t>((frameTime - MIN_FRAME_TIME) / BUCKET_SIZE);
-        bucketIndex = std::min(bucketIndex, BUCKET_COUNT - 1);
-        buckets[bucketIndex]++;
-      }
-      totalSamples++;
-    }
-    
-    // Batch add frame times to avoid per-frame loops
-    void addFrameTime(float frameTime, uint32_t count) {
-      if (frameTime < MIN_FRAME_TIME) {
-        underflowCount += count;
-      } else if (frameTime > MAX_FRAME_TIME) {
-        overflowCount += count;
-      } else {
-        size_t bucketIndex = static_cast<size_t>((frameTime - MIN_FRAME_TIME) / BUCKET_SIZE);
-        bucketIndex = std::min(bucketIndex, BUCKET_COUNT - 1);
-        buckets[bucketIndex] += count;
-      }
-      totalSamples += count;
-    }
-    
-    float calculatePercentile(float percentile) const {
-      if (totalSamples == 0) return -1.0f;
-      
-      uint32_t targetSample = static_cast<uint32_t>(totalSamples * (percentile / 100.0f));
-      targetSample = std::min(targetSample, totalSamples - 1);
-      
-      uint32_t cumulativeCount = underflowCount;
-      
-      // Check if target is in underflow
-      if (targetSample < cumulativeCount) {
-        return MIN_FRAME_TIME / 2.0f; // Return estimate for underflow
-      }
-      
-      // Search through histogram buckets
-      for (size_t i = 0; i < BUCKET_COUNT; ++i) {
-        cumulativeCount += buckets[i];
-        if (targetSample < cumulativeCount) {
-          return MIN_FRAME_TIME + (i * BUCKET_SIZE) + (BUCKET_SIZE / 2.0f);
-        }
-      }
-      
-      // Must be in overflow
-      return MAX_FRAME_TIME * 1.5f; // Return estimate for overflow
-    }
-    
-    void clear() {
-      buckets.fill(0);
-      totalSamples = 0;
-      underflowCount = 0;
-      overflowCount = 0;
-    }
-  };
-  
-  FrameTimeHistogram frameTimeHistogram;
+  // Every frame presented during RUNNING, fed per-frame by PresentMon via
+  // OnFrameTimesUpdate. Fixed-size, so memory doesn't grow over long runs;
+  // cumulative lows are within the sketch's 0.5% relative error.
+  FrameTimeSketch frameTimeSketch;
 
   // Cumulative frame time percentiles (for UI display)
   float m_cumulativeFrameTime1pct = -1.0f;
@@ -1,16 +1,69 @@
 #include "BenchmarkResultFileManager.h"
+#include "BenchmarkRunFile.h"
 #include "BenchmarkSpecsFileManager.h"
 #include "../hardware/ConstantSystemInfo.h"
 #include "../profiles/UserSystemProfile.h"
 #include "BenchmarkConstants.h"
 #include "../logging/Logger.h"
 #include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include <iostream>
-#include <iomanip>
+#include <sstream>
 #include <algorithm>
+#include <charconv>
 #include <windows.h>
 
-BenchmarkResultFileManager::BenchmarkResultFileManager() {
+namespace {
+// In-progress rows go to "<name>.csv.partial", the final file is assembled in
+// "<name>.csv.tmp" and renamed into place
+const std::string PARTIAL_SUFFIX = ".partial";
+const std::string TEMP_SUFFIX = ".tmp";
+
+// Comma-separated row builder on top of std::to_chars. Output matches the
+// previous std::fixed / std::setprecision stream formatting.
+class CsvRow {
+public:
+    explicit CsvRow(std::string& out) : m_out(out) {}
+
+    void fixed(double value, int precision) {
+        separator();
+        char buf[512];  // fits any double in fixed notation
+        auto result = std::to_chars(buf, buf + sizeof(buf), value,
+                                    std::chars_format::fixed, precision);
+        m_out.append(buf, result.ptr);
+    }
+
+    template <typename T>
+    void integer(T value) {
+        separator();
+        char buf[32];
+        auto result = std::to_chars(buf, buf + sizeof(buf), value);
+        m_out.append(buf, result.ptr);
+    }
+
+    // value if valid, otherwise -1 with the same precision
+    void fixedOr(bool valid, double value, int precision) {
+        fixed(valid ? value : -1.0, precision);
+    }
+
+    void end() { m_out.push_back('\n'); }
+
+private:
+    void separator() {
+        if (!m_first) m_out.push_back(',');
+        m_first = false;
+    }
+
+    std::string& m_out;
+    bool m_first = true;
+};
+}  // namespace
+
+BenchmarkResultFileManager::BenchmarkResultFileManager()
+    : m_writer([this](const BenchmarkDataPoint& row,
+                      const std::set<std::string>& diskNames,
+                      std::string& out) { formatDataPoint(row, diskNames, out); }) {
     // Initialize with system core counts
     const auto& sysInfo = SystemMetrics::GetConstantSystemInfo();
     setCoreCount(sysInfo.logicalCores, sysInfo.physicalCores);
@@ -29,7 +82,9 @@ bool BenchmarkResultFileManager::initializeOutputFile(const QString& filename) {
     m_outputFilename = filename;
     m_fullPath = "benchmark_results/" + filename.toStdString();
     
-    return createDirectories();
+    bool created = createDirectories();
+    recoverPartialFiles();
+    return created;
 }
 
 bool BenchmarkResultFileManager::createDirectories() {
@@ -38,37 +93,95 @@ bool BenchmarkResultFileManager::createDirectories() {
     return true;
 }
 
-bool BenchmarkResultFileManager::openFile() {
+bool BenchmarkResultFileManager::openFile(const std::string& suffix) {
     closeFile(); // Ensure any existing file is closed
+    m_headerTerminated = false;
+    m_headerDiskNames.clear();
+    
+    auto tryOpen = [this, &suffix](const std::string& basePath) {
+        std::string path = basePath + suffix;
+        if (!m_writer.open(QString::fromStdString(path).toStdWString())) {
+            return false;
+        }
+        m_fullPath = basePath;
+        m_openPath = path;
+        return true;
+    };
     
-    m_outputFile.open(m_fullPath, std::ios::out | std::ios::trunc);
-    if (!m_outputFile.is_open()) {
-        logError("Failed to open output file: " + m_fullPath);
+    if (!tryOpen(m_fullPath)) {
+        logError("Failed to open output file: " + m_fullPath + suffix);
         
         // Try alternative path
         QString absPath = QDir::currentPath() + "/benchmark_results/";
         QDir().mkpath(absPath);
         std::string altPath = absPath.toStdString() + m_outputFilename.toStdString();
         
-        m_outputFile.open(altPath, std::ios::out | std::ios::trunc);
-        if (!m_outputFile.is_open()) {
+        if (!tryOpen(altPath)) {
             // Emergency backup path
             QString emergencyPath = absPath + "emergency_backup.csv";
-            m_outputFile.open(emergencyPath.toStdString(), std::ios::out | std::ios::trunc);
             
-            if (!m_outputFile.is_open()) {
+            if (!tryOpen(emergencyPath.toStdString())) {
                 logError("All file creation attempts failed");
                 return false;
             }
-            m_fullPath = emergencyPath.toStdString();
-        } else {
-            m_fullPath = altPath;
         }
     }
     
     return true;
 }
 
+bool BenchmarkResultFileManager::promoteFile(const std::string& from, const std::string& to) {
+    // Atomic replace: readers see either the old file or the complete new one
+    if (!MoveFileExW(QString::fromStdString(from).toStdWString().c_str(),
+                     QString::fromStdString(to).toStdWString().c_str(),
+                     MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        logError("Failed to move " + from + " to " + to + " (error " +
+                 std::to_string(GetLastError()) + ")");
+        return false;
+    }
+    return true;
+}
+
+void BenchmarkResultFileManager::recoverPartialFiles() {
+    QDir dir = QFileInfo(QString::fromStdString(m_fullPath)).absoluteDir();
+    
+    // A leftover temp file means the crash happened while finalizing; the
+    // partial file it was built from is still there
+    for (const QFileInfo& temp : dir.entryInfoList({"*.csv" + QString::fromStdString(TEMP_SUFFIX)}, QDir::Files)) {
+        QFile::remove(temp.filePath());
+    }
+    
+    for (const QFileInfo& partial : dir.entryInfoList({"*.csv" + QString::fromStdString(PARTIAL_SUFFIX)}, QDir::Files)) {
+        QString partialPath = partial.filePath();
+        QString targetPath = partialPath.left(partialPath.size() - static_cast<int>(PARTIAL_SUFFIX.size()));
+        
+        QFile file(partialPath);
+        if (QFile::exists(targetPath) || !file.open(QIODevice::ReadWrite)) {
+            QFile::remove(partialPath);
+            continue;
+        }
+        
+        // Rows are only ever written whole, so anything after the last newline
+        // is a torn write from the crash
+        QByteArray contents = file.readAll();
+        int lastNewline = contents.lastIndexOf('\n');
+        bool hasRows = lastNewline > 0 && contents.indexOf('\n') < lastNewline;
+        if (hasRows) {
+            file.resize(lastNewline + 1);
+        }
+        file.close();
+        
+        if (!hasRows) {
+            QFile::remove(partialPath);
+            continue;
+        }
+        
+        if (promoteFile(partialPath.toStdString(), targetPath.toStdString())) {
+            logCritical("Recovered partial benchmark run: " + targetPath.toStdString());
+        }
+    }
+}
+
 void BenchmarkResultFileManager::setCoreCount(size_t logicalCores, size_t physicalCores) {
     m_finalUsageCount = logicalCores > 0 ? logicalCores : 0;
     m_finalSpeedCount = physicalCores > 0 ? physicalCores : 0;
@@ -87,7 +200,7 @@ void BenchmarkResultFileManager::setCoreCount(size_t logicalCores, size_t physic
 }
 
 bool BenchmarkResultFileManager::writeHeader() {
-    if (!openFile()) {
+    if (!openFile(PARTIAL_SUFFIX)) {
         return false;
     }
     
@@ -100,7 +213,8 @@ void BenchmarkResultFileManager::writeCSVHeader() {
     // === CSV HEADER ORGANIZED BY PROVIDER ===
     // =====================================================================================
     
-    m_outputFile
+    std::ostringstream header;
+    header
         // === PRESENTMON (ETW) METRICS - Keep FPS first as requested ===
         << "Time,FPS,Frame Time,Highest Frame Time,5% Highest Frame Time (Per-Second),"
         << "GPU Render Time,CPU Render Time,Highest GPU Time,Highest CPU Time,Frame Time Variance,"
@@ -139,14 +253,14 @@ void BenchmarkResultFileManager::writeCSVHeader() {
 
     // === PDH PER-CORE METRICS ===
     for (size_t i = 0; i < m_finalUsageCount; i++) {
-        m_outputFile << ",PDH_Core " << i << " CPU (%)";
+        header << ",PDH_Core " << i << " CPU (%)";
     }
     for (size_t i = 0; i < m_finalSpeedCount; i++) {
-        m_outputFile << ",PDH_Core " << i << " Freq (MHz)";
+        header << ",PDH_Core " << i << " Freq (MHz)";
     }
     
     // === CPU KERNEL TRACKER (ETW) METRICS ===
-    m_outputFile
+    header
         << ",ETW_Interrupts/sec,ETW_DPCs/sec,ETW_Avg_DPC_Latency(μs),"
         << "ETW_DPC_Latencies_>50μs(%),ETW_DPC_Latencies_>100μs(%),"
         
@@ -156,41 +270,50 @@ void BenchmarkResultFileManager::writeCSVHeader() {
         << "Disk_Min_Read_Latency(ms),Disk_Max_Read_Latency(ms),"
         << "Disk_Min_Write_Latency(ms),Disk_Max_Write_Latency(ms),"
         << "Disk_IO_Read_Total(MB),Disk_IO_Write_Total(MB)";
+
+    m_writer.appendText(header.str());
 }
 
-bool BenchmarkResultFileManager::writeDataPoints(
-    const std::vector<BenchmarkDataPoint>& dataPoints,
-    const std::set<std::string>& diskNames) {
-    
-    if (!m_outputFile.is_open()) {
-        logError("Cannot write data points: file is not open");
-        return false;
+void BenchmarkResultFileManager::terminateHeader(const std::set<std::string>& diskNames) {
+    if (m_headerTerminated) {
+        return;
     }
-
-    // Add headers for per-disk throughput metrics if we have disk data
+    
+    // Per-disk columns are fixed by the first batch so every row of the file
+    // lines up with the header
+    std::string columns;
     if (!diskNames.empty()) {
         logCritical("Found per-disk data for " + std::to_string(diskNames.size()) + " drives");
         for (const auto& diskName : diskNames) {
-            m_outputFile << ",Disk_" << diskName << "_Read(MB/s),Disk_" << diskName << "_Write(MB/s)";
+            columns += ",Disk_" + diskName + "_Read(MB/s),Disk_" + diskName + "_Write(MB/s)";
         }
     }
+    columns += "\n";
     
-    m_outputFile << "\n";
+    m_writer.appendText(std::move(columns));
+    m_headerDiskNames = diskNames;
+    m_headerTerminated = true;
+}
 
-    int pointsWritten = 0;
-    for (const auto& data : dataPoints) {
-        if (data.presentCount > 0) {
-            writeDataPoint(data, diskNames);
-            pointsWritten++;
-        }
+bool BenchmarkResultFileManager::writeDataPoints(
+    BenchmarkSampleStore& samples,
+    const std::set<std::string>& diskNames) {
+    
+    if (!m_writer.isOpen()) {
+        logError("Cannot write data points: file is not open");
+        return false;
     }
 
-    m_outputFile.flush();
+    terminateHeader(diskNames);
+
+    const auto& presentCounts = samples.column(&BenchmarkDataPoint::presentCount);
+    size_t pointsQueued = std::count_if(presentCounts.begin(), presentCounts.end(),
+                                        [](int count) { return count > 0; });
     
     // Calculate and log average values for all metrics
-    if (!dataPoints.empty()) {
+    if (!samples.empty()) {
         try {
-            logBenchmarkAverages(dataPoints, diskNames);
+            logBenchmarkAverages(samples, 0, samples.size());
         } catch (const std::exception& e) {
             logError("Benchmark averages error: " + std::string(e.what()));
         } catch (...) {
@@ -198,184 +321,185 @@ bool BenchmarkResultFileManager::writeDataPoints(
         }
     }
     
-    logCritical("Wrote " + std::to_string(pointsWritten) + " data points to CSV");
+    // Formatting and the disk write happen on the writer thread
+    m_writer.appendSamples(samples, 0, samples.size(), m_headerDiskNames);
+    
+    logCritical("Queued " + std::to_string(pointsQueued) + " data points for CSV");
     return true;
 }
 
-void BenchmarkResultFileManager::writeDataPoint(
+void BenchmarkResultFileManager::formatDataPoint(
     const BenchmarkDataPoint& data, 
-    const std::set<std::string>& diskNames) {
+    const std::set<std::string>& diskNames,
+    std::string& out) const {
     
     // =====================================================================================
     // === DATA ORGANIZED BY PROVIDER (matching headers) ===
     // =====================================================================================
     
-    m_outputFile << std::fixed << std::setprecision(2)
-        // === PRESENTMON (ETW) METRICS ===
-        << data.timestamp
-        << "," << (data.fps > 0 ? data.fps : -1)
-        << "," << (data.frameTime > 0 ? data.frameTime : -1)
-        << "," << (data.highestFrameTime > 0 ? data.highestFrameTime : -1)
-        << "," << (data.highest5PctFrameTime > 0 ? data.highest5PctFrameTime : -1)
-        << "," << (data.gpuRenderTime > 0 ? data.gpuRenderTime : -1)
-        << "," << (data.cpuRenderTime > 0 ? data.cpuRenderTime : -1)
-        << "," << (data.highestGpuTime > 0 ? data.highestGpuTime : -1)
-        << "," << (data.highestCpuTime > 0 ? data.highestCpuTime : -1)
-        << "," << data.fpsVariance
-        << "," << data.lowFps1Percent
-        << "," << data.lowFps5Percent
-        << "," << data.lowFps05Percent
-        << "," << data.destWidth
-        << "," << data.destHeight
-        
-        // === NVIDIA GPU METRICS ===
-        << "," << data.gpuTemp
-        << "," << data.gpuUtilization
-        << "," << data.gpuPower
-        << "," << data.gpuClock
-        << "," << data.gpuMemClock
-        << "," << data.gpuFanSpeed
-        << "," << std::setprecision(4) << (data.gpuMemUsed / (1024.0 * 1024.0))
-        << "," << (data.gpuMemTotal / (1024.0 * 1024.0))
-        << "," << data.gpuSmUtilization
-        << "," << data.gpuMemBandwidthUtil
-        << "," << data.gpuPcieRxThroughput
-        << "," << data.gpuPcieTxThroughput
-        << "," << data.gpuNvdecUtil
-        << "," << data.gpuNvencUtil
-        
-        // === PDH CPU METRICS ===
-        << "," << std::setprecision(2) << (data.procProcessorTime >= 0 ? data.procProcessorTime : -1)
-        << "," << (data.procUserTime >= 0 ? data.procUserTime : -1)
-        << "," << (data.procPrivilegedTime >= 0 ? data.procPrivilegedTime : -1)
-        << "," << (data.procIdleTime >= 0 ? data.procIdleTime : -1)
-        << "," << (data.procActualFreq >= 0 ? data.procActualFreq : -1)
-        << "," << (data.cpuInterruptsPerSec >= 0 ? data.cpuInterruptsPerSec : -1)
-        << "," << (data.cpuDpcTime >= 0 ? data.cpuDpcTime : -1)
-        << "," << (data.cpuInterruptTime >= 0 ? data.cpuInterruptTime : -1)
-        << "," << (data.cpuDpcsQueuedPerSec >= 0 ? data.cpuDpcsQueuedPerSec : -1)
-        << "," << (data.cpuDpcRate >= 0 ? data.cpuDpcRate : -1)
-        << "," << (data.cpuC1Time >= 0 ? data.cpuC1Time : -1)
-        << "," << (data.cpuC2Time >= 0 ? data.cpuC2Time : -1)
-        << "," << (data.cpuC3Time >= 0 ? data.cpuC3Time : -1)
-        << "," << (data.cpuC1TransitionsPerSec >= 0 ? data.cpuC1TransitionsPerSec : -1)
-        << "," << (data.cpuC2TransitionsPerSec >= 0 ? data.cpuC2TransitionsPerSec : -1)
-        << "," << (data.cpuC3TransitionsPerSec >= 0 ? data.cpuC3TransitionsPerSec : -1)
-        
-        // === PDH MEMORY METRICS ===
-        << "," << (data.availableMemoryMB > 0 ? data.availableMemoryMB : -1)
-        << "," << (data.memoryLoad > 0 ? data.memoryLoad : -1)
-        << "," << (data.memoryCommittedBytes >= 0 ? data.memoryCommittedBytes : -1)
-        << "," << (data.memoryCommitLimit >= 0 ? data.memoryCommitLimit : -1)
-        << "," << (data.memoryFaultsPerSec >= 0 ? data.memoryFaultsPerSec : -1)
-        << "," << (data.memoryPagesPerSec >= 0 ? data.memoryPagesPerSec : -1)
-        << "," << (data.memoryPoolNonPagedBytes >= 0 ? data.memoryPoolNonPagedBytes : -1)
-        << "," << (data.memoryPoolPagedBytes >= 0 ? data.memoryPoolPagedBytes : -1)
-        << "," << (data.memorySystemCodeBytes >= 0 ? data.memorySystemCodeBytes : -1)
-        << "," << (data.memorySystemDriverBytes >= 0 ? data.memorySystemDriverBytes : -1)
-        
-        // === PDH DISK METRICS ===
-        << "," << (data.ioReadRateMBs >= 0 ? data.ioReadRateMBs : -1)
-        << "," << (data.ioWriteRateMBs >= 0 ? data.ioWriteRateMBs : -1)
-        << "," << (data.diskReadsPerSec >= 0 ? data.diskReadsPerSec : -1)
-        << "," << (data.diskWritesPerSec >= 0 ? data.diskWritesPerSec : -1)
-        << "," << (data.diskTransfersPerSec >= 0 ? data.diskTransfersPerSec : -1)
-        << "," << (data.diskBytesPerSec >= 0 ? data.diskBytesPerSec : -1)
-        << "," << (data.diskAvgReadQueueLength >= 0 ? data.diskAvgReadQueueLength : -1)
-        << "," << (data.diskAvgWriteQueueLength >= 0 ? data.diskAvgWriteQueueLength : -1)
-        << "," << (data.diskAvgQueueLength >= 0 ? data.diskAvgQueueLength : -1)
-        << "," << (data.diskAvgReadTime >= 0 ? data.diskAvgReadTime : -1)
-        << "," << (data.diskAvgWriteTime >= 0 ? data.diskAvgWriteTime : -1)
-        << "," << (data.diskAvgTransferTime >= 0 ? data.diskAvgTransferTime : -1)
-        << "," << (data.diskPercentTime >= 0 ? data.diskPercentTime : -1)
-        << "," << (data.diskPercentReadTime >= 0 ? data.diskPercentReadTime : -1)
-        << "," << (data.diskPercentWriteTime >= 0 ? data.diskPercentWriteTime : -1)
-        
-        // === PDH SYSTEM METRICS ===
-        << "," << (data.contextSwitchesPerSec >= 0 ? data.contextSwitchesPerSec : -1)
-        << "," << (data.systemProcessorQueueLength >= 0 ? data.systemProcessorQueueLength : -1)
-        << "," << (data.systemProcesses >= 0 ? data.systemProcesses : -1)
-        << "," << (data.systemThreads >= 0 ? data.systemThreads : -1)
-        << "," << (data.pdhInterruptsPerSec >= 0 ? data.pdhInterruptsPerSec : -1);
+    CsvRow row(out);
+    
+    // === PRESENTMON (ETW) METRICS ===
+    row.integer(data.timestamp);
+    row.fixedOr(data.fps > 0, data.fps, 2);
+    row.fixedOr(data.frameTime > 0, data.frameTime, 2);
+    row.fixedOr(data.highestFrameTime > 0, data.highestFrameTime, 2);
+    row.fixedOr(data.highest5PctFrameTime > 0, data.highest5PctFrameTime, 2);
+    row.fixedOr(data.gpuRenderTime > 0, data.gpuRenderTime, 2);
+    row.fixedOr(data.cpuRenderTime > 0, data.cpuRenderTime, 2);
+    row.fixedOr(data.highestGpuTime > 0, data.highestGpuTime, 2);
+    row.fixedOr(data.highestCpuTime > 0, data.highestCpuTime, 2);
+    row.fixed(data.fpsVariance, 2);
+    row.fixed(data.lowFps1Percent, 2);
+    row.fixed(data.lowFps5Percent, 2);
+    row.fixed(data.lowFps05Percent, 2);
+    row.integer(data.destWidth);
+    row.integer(data.destHeight);
+    
+    // === NVIDIA GPU METRICS ===
+    row.integer(data.gpuTemp);
+    row.integer(data.gpuUtilization);
+    row.integer(data.gpuPower);
+    row.integer(data.gpuClock);
+    row.integer(data.gpuMemClock);
+    row.integer(data.gpuFanSpeed);
+    row.fixed(data.gpuMemUsed / (1024.0 * 1024.0), 4);
+    row.fixed(data.gpuMemTotal / (1024.0 * 1024.0), 4);
+    row.integer(data.gpuSmUtilization);
+    row.integer(data.gpuMemBandwidthUtil);
+    row.integer(data.gpuPcieRxThroughput);
+    row.integer(data.gpuPcieTxThroughput);
+    row.integer(data.gpuNvdecUtil);
+    row.integer(data.gpuNvencUtil);
+    
+    // === PDH CPU METRICS ===
+    row.fixedOr(data.procProcessorTime >= 0, data.procProcessorTime, 2);
+    row.fixedOr(data.procUserTime >= 0, data.procUserTime, 2);
+    row.fixedOr(data.procPrivilegedTime >= 0, data.procPrivilegedTime, 2);
+    row.fixedOr(data.procIdleTime >= 0, data.procIdleTime, 2);
+    row.fixedOr(data.procActualFreq >= 0, data.procActualFreq, 2);
+    row.fixedOr(data.cpuInterruptsPerSec >= 0, data.cpuInterruptsPerSec, 2);
+    row.fixedOr(data.cpuDpcTime >= 0, data.cpuDpcTime, 2);
+    row.fixedOr(data.cpuInterruptTime >= 0, data.cpuInterruptTime, 2);
+    row.fixedOr(data.cpuDpcsQueuedPerSec >= 0, data.cpuDpcsQueuedPerSec, 2);
+    row.fixedOr(data.cpuDpcRate >= 0, data.cpuDpcRate, 2);
+    row.fixedOr(data.cpuC1Time >= 0, data.cpuC1Time, 2);
+    row.fixedOr(data.cpuC2Time >= 0, data.cpuC2Time, 2);
+    row.fixedOr(data.cpuC3Time >= 0, data.cpuC3Time, 2);
+    row.fixedOr(data.cpuC1TransitionsPerSec >= 0, data.cpuC1TransitionsPerSec, 2);
+    row.fixedOr(data.cpuC2TransitionsPerSec >= 0, data.cpuC2TransitionsPerSec, 2);
+    row.fixedOr(data.cpuC3TransitionsPerSec >= 0, data.cpuC3TransitionsPerSec, 2);
+    
+    // === PDH MEMORY METRICS ===
+    row.fixedOr(data.availableMemoryMB > 0, data.availableMemoryMB, 2);
+    row.fixedOr(data.memoryLoad > 0, data.memoryLoad, 2);
+    row.fixedOr(data.memoryCommittedBytes >= 0, data.memoryCommittedBytes, 2);
+    row.fixedOr(data.memoryCommitLimit >= 0, data.memoryCommitLimit, 2);
+    row.fixedOr(data.memoryFaultsPerSec >= 0, data.memoryFaultsPerSec, 2);
+    row.fixedOr(data.memoryPagesPerSec >= 0, data.memoryPagesPerSec, 2);
+    row.fixedOr(data.memoryPoolNonPagedBytes >= 0, data.memoryPoolNonPagedBytes, 2);
+    row.fixedOr(data.memoryPoolPagedBytes >= 0, data.memoryPoolPagedBytes, 2);
+    row.fixedOr(data.memorySystemCodeBytes >= 0, data.memorySystemCodeBytes, 2);
+    row.fixedOr(data.memorySystemDriverBytes >= 0, data.memorySystemDriverBytes, 2);
+    
+    // === PDH DISK METRICS ===
+    row.fixedOr(data.ioReadRateMBs >= 0, data.ioReadRateMBs, 2);
+    row.fixedOr(data.ioWriteRateMBs >= 0, data.ioWriteRateMBs, 2);
+    row.fixedOr(data.diskReadsPerSec >= 0, data.diskReadsPerSec, 2);
+    row.fixedOr(data.diskWritesPerSec >= 0, data.diskWritesPerSec, 2);
+    row.fixedOr(data.diskTransfersPerSec >= 0, data.diskTransfersPerSec, 2);
+    row.fixedOr(data.diskBytesPerSec >= 0, data.diskBytesPerSec, 2);
+    row.fixedOr(data.diskAvgReadQueueLength >= 0, data.diskAvgReadQueueLength, 2);
+    row.fixedOr(data.diskAvgWriteQueueLength >= 0, data.diskAvgWriteQueueLength, 2);
+    row.fixedOr(data.diskAvgQueueLength >= 0, data.diskAvgQueueLength, 2);
+    row.fixedOr(data.diskAvgReadTime >= 0, data.diskAvgReadTime, 2);
+    row.fixedOr(data.diskAvgWriteTime >= 0, data.diskAvgWriteTime, 2);
+    row.fixedOr(data.diskAvgTransferTime >= 0, data.diskAvgTransferTime, 2);
+    row.fixedOr(data.diskPercentTime >= 0, data.diskPercentTime, 2);
+    row.fixedOr(data.diskPercentReadTime >= 0, data.diskPercentReadTime, 2);
+    row.fixedOr(data.diskPercentWriteTime >= 0, data.diskPercentWriteTime, 2);
+    
+    // === PDH SYSTEM METRICS ===
+    row.fixedOr(data.contextSwitchesPerSec >= 0, data.contextSwitchesPerSec, 2);
+    row.fixedOr(data.systemProcessorQueueLength >= 0, data.systemProcessorQueueLength, 2);
+    row.fixedOr(data.systemProcesses >= 0, data.systemProcesses, 2);
+    row.fixedOr(data.systemThreads >= 0, data.systemThreads, 2);
+    row.fixedOr(data.pdhInterruptsPerSec >= 0, data.pdhInterruptsPerSec, 2);
 
     // === PDH PER-CORE CPU USAGE ===
     for (size_t i = 0; i < m_finalUsageCount; i++) {
-        m_outputFile << ",";
         if (i < data.perCoreCpuUsagePdh.size() && data.perCoreCpuUsagePdh[i] >= 0) {
-            m_outputFile << std::setprecision(2) << data.perCoreCpuUsagePdh[i];
+            row.fixed(data.perCoreCpuUsagePdh[i], 2);
         } else {
-            m_outputFile << -1;
+            row.integer(-1);
         }
     }
     
     // === PDH PER-CORE ACTUAL FREQUENCY ===
+    // The stream-based writer left precision at 0 after printing a frequency
+    // and the two ETW rates below inherited it; keep that output unchanged
+    int etwRatePrecision = 2;
     for (size_t i = 0; i < m_finalSpeedCount; i++) {
-        m_outputFile << ",";
         if (i < data.perCoreActualFreq.size() && data.perCoreActualFreq[i] > 0) {
-            m_outputFile << std::setprecision(0) << data.perCoreActualFreq[i];
+            row.fixed(data.perCoreActualFreq[i], 0);
+            etwRatePrecision = 0;
         } else {
-            m_outputFile << -1;
+            row.integer(-1);
         }
     }
     
     // === CPU KERNEL TRACKER (ETW) METRICS ===
-    m_outputFile 
-        << "," << (data.interruptsPerSec >= 0 ? data.interruptsPerSec : -1)
-        << "," << (data.dpcCountPerSec >= 0 ? data.dpcCountPerSec : -1)
-        << "," << std::setprecision(3) << data.avgDpcLatencyUs
-        << "," << std::setprecision(2) << data.dpcLatenciesAbove50us
-        << "," << data.dpcLatenciesAbove100us;
+    row.fixedOr(data.interruptsPerSec >= 0, data.interruptsPerSec, etwRatePrecision);
+    row.fixedOr(data.dpcCountPerSec >= 0, data.dpcCountPerSec, etwRatePrecision);
+    row.fixed(data.avgDpcLatencyUs, 3);
+    row.fixed(data.dpcLatenciesAbove50us, 2);
+    row.fixed(data.dpcLatenciesAbove100us, 2);
 
     // === DISK PERFORMANCE TRACKER METRICS ===
-    m_outputFile << std::setprecision(4)
-        << "," << (data.diskReadLatencyMs >= 0 ? data.diskReadLatencyMs : -1)
-        << "," << (data.diskWriteLatencyMs >= 0 ? data.diskWriteLatencyMs : -1)
-        << "," << (data.diskQueueLength >= 0 ? data.diskQueueLength : -1)
-        << "," << (data.avgDiskQueueLength >= 0 ? data.avgDiskQueueLength : -1)
-        << "," << (data.maxDiskQueueLength >= 0 ? data.maxDiskQueueLength : -1)
-        << "," << (data.minDiskReadLatencyMs >= 0 ? data.minDiskReadLatencyMs : -1)
-        << "," << (data.maxDiskReadLatencyMs >= 0 ? data.maxDiskReadLatencyMs : -1)
-        << "," << (data.minDiskWriteLatencyMs >= 0 ? data.minDiskWriteLatencyMs : -1)
-        << "," << (data.maxDiskWriteLatencyMs >= 0 ? data.maxDiskWriteLatencyMs : -1)
-        << "," << std::setprecision(2) << (data.ioReadMB >= 0 ? data.ioReadMB : -1)
-        << "," << (data.ioWriteMB >= 0 ? data.ioWriteMB : -1);
+    row.fixedOr(data.diskReadLatencyMs >= 0, data.diskReadLatencyMs, 4);
+    row.fixedOr(data.diskWriteLatencyMs >= 0, data.diskWriteLatencyMs, 4);
+    row.fixedOr(data.diskQueueLength >= 0, data.diskQueueLength, 4);
+    row.fixedOr(data.avgDiskQueueLength >= 0, data.avgDiskQueueLength, 4);
+    row.fixedOr(data.maxDiskQueueLength >= 0, data.maxDiskQueueLength, 4);
+    row.fixedOr(data.minDiskReadLatencyMs >= 0, data.minDiskReadLatencyMs, 4);
+    row.fixedOr(data.maxDiskReadLatencyMs >= 0, data.maxDiskReadLatencyMs, 4);
+    row.fixedOr(data.minDiskWriteLatencyMs >= 0, data.minDiskWriteLatencyMs, 4);
+    row.fixedOr(data.maxDiskWriteLatencyMs >= 0, data.maxDiskWriteLatencyMs, 4);
+    row.fixedOr(data.ioReadMB >= 0, data.ioReadMB, 2);
+    row.fixedOr(data.ioWriteMB >= 0, data.ioWriteMB, 2);
 
     // === PER-DISK THROUGHPUT (from DiskPerformanceTracker) ===
     for (const auto& diskName : diskNames) {
-        m_outputFile << ",";
         auto readIt = data.perDiskReadRates.find(diskName);
         if (readIt != data.perDiskReadRates.end()) {
-            m_outputFile << std::setprecision(4) << readIt->second;
+            row.fixed(readIt->second, 4);
         } else {
-            m_outputFile << -1;
+            row.integer(-1);
         }
 
-        m_outputFile << ",";
         auto writeIt = data.perDiskWriteRates.find(diskName);
         if (writeIt != data.perDiskWriteRates.end()) {
-            m_outputFile << std::setprecision(4) << writeIt->second;
+            row.fixed(writeIt->second, 4);
         } else {
-            m_outputFile << -1;
+            row.integer(-1);
         }
     }
 
-    m_outputFile << "\n";
+    row.end();
 }
 
-std::vector<BenchmarkDataPoint> BenchmarkResultFileManager::extractBenchmarkData(
-    const std::vector<BenchmarkDataPoint>& allData) {
-    
-    std::vector<BenchmarkDataPoint> trimmedData;
+std::pair<size_t, size_t> BenchmarkResultFileManager::extractBenchmarkRange(
+    const BenchmarkSampleStore& allData) {
     
     if (allData.empty()) {
         logError("No benchmark data to extract");
-        return trimmedData;
+        return {0, 0};
     }
 
-    trimmedData.reserve(allData.size());
+    const auto& timestamps = allData.column(&BenchmarkDataPoint::timestamp);
 
     // Get the last timestamp as the end of the reference data
-    float rawEndTime = allData.back().timestamp;
+    float rawEndTime = static_cast<float>(timestamps.back());
 
     // Adjust end time to exclude the buffer
     float endTime = rawEndTime - static_cast<float>(BenchmarkConstants::BENCHMARK_END_BUFFER);
@@ -387,47 +511,80 @@ std::vector<BenchmarkDataPoint> BenchmarkResultFileManager::extractBenchmarkData
     logCritical("Extracting data: " + std::to_string(static_cast<int>(startTime)) +
                "s to " + std::to_string(static_cast<int>(endTime)) + "s");
 
-    int pointsInRange = 0;
-    for (const auto& data : allData) {
-        if (data.timestamp >= startTime && data.timestamp <= endTime) {
-            trimmedData.push_back(data);
-            pointsInRange++;
-        }
+    // Samples are appended once per second in order, so the selection is a
+    // single contiguous range of the timestamp column
+    size_t first = 0;
+    while (first < timestamps.size() && timestamps[first] < startTime) {
+        first++;
+    }
+    size_t last = first;
+    while (last < timestamps.size() && timestamps[last] <= endTime) {
+        last++;
     }
 
-    logCritical("Selected " + std::to_string(pointsInRange) + " data points");
-    return trimmedData;
+    logCritical("Selected " + std::to_string(last - first) + " data points");
+    return {first, last};
 }
 
 bool BenchmarkResultFileManager::finalizeBenchmark(
-    const std::vector<BenchmarkDataPoint>& allData,
+    BenchmarkSampleStore& allData,
     const QString& userSystemId) {
     
-    // Extract benchmark data points
-    std::vector<BenchmarkDataPoint> trimmedData = extractBenchmarkData(allData);
+    // Extract benchmark sample range
+    auto [first, last] = extractBenchmarkRange(allData);
     
     // Find all disk names for headers
-    std::set<std::string> allDiskNames;
-    for (const auto& data : trimmedData) {
-        for (const auto& [diskName, _] : data.perDiskReadRates) {
-            allDiskNames.insert(diskName);
-        }
-    }
+    std::set<std::string> allDiskNames = allData.diskNamesWithData(
+        BenchmarkSampleStore::DiskMetric::ReadRate, first, last);
 
-    // Write header and data
-    if (!writeHeader()) {
+    // The final file supersedes the rows batched during the run
+    std::string partialPath = m_openPath;
+    m_writer.close();
+    m_openPath.clear();
+
+    // Write header and data to a temp file, then swap it into place
+    if (!openFile(TEMP_SUFFIX)) {
+        return false;
+    }
+    writeCSVHeader();
+    terminateHeader(allDiskNames);
+    
+    try {
+        logBenchmarkAverages(allData, first, last);
+    } catch (...) {
+        logError("Unknown error in benchmark averages");
+    }
+    m_writer.appendSamples(allData, first, last, m_headerDiskNames);
+    
+    if (!m_writer.sync()) {
+        logError("Failed to write final benchmark file: " + m_openPath);
+        m_writer.close();
+        m_openPath.clear();
         return false;
     }
+    std::string tempPath = m_openPath;
+    m_writer.close();
+    m_openPath.clear();
     
-    if (!writeDataPoints(trimmedData, allDiskNames)) {
+    if (!promoteFile(tempPath, m_fullPath)) {
         return false;
     }
+    if (partialPath.size() > PARTIAL_SUFFIX.size() &&
+        partialPath.compare(partialPath.size() - PARTIAL_SUFFIX.size(),
+                            PARTIAL_SUFFIX.size(), PARTIAL_SUFFIX) == 0) {
+        QFile::remove(QString::fromStdString(partialPath));
+    }
+    logCritical("Wrote " + std::to_string(last - first) + " data points to " + m_fullPath);
+
+    // Binary copy for the results view; the CSV stays the export format
+    if (!BenchmarkRunFile::writeFromCsv(QString::fromStdString(m_fullPath))) {
+        logError("Failed to write binary run file for " + m_fullPath);
+    }
 
     // Write system specs and benchmark results
     writeSystemSpecs(userSystemId);
     writeFinalBenchmarkResults();
 
-    closeFile();
     return true;
 }
 
@@ -468,14 +625,22 @@ bool BenchmarkResultFileManager::writeFinalBenchmarkResults() {
 }
 
 void BenchmarkResultFileManager::closeFile() {
-    if (m_outputFile.is_open()) {
-        m_outputFile.flush();
-        m_outputFile.close();
+    m_writer.close();
+    if (m_openPath.empty()) {
+        return;
+    }
+    
+    // A run closed without being finalized keeps its batched rows under the
+    // real file name, as before
+    std::string openPath = m_openPath;
+    m_openPath.clear();
+    if (openPath == m_fullPath + PARTIAL_SUFFIX) {
+        promoteFile(openPath, m_fullPath);
     }
 }
 
 bool BenchmarkResultFileManager::isFileOpen() const {
-    return m_outputFile.is_open();
+    return m_writer.isOpen();
 }
 
 std::string BenchmarkResultFileManager::getFilePath() const {
@@ -490,27 +655,36 @@ void BenchmarkResultFileManager::logCritical(const std::string& message) {
     LOG_ERROR << "[CRITICAL] " << message;
 }
 
-void BenchmarkResultFileManager::logBenchmarkAverages(const std::vector<BenchmarkDataPoint>& dataPoints,
-                                                     const std::set<std::string>& diskNames) {
+void BenchmarkResultFileManager::logBenchmarkAverages(const BenchmarkSampleStore& samples,
+                                                     size_t first, size_t last) {
     try {
-        if (dataPoints.empty()) {
+        last = std::min(last, samples.size());
+        if (first >= last) {
             logError("No data points for averages calculation");
             return;
         }
         
+        // Each metric is a straight scan over its own column
+        const auto& presentCounts = samples.column(&BenchmarkDataPoint::presentCount);
+        const auto& fps = samples.column(&BenchmarkDataPoint::fps);
+        const auto& frameTime = samples.column(&BenchmarkDataPoint::frameTime);
+        const auto& cpuUsage = samples.column(&BenchmarkDataPoint::procProcessorTime);
+        const auto& gpuTemp = samples.column(&BenchmarkDataPoint::gpuTemp);
+        const auto& gpuUtil = samples.column(&BenchmarkDataPoint::gpuUtilization);
+        
         size_t validSamples = 0;
         double sumFps = 0.0, sumFrameTime = 0.0, sumCpuUsage = 0.0;
         double sumGpuTemp = 0.0, sumGpuUtil = 0.0;
         
         // Simple accumulation with bounds checking using PDH metrics
-        for (const auto& data : dataPoints) {
-            if (data.presentCount > 0) {
+        for (size_t i = first; i < last; i++) {
+            if (presentCounts[i] > 0) {
                 validSamples++;
-                if (data.fps > 0 && data.fps < 1000) sumFps += data.fps;
-                if (data.frameTime > 0 && data.frameTime < 1000) sumFrameTime += data.frameTime;
-                if (data.procProcessorTime >= 0 && data.procProcessorTime <= 100) sumCpuUsage += data.procProcessorTime;
-                if (data.gpuTemp > 0 && data.gpuTemp < 200) sumGpuTemp += data.gpuTemp;
-                if (data.gpuUtilization >= 0 && data.gpuUtilization <= 100) sumGpuUtil += data.gpuUtilization;
+                if (fps[i] > 0 && fps[i] < 1000) sumFps += fps[i];
+                if (frameTime[i] > 0 && frameTime[i] < 1000) sumFrameTime += frameTime[i];
+                if (cpuUsage[i] >= 0 && cpuUsage[i] <= 100) sumCpuUsage += cpuUsage[i];
+                if (gpuTemp[i] > 0 && gpuTemp[i] < 200) sumGpuTemp += gpuTemp[i];
+                if (gpuUtil[i] <= 100) sumGpuUtil += gpuUtil[i];
             }
         }
         
@@ -3,9 +3,11 @@
 #include <string>
 #include <vector>
 #include <set>
-#include <fstream>
+#include <utility>
 #include <QString>
+#include "BenchmarkCsvWriter.h"
 #include "BenchmarkDataPoint.h"
+#include "BenchmarkSampleStore.h"
 
 /**
  * @brief Handles all CSV file operations for benchmark results
@@ -17,6 +19,13 @@
  * - Handling per-core CPU metrics
  * - Writing system specs files
  * - Managing benchmark result finalization
+ *
+ * Rows are formatted and written by a background BenchmarkCsvWriter. While a
+ * run is in progress batches are appended to "<name>.csv.partial"; the final
+ * CSV is written to a temporary file, fsynced and renamed over "<name>.csv",
+ * so a crash never leaves a half-written result under the real name.
+ * Leftover partial files are recovered (torn last row dropped) the next time
+ * an output file is initialized.
  */
 class BenchmarkResultFileManager {
 public:
@@ -26,9 +35,10 @@ public:
     // Main file operations
     bool initializeOutputFile(const QString& filename);
     bool writeHeader();
-    bool writeDataPoints(const std::vector<BenchmarkDataPoint>& dataPoints, 
+    // Hands the batch to the writer thread; samples is left empty
+    bool writeDataPoints(BenchmarkSampleStore& samples,
                         const std::set<std::string>& diskNames);
-    bool finalizeBenchmark(const std::vector<BenchmarkDataPoint>& allData,
+    bool finalizeBenchmark(BenchmarkSampleStore& allData,
                           const QString& userSystemId);
     void closeFile();
 
@@ -41,9 +51,12 @@ public:
 
 private:
     // File management
-    std::ofstream m_outputFile;
+    BenchmarkCsvWriter m_writer;
     QString m_outputFilename;
     std::string m_fullPath;
+    std::string m_openPath;               // file the writer currently appends to
+    bool m_headerTerminated = false;      // per-disk columns + newline written
+    std::set<std::string> m_headerDiskNames;
     
     // Core count for per-core metrics
     size_t m_finalUsageCount = 0;  // For logical cores (CPU usage)
@@ -51,20 +64,24 @@ private:
     
     // Internal helpers
     bool createDirectories();
-    bool openFile();
+    bool openFile(const std::string& suffix);
+    bool promoteFile(const std::string& from, const std::string& to);
+    void recoverPartialFiles();
     void writeCSVHeader();
-    void writeDataPoint(const BenchmarkDataPoint& data, 
-                       const std::set<std::string>& diskNames);
+    void terminateHeader(const std::set<std::string>& diskNames);
+    void formatDataPoint(const BenchmarkDataPoint& data,
+                        const std::set<std::string>& diskNames,
+                        std::string& out) const;
     
-    // Data processing
-    std::vector<BenchmarkDataPoint> extractBenchmarkData(
-        const std::vector<BenchmarkDataPoint>& allData);
+    // Data processing - returns the [first, last) sample range of the run
+    std::pair<size_t, size_t> extractBenchmarkRange(
+        const BenchmarkSampleStore& allData);
     
     // System specs and final results
     bool writeSystemSpecs(const QString& userSystemId);
     bool writeFinalBenchmarkResults();
-    void logBenchmarkAverages(const std::vector<BenchmarkDataPoint>& dataPoints,
-                             const std::set<std::string>& diskNames);
+    void logBenchmarkAverages(const BenchmarkSampleStore& samples,
+                             size_t first, size_t last);
     
     // Error handling
     void logError(const std::string& message);
@@ -0,0 +1,240 @@
+#include "BenchmarkRunFile.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "../logging/Logger.h"
+#include "../network/serialization/CsvTokenizer.h"
+
+static_assert(std::endian::native == std::endian::little,
+              "BenchmarkRunFile is stored little-endian");
+
+namespace {
+constexpr char RUN_FILE_MAGIC[8] = {'C', 'M', 'R', 'U', 'N', '\0', '\0', '\0'};
+constexpr uint32_t RUN_FILE_VERSION = 3;  // 2: per-row field counts, 3: blank rows kept
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t columnCount;
+  uint64_t rowCount;
+  uint64_t sourceSize;     // CSV the file was built from
+  int64_t sourceMtimeMs;
+  uint64_t schemaOffset;
+  uint64_t dataOffset;
+  uint64_t footerOffset;   // field counts sit between the data and the footer
+};
+static_assert(sizeof(FileHeader) == 64, "FileHeader layout is part of the format");
+static_assert(sizeof(BenchmarkRunFile::ColumnStats) == 32,
+              "ColumnStats layout is part of the format");
+
+uint64_t alignTo8(uint64_t offset) { return (offset + 7) & ~uint64_t(7); }
+}  // namespace
+
+BenchmarkRunFile::~BenchmarkRunFile() { close(); }
+
+QString BenchmarkRunFile::sidecarPath(const QString& csvPath) {
+  QString path = csvPath;
+  if (path.endsWith(".csv", Qt::CaseInsensitive)) {
+    path.chop(4);
+  }
+  return path + ".cmrun";
+}
+
+bool BenchmarkRunFile::writeFromCsv(const QString& csvPath) {
+  QFile csv(csvPath);
+  if (!csv.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  QFileInfo csvInfo(csvPath);
+  const qint64 csvSize = csv.size();
+  const uchar* mapped = csvSize > 0 ? csv.map(0, csvSize) : nullptr;
+  if (!mapped) {
+    return false;
+  }
+  std::string_view text(reinterpret_cast<const char*>(mapped),
+                        static_cast<size_t>(csvSize));
+
+  CsvTokenizer::Table table;
+  if (!CsvTokenizer().tokenize(text, table) || table.columnNames.empty() ||
+      (table.columnNames.size() == 1 && table.columnNames[0].empty())) {
+    return false;  // no header
+  }
+  const size_t columnCount = table.columnNames.size();
+  const size_t rowCount = table.rowCount;
+
+  // Schema bytes
+  QByteArray schema;
+  for (const auto& name : table.columnNames) {
+    uint32_t length = static_cast<uint32_t>(name.size());
+    schema.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    schema.append(name.data(), static_cast<qsizetype>(name.size()));
+  }
+
+  FileHeader header{};
+  std::memcpy(header.magic, RUN_FILE_MAGIC, sizeof(header.magic));
+  header.version = RUN_FILE_VERSION;
+  header.columnCount = static_cast<uint32_t>(columnCount);
+  header.rowCount = rowCount;
+  header.sourceSize = static_cast<uint64_t>(csvSize);
+  header.sourceMtimeMs = csvInfo.lastModified().toMSecsSinceEpoch();
+  header.schemaOffset = sizeof(FileHeader);
+  header.dataOffset = alignTo8(header.schemaOffset + schema.size());
+  const uint64_t fieldCountOffset =
+    header.dataOffset + columnCount * rowCount * sizeof(double);
+  header.footerOffset = alignTo8(fieldCountOffset + rowCount * sizeof(uint32_t));
+
+  std::vector<ColumnStats> footer(columnCount);
+  for (size_t c = 0; c < columnCount; ++c) {
+    ColumnStats stats{0.0, 0.0, 0.0, 0};
+    for (double value : table.column(c)) {
+      if (!std::isfinite(value)) continue;
+      stats.min = stats.count == 0 ? value : std::min(stats.min, value);
+      stats.max = stats.count == 0 ? value : std::max(stats.max, value);
+      stats.sum += value;
+      stats.count++;
+    }
+    footer[c] = stats;
+  }
+
+  QSaveFile out(sidecarPath(csvPath));
+  if (!out.open(QIODevice::WriteOnly)) {
+    LOG_ERROR << "Failed to create run file for " << csvPath.toStdString();
+    return false;
+  }
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(schema);
+  const char padding[8] = {};
+  out.write(padding, static_cast<qint64>(header.dataOffset - header.schemaOffset -
+                                         schema.size()));
+  for (size_t c = 0; c < columnCount; ++c) {
+    out.write(reinterpret_cast<const char*>(table.column(c).data()),
+              static_cast<qint64>(rowCount * sizeof(double)));
+  }
+  out.write(reinterpret_cast<const char*>(table.fieldCounts.data()),
+            static_cast<qint64>(rowCount * sizeof(uint32_t)));
+  out.write(padding, static_cast<qint64>(header.footerOffset - fieldCountOffset -
+                                         rowCount * sizeof(uint32_t)));
+  out.write(reinterpret_cast<const char*>(footer.data()),
+            static_cast<qint64>(footer.size() * sizeof(ColumnStats)));
+  return out.commit();
+}
+
+bool BenchmarkRunFile::open(const QString& csvPath) {
+  close();
+  if (mapSidecar(csvPath)) {
+    return true;
+  }
+  close();
+  return false;
+}
+
+bool BenchmarkRunFile::openOrBuild(const QString& csvPath) {
+  if (open(csvPath)) {
+    return true;
+  }
+
+  // Missing, stale or unreadable: rebuild from the CSV once
+  if (writeFromCsv(csvPath) && mapSidecar(csvPath)) {
+    return true;
+  }
+  close();
+  return false;
+}
+
+void BenchmarkRunFile::close() {
+  if (m_data) {
+    m_file.unmap(const_cast<uchar*>(m_data));
+    m_data = nullptr;
+  }
+  m_file.close();
+  m_rowCount = 0;
+  m_dataOffset = 0;
+  m_fieldCountOffset = 0;
+  m_footerOffset = 0;
+  m_columnNames.clear();
+}
+
+bool BenchmarkRunFile::mapSidecar(const QString& csvPath) {
+  QFileInfo csvInfo(csvPath);
+  m_file.setFileName(sidecarPath(csvPath));
+  if (!m_file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  const qint64 fileSize = m_file.size();
+  if (fileSize < static_cast<qint64>(sizeof(FileHeader))) {
+    return false;
+  }
+  const uchar* data = m_file.map(0, fileSize);
+  if (!data) {
+    return false;
+  }
+  m_data = data;
+
+  FileHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  const uint64_t columnBytes = uint64_t(header.columnCount) * header.rowCount * sizeof(double);
+  const uint64_t fieldCountOffset = header.dataOffset + columnBytes;
+  const bool valid =
+    std::memcmp(header.magic, RUN_FILE_MAGIC, sizeof(header.magic)) == 0 &&
+    header.version == RUN_FILE_VERSION &&
+    header.schemaOffset == sizeof(FileHeader) &&
+    header.dataOffset % 8 == 0 && header.dataOffset >= header.schemaOffset &&
+    header.footerOffset ==
+      alignTo8(fieldCountOffset + header.rowCount * sizeof(uint32_t)) &&
+    header.footerOffset + uint64_t(header.columnCount) * sizeof(ColumnStats) ==
+      static_cast<uint64_t>(fileSize);
+  const bool current =
+    csvInfo.exists() && header.sourceSize == static_cast<uint64_t>(csvInfo.size()) &&
+    header.sourceMtimeMs == csvInfo.lastModified().toMSecsSinceEpoch();
+  if (!valid || !current) {
+    return false;
+  }
+
+  // Schema
+  uint64_t offset = header.schemaOffset;
+  for (uint32_t c = 0; c < header.columnCount; ++c) {
+    uint32_t length = 0;
+    if (offset + sizeof(length) > header.dataOffset) return false;
+    std::memcpy(&length, data + offset, sizeof(length));
+    offset += sizeof(length);
+    if (offset + length > header.dataOffset) return false;
+    m_columnNames.append(QString::fromUtf8(reinterpret_cast<const char*>(data + offset),
+                                           static_cast<qsizetype>(length)));
+    offset += length;
+  }
+
+  m_rowCount = static_cast<size_t>(header.rowCount);
+  m_dataOffset = header.dataOffset;
+  m_fieldCountOffset = fieldCountOffset;
+  m_footerOffset = header.footerOffset;
+  return true;
+}
+
+const double* BenchmarkRunFile::column(int index) const {
+  if (!m_data || index < 0 || index >= columnCount()) return nullptr;
+  return reinterpret_cast<const double*>(m_data + m_dataOffset) +
+         static_cast<size_t>(index) * m_rowCount;
+}
+
+const uint32_t* BenchmarkRunFile::fieldCounts() const {
+  if (!m_data) return nullptr;
+  return reinterpret_cast<const uint32_t*>(m_data + m_fieldCountOffset);
+}
+
+BenchmarkRunFile::ColumnStats BenchmarkRunFile::stats(int index) const {
+  ColumnStats stats{0.0, 0.0, 0.0, 0};
+  if (!m_data || index < 0 || index >= columnCount()) return stats;
+  std::memcpy(&stats, m_data + m_footerOffset + index * sizeof(ColumnStats),
+              sizeof(stats));
+  return stats;
+}
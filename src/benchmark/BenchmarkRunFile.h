@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief BenchmarkRunFile - Binary, memory-mapped copy of a benchmark CSV
+ *
+ * Written next to "<run>.csv" as "<run>.cmrun" so readers never parse text.
+ * Layout (little-endian):
+ *
+ * - FileHeader: magic, version, column/row counts, the size and mtime of
+ *   the CSV it was built from, and section offsets
+ * - Schema: one length-prefixed UTF-8 column name per CSV header field
+ * - Data: one contiguous block of rowCount doubles per column, in header
+ *   order. Cells that were empty or not numeric in the CSV are NaN.
+ * - Field counts: one uint32 per row, how many fields the CSV line had, so
+ *   readers can still tell a short (torn) row from one with empty cells
+ * - Footer: ColumnStats (min/max/sum/count over finite values) per column
+ *
+ * The values are exactly what the CSV holds (as rounded in the text), so a
+ * reader sees the same numbers either way. open() only maps a sidecar that
+ * is current, so it is cheap enough for the GUI thread. openOrBuild() also
+ * builds or rebuilds a missing or stale one, which parses the whole CSV and
+ * belongs on a worker thread; that is how runs saved before this format
+ * existed are upgraded (RunLibraryIndex does it when it scans them).
+ */
+class BenchmarkRunFile {
+ public:
+  struct ColumnStats {
+    double min;
+    double max;
+    double sum;
+    uint64_t count;  // finite values only
+  };
+
+  BenchmarkRunFile() = default;
+  ~BenchmarkRunFile();
+  BenchmarkRunFile(const BenchmarkRunFile&) = delete;
+  BenchmarkRunFile& operator=(const BenchmarkRunFile&) = delete;
+
+  static QString sidecarPath(const QString& csvPath);
+
+  // Parses the CSV once and (atomically) writes its sidecar
+  static bool writeFromCsv(const QString& csvPath);
+
+  // Maps the sidecar for csvPath; fails if it is missing or stale
+  bool open(const QString& csvPath);
+  // As open(), but builds the sidecar first if needed. Not for the GUI thread.
+  bool openOrBuild(const QString& csvPath);
+  void close();
+  bool isOpen() const { return m_data != nullptr; }
+
+  size_t rowCount() const { return m_rowCount; }
+  int columnCount() const { return static_cast<int>(m_columnNames.size()); }
+  const QStringList& columnNames() const { return m_columnNames; }
+  int columnIndex(const QString& name) const { return m_columnNames.indexOf(name); }
+
+  // rowCount() values, valid while the file is open
+  const double* column(int index) const;
+  const uint32_t* fieldCounts() const;
+  ColumnStats stats(int index) const;
+
+ private:
+  bool mapSidecar(const QString& csvPath);
+
+  QFile m_file;
+  const uchar* m_data = nullptr;
+  size_t m_rowCount = 0;
+  uint64_t m_dataOffset = 0;
+  uint64_t m_fieldCountOffset = 0;
+  uint64_t m_footerOffset = 0;
+  QStringList m_columnNames;
+};
@@ -0,0 +1,280 @@
+#include "BenchmarkSampleStore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr double MISSING_CORE_VALUE = -1.0;
+const double MISSING_DISK_VALUE = std::numeric_limits<double>::quiet_NaN();
+
+template <typename T>
+void addColumns(std::vector<T>& list,
+                std::initializer_list<decltype(T::field)> fields) {
+  for (auto field : fields) {
+    list.push_back({field, {}});
+  }
+}
+}  // namespace
+
+const std::array<BenchmarkSampleStore::DiskMap BenchmarkDataPoint::*,
+                 BenchmarkSampleStore::DISK_METRIC_COUNT>
+  BenchmarkSampleStore::DISK_FIELDS = {
+    &BenchmarkDataPoint::perDiskPercentTime,
+    &BenchmarkDataPoint::perDiskPercentReadTime,
+    &BenchmarkDataPoint::perDiskPercentWriteTime,
+    &BenchmarkDataPoint::perDiskPercentIdleTime,
+    &BenchmarkDataPoint::perDiskReadRates,
+    &BenchmarkDataPoint::perDiskWriteRates,
+};
+
+BenchmarkSampleStore::BenchmarkSampleStore() {
+  using DP = BenchmarkDataPoint;
+
+  // PresentMon frame metrics
+  addColumns(std::get<ColumnList<float>>(m_columns),
+             {&DP::fps, &DP::frameTime, &DP::maxFrameTime, &DP::gpuRenderTime,
+              &DP::cpuRenderTime, &DP::appRenderTime, &DP::lowFps1Percent,
+              &DP::lowFps5Percent, &DP::lowFps05Percent, &DP::highestFrameTime,
+              &DP::highest5PctFrameTime, &DP::highestGpuTime,
+              &DP::highestCpuTime, &DP::fpsVariance});
+
+  // Display and NVIDIA GPU metrics
+  addColumns(std::get<ColumnList<unsigned int>>(m_columns),
+             {&DP::destWidth, &DP::destHeight, &DP::gpuTemp,
+              &DP::gpuUtilization, &DP::gpuMemUtilization, &DP::gpuPower,
+              &DP::gpuClock, &DP::gpuMemClock, &DP::gpuFanSpeed,
+              &DP::gpuSmUtilization, &DP::gpuMemBandwidthUtil,
+              &DP::gpuPcieRxThroughput, &DP::gpuPcieTxThroughput,
+              &DP::gpuNvdecUtil, &DP::gpuNvencUtil});
+  addColumns(std::get<ColumnList<unsigned long long>>(m_columns),
+             {&DP::gpuMemTotal, &DP::gpuMemUsed});
+  addColumns(std::get<ColumnList<bool>>(m_columns), {&DP::gpuThrottling});
+
+  // PDH, CPU kernel tracker and disk tracker metrics
+  addColumns(std::get<ColumnList<double>>(m_columns),
+             {&DP::procProcessorTime, &DP::procUserTime,
+              &DP::procPrivilegedTime, &DP::procIdleTime, &DP::procActualFreq,
+              &DP::cpuInterruptsPerSec, &DP::cpuDpcTime, &DP::cpuInterruptTime,
+              &DP::cpuDpcsQueuedPerSec, &DP::cpuDpcRate, &DP::cpuC1Time,
+              &DP::cpuC2Time, &DP::cpuC3Time, &DP::cpuC1TransitionsPerSec,
+              &DP::cpuC2TransitionsPerSec, &DP::cpuC3TransitionsPerSec,
+              &DP::availableMemoryMB, &DP::memoryLoad,
+              &DP::memoryCommittedBytes, &DP::memoryCommitLimit,
+              &DP::memoryFaultsPerSec, &DP::memoryPagesPerSec,
+              &DP::memoryPoolNonPagedBytes, &DP::memoryPoolPagedBytes,
+              &DP::memorySystemCodeBytes, &DP::memorySystemDriverBytes,
+              &DP::ioReadRateMBs, &DP::ioWriteRateMBs, &DP::diskReadsPerSec,
+              &DP::diskWritesPerSec, &DP::diskTransfersPerSec,
+              &DP::diskBytesPerSec, &DP::diskAvgReadQueueLength,
+              &DP::diskAvgWriteQueueLength, &DP::diskAvgQueueLength,
+              &DP::diskAvgReadTime, &DP::diskAvgWriteTime,
+              &DP::diskAvgTransferTime, &DP::diskPercentTime,
+              &DP::diskPercentReadTime, &DP::diskPercentWriteTime,
+              &DP::contextSwitchesPerSec, &DP::systemProcessorQueueLength,
+              &DP::systemProcesses, &DP::systemThreads,
+              &DP::pdhInterruptsPerSec, &DP::interruptsPerSec,
+              &DP::dpcCountPerSec, &DP::avgDpcLatencyUs,
+              &DP::dpcLatenciesAbove50us, &DP::dpcLatenciesAbove100us,
+              &DP::voluntaryContextSwitchesPerSec,
+              &DP::involuntaryContextSwitchesPerSec,
+              &DP::highPriorityInterruptionsPerSec,
+              &DP::priorityInversionsPerSec, &DP::avgThreadWaitTimeMs,
+              &DP::ioReadMB, &DP::ioWriteMB, &DP::ioReadDeltaMB,
+              &DP::ioWriteDeltaMB, &DP::diskReadLatencyMs,
+              &DP::diskWriteLatencyMs, &DP::diskQueueLength,
+              &DP::avgDiskQueueLength, &DP::maxDiskQueueLength,
+              &DP::minDiskReadLatencyMs, &DP::maxDiskReadLatencyMs,
+              &DP::minDiskWriteLatencyMs, &DP::maxDiskWriteLatencyMs});
+
+  // Metadata
+  addColumns(std::get<ColumnList<int64_t>>(m_columns), {&DP::timestamp});
+  addColumns(std::get<ColumnList<int>>(m_columns),
+             {&DP::presentCount, &DP::processCount});
+}
+
+void BenchmarkSampleStore::reserve(size_t samples) {
+  if (samples <= m_capacity) return;
+  m_capacity = samples;
+
+  std::apply(
+    [samples](auto&... lists) {
+      ((
+         [&] {
+           for (auto& col : lists) col.values.reserve(samples);
+         }()),
+       ...);
+    },
+    m_columns);
+
+  for (auto& col : m_perCoreCpuUsage) col.reserve(samples);
+  for (auto& col : m_perCoreActualFreq) col.reserve(samples);
+  for (auto& disk : m_diskColumns) {
+    for (auto& col : disk) col.reserve(samples);
+  }
+}
+
+void BenchmarkSampleStore::clear() {
+  std::apply(
+    [](auto&... lists) {
+      ((
+         [&] {
+           for (auto& col : lists) col.values.clear();
+         }()),
+       ...);
+    },
+    m_columns);
+
+  // Core and disk columns keep their slots (and capacity) for the next run;
+  // only the values go
+  for (auto& col : m_perCoreCpuUsage) col.clear();
+  for (auto& col : m_perCoreActualFreq) col.clear();
+  for (auto& disk : m_diskColumns) {
+    for (auto& col : disk) col.clear();
+  }
+  m_size = 0;
+}
+
+void BenchmarkSampleStore::append(const BenchmarkDataPoint& sample) {
+  if (m_size == m_capacity) {
+    reserve(m_capacity == 0 ? 128 : m_capacity * 2);
+  }
+
+  std::apply(
+    [&sample](auto&... lists) {
+      ((
+         [&] {
+           for (auto& col : lists) col.values.push_back(sample.*(col.field));
+         }()),
+       ...);
+    },
+    m_columns);
+
+  appendCoreValues(m_perCoreCpuUsage, sample.perCoreCpuUsagePdh);
+  appendCoreValues(m_perCoreActualFreq, sample.perCoreActualFreq);
+
+  // Intern any disk seen for the first time (backfills earlier rows)
+  for (size_t metric = 0; metric < DISK_METRIC_COUNT; ++metric) {
+    for (const auto& [name, _] : sample.*DISK_FIELDS[metric]) {
+      internDisk(name);
+    }
+  }
+  for (size_t diskId = 0; diskId < m_diskNames.size(); ++diskId) {
+    const std::string& name = m_diskNames[diskId];
+    for (size_t metric = 0; metric < DISK_METRIC_COUNT; ++metric) {
+      const DiskMap& values = sample.*DISK_FIELDS[metric];
+      auto it = values.empty() ? values.end() : values.find(name);
+      m_diskColumns[diskId][metric].push_back(
+        it != values.end() ? it->second : MISSING_DISK_VALUE);
+    }
+  }
+
+  ++m_size;
+}
+
+void BenchmarkSampleStore::appendCoreValues(
+  std::vector<std::vector<double>>& columns, const std::vector<double>& values) {
+  // A sample reporting more cores than seen so far adds dense columns,
+  // backfilled as missing for earlier rows
+  while (columns.size() < values.size()) {
+    columns.emplace_back();
+    columns.back().reserve(m_capacity);
+    columns.back().assign(m_size, MISSING_CORE_VALUE);
+  }
+  for (size_t core = 0; core < columns.size(); ++core) {
+    columns[core].push_back(core < values.size() ? values[core]
+                                                 : MISSING_CORE_VALUE);
+  }
+}
+
+size_t BenchmarkSampleStore::internDisk(const std::string& name) {
+  auto it = m_diskIds.find(name);
+  if (it != m_diskIds.end()) return it->second;
+
+  size_t diskId = m_diskNames.size();
+  m_diskNames.push_back(name);
+  m_diskIds.emplace(name, diskId);
+  if (m_diskColumns.size() <= diskId) {
+    m_diskColumns.emplace_back();
+  }
+  for (auto& col : m_diskColumns[diskId]) {
+    col.reserve(m_capacity);
+    col.assign(m_size, MISSING_DISK_VALUE);
+  }
+  return diskId;
+}
+
+std::set<std::string> BenchmarkSampleStore::diskNamesWithData(
+  DiskMetric metric, size_t first, size_t last) const {
+  std::set<std::string> names;
+  last = std::min(last, m_size);
+  for (size_t diskId = 0; diskId < m_diskNames.size(); ++diskId) {
+    const auto& col = diskColumn(diskId, metric);
+    for (size_t i = first; i < last; ++i) {
+      if (!std::isnan(col[i])) {
+        names.insert(m_diskNames[diskId]);
+        break;
+      }
+    }
+  }
+  return names;
+}
+
+void BenchmarkSampleStore::materialize(size_t index,
+                                       BenchmarkDataPoint& out) const {
+  std::apply(
+    [index, &out](const auto&... lists) {
+      ((
+         [&] {
+           for (const auto& col : lists) out.*(col.field) = col.values[index];
+         }()),
+       ...);
+    },
+    m_columns);
+
+  out.perCoreCpuUsagePdh.resize(m_perCoreCpuUsage.size());
+  for (size_t core = 0; core < m_perCoreCpuUsage.size(); ++core) {
+    out.perCoreCpuUsagePdh[core] = m_perCoreCpuUsage[core][index];
+  }
+  out.perCoreActualFreq.resize(m_perCoreActualFreq.size());
+  for (size_t core = 0; core < m_perCoreActualFreq.size(); ++core) {
+    out.perCoreActualFreq[core] = m_perCoreActualFreq[core][index];
+  }
+
+  for (size_t metric = 0; metric < DISK_METRIC_COUNT; ++metric) {
+    DiskMap& values = out.*DISK_FIELDS[metric];
+    values.clear();
+    for (size_t diskId = 0; diskId < m_diskNames.size(); ++diskId) {
+      double value = m_diskColumns[diskId][metric][index];
+      if (!std::isnan(value)) values[m_diskNames[diskId]] = value;
+    }
+  }
+}
+
+BenchmarkDataPoint BenchmarkSampleStore::at(size_t index) const {
+  BenchmarkDataPoint out;
+  materialize(index, out);
+  return out;
+}
+
+size_t BenchmarkSampleStore::memoryBytes() const {
+  size_t bytes = 0;
+  std::apply(
+    [&bytes](const auto&... lists) {
+      ((
+         [&] {
+           for (const auto& col : lists) {
+             using Value = typename std::decay_t<decltype(col.values)>::value_type;
+             bytes += col.values.capacity() * sizeof(Value);
+           }
+         }()),
+       ...);
+    },
+    m_columns);
+  for (const auto& col : m_perCoreCpuUsage) bytes += col.capacity() * sizeof(double);
+  for (const auto& col : m_perCoreActualFreq) bytes += col.capacity() * sizeof(double);
+  for (const auto& disk : m_diskColumns) {
+    for (const auto& col : disk) bytes += col.capacity() * sizeof(double);
+  }
+  return bytes;
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "BenchmarkDataPoint.h"
+
+/**
+ * @brief BenchmarkSampleStore - Columnar storage for per-second benchmark samples
+ *
+ * BenchmarkDataPoint is convenient for assembling one sample, but keeping one
+ * per second for a whole run (with two heap vectors and eight maps each) is
+ * wasteful. The store keeps the same data as columns instead:
+ *
+ * - One contiguous, typed column per scalar metric, addressed by the
+ *   BenchmarkDataPoint member pointer: column(&BenchmarkDataPoint::fps)
+ * - Per-core metrics as N dense columns (-1 where a sample had no value)
+ * - Per-disk metrics keyed by an interned disk ID (NaN where a sample had no
+ *   value for that disk)
+ *
+ * After reserve() appending a sample does not allocate, and clear() keeps
+ * capacity, so a store reused as a batch buffer never reallocates. Any
+ * aggregation over one metric is a linear scan of a single vector.
+ *
+ * Not thread-safe; BenchmarkManager guards it with dataMutex.
+ */
+class BenchmarkSampleStore {
+ public:
+  enum class DiskMetric {
+    PercentTime,
+    PercentReadTime,
+    PercentWriteTime,
+    PercentIdleTime,
+    ReadRate,
+    WriteRate,
+    Count
+  };
+  static constexpr size_t DISK_METRIC_COUNT = static_cast<size_t>(DiskMetric::Count);
+
+  BenchmarkSampleStore();
+
+  void reserve(size_t samples);
+  void clear();  // drops samples; keeps core/disk column slots and capacity
+  void append(const BenchmarkDataPoint& sample);
+
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  // Scalar column for any BenchmarkDataPoint field, e.g.
+  // store.column(&BenchmarkDataPoint::fps) -> const std::vector<float>&
+  // Asserts on a field the constructor didn't register (a new member not
+  // added there); release builds get an empty column.
+  template <typename T>
+  const std::vector<T>& column(T BenchmarkDataPoint::* field) const {
+    for (const auto& col : std::get<ColumnList<T>>(m_columns)) {
+      if (col.field == field) return col.values;
+    }
+    assert(!"BenchmarkSampleStore::column: field not registered");
+    static const std::vector<T> empty;
+    return empty;
+  }
+
+  // Per-core columns (index = core number)
+  size_t coreUsageColumnCount() const { return m_perCoreCpuUsage.size(); }
+  size_t coreFreqColumnCount() const { return m_perCoreActualFreq.size(); }
+  const std::vector<double>& coreUsageColumn(size_t core) const {
+    return m_perCoreCpuUsage[core];
+  }
+  const std::vector<double>& coreFreqColumn(size_t core) const {
+    return m_perCoreActualFreq[core];
+  }
+
+  // Per-disk columns (index = interned disk ID)
+  size_t diskCount() const { return m_diskNames.size(); }
+  const std::string& diskName(size_t diskId) const { return m_diskNames[diskId]; }
+  const std::vector<double>& diskColumn(size_t diskId, DiskMetric metric) const {
+    return m_diskColumns[diskId][static_cast<size_t>(metric)];
+  }
+
+  // Names of disks with at least one value for metric in [first, last)
+  std::set<std::string> diskNamesWithData(DiskMetric metric, size_t first,
+                                          size_t last) const;
+
+  // Rebuild a row. `out` is reused so repeated calls don't reallocate vectors.
+  void materialize(size_t index, BenchmarkDataPoint& out) const;
+  BenchmarkDataPoint at(size_t index) const;
+
+  // Approximate heap footprint of the stored samples
+  size_t memoryBytes() const;
+
+ private:
+  template <typename T>
+  struct Column {
+    T BenchmarkDataPoint::* field;
+    std::vector<T> values;
+  };
+  template <typename T>
+  using ColumnList = std::vector<Column<T>>;
+
+  using DiskMap = std::map<std::string, double>;
+  using DiskColumns = std::array<std::vector<double>, DISK_METRIC_COUNT>;
+
+  size_t internDisk(const std::string& name);
+  void appendCoreValues(std::vector<std::vector<double>>& columns,
+                        const std::vector<double>& values);
+
+  std::tuple<ColumnList<float>, ColumnList<double>, ColumnList<unsigned int>,
+             ColumnList<unsigned long long>, ColumnList<int>,
+             ColumnList<int64_t>, ColumnList<bool>>
+    m_columns;
+
+  std::vector<std::vector<double>> m_perCoreCpuUsage;
+  std::vector<std::vector<double>> m_perCoreActualFreq;
+
+  std::vector<std::string> m_diskNames;
+  std::unordered_map<std::string, size_t> m_diskIds;
+  std::vector<DiskColumns> m_diskColumns;
+
+  size_t m_size = 0;
+  size_t m_capacity = 0;
+
+  static const std::array<DiskMap BenchmarkDataPoint::*, DISK_METRIC_COUNT> DISK_FIELDS;
+};
@@ -0,0 +1,136 @@
+#include "FrameTimeSketch.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Bucket layout is identical for every sketch so merges are a plain add
+const double kGamma = (1.0 + FrameTimeSketch::RELATIVE_ACCURACY) /
+                      (1.0 - FrameTimeSketch::RELATIVE_ACCURACY);
+const double kLogGamma = std::log(kGamma);
+const int kMinKey = static_cast<int>(
+  std::floor(std::log(FrameTimeSketch::MIN_TRACKED_MS) / kLogGamma));
+const int kMaxKey = static_cast<int>(
+  std::ceil(std::log(FrameTimeSketch::MAX_TRACKED_MS) / kLogGamma));
+const size_t kBucketCount = static_cast<size_t>(kMaxKey - kMinKey + 1);
+}  // namespace
+
+FrameTimeSketch::FrameTimeSketch()
+    : m_buckets(kBucketCount, 0), m_lowIndex(kBucketCount), m_highIndex(0) {}
+
+size_t FrameTimeSketch::bucketCount() { return kBucketCount; }
+
+size_t FrameTimeSketch::bucketIndex(double frameTimeMs) {
+  int key = static_cast<int>(std::ceil(std::log(frameTimeMs) / kLogGamma));
+  key = std::clamp(key, kMinKey, kMaxKey);
+  return static_cast<size_t>(key - kMinKey);
+}
+
+double FrameTimeSketch::bucketValue(size_t index) {
+  // Midpoint (in relative terms) of (gamma^(k-1), gamma^k]
+  int key = static_cast<int>(index) + kMinKey;
+  return 2.0 * std::pow(kGamma, key) / (kGamma + 1.0);
+}
+
+void FrameTimeSketch::add(double frameTimeMs) { add(frameTimeMs, 1); }
+
+void FrameTimeSketch::add(double frameTimeMs, uint64_t count) {
+  if (count == 0 || !(frameTimeMs >= 0.0)) return;  // also rejects NaN
+
+  if (m_count == 0) {
+    m_min = frameTimeMs;
+    m_max = frameTimeMs;
+  } else {
+    m_min = std::min(m_min, frameTimeMs);
+    m_max = std::max(m_max, frameTimeMs);
+  }
+  m_count += count;
+  m_sum += frameTimeMs * static_cast<double>(count);
+
+  if (frameTimeMs <= MIN_TRACKED_MS) {
+    m_zeroCount += count;
+    return;
+  }
+
+  size_t index = bucketIndex(frameTimeMs);
+  m_buckets[index] += count;
+  m_lowIndex = std::min(m_lowIndex, index);
+  m_highIndex = std::max(m_highIndex, index);
+}
+
+void FrameTimeSketch::merge(const FrameTimeSketch& other) {
+  if (other.m_count == 0) return;
+
+  if (m_count == 0) {
+    m_min = other.m_min;
+    m_max = other.m_max;
+  } else {
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+  }
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+  m_zeroCount += other.m_zeroCount;
+
+  if (other.m_lowIndex > other.m_highIndex) return;  // only zero-bucket frames
+  for (size_t i = other.m_lowIndex; i <= other.m_highIndex; ++i) {
+    m_buckets[i] += other.m_buckets[i];
+  }
+  m_lowIndex = std::min(m_lowIndex, other.m_lowIndex);
+  m_highIndex = std::max(m_highIndex, other.m_highIndex);
+}
+
+void FrameTimeSketch::clear() {
+  if (m_lowIndex <= m_highIndex) {
+    std::fill(m_buckets.begin() + m_lowIndex,
+              m_buckets.begin() + m_highIndex + 1, 0);
+  }
+  m_zeroCount = 0;
+  m_count = 0;
+  m_sum = 0.0;
+  m_min = 0.0;
+  m_max = 0.0;
+  m_lowIndex = kBucketCount;
+  m_highIndex = 0;
+}
+
+float FrameTimeSketch::percentile(float percentile) const {
+  if (m_count == 0) return -1.0f;
+
+  uint64_t targetRank =
+    static_cast<uint64_t>(static_cast<double>(m_count) * (percentile / 100.0));
+  targetRank = std::min(targetRank, m_count - 1);
+  if (targetRank == m_count - 1) {
+    return static_cast<float>(m_max);  // worst frame is tracked exactly
+  }
+  if (targetRank == 0) {
+    return static_cast<float>(m_min);  // and so is the best
+  }
+
+  uint64_t cumulative = m_zeroCount;
+  if (targetRank < cumulative) {
+    return static_cast<float>(m_min);
+  }
+
+  for (size_t i = m_lowIndex; i <= m_highIndex && i < kBucketCount; ++i) {
+    cumulative += m_buckets[i];
+    if (targetRank < cumulative) {
+      return static_cast<float>(std::clamp(bucketValue(i), m_min, m_max));
+    }
+  }
+
+  return static_cast<float>(m_max);
+}
+
+uint64_t FrameTimeSketch::countAbove(double frameTimeMs) const {
+  if (m_count == 0 || frameTimeMs >= m_max) return 0;
+  if (frameTimeMs < m_min) return m_count;
+  if (frameTimeMs <= MIN_TRACKED_MS) return m_count - m_zeroCount;
+
+  uint64_t above = 0;
+  for (size_t i = std::max(bucketIndex(frameTimeMs) + 1, m_lowIndex);
+       i <= m_highIndex && i < kBucketCount; ++i) {
+    above += m_buckets[i];
+  }
+  return above;
+}
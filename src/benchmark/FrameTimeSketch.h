@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief FrameTimeSketch - Mergeable log-bucketed quantile sketch for frame times
+ *
+ * DDSketch-style layout: bucket k covers (gamma^(k-1), gamma^k] with
+ * gamma = (1 + RELATIVE_ACCURACY) / (1 - RELATIVE_ACCURACY), so any reported
+ * percentile is within RELATIVE_ACCURACY of the true frame time. The bucket
+ * array is allocated once and never grows, which gives:
+ *
+ * - O(1) add() per frame (one log + one increment)
+ * - O(buckets) merge() and clear(), restricted to the populated range
+ * - Fixed memory (~15 KB) no matter how long the run is
+ *
+ * Values at or below MIN_TRACKED_MS share a single "zero" bucket and values
+ * above MAX_TRACKED_MS land in the top bucket. Exact min/max are tracked
+ * separately and every percentile is clamped to them, so a single multi-second
+ * freeze is reported at its real duration instead of an overflow estimate.
+ *
+ * Not thread-safe; callers guard it with their own mutex.
+ */
+class FrameTimeSketch {
+ public:
+  static constexpr double RELATIVE_ACCURACY = 0.005;  // 0.5% relative error
+  static constexpr double MIN_TRACKED_MS = 0.01;      // 100000 FPS
+  static constexpr double MAX_TRACKED_MS = 1.0e6;     // ~16 minute freeze
+
+  FrameTimeSketch();
+
+  // Record one frame (or `count` identical frames)
+  void add(double frameTimeMs);
+  void add(double frameTimeMs, uint64_t count);
+
+  // Fold another sketch into this one (both use the same fixed bucket layout)
+  void merge(const FrameTimeSketch& other);
+
+  void clear();
+
+  // Frame time at the given percentile (0-100). Uses the same rank convention
+  // as calculatePercentile(): index = floor(count * percentile / 100).
+  // Returns -1 when the sketch is empty.
+  float percentile(float percentile) const;
+
+  bool empty() const { return m_count == 0; }
+  uint64_t count() const { return m_count; }
+  float min() const { return m_count ? static_cast<float>(m_min) : -1.0f; }
+  float max() const { return m_count ? static_cast<float>(m_max) : -1.0f; }
+  float mean() const {
+    return m_count ? static_cast<float>(m_sum / m_count) : -1.0f;
+  }
+
+  // Number of frames strictly slower than the given frame time (approximate
+  // within RELATIVE_ACCURACY at the threshold boundary)
+  uint64_t countAbove(double frameTimeMs) const;
+
+  static size_t bucketCount();
+
+ private:
+  static size_t bucketIndex(double frameTimeMs);
+  static double bucketValue(size_t index);
+
+  std::vector<uint64_t> m_buckets;
+  uint64_t m_zeroCount = 0;  // frames <= MIN_TRACKED_MS
+  uint64_t m_count = 0;
+  double m_sum = 0.0;
+  double m_min = 0.0;
+  double m_max = 0.0;
+
+  // Populated bucket range, keeps scans/merges/clears proportional to the
+  // spread of frame times rather than the full layout
+  size_t m_lowIndex;
+  size_t m_highIndex;
+};
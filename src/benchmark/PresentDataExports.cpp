@@ -1,8 +1,10 @@
 #include "PresentDataExports.h"
 
 #include <algorithm>
+#include <cfloat>
 #include <chrono>
 #include <deque>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -13,6 +15,9 @@
 #include <evntrace.h>
 
 #include "BenchmarkConstants.h"
+#include "FrameTimeSketch.h"
+#include "SlidingWindowStats.h"
+#include "SpscRing.h"
 #include "PresentMonTraceConsumer.hpp"
 #include "PresentMonTraceSession.hpp"
 #include "../logging/Logger.h"
@@ -37,7 +42,8 @@ struct ProcessMonitor {
   std::unique_ptr<PMTraceConsumer> consumer;
   std::unique_ptr<PMTraceSession> session;
   std::thread traceThread;
-  std::thread processingThread;
+  std::thread eventThread;       // PresentMon events -> frameRing
+  std::thread processingThread;  // frameRing -> frameCollector, snapshots
 
   PM_METRICS latestMetrics;
   std::mutex metricsMutex;
@@ -46,9 +52,40 @@ struct ProcessMonitor {
   bool running;
   ProcessInfo processInfo;
 
-  std::deque<PM_METRICS> metricsQueue;
-  std::mutex queueMutex;
+  // One present of the monitored process, reduced to plain values on
+  // eventThread so the PresentEvent is released right away
+  struct FrameRecord {
+    uint64_t presentStartTime;  // QPC
+    float frameTime;            // ms, 0 if not a completed frame
+    float gpuRenderTime;
+    float gpuVideoTime;
+    float cpuRenderTime;
+    uint32_t frameId;
+    uint32_t destWidth;         // 0 if the event carried no display info
+    uint32_t destHeight;
+    int32_t syncInterval;
+    bool supportsTearing;
+  };
+
+  // Every frame from eventThread (producer) to processingThread (consumer).
+  // Holds several seconds at a few thousand FPS, so a slow metrics callback
+  // doesn't lose frames. A full ring drops the newest record and counts it
+  // (see SpscRing for why it can't drop the oldest).
+  static constexpr size_t FRAME_RING_CAPACITY = 16384;
+  static constexpr size_t FRAME_BATCH = 256;
+  static constexpr uint32_t EVENT_DRAIN_INTERVAL_MS = 5;
+  SpscRing<FrameRecord, FRAME_RING_CAPACITY> frameRing;
+  uint64_t reportedFrameDrops = 0;  // processingThread only, for logging new drops once
+
+  // Snapshots from processingThread (producer) to PM_GetMetrics (consumer).
+  // Lock-free; a full ring drops the newest snapshot and counts it, which
+  // takes MAX_QUEUE_SIZE snapshot intervals without a PM_GetMetrics call.
   static constexpr size_t MAX_QUEUE_SIZE = BenchmarkConstants::MAX_QUEUE_SIZE;
+  static constexpr size_t METRICS_RING_CAPACITY = 2048;
+  static_assert(METRICS_RING_CAPACITY >= MAX_QUEUE_SIZE,
+                "metrics ring must hold at least MAX_QUEUE_SIZE snapshots");
+  SpscRing<PM_METRICS, METRICS_RING_CAPACITY> metricsRing;
+  uint64_t reportedDrops = 0;  // consumer-side, for logging new drops once
 
   // Per-frame data collection for accurate min/max values
   struct FrameDataCollector {
@@ -60,12 +97,17 @@ struct ProcessMonitor {
       uint64_t timestamp;  // QPC timestamp when frame was captured
     };
 
+    // Quantization for windowed percentiles: 10us bins up to 1s frames.
+    // Anything slower shares the top bin and is clamped to the exact max.
+    static constexpr float PERCENTILE_BIN_WIDTH_MS = 0.01f;
+    static constexpr float PERCENTILE_MAX_MS = 1000.0f;
+
     std::deque<FrameInfo> frameBuffer;  // Rolling buffer of frames
     uint64_t timestampFrequency = 0;     // QPC frequency for time conversion
     std::chrono::steady_clock::time_point lastUpdate =
       std::chrono::steady_clock::now();  // Add this line
 
-    // Stats calculated from current buffer
+    // Stats maintained incrementally as frames enter and leave the window
     float minFrameTime = FLT_MAX;
     float maxFrameTime = 0.0f;
     float minGpuRenderTime = FLT_MAX;
@@ -76,8 +118,19 @@ struct ProcessMonitor {
     float sumGpuRenderTime = 0.0f;
     float sumCpuRenderTime = 0.0f;
     int frameCount = 0;
-    bool extremaNeedRecalc = false;  // Flag to track when extrema need recalculation
-    mutable std::vector<float> scratchVector;  // Reusable vector for percentile calculations
+    FrameTimeSketch intervalFrameTimes;  // Every frame since the last snapshot (not windowed)
+
+    // Sequence number of the next frame; frameBuffer.front() has
+    // nextFrameSeq - frameBuffer.size()
+    uint64_t nextFrameSeq = 0;
+    WindowedQuantiles frameTimeQuantiles{PERCENTILE_BIN_WIDTH_MS, PERCENTILE_MAX_MS};
+    WindowedMoments frameTimeMoments;
+    MonotonicExtremum<std::less<float>> frameTimeMin;
+    MonotonicExtremum<std::greater<float>> frameTimeMax;
+    MonotonicExtremum<std::less<float>> gpuRenderTimeMin;
+    MonotonicExtremum<std::greater<float>> gpuRenderTimeMax;
+    MonotonicExtremum<std::less<float>> cpuRenderTimeMin;
+    MonotonicExtremum<std::greater<float>> cpuRenderTimeMax;
 
     // Initialize with the QPC frequency
     void initialize(uint64_t frequency) {
@@ -91,13 +144,24 @@ struct ProcessMonitor {
       // Add new frame to buffer
       frameBuffer.push_back(
         {frameTime, gpuRenderTime, cpuRenderTime, currentTimestamp});
+      intervalFrameTimes.add(frameTime);
 
-      // Remove frames older than 1 second
-      cleanupOldFrames(currentTimestamp);
+      uint64_t seq = nextFrameSeq++;
+      frameTimeMin.push(seq, frameTime);
+      frameTimeMax.push(seq, frameTime);
+      gpuRenderTimeMin.push(seq, gpuRenderTime);
+      gpuRenderTimeMax.push(seq, gpuRenderTime);
+      cpuRenderTimeMin.push(seq, cpuRenderTime);
+      cpuRenderTimeMax.push(seq, cpuRenderTime);
 
       // Update incremental sums and frame count
       updateIncrementalStats(frameTime, gpuRenderTime, cpuRenderTime, true);
-      
+
+      // Remove frames older than 1 second
+      cleanupOldFrames(currentTimestamp);
+
+      refreshExtrema();
+
       // Update lastUpdate timestamp
       lastUpdate = std::chrono::steady_clock::now();
     }
@@ -112,6 +176,13 @@ struct ProcessMonitor {
       // Remove frames older than one second using O(1) front removal
       while (!frameBuffer.empty() && frameBuffer.front().timestamp < oneSecondAgo) {
         const auto& removedFrame = frameBuffer.front();
+        uint64_t removedSeq = nextFrameSeq - frameBuffer.size();
+        frameTimeMin.evict(removedSeq);
+        frameTimeMax.evict(removedSeq);
+        gpuRenderTimeMin.evict(removedSeq);
+        gpuRenderTimeMax.evict(removedSeq);
+        cpuRenderTimeMin.evict(removedSeq);
+        cpuRenderTimeMax.evict(removedSeq);
         updateIncrementalStats(removedFrame.frameTime, removedFrame.gpuRenderTime, removedFrame.cpuRenderTime, false);
         frameBuffer.pop_front();
       }
@@ -125,97 +196,53 @@ struct ProcessMonitor {
         sumGpuRenderTime += gpuRenderTime;
         sumCpuRenderTime += cpuRenderTime;
         frameCount++;
-        
-        // Update extrema only if necessary
-        if (frameTime < minFrameTime) minFrameTime = frameTime;
-        if (frameTime > maxFrameTime) maxFrameTime = frameTime;
-        if (gpuRenderTime < minGpuRenderTime) minGpuRenderTime = gpuRenderTime;
-        if (gpuRenderTime > maxGpuRenderTime) maxGpuRenderTime = gpuRenderTime;
-        if (cpuRenderTime < minCpuRenderTime) minCpuRenderTime = cpuRenderTime;
-        if (cpuRenderTime > maxCpuRenderTime) maxCpuRenderTime = cpuRenderTime;
+        frameTimeQuantiles.add(frameTime);
+        frameTimeMoments.add(frameTime);
       } else {
         // Removing frame
         sumFrameTime -= frameTime;
         sumGpuRenderTime -= gpuRenderTime;
         sumCpuRenderTime -= cpuRenderTime;
         frameCount--;
-        
-        // Note: min/max values are NOT decremented here for performance
-        // They will be recalculated only when needed (on snapshot requests)
-        extremaNeedRecalc = true;
+        frameTimeQuantiles.remove(frameTime);
+        frameTimeMoments.remove(frameTime);
       }
     }
-    
-    // Force recalculate extrema when needed (only called on snapshots)
-    void recalculateExtrema() {
-      if (!extremaNeedRecalc || frameBuffer.empty()) return;
-      
-      minFrameTime = FLT_MAX;
-      maxFrameTime = 0.0f;
-      minGpuRenderTime = FLT_MAX;
-      maxGpuRenderTime = 0.0f;
-      minCpuRenderTime = FLT_MAX;
-      maxCpuRenderTime = 0.0f;
-      
-      for (const auto& frame : frameBuffer) {
-        if (frame.frameTime < minFrameTime) minFrameTime = frame.frameTime;
-        if (frame.frameTime > maxFrameTime) maxFrameTime = frame.frameTime;
-        if (frame.gpuRenderTime < minGpuRenderTime) minGpuRenderTime = frame.gpuRenderTime;
-        if (frame.gpuRenderTime > maxGpuRenderTime) maxGpuRenderTime = frame.gpuRenderTime;
-        if (frame.cpuRenderTime < minCpuRenderTime) minCpuRenderTime = frame.cpuRenderTime;
-        if (frame.cpuRenderTime > maxCpuRenderTime) maxCpuRenderTime = frame.cpuRenderTime;
-      }
-      
-      extremaNeedRecalc = false;
+
+    // Pull current window extrema from the monotonic deques (O(1))
+    void refreshExtrema() {
+      if (frameBuffer.empty()) return;  // keep last values, as before
+
+      minFrameTime = frameTimeMin.value();
+      maxFrameTime = frameTimeMax.value();
+      minGpuRenderTime = gpuRenderTimeMin.value();
+      maxGpuRenderTime = gpuRenderTimeMax.value();
+      minCpuRenderTime = cpuRenderTimeMin.value();
+      maxCpuRenderTime = cpuRenderTimeMax.value();
     }
 
-    // Calculate percentile from current buffer using reusable scratch vector
+    // Windowed percentile in O(log bins), no copy or sort of the buffer
     float calculatePercentile(float percentile) const {
-      // Recalculate extrema if needed before percentile calculation
-      const_cast<FrameDataCollector*>(this)->recalculateExtrema();
-      
       if (frameBuffer.empty()) return 0.0f;
       if (frameBuffer.size() == 1) return frameBuffer[0].frameTime;
 
-      // Reuse scratch vector to avoid allocations
-      scratchVector.clear();
-      scratchVector.reserve(frameBuffer.size());
-      for (const auto& frame : frameBuffer) {
-        scratchVector.push_back(frame.frameTime);
-      }
-
-      std::sort(scratchVector.begin(), scratchVector.end());
-
-      float fraction = percentile / 100.0f;
-      size_t index = static_cast<size_t>(scratchVector.size() * fraction);
-      index = std::min(index, scratchVector.size() - 1);
-
-      return scratchVector[index];
+      // Bin midpoints are clamped to the exact window extrema so the slowest
+      // frames (and anything past PERCENTILE_MAX_MS) keep their real value
+      float value = frameTimeQuantiles.percentile(percentile);
+      return std::clamp(value, frameTimeMin.value(), frameTimeMax.value());
     }
 
-    // Calculate standard deviation of frame times (expensive - only call at snapshot time)
+    // Standard deviation of frame times from the running Welford moments
     float calculateStdDev() const {
-      const_cast<FrameDataCollector*>(this)->recalculateExtrema();
-      
       if (frameBuffer.empty() || frameCount == 0) return 0.0f;
-
-      float mean = sumFrameTime / frameCount;
-      float sumSquaredDiff = 0.0f;
-
-      for (const auto& frame : frameBuffer) {
-        float diff = frame.frameTime - mean;
-        sumSquaredDiff += diff * diff;
-      }
-
-      return std::sqrt(sumSquaredDiff / frameBuffer.size());
+      return static_cast<float>(frameTimeMoments.stdDev());
     }
     
-    // Calculate all expensive statistics at snapshot time only
+    // Calculate all snapshot statistics; every input is already maintained
+    // incrementally, so this is cheap enough for the ETW processing thread
     void calculateSnapshotStats(PM_METRICS& metrics) {
-      // Recalculate extrema if needed
-      recalculateExtrema();
+      refreshExtrema();
       
-      // Calculate expensive percentiles only at snapshot time
       metrics.frameTime95Percentile = calculatePercentile(95.0f);
       metrics.frameTime99Percentile = calculatePercentile(99.0f);
       metrics.frameTime995Percentile = calculatePercentile(99.5f);
@@ -248,6 +275,7 @@ std::mutex g_monitorsMutex;
 std::unordered_map<uint32_t, std::unique_ptr<ProcessMonitor>> g_monitors;
 bool g_initialized = false;
 PresentMetricsCallback g_metricsCallback = nullptr;
+PresentFrameTimesCallback g_frameTimesCallback = nullptr;
 }  // namespace
 
 void StopExistingSession(const wchar_t* sessionName) {
@@ -343,140 +371,178 @@ PRESENT_DATA_API PM_STATUS PM_StartMonitoring(uint32_t processId,
     }
   });
 
-  monitor->processingThread = std::thread([monitor = monitor.get()]() {
+  // Drains the trace consumer every few ms so its queue stays short; the
+  // window statistics and metrics callbacks run on processingThread
+  monitor->eventThread = std::thread([monitor = monitor.get()]() {
+    const double freq =
+      static_cast<double>(monitor->session->mTimestampFrequency.QuadPart);
+    std::vector<std::shared_ptr<PresentEvent>> events;
     while (monitor->running) {
-      std::vector<std::shared_ptr<PresentEvent>> events;
       monitor->consumer->DequeuePresentEvents(events);
 
-      if (!events.empty()) {
-        for (const auto& pe : events) {
-          if (pe->IsLost || pe->ProcessId != monitor->processInfo.pid) {
-            continue;
-          }
+      for (const auto& pe : events) {
+        if (pe->IsLost || pe->ProcessId != monitor->processInfo.pid) {
+          continue;
+        }
 
-          // Process resolution and display metrics immediately
-          if (pe->DestWidth > 0 && pe->DestHeight > 0) {
-            std::lock_guard<std::mutex> lock(monitor->metricsMutex);
-            monitor->latestMetrics.destWidth = pe->DestWidth;
-            monitor->latestMetrics.destHeight = pe->DestHeight;
-            monitor->latestMetrics.syncInterval = pe->SyncInterval;
-            monitor->latestMetrics.supportsTearing = pe->SupportsTearing;
+        ProcessMonitor::FrameRecord record{};
+        record.presentStartTime = pe->PresentStartTime;
+        record.frameId = pe->AppFrameId;
+        if (pe->DestWidth > 0 && pe->DestHeight > 0) {
+          record.destWidth = pe->DestWidth;
+          record.destHeight = pe->DestHeight;
+          record.syncInterval = pe->SyncInterval;
+          record.supportsTearing = pe->SupportsTearing;
+        }
+
+        auto& chain = monitor->processInfo.mSwapChains[pe->SwapChainAddress];
+
+        if (pe->FinalState == PresentResult::Presented &&
+            chain.mLastPresent != nullptr) {
+          double frameTime_ms = 0.0;
+          if (pe->PresentStartTime > chain.mLastPresent->PresentStartTime) {
+            double qpcDelta = static_cast<double>(
+              pe->PresentStartTime - chain.mLastPresent->PresentStartTime);
+            frameTime_ms = (qpcDelta * 1000.0) / freq;
           }
 
-          auto& chain = monitor->processInfo.mSwapChains[pe->SwapChainAddress];
+          double gpuRenderTime_ms = 0.0;
+          if (pe->GPUDuration > 0) {
+            gpuRenderTime_ms = (pe->GPUDuration * 1000.0) / freq;
+          }
 
-          if (pe->FinalState == PresentResult::Presented &&
-              chain.mLastPresent != nullptr) {
-            double freq = static_cast<double>(
-              monitor->session->mTimestampFrequency.QuadPart);
+          double cpuTime_ms = frameTime_ms - gpuRenderTime_ms;
+          if (cpuTime_ms < 0) cpuTime_ms = 0.0;
 
-            double frameTime_ms = 0.0;
-            if (pe->PresentStartTime > chain.mLastPresent->PresentStartTime) {
-              double qpcDelta = static_cast<double>(
-                pe->PresentStartTime - chain.mLastPresent->PresentStartTime);
-              frameTime_ms = (qpcDelta * 1000.0) / freq;
-            }
+          record.frameTime = static_cast<float>(frameTime_ms);
+          record.gpuRenderTime = static_cast<float>(gpuRenderTime_ms);
+          record.gpuVideoTime = static_cast<float>(
+            pe->GPUVideoDuration > 0 ? (pe->GPUVideoDuration * 1000.0) / freq
+                                     : 0);
+          record.cpuRenderTime = static_cast<float>(cpuTime_ms);
+        }
+        chain.mLastPresent = pe;
 
-            double gpuRenderTime_ms = 0.0;
-            if (pe->GPUDuration > 0) {
-              gpuRenderTime_ms = (pe->GPUDuration * 1000.0) / freq;
-            }
+        if (record.frameTime > 0 || record.destWidth > 0) {
+          monitor->frameRing.tryPush(record);
+        }
+      }
+      events.clear();
 
-            double cpuTime_ms = frameTime_ms - gpuRenderTime_ms;
-            if (cpuTime_ms < 0) cpuTime_ms = 0.0;
+      std::this_thread::sleep_for(
+        std::chrono::milliseconds(ProcessMonitor::EVENT_DRAIN_INTERVAL_MS));
+    }
+  });
 
-            // Add frame to the rolling window
-            if (frameTime_ms > 0) {
-              std::lock_guard<std::mutex> lock(monitor->metricsMutex);
+  monitor->processingThread = std::thread([monitor = monitor.get()]() {
+    std::vector<ProcessMonitor::FrameRecord> batch(ProcessMonitor::FRAME_BATCH);
+    while (monitor->running) {
+      size_t count;
+      while ((count = monitor->frameRing.popBatch(batch.data(), batch.size())) > 0) {
+        // One lock per batch rather than per frame
+        std::lock_guard<std::mutex> lock(monitor->metricsMutex);
+        for (size_t i = 0; i < count; ++i) {
+          const ProcessMonitor::FrameRecord& frame = batch[i];
 
-              // Add frame to collector
-              monitor->frameCollector.addFrame(
-                static_cast<float>(frameTime_ms),
-                static_cast<float>(gpuRenderTime_ms),
-                static_cast<float>(cpuTime_ms), pe->PresentStartTime);
+          // Process resolution and display metrics immediately
+          if (frame.destWidth > 0) {
+            monitor->latestMetrics.destWidth = frame.destWidth;
+            monitor->latestMetrics.destHeight = frame.destHeight;
+            monitor->latestMetrics.syncInterval = frame.syncInterval;
+            monitor->latestMetrics.supportsTearing = frame.supportsTearing;
+          }
 
-              // Update basic metrics for current frame
-              monitor->latestMetrics.frameId = pe->AppFrameId;
+          // Add frame to the rolling window
+          if (frame.frameTime > 0) {
+            // Add frame to collector
+            monitor->frameCollector.addFrame(frame.frameTime,
+                                             frame.gpuRenderTime,
+                                             frame.cpuRenderTime,
+                                             frame.presentStartTime);
+
+            // Update basic metrics for current frame
+            monitor->latestMetrics.frameId = frame.frameId;
+            monitor->latestMetrics.frametime = frame.frameTime;
+            monitor->latestMetrics.fps = 1000.0f / frame.frameTime;
+            monitor->latestMetrics.gpuRenderTime = frame.gpuRenderTime;
+            monitor->latestMetrics.gpuVideoTime = frame.gpuVideoTime;
+            monitor->latestMetrics.cpuRenderTime = frame.cpuRenderTime;
+
+            // Update aggregated metrics
+            monitor->latestMetrics.frameCount =
+              monitor->frameCollector.frameCount;
+            monitor->latestMetrics.minFrameTime =
+              monitor->frameCollector.minFrameTime;
+            monitor->latestMetrics.maxFrameTime =
+              monitor->frameCollector.maxFrameTime;
+            monitor->latestMetrics.minGpuRenderTime =
+              monitor->frameCollector.minGpuRenderTime;
+            monitor->latestMetrics.maxGpuRenderTime =
+              monitor->frameCollector.maxGpuRenderTime;
+            monitor->latestMetrics.minCpuRenderTime =
+              monitor->frameCollector.minCpuRenderTime;
+            monitor->latestMetrics.maxCpuRenderTime =
+              monitor->frameCollector.maxCpuRenderTime;
+
+            // Calculate average values
+            if (monitor->frameCollector.frameCount > 0) {
               monitor->latestMetrics.frametime =
-                static_cast<float>(frameTime_ms);
+                monitor->frameCollector.sumFrameTime /
+                monitor->frameCollector.frameCount;
               monitor->latestMetrics.fps =
-                frameTime_ms > 0 ? 1000.0f / frameTime_ms : 0;
+                1000.0f / monitor->latestMetrics.frametime;
               monitor->latestMetrics.gpuRenderTime =
-                static_cast<float>(gpuRenderTime_ms);
-              monitor->latestMetrics.gpuVideoTime =
-                static_cast<float>(pe->GPUVideoDuration > 0
-                                     ? (pe->GPUVideoDuration * 1000.0) / freq
-                                     : 0);
+                monitor->frameCollector.sumGpuRenderTime /
+                monitor->frameCollector.frameCount;
               monitor->latestMetrics.cpuRenderTime =
-                static_cast<float>(cpuTime_ms);
-
-              // Update aggregated metrics
-              monitor->latestMetrics.frameCount =
+                monitor->frameCollector.sumCpuRenderTime /
                 monitor->frameCollector.frameCount;
-              monitor->latestMetrics.minFrameTime =
-                monitor->frameCollector.minFrameTime;
-              monitor->latestMetrics.maxFrameTime =
-                monitor->frameCollector.maxFrameTime;
-              monitor->latestMetrics.minGpuRenderTime =
-                monitor->frameCollector.minGpuRenderTime;
-              monitor->latestMetrics.maxGpuRenderTime =
-                monitor->frameCollector.maxGpuRenderTime;
-              monitor->latestMetrics.minCpuRenderTime =
-                monitor->frameCollector.minCpuRenderTime;
-              monitor->latestMetrics.maxCpuRenderTime =
-                monitor->frameCollector.maxCpuRenderTime;
-
-              // Calculate average values
-              if (monitor->frameCollector.frameCount > 0) {
-                monitor->latestMetrics.frametime =
-                  monitor->frameCollector.sumFrameTime /
-                  monitor->frameCollector.frameCount;
-                monitor->latestMetrics.fps =
-                  1000.0f / monitor->latestMetrics.frametime;
-                monitor->latestMetrics.gpuRenderTime =
-                  monitor->frameCollector.sumGpuRenderTime /
-                  monitor->frameCollector.frameCount;
-                monitor->latestMetrics.cpuRenderTime =
-                  monitor->frameCollector.sumCpuRenderTime /
-                  monitor->frameCollector.frameCount;
-              }
+            }
 
-              // Note: Percentiles and variance are expensive - only calculated at snapshot time
-              // Basic metrics are updated here for immediate use
+            // Note: Percentiles and variance are expensive - only calculated at snapshot time
+            // Basic metrics are updated here for immediate use
+            
+            // Store a copy in the queue periodically based on updateFrequencyMs
+            auto now = std::chrono::steady_clock::now();
+            auto elapsed =
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                now - monitor->lastQueueUpdate)
+                .count();
+
+            // Push metrics to queue at configured frequency
+            if (elapsed >= monitor->updateFrequencyMs) {
+              // Calculate expensive stats only at snapshot time
+              PM_METRICS snapshotMetrics = monitor->latestMetrics;
+              monitor->frameCollector.calculateSnapshotStats(snapshotMetrics);
               
-              // Store a copy in the queue periodically based on updateFrequencyMs
-              auto now = std::chrono::steady_clock::now();
-              auto elapsed =
-                std::chrono::duration_cast<std::chrono::milliseconds>(
-                  now - monitor->lastQueueUpdate)
-                  .count();
-
-              // Push metrics to queue at configured frequency
-              if (elapsed >= monitor->updateFrequencyMs) {
-                // Calculate expensive stats only at snapshot time
-                PM_METRICS snapshotMetrics = monitor->latestMetrics;
-                monitor->frameCollector.calculateSnapshotStats(snapshotMetrics);
-                
-                std::lock_guard<std::mutex> queueLock(monitor->queueMutex);
-                monitor->metricsQueue.push_back(snapshotMetrics);
-                if (monitor->metricsQueue.size() >
-                    ProcessMonitor::MAX_QUEUE_SIZE) {
-                  monitor->metricsQueue.pop_front();
-                }
-
-                // Notify callback if registered
-                if (g_metricsCallback) {
-                  g_metricsCallback(monitor->processInfo.pid, &snapshotMetrics);
-                }
-
-                monitor->lastQueueUpdate = now;
+              monitor->metricsRing.tryPush(snapshotMetrics);
+
+              // Notify callback if registered
+              if (g_metricsCallback) {
+                g_metricsCallback(monitor->processInfo.pid, &snapshotMetrics);
+              }
+
+              // Hand over the exact per-frame distribution for this interval
+              if (g_frameTimesCallback) {
+                g_frameTimesCallback(monitor->processInfo.pid,
+                                     &monitor->frameCollector.intervalFrameTimes);
               }
+              monitor->frameCollector.intervalFrameTimes.clear();
+
+              monitor->lastQueueUpdate = now;
             }
           }
-          chain.mLastPresent = pe;
         }
       }
 
+      uint64_t frameDrops = monitor->frameRing.droppedCount();
+      if (frameDrops != monitor->reportedFrameDrops) {
+        LOG_WARN << "[PresentMon] Frame ring full, dropped "
+                 << (frameDrops - monitor->reportedFrameDrops)
+                 << " frames (total " << frameDrops << ")";
+        monitor->reportedFrameDrops = frameDrops;
+      }
+
       // Check if we need to force an update due to timeout
       {
         std::lock_guard<std::mutex> lock(monitor->metricsMutex);
@@ -495,11 +561,7 @@ PRESENT_DATA_API PM_STATUS PM_StartMonitoring(uint32_t processId,
           monitor->frameCollector.lastUpdate = now;
 
           // Store a copy in the queue
-          std::lock_guard<std::mutex> queueLock(monitor->queueMutex);
-          monitor->metricsQueue.push_back(monitor->latestMetrics);
-          if (monitor->metricsQueue.size() > ProcessMonitor::MAX_QUEUE_SIZE) {
-            monitor->metricsQueue.pop_front();
-          }
+          monitor->metricsRing.tryPush(monitor->latestMetrics);
         }
       }
 
@@ -533,6 +595,15 @@ PRESENT_DATA_API PM_STATUS PM_StopMonitoring(uint32_t processId) {
     }
   }
 
+  if (it->second->eventThread.joinable()) {
+    try {
+      it->second->eventThread.join();
+    } catch (const std::exception& e) {
+      LOG_ERROR << "[ERROR] Error joining event thread: " << e.what()
+               ;
+    }
+  }
+
   try {
     it->second->session->Stop();
   } catch (const std::exception& e) {
@@ -566,19 +637,24 @@ PM_GetMetrics(uint32_t processId, PM_METRICS* metrics,
     return PM_STATUS::PM_ERROR_NOT_RUNNING;
   }
 
-  std::lock_guard<std::mutex> metricsLock(it->second->metricsMutex);
-  *metrics = it->second->latestMetrics;
+  {
+    std::lock_guard<std::mutex> metricsLock(it->second->metricsMutex);
+    *metrics = it->second->latestMetrics;
+  }
 
-  // If caller wants all metrics since last call
+  // If caller wants all metrics since last call (single consumer, serialized
+  // by g_monitorsMutex)
   if (allMetricsSinceLastCall) {
-    std::lock_guard<std::mutex> queueLock(it->second->queueMutex);
     allMetricsSinceLastCall->clear();
-    // Reserve space to avoid reallocations during copy
-    allMetricsSinceLastCall->reserve(it->second->metricsQueue.size());
-    allMetricsSinceLastCall->insert(allMetricsSinceLastCall->end(),
-                                    it->second->metricsQueue.begin(),
-                                    it->second->metricsQueue.end());
-    it->second->metricsQueue.clear();
+    it->second->metricsRing.drainInto(*allMetricsSinceLastCall);
+
+    uint64_t drops = it->second->metricsRing.droppedCount();
+    if (drops != it->second->reportedDrops) {
+      LOG_WARN << "[PresentMon] Metrics ring full, dropped "
+               << (drops - it->second->reportedDrops)
+               << " snapshots (total " << drops << ")";
+      it->second->reportedDrops = drops;
+    }
   }
 
   return PM_STATUS::PM_SUCCESS;
@@ -594,6 +670,9 @@ PRESENT_DATA_API void PM_Shutdown() {
     if (monitor->processingThread.joinable()) {
       monitor->processingThread.join();
     }
+    if (monitor->eventThread.joinable()) {
+      monitor->eventThread.join();
+    }
     if (monitor->traceThread.joinable()) {
       monitor->traceThread.join();
     }
@@ -607,3 +686,8 @@ PRESENT_DATA_API void PM_Shutdown() {
 PRESENT_DATA_API void PM_SetMetricsCallback(PresentMetricsCallback callback) {
   g_metricsCallback = callback;
 }
+
+PRESENT_DATA_API void PM_SetFrameTimesCallback(
+  PresentFrameTimesCallback callback) {
+  g_frameTimesCallback = callback;
+}
@@ -28,6 +28,12 @@
  * - frameTime95Percentile: 95th percentile frame time (5% low)
  * - frameTime995Percentile: 99.5th percentile frame time (0.5% low)
  * - frameCount: Number of frames in this collection interval
+ *
+ * PER-FRAME DISTRIBUTION:
+ * - Every presented frame is also recorded into a FrameTimeSketch. At each
+ *   snapshot the sketch of frames since the previous snapshot is handed to the
+ *   frame times callback and reset, so consumers can build exact cumulative
+ *   percentiles without double-counting the rolling 1-second window.
  */
 
 #pragma once
@@ -106,11 +112,18 @@ struct PM_METRICS {
 // Forward declarations
 struct ProcessInfo;
 struct PresentEvent;
+class FrameTimeSketch;
 
 // Callback type for receiving metrics updates
 typedef void (*PresentMetricsCallback)(uint32_t processId,
                                        const PM_METRICS* metrics);
 
+// Callback type for receiving the frame time distribution of every frame
+// presented since the previous snapshot. The sketch is only valid for the
+// duration of the call; merge it, don't keep the pointer.
+typedef void (*PresentFrameTimesCallback)(uint32_t processId,
+                                          const FrameTimeSketch* frameTimes);
+
 extern "C" {
 // Core API Functions
 PRESENT_DATA_API PM_STATUS PM_Initialize();
@@ -121,5 +134,7 @@ PRESENT_DATA_API PM_STATUS
 PM_GetMetrics(uint32_t processId, PM_METRICS* metrics,
               std::vector<PM_METRICS>* allMetricsSinceLastCall = nullptr);
 PRESENT_DATA_API void PM_SetMetricsCallback(PresentMetricsCallback callback);
+PRESENT_DATA_API void PM_SetFrameTimesCallback(
+  PresentFrameTimesCallback callback);
 PRESENT_DATA_API void PM_Shutdown();
 }
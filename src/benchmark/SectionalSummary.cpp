@@ -0,0 +1,239 @@
+#include "SectionalSummary.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QRegularExpression>
+
+namespace {
+// Threshold rules, per one-second sample
+constexpr double GPU_HIGH_USAGE_PCT = 90.0;
+constexpr int GPU_BOTTLENECK_LIGHT_SAMPLES = 5;
+constexpr int GPU_BOTTLENECK_SEVERE_SAMPLES = 30;
+constexpr double RAM_WARNING_LOAD_PCT = 90.0;
+constexpr double VRAM_WARNING_PCT = 85.0;
+constexpr double STUTTER_VARIANCE = 3.0;
+constexpr int STUTTER_SAMPLES = 15;
+constexpr double FREEZE_MS = 100.0;
+constexpr double SMALL_FREEZE_MS = 50.0;
+
+// Index into the builder's sections, or -1 outside every section
+int sectionAt(int seconds) {
+  if (seconds >= SectionalSummary::beachStartTime &&
+      seconds < SectionalSummary::beachEndTime) {
+    return 0;
+  }
+  if (seconds >= SectionalSummary::flyingStartTime &&
+      seconds < SectionalSummary::flyingEndTime) {
+    return 1;
+  }
+  if (seconds >= SectionalSummary::outpostStartTime &&
+      seconds < SectionalSummary::outpostEndTime) {
+    return 2;
+  }
+  return -1;
+}
+}  // namespace
+
+void SectionalSummaryBuilder::Stat::add(double value) {
+  min = (count == 0) ? value : std::min(min, value);
+  max = (count == 0) ? value : std::max(max, value);
+  sum += value;
+  count++;
+}
+
+void SectionalSummaryBuilder::Stat::merge(const Stat& other) {
+  if (other.count == 0) return;
+  min = (count == 0) ? other.min : std::min(min, other.min);
+  max = (count == 0) ? other.max : std::max(max, other.max);
+  sum += other.sum;
+  count += other.count;
+}
+
+void SectionalSummaryBuilder::Section::add(double fps, double frameTime1HighValue,
+                                           double frameTime5HighValue) {
+  fpsSum += fps;
+  fpsCount++;
+  fpsSketch.add(fps);
+  if (frameTime1HighValue > 0) frameTime1High.add(frameTime1HighValue);
+  if (frameTime5HighValue > 0) frameTime5High.add(frameTime5HighValue);
+}
+
+void SectionalSummaryBuilder::Section::merge(const Section& other) {
+  fpsSum += other.fpsSum;
+  fpsCount += other.fpsCount;
+  frameTime1High.merge(other.frameTime1High);
+  frameTime5High.merge(other.frameTime5High);
+  fpsSketch.merge(other.fpsSketch);
+}
+
+double SectionalSummaryBuilder::Section::lowFps(const Stat& highFrameTime,
+                                                float percentile) const {
+  if (highFrameTime.count > 0) {
+    // Convert to FPS (1000 ms / frame time in ms)
+    const double avgHighFrameTime = highFrameTime.avg();
+    return avgHighFrameTime > 0 ? 1000.0 / avgHighFrameTime : -1.0;
+  }
+  return fpsSketch.percentile(percentile);  // -1 when empty
+}
+
+SectionalSummaryBuilder::SectionalSummaryBuilder(const QStringList& headers)
+    : m_columns(resolveColumns(headers)) {}
+
+SectionalSummaryBuilder::Columns SectionalSummaryBuilder::resolveColumns(
+  const QStringList& headers) {
+  Columns c;
+  c.time = headers.indexOf("Time");
+  c.fps = headers.indexOf("FPS");
+  c.frameTime = headers.indexOf("Frame Time");
+  c.frameTime1High = headers.indexOf("1% High Frame Time");
+  c.frameTime5High = headers.indexOf("5% High Frame Time");
+  c.cpuUsage = headers.indexOf("PDH_CPU_Usage(%)");
+  if (c.cpuUsage < 0) c.cpuUsage = headers.indexOf("CPU Usage");
+  c.gpuUsage = headers.indexOf("GPU Usage");
+  if (c.gpuUsage < 0) c.gpuUsage = headers.indexOf("GPU Utilization");
+  c.memoryLoad = headers.indexOf("PDH_Memory_Load(%)");
+  if (c.memoryLoad < 0) c.memoryLoad = headers.indexOf("Memory Load");
+  c.gpuMemUsed = headers.indexOf("GPU Mem Used");
+  c.gpuMemTotal = headers.indexOf("GPU Mem Total");
+  c.frameTimeVariance = headers.indexOf("Frame Time Variance");
+  c.highestFrameTime = headers.indexOf("Highest Frame Time");
+
+  static const QRegularExpression corePattern(
+    R"(^\s*(PDH_)?Core\s+\d+\s+CPU?\s*\(%\)\s*$)",
+    QRegularExpression::CaseInsensitiveOption);
+  for (int i = 0; i < headers.size(); i++) {
+    if (corePattern.match(headers[i].trimmed()).hasMatch()) {
+      c.cpuCores.push_back(i);
+    }
+  }
+
+  c.maxIndex = std::max({c.fps, c.frameTime, c.frameTime1High, c.frameTime5High,
+                         c.cpuUsage, c.gpuUsage, c.memoryLoad, c.gpuMemUsed,
+                         c.gpuMemTotal, c.frameTimeVariance, c.highestFrameTime});
+  for (int core : c.cpuCores) {
+    c.maxIndex = std::max(c.maxIndex, core);
+  }
+  return c;
+}
+
+void SectionalSummaryBuilder::addSample(const Sample& s) {
+  // Seconds since the first valid Time value; the row number if there is none
+  int seconds = m_rowCounter;
+  if (!std::isnan(s.time)) {
+    if (!m_hasTimeBase) {
+      m_timeBase = static_cast<int>(s.time);
+      m_hasTimeBase = true;
+    }
+    seconds = static_cast<int>(s.time) - m_timeBase;
+  }
+  m_rowCounter++;
+
+  // Usage metrics count even on rows without a valid FPS
+  if (s.frameTime > 0) m_frameTime.add(s.frameTime);
+  if (s.cpuUsage >= 0) m_cpuUsage.add(s.cpuUsage);
+  if (s.gpuUsage >= 0) m_gpuUsage.add(s.gpuUsage);
+  if (s.memoryLoad >= 0) m_memoryLoad.add(s.memoryLoad);
+
+  // Everything else needs a valid FPS (also rejects NaN)
+  if (!(s.fps > 0)) return;
+
+  m_fps.add(s.fps);
+  m_overall.add(s.fps, s.frameTime1High, s.frameTime5High);
+  const int section = sectionAt(seconds);
+  if (section >= 0) {
+    m_sections[section].add(s.fps, s.frameTime1High, s.frameTime5High);
+  }
+
+  if (s.gpuUsage > GPU_HIGH_USAGE_PCT) m_gpuHighUsageCount++;
+  if (s.memoryLoad > RAM_WARNING_LOAD_PCT) m_ramWarning = true;
+  if (!std::isnan(s.gpuMemUsed) && s.gpuMemTotal > 0 &&
+      (s.gpuMemUsed / s.gpuMemTotal) * 100.0 > VRAM_WARNING_PCT) {
+    m_vramWarning = true;
+  }
+  if (s.frameTimeVariance > STUTTER_VARIANCE) m_highFrameTimeVarianceCount++;
+  if (s.highestFrameTime > FREEZE_MS) {
+    m_fpsFreezeCount++;
+  } else if (s.highestFrameTime > SMALL_FREEZE_MS) {
+    m_smallFreezeCount++;
+  }
+}
+
+void SectionalSummaryBuilder::merge(const SectionalSummaryBuilder& other) {
+  m_overall.merge(other.m_overall);
+  for (size_t i = 0; i < m_sections.size(); ++i) {
+    m_sections[i].merge(other.m_sections[i]);
+  }
+  m_fps.merge(other.m_fps);
+  m_frameTime.merge(other.m_frameTime);
+  m_cpuUsage.merge(other.m_cpuUsage);
+  m_gpuUsage.merge(other.m_gpuUsage);
+  m_memoryLoad.merge(other.m_memoryLoad);
+
+  m_gpuHighUsageCount += other.m_gpuHighUsageCount;
+  m_ramWarning = m_ramWarning || other.m_ramWarning;
+  m_vramWarning = m_vramWarning || other.m_vramWarning;
+  m_highFrameTimeVarianceCount += other.m_highFrameTimeVarianceCount;
+  m_smallFreezeCount += other.m_smallFreezeCount;
+  m_fpsFreezeCount += other.m_fpsFreezeCount;
+}
+
+SectionalSummary SectionalSummaryBuilder::result() const {
+  SectionalSummary summary;
+
+  auto fillSection = [](const Section& section, double& avgFps, double& low1,
+                        double& low5) {
+    if (section.fpsCount == 0) return;
+    avgFps = section.fpsSum / static_cast<double>(section.fpsCount);
+    low1 = section.lowFps(section.frameTime1High, 1.0f);
+    low5 = section.lowFps(section.frameTime5High, 5.0f);
+  };
+  fillSection(m_sections[0], summary.beachAvgFps, summary.beach1LowFps,
+              summary.beach5LowFps);
+  fillSection(m_sections[1], summary.flyingAvgFps, summary.flying1LowFps,
+              summary.flying5LowFps);
+  fillSection(m_sections[2], summary.outpostAvgFps, summary.outpost1LowFps,
+              summary.outpost5LowFps);
+  fillSection(m_overall, summary.overallAvgFps, summary.overall1LowFps,
+              summary.overall5LowFps);
+
+  // Legacy/aggregate metrics for dashboard and existing cards
+  if (m_fps.count > 0) {
+    summary.avgFps = m_fps.avg();
+    summary.minFps = m_fps.min;
+    summary.maxFps = m_fps.max;
+  }
+  summary.fps1Low = (summary.overall1LowFps > 0)
+                      ? summary.overall1LowFps
+                      : m_overall.fpsSketch.percentile(1.0f);
+  summary.fps01Low = m_overall.fpsSketch.percentile(0.1f);
+
+  if (m_frameTime.count > 0) {
+    summary.avgFrameTime = m_frameTime.avg();
+    summary.minFrameTime = m_frameTime.min;
+    summary.maxFrameTime = m_frameTime.max;
+  }
+  if (m_cpuUsage.count > 0) {
+    summary.avgCpuUsage = m_cpuUsage.avg();
+    summary.maxCpuUsage = m_cpuUsage.max;
+  }
+  if (m_gpuUsage.count > 0) {
+    summary.avgGpuUsage = m_gpuUsage.avg();
+    summary.maxGpuUsage = m_gpuUsage.max;
+  }
+  if (m_memoryLoad.count > 0) {
+    summary.avgMemoryUsage = m_memoryLoad.avg();
+    summary.maxMemoryUsage = m_memoryLoad.max;
+  }
+
+  // Set analysis flags
+  summary.gpuBottleneckLight = (m_gpuHighUsageCount >= GPU_BOTTLENECK_LIGHT_SAMPLES);
+  summary.gpuBottleneckSevere = (m_gpuHighUsageCount >= GPU_BOTTLENECK_SEVERE_SAMPLES);
+  summary.ramUsageWarning = m_ramWarning;
+  summary.vramUsageWarning = m_vramWarning;
+  summary.fpsStutteringDetected = (m_highFrameTimeVarianceCount >= STUTTER_SAMPLES);
+  summary.smallFreezeCount = m_smallFreezeCount;
+  summary.fpsFreezeCount = m_fpsFreezeCount;
+
+  return summary;
+}
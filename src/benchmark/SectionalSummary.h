@@ -0,0 +1,255 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <QString>
+#include <QStringList>
+
+#include "FrameTimeSketch.h"
+
+/**
+ * @brief SectionalSummary - Per-section FPS, lows and warning flags of a run
+ *
+ * Produced by SectionalSummaryBuilder. Every value is -1 when the run had no
+ * data for it.
+ */
+struct SectionalSummary {
+  // Section time boundaries (in seconds)
+  static constexpr int beachStartTime = 0;
+  static constexpr int beachEndTime = 26;
+  static constexpr int flyingStartTime = 26;
+  static constexpr int flyingEndTime = 114;
+  static constexpr int outpostStartTime = 114;
+  static constexpr int outpostEndTime = 124;
+
+  // Section labels
+  static const inline QString beachLabel = "Beach";
+  static const inline QString jungleLabel = "Jungle";
+  static const inline QString outpostLabel = "Outpost";
+  static const inline QString overallLabel = "Overall";
+
+  // Beach section metrics
+  double beachAvgFps = -1.0;
+  double beach1LowFps = -1.0;
+  double beach5LowFps = -1.0;
+
+  // Flying section metrics (labeled as "Jungle" for users)
+  double flyingAvgFps = -1.0;
+  double flying1LowFps = -1.0;
+  double flying5LowFps = -1.0;
+
+  // Outpost section metrics
+  double outpostAvgFps = -1.0;
+  double outpost1LowFps = -1.0;
+  double outpost5LowFps = -1.0;
+
+  // Overall metrics (whole benchmark run)
+  double overallAvgFps = -1.0;
+  double overall1LowFps = -1.0;
+  double overall5LowFps = -1.0;
+
+  // Analysis flags
+  bool gpuBottleneckLight = false;   // GPU usage > 90% for 5+ seconds
+  bool gpuBottleneckSevere = false;  // GPU usage > 90% for 30+ seconds
+  bool ramUsageWarning = false;      // Memory load > 90% at any point
+  bool vramUsageWarning = false;     // GPU memory usage > 85% at any point
+  bool fpsStutteringDetected =
+    false;                   // Frame time variance > 3 for 15+ seconds
+  int smallFreezeCount = 0;  // Count of highest frame time > 50ms
+  int fpsFreezeCount = 0;    // Count of highest frame time > 100ms
+
+  // Legacy metrics - will not be used in the new implementation
+  double avgFps = -1.0;
+  double minFps = -1.0;
+  double maxFps = -1.0;
+  double fps1Low = -1.0;
+  double fps01Low = -1.0;
+
+  double avgFrameTime = -1.0;
+  double minFrameTime = -1.0;
+  double maxFrameTime = -1.0;
+  double frameTime1High = -1.0;
+  double frameTime01High = -1.0;
+
+  double avgCpuUsage = -1.0;
+  double maxCpuUsage = -1.0;
+
+  double avgGpuUsage = -1.0;
+  double maxGpuUsage = -1.0;
+
+  double avgMemoryUsage = -1.0;
+  double maxMemoryUsage = -1.0;
+};
+
+/**
+ * @brief SectionalSummaryBuilder - One-pass aggregator behind SectionalSummary
+ *
+ * Each row goes straight to the overall accumulator and the accumulator of
+ * the section it falls in. The accumulators keep running sums and a
+ * FrameTimeSketch of FPS values for the percentile lows. The GPU, RAM, VRAM,
+ * stutter and freeze rules are checked on the same row, so nothing is stored
+ * per sample and nothing is read twice.
+ *
+ * Builders merge, so a comparison set or leaderboard is summarised by merging
+ * the per-run builders instead of rescanning the runs. Time normalization is
+ * per run; merge only the totals, never feed rows into a merged builder.
+ *
+ * Rows come from any column source through addRow(), which resolves the
+ * usual CSV headers once. addSample() takes values that are already mapped,
+ * e.g. from live data. Section lows come from the "1%/5% High Frame Time"
+ * columns when a run has them, and from the FPS sketch otherwise.
+ *
+ * Not thread-safe; use one builder per thread and merge.
+ */
+class SectionalSummaryBuilder {
+ public:
+  static constexpr double MISSING = std::numeric_limits<double>::quiet_NaN();
+
+  // Column indices in a run's header, -1 if absent
+  struct Columns {
+    int time = -1;
+    int fps = -1;
+    int frameTime = -1;
+    int frameTime1High = -1;
+    int frameTime5High = -1;
+    int cpuUsage = -1;
+    int gpuUsage = -1;
+    int memoryLoad = -1;
+    int gpuMemUsed = -1;
+    int gpuMemTotal = -1;
+    int frameTimeVariance = -1;
+    int highestFrameTime = -1;
+    std::vector<int> cpuCores;
+    int maxIndex = -1;  // rows with this many fields or fewer are torn
+  };
+
+  // One row's values, MISSING where there is none
+  struct Sample {
+    double time = MISSING;
+    double fps = MISSING;
+    double frameTime = MISSING;
+    double frameTime1High = MISSING;
+    double frameTime5High = MISSING;
+    double cpuUsage = MISSING;  // total, or the average of the cores
+    double gpuUsage = MISSING;
+    double memoryLoad = MISSING;
+    double gpuMemUsed = MISSING;
+    double gpuMemTotal = MISSING;
+    double frameTimeVariance = MISSING;
+    double highestFrameTime = MISSING;
+  };
+
+  SectionalSummaryBuilder() = default;
+  explicit SectionalSummaryBuilder(const QStringList& headers);
+
+  static Columns resolveColumns(const QStringList& headers);
+  const Columns& columns() const { return m_columns; }
+  bool hasFpsColumn() const { return m_columns.fps >= 0; }
+
+  // valueAt(column) returns the row's value in that column (NaN if missing)
+  template <typename ValueAt>
+  void addRow(ValueAt&& valueAt);
+
+  // A row that had to be dropped still advances the row clock
+  void skipRow() { m_rowCounter++; }
+
+  void addSample(const Sample& sample);
+  void merge(const SectionalSummaryBuilder& other);
+
+  SectionalSummary result() const;
+
+  // Samples with a valid FPS, overall and per section (beach, flying, outpost)
+  uint64_t sampleCount() const { return m_overall.fpsCount; }
+  uint64_t sectionSampleCount(size_t section) const {
+    return m_sections[section].fpsCount;
+  }
+
+ private:
+  struct Stat {
+    double sum = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    uint64_t count = 0;
+
+    void add(double value);
+    void merge(const Stat& other);
+    double avg() const { return count ? sum / static_cast<double>(count) : -1.0; }
+  };
+
+  struct Section {
+    double fpsSum = 0.0;
+    uint64_t fpsCount = 0;
+    Stat frameTime1High;  // only samples > 0
+    Stat frameTime5High;
+    FrameTimeSketch fpsSketch;  // unit-agnostic, it only needs positive values
+
+    void add(double fps, double frameTime1High, double frameTime5High);
+    void merge(const Section& other);
+    // From the high frame time columns when present, else the FPS percentile
+    double lowFps(const Stat& highFrameTime, float percentile) const;
+  };
+
+  Columns m_columns;
+
+  // Row clock: seconds since the run's first Time value, else the row number
+  bool m_hasTimeBase = false;
+  int m_timeBase = 0;
+  int m_rowCounter = 0;
+
+  Section m_overall;
+  std::array<Section, 3> m_sections;
+  Stat m_fps;
+  Stat m_frameTime;
+  Stat m_cpuUsage;
+  Stat m_gpuUsage;
+  Stat m_memoryLoad;
+
+  // Threshold rules
+  int m_gpuHighUsageCount = 0;
+  bool m_ramWarning = false;
+  bool m_vramWarning = false;
+  int m_highFrameTimeVarianceCount = 0;
+  int m_smallFreezeCount = 0;
+  int m_fpsFreezeCount = 0;
+};
+
+template <typename ValueAt>
+void SectionalSummaryBuilder::addRow(ValueAt&& valueAt) {
+  auto at = [&](int column) { return column >= 0 ? valueAt(column) : MISSING; };
+
+  Sample sample;
+  sample.time = at(m_columns.time);
+  sample.fps = at(m_columns.fps);
+  sample.frameTime = at(m_columns.frameTime);
+  sample.frameTime1High = at(m_columns.frameTime1High);
+  sample.frameTime5High = at(m_columns.frameTime5High);
+  sample.cpuUsage = at(m_columns.cpuUsage);
+  sample.gpuUsage = at(m_columns.gpuUsage);
+  sample.memoryLoad = at(m_columns.memoryLoad);
+  sample.gpuMemUsed = at(m_columns.gpuMemUsed);
+  sample.gpuMemTotal = at(m_columns.gpuMemTotal);
+  sample.frameTimeVariance = at(m_columns.frameTimeVariance);
+  sample.highestFrameTime = at(m_columns.highestFrameTime);
+
+  // No total CPU column (or no value in it): average the cores instead
+  if (std::isnan(sample.cpuUsage) && !m_columns.cpuCores.empty()) {
+    double totalUsage = 0.0;
+    int validCores = 0;
+    for (int core : m_columns.cpuCores) {
+      const double usage = valueAt(core);
+      if (usage >= 0) {
+        totalUsage += usage;
+        validCores++;
+      }
+    }
+    if (validCores > 0) {
+      sample.cpuUsage = totalUsage / validCores;
+    }
+  }
+
+  addSample(sample);
+}
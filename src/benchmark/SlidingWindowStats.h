@@ -0,0 +1,182 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+/**
+ * Incremental statistics for a sliding window of samples where every sample
+ * that enters the window eventually leaves it in FIFO order (the rolling
+ * 1-second frame window in PresentDataExports).
+ *
+ * Each structure is updated in O(1) / O(log n) per add and per eviction, so
+ * snapshot queries never copy or sort the window:
+ *
+ * - WindowedQuantiles: Fenwick tree over fixed-width bins, O(log bins) order
+ *   statistics
+ * - MonotonicExtremum: monotonic deque, amortized O(1) windowed min or max
+ * - WindowedMoments: Welford mean/variance with removal support
+ */
+
+/**
+ * @brief Order statistics over a sliding window using a Fenwick tree of
+ * fixed-width bins. Values are quantized to binWidth (10 us for frame times),
+ * values at or above maxValue share the last bin; callers clamp query results
+ * to the exact window extrema.
+ */
+class WindowedQuantiles {
+ public:
+  WindowedQuantiles(float binWidth, float maxValue)
+      : m_binWidth(binWidth),
+        m_binCount(static_cast<size_t>(std::ceil(maxValue / binWidth)) + 1),
+        m_tree(m_binCount + 1, 0) {
+    m_topStep = 1;
+    while (m_topStep * 2 <= m_binCount) m_topStep *= 2;
+  }
+
+  void add(float value) {
+    update(binFor(value), 1);
+    ++m_size;
+  }
+
+  void remove(float value) {
+    if (m_size == 0) return;
+    update(binFor(value), -1);
+    --m_size;
+  }
+
+  void clear() {
+    std::fill(m_tree.begin(), m_tree.end(), 0);
+    m_size = 0;
+  }
+
+  size_t size() const { return m_size; }
+
+  // Value of the k-th smallest sample (0-based). Returns the bin midpoint.
+  float kth(size_t k) const {
+    if (m_size == 0) return 0.0f;
+    k = std::min(k, m_size - 1);
+
+    // Fenwick binary lifting: find the first bin whose prefix count > k
+    size_t pos = 0;
+    int64_t remaining = static_cast<int64_t>(k) + 1;
+    for (size_t step = m_topStep; step > 0; step >>= 1) {
+      size_t next = pos + step;
+      if (next <= m_binCount && m_tree[next] < remaining) {
+        pos = next;
+        remaining -= m_tree[next];
+      }
+    }
+    // pos is the 1-based index of the last bin before the target
+    return (static_cast<float>(pos) + 0.5f) * m_binWidth;
+  }
+
+  // Same rank convention as the previous sort-based calculatePercentile():
+  // index = floor(size * percentile / 100)
+  float percentile(float percentile) const {
+    if (m_size == 0) return 0.0f;
+    size_t index = static_cast<size_t>(m_size * (percentile / 100.0f));
+    return kth(std::min(index, m_size - 1));
+  }
+
+ private:
+  size_t binFor(float value) const {
+    if (!(value > 0.0f)) return 0;
+    size_t bin = static_cast<size_t>(value / m_binWidth);
+    return std::min(bin, m_binCount - 1);
+  }
+
+  void update(size_t bin, int32_t delta) {
+    for (size_t i = bin + 1; i <= m_binCount; i += i & (~i + 1)) {
+      m_tree[i] += delta;
+    }
+  }
+
+  float m_binWidth;
+  size_t m_binCount;
+  size_t m_topStep = 1;
+  size_t m_size = 0;
+  std::vector<int32_t> m_tree;  // 1-based Fenwick tree over bins
+};
+
+/**
+ * @brief Windowed minimum (Compare = std::less) or maximum (std::greater)
+ * using a monotonic deque keyed by the sample's sequence number.
+ */
+template <typename Compare>
+class MonotonicExtremum {
+ public:
+  void push(uint64_t seq, float value) {
+    while (!m_deque.empty() && !m_compare(m_deque.back().value, value)) {
+      m_deque.pop_back();
+    }
+    m_deque.push_back({seq, value});
+  }
+
+  // Call with the sequence number of the sample leaving the window
+  void evict(uint64_t seq) {
+    if (!m_deque.empty() && m_deque.front().seq == seq) {
+      m_deque.pop_front();
+    }
+  }
+
+  void clear() { m_deque.clear(); }
+  bool empty() const { return m_deque.empty(); }
+  float value() const { return m_deque.front().value; }
+
+ private:
+  struct Entry {
+    uint64_t seq;
+    float value;
+  };
+  std::deque<Entry> m_deque;
+  Compare m_compare;
+};
+
+/**
+ * @brief Welford running mean/variance that also supports removing samples,
+ * so the window's standard deviation is available without a rescan.
+ */
+class WindowedMoments {
+ public:
+  void add(double value) {
+    ++m_count;
+    double delta = value - m_mean;
+    m_mean += delta / m_count;
+    m_m2 += delta * (value - m_mean);
+  }
+
+  void remove(double value) {
+    if (m_count <= 1) {
+      clear();
+      return;
+    }
+    --m_count;
+    double delta = value - m_mean;
+    m_mean -= delta / m_count;
+    m_m2 -= delta * (value - m_mean);
+    if (m_m2 < 0.0) m_m2 = 0.0;  // guard against rounding drift
+  }
+
+  void clear() {
+    m_count = 0;
+    m_mean = 0.0;
+    m_m2 = 0.0;
+  }
+
+  size_t count() const { return m_count; }
+  double mean() const { return m_mean; }
+
+  // Population standard deviation, matching the previous rescan
+  double stdDev() const {
+    return m_count > 0 ? std::sqrt(m_m2 / m_count) : 0.0;
+  }
+
+ private:
+  size_t m_count = 0;
+  double m_mean = 0.0;
+  double m_m2 = 0.0;
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief SpscRing - Fixed-capacity lock-free single-producer/single-consumer ring
+ *
+ * Hands records from one thread to exactly one other thread without locks or
+ * allocation after construction:
+ *
+ * - tryPush() is producer-only; when the ring is full the new record is
+ *   dropped and counted instead of blocking the producer. The deques this
+ *   replaced dropped the oldest entry instead, but that needs the producer to
+ *   advance the consumer's index while the consumer may be copying that slot;
+ *   dropping the newest keeps each index written by one side only
+ * - popBatch()/drainInto() are consumer-only and move everything available
+ *   in one pass, with a single acquire load of the producer index
+ * - Producer and consumer indices (and each side's cached copy of the other)
+ *   live on separate cache lines so the two threads never false-share
+ *
+ * Capacity must be a power of two. T must be trivially copyable in practice
+ * (slots are overwritten in place, never destroyed individually).
+ */
+template <typename T, size_t Capacity>
+class SpscRing {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "SpscRing capacity must be a power of two");
+
+ public:
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  // Producer side. Returns false (and counts a drop) if the ring is full.
+  bool tryPush(const T& item) {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_cachedHead >= Capacity) {
+      m_cachedHead = m_head.load(std::memory_order_acquire);
+      if (tail - m_cachedHead >= Capacity) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    }
+    m_slots[tail & MASK] = item;
+    m_tail.store(tail + 1, std::memory_order_release);
+    m_pushed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Consumer side. Copies up to maxItems records into out, returns the count.
+  size_t popBatch(T* out, size_t maxItems) {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (m_cachedTail == head) {
+      m_cachedTail = m_tail.load(std::memory_order_acquire);
+    }
+    size_t available = m_cachedTail - head;
+    size_t count = available < maxItems ? available : maxItems;
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = m_slots[(head + i) & MASK];
+    }
+    m_head.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  // Consumer side. Appends everything currently available to out.
+  size_t drainInto(std::vector<T>& out) {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    m_cachedTail = m_tail.load(std::memory_order_acquire);
+    size_t count = m_cachedTail - head;
+    out.reserve(out.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+      out.push_back(m_slots[(head + i) & MASK]);
+    }
+    m_head.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  // Approximate when called concurrently with the other side
+  size_t sizeApprox() const {
+    return m_tail.load(std::memory_order_acquire) -
+           m_head.load(std::memory_order_acquire);
+  }
+
+  static constexpr size_t capacity() { return Capacity; }
+  uint64_t pushedCount() const { return m_pushed.load(std::memory_order_relaxed); }
+  uint64_t droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+ private:
+  static constexpr size_t MASK = Capacity - 1;
+
+  // Consumer-owned
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head{0};
+  size_t m_cachedTail = 0;
+
+  // Producer-owned
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail{0};
+  size_t m_cachedHead = 0;
+
+  // Diagnostics, written by the producer only
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_pushed{0};
+  std::atomic<uint64_t> m_dropped{0};
+
+  alignas(CACHE_LINE_SIZE) std::array<T, Capacity> m_slots{};
+};
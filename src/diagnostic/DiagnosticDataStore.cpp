@@ -393,6 +393,10 @@ void DiagnosticDataStore::updateFromMemoryMetrics(const MemoryData& metrics) {
   // Call the existing method that handles updating memory metrics
   updateMemoryPerformanceMetrics(metrics.bandwidth, metrics.latency,
                                  metrics.writeTime, metrics.readTime);
+
+  std::lock_guard<std::mutex> lock(dataMutex);
+  memoryData.latencyPageLocal = metrics.latencyPageLocal;
+  memoryData.latencyLargePages = metrics.latencyLargePages;
 }
 
 void DiagnosticDataStore::updateBackgroundProcessData(
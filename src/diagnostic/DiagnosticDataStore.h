@@ -9,6 +9,8 @@
 
 #include <QString>
 
+#include "diagnostic/memory_tests/stream_bandwidth.h"
+
 // Forward declaration
 class DiagnosticWorker;
 
@@ -30,7 +32,9 @@ class DiagnosticDataStore {
   struct MemoryData {
     // Test results
     double bandwidth = -1.0;
-    double latency = -1.0;
+    double latency = -1.0;              // ns, random chase, normal pages
+    double latencyPageLocal = -1.0;     // ns, a page's lines before the next
+    double latencyLargePages = -1.0;    // ns, random chase, large pages
     double writeTime = -1.0;
     double readTime = -1.0;
 
@@ -80,9 +84,19 @@ class DiagnosticDataStore {
       int completedLoops = 0;
       int completedPatterns = 0;
       size_t testedSizeMB = 0;
+      int threads = 0;
+      double durationSeconds = -1.0;
+      double coverageGBs = -1.0;  // tested size per pattern run, per second
+      std::vector<uint64_t> errorAddresses;  // the first few failing words
     };
 
     StabilityTestResults stabilityTest;
+
+    // STREAM bandwidth, declared with the benchmark in stream_bandwidth.h
+    using StreamKernelResult = ::StreamKernelResult;
+    using StreamResults = ::StreamResults;
+
+    StreamResults stream;
   };
 
   // Enhanced CPU data structure
@@ -128,6 +142,9 @@ class DiagnosticDataStore {
       double ramLatencyNs = -1.0;
 
       std::map<size_t, double> rawLatencies;
+
+      // Where the latency curve steps up, smallest first (approximate sizes)
+      std::vector<int> measuredLevelKB;
     };
 
     CacheData cache;
@@ -191,6 +208,39 @@ class DiagnosticDataStore {
       double varianceUs = -1.0;
     };
     ColdStartMetrics coldStart;
+
+    // Matrix multiplication kernel family, GFLOP/s
+    struct MatrixKernelMetrics {
+      int size = -1;
+      double naiveGflops = -1.0;
+      double registerBlockedGflops = -1.0;
+      double cacheTiledGflops = -1.0;
+      double avx2FmaGflops = -1.0;
+      double avx512FmaGflops = -1.0;
+      double allCoresGflops = -1.0;
+      std::string allCoresKernel;
+    };
+    MatrixKernelMetrics matrixKernels;
+
+    // Entity workload in array-of-structs and struct-of-arrays layouts,
+    // median milliseconds per tick
+    struct GameWorkloadMetrics {
+      struct Phases {
+        double integrateMs = -1.0;
+        double broadphaseMs = -1.0;
+        double collisionMs = -1.0;
+        double aiMs = -1.0;
+        double tickMs = -1.0;
+      };
+      int entityCount = -1;
+      int threads = -1;
+      Phases aos;
+      Phases soa;
+      double soaSpeedup = -1.0;
+      double entityUpdatesPerSecond = -1.0;
+      bool consistent = false;
+    };
+    GameWorkloadMetrics gameWorkload;
   };
 
   // Add GPU data structure
@@ -528,6 +578,11 @@ class DiagnosticDataStore {
     memoryData.stabilityTest = results;
   }
 
+  void updateMemoryStreamResults(const MemoryData::StreamResults& results) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    memoryData.stream = results;
+  }
+
   // Add this getter for our mutex to allow safe updates
   std::mutex& getDataMutex() { return dataMutex; }
 
@@ -818,7 +818,8 @@ void DiagnosticWorker::runMemoryTest() {
     // Then run memory tests - always run synchronously
     log("Starting memory benchmarks...");
     emit testStarted("Memory Test: Running Memory Bandwidth Test");
-    memoryTestFuture = runMemoryTestsAsync(&memoryMetrics);
+    memoryTestFuture =
+      runMemoryTestsAsync(&memoryMetrics, fullMemoryStabilityTest);
 
     try {
       // Block until complete - no async here
@@ -1504,6 +1505,43 @@ QJsonObject DiagnosticWorker::resultsToJson() const {
   cpuResults["game_sim_medium"] = cpuData.gameSimUPS_medium;
   cpuResults["game_sim_large"] = cpuData.gameSimUPS_large;
 
+  if (cpuData.matrixKernels.size > 0) {
+    const auto& kernels = cpuData.matrixKernels;
+    QJsonObject matrixKernels;
+    matrixKernels["size"] = kernels.size;
+    matrixKernels["naive_gflops"] = kernels.naiveGflops;
+    matrixKernels["register_blocked_gflops"] = kernels.registerBlockedGflops;
+    matrixKernels["cache_tiled_gflops"] = kernels.cacheTiledGflops;
+    matrixKernels["avx2_fma_gflops"] = kernels.avx2FmaGflops;
+    matrixKernels["avx512_fma_gflops"] = kernels.avx512FmaGflops;
+    matrixKernels["all_cores_gflops"] = kernels.allCoresGflops;
+    matrixKernels["all_cores_kernel"] =
+      QString::fromStdString(kernels.allCoresKernel);
+    cpuResults["matrix_kernels"] = matrixKernels;
+  }
+
+  if (cpuData.gameWorkload.entityCount > 0) {
+    const auto& workload = cpuData.gameWorkload;
+    auto phasesJson = [](const auto& phases) {
+      QJsonObject json;
+      json["integrate_ms"] = phases.integrateMs;
+      json["broadphase_ms"] = phases.broadphaseMs;
+      json["collision_ms"] = phases.collisionMs;
+      json["ai_ms"] = phases.aiMs;
+      json["tick_ms"] = phases.tickMs;
+      return json;
+    };
+    QJsonObject gameWorkload;
+    gameWorkload["entities"] = workload.entityCount;
+    gameWorkload["threads"] = workload.threads;
+    gameWorkload["aos"] = phasesJson(workload.aos);
+    gameWorkload["soa"] = phasesJson(workload.soa);
+    gameWorkload["soa_speedup"] = workload.soaSpeedup;
+    gameWorkload["entity_updates_per_s"] = workload.entityUpdatesPerSecond;
+    gameWorkload["consistent"] = workload.consistent;
+    cpuResults["game_workload"] = gameWorkload;
+  }
+
   // Remove the duplicate cache latencies array and keep only the raw
   // measurements for more detailed and accurate analysis
   QJsonArray rawLatencies;
@@ -1519,6 +1557,14 @@ QJsonObject DiagnosticWorker::resultsToJson() const {
     cpuResults["raw_cache_latencies"] = rawLatencies;
   }
 
+  if (!cpuData.cache.measuredLevelKB.empty()) {
+    QJsonArray measuredLevels;
+    for (int kb : cpuData.cache.measuredLevelKB) {
+      measuredLevels.append(kb);
+    }
+    cpuResults["measured_cache_levels_kb"] = measuredLevels;
+  }
+
   // In the CPU cache section:
   QJsonObject specificLatencies;
   if (cpuData.cache.l1LatencyNs > 0)
@@ -1675,6 +1721,13 @@ QJsonObject DiagnosticWorker::resultsToJson() const {
   QJsonObject memResults;
   memResults["bandwidth"] = memoryData.bandwidth;
   memResults["latency"] = memoryData.latency;
+  memResults["latency_page_local"] = memoryData.latencyPageLocal;
+  memResults["latency_large_pages"] = memoryData.latencyLargePages;
+  // What the 4 KB page walks add to a random access, when large pages worked
+  memResults["tlb_miss_ns"] =
+    memoryData.latency > 0 && memoryData.latencyLargePages > 0
+      ? memoryData.latency - memoryData.latencyLargePages
+      : -1.0;
   memResults["write_time"] = memoryData.writeTime;
   memResults["read_time"] = memoryData.readTime;
 
@@ -1688,8 +1741,43 @@ QJsonObject DiagnosticWorker::resultsToJson() const {
     memoryData.stabilityTest.completedPatterns;
   stabilityTest["tested_size_mb"] =
     static_cast<int>(memoryData.stabilityTest.testedSizeMB);
+  stabilityTest["threads"] = memoryData.stabilityTest.threads;
+  stabilityTest["duration_s"] = memoryData.stabilityTest.durationSeconds;
+  stabilityTest["coverage_gbs"] = memoryData.stabilityTest.coverageGBs;
+  QJsonArray errorAddresses;
+  for (uint64_t address : memoryData.stabilityTest.errorAddresses) {
+    errorAddresses.append(
+      QString("0x%1").arg(static_cast<qulonglong>(address), 0, 16));
+  }
+  stabilityTest["error_addresses"] = errorAddresses;
   memResults["stability_test"] = stabilityTest;
 
+  if (memoryData.stream.testPerformed) {
+    const auto& stream = memoryData.stream;
+    QJsonObject streamJson;
+    streamJson["validated"] = stream.validated;
+    streamJson["array_mb"] = stream.arrayMB;
+    streamJson["threads"] = stream.threads;
+    QJsonArray kernels;
+    for (const auto& kernel : stream.kernels) {
+      QJsonObject kernelJson;
+      kernelJson["kernel"] = QString::fromStdString(kernel.kernel);
+      kernelJson["non_temporal"] = kernel.nonTemporal;
+      kernelJson["best_gbs"] = kernel.bestGBs;
+      kernelJson["median_gbs"] = kernel.medianGBs;
+      kernels.append(kernelJson);
+    }
+    streamJson["kernels"] = kernels;
+    QJsonArray triadByThreads;
+    for (double gbs : stream.triadByThreads) {
+      triadByThreads.append(gbs);
+    }
+    streamJson["triad_by_threads"] = triadByThreads;
+    streamJson["saturation_threads"] = stream.saturationThreads;
+    streamJson["single_thread_triad_gbs"] = stream.singleThreadTriadGBs;
+    memResults["stream"] = streamJson;
+  }
+
   memory["results"] = memResults;
   results["memory"] = memory;
 
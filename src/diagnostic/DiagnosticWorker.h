@@ -83,6 +83,9 @@ class DiagnosticWorker : public QObject {
   void setExtendedCpuThrottlingTests(bool extended) {
     extendedCpuThrottlingTests = extended;
   }
+  void setFullMemoryStabilityTest(bool full) {
+    fullMemoryStabilityTest = full;
+  }
 
  public slots:
   // This method now just starts the thread
@@ -185,6 +188,7 @@ class DiagnosticWorker : public QObject {
   // Add these new member variables
   bool systemDriveOnlyMode = true;          // Default to system drive only
   bool extendedCpuThrottlingTests = false;  // Default to basic throttling tests
+  bool fullMemoryStabilityTest = false;  // Default to a 256 MB stability test
 
   // Kernel memory metrics removed - using ConstantSystemInfo instead
   // SystemInfoProvider::KernelMemoryInfo m_startKernelMemory;
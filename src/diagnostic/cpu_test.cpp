@@ -13,6 +13,7 @@
 
 // Include the new modularized test headers
 #include "cpu_tests/cpu_benchmarks.h"
+#include "cpu_tests/game_workload.h"
 #include "cpu_tests/throttle_boost_tests.h"
 
 // Add a function to emit progress updates
@@ -91,6 +92,12 @@ void runCpuTests() {
   // Keep the implementation but don't call it
   // eightThreadMatrixMultiplicationTest(cpuInfo.logicalCores, &eightThreadTime);
 
+  // Emit progress and status
+  emitCpuTestProgress("CPU Test: Matrix Kernels", 21);
+
+  // Naive through AVX-512 matrix kernels (delegates to cpu_benchmarks.cpp)
+  runMatrixKernelTest();
+
   // Emit progress and status
   emitCpuTestProgress("CPU Test: SIMD Performance", 22);
 
@@ -163,6 +170,12 @@ void runCpuTests() {
                                     cpuData.gameSimUPS_medium,
                                     cpuData.gameSimUPS_large);
 
+  // Emit progress and status
+  emitCpuTestProgress("CPU Test: Game Workload", 27);
+
+  // AoS vs SoA entity workload (delegates to game_workload.cpp)
+  runGameWorkloadTest();
+
   // Emit progress and status
   emitCpuTestProgress("CPU Test: Cold Start Response", 28);
 
@@ -206,6 +219,65 @@ void runCpuColdStartTest() {
   LOG_INFO << "[CPU Cold Start Response Test] Completed.";
 }
 
+// Interface to the matrix kernel family test
+void runMatrixKernelTest() {
+  LOG_INFO << "[Matrix Kernel Test] Running...";
+
+  MatrixKernelResults results = testMatrixKernels();
+
+  auto& dataStore = DiagnosticDataStore::getInstance();
+  DiagnosticDataStore::CPUData cpuData = dataStore.getCPUData();
+
+  DiagnosticDataStore::CPUData::MatrixKernelMetrics metrics;
+  metrics.size = results.size;
+  metrics.naiveGflops = results.naiveGflops;
+  metrics.registerBlockedGflops = results.registerBlockedGflops;
+  metrics.cacheTiledGflops = results.cacheTiledGflops;
+  metrics.avx2FmaGflops = results.avx2FmaGflops;
+  metrics.avx512FmaGflops = results.avx512FmaGflops;
+  metrics.allCoresGflops = results.allCoresGflops;
+  metrics.allCoresKernel = results.allCoresKernel;
+
+  cpuData.matrixKernels = metrics;
+  dataStore.setCPUData(cpuData);
+
+  LOG_INFO << "[Matrix Kernel Test] Completed.";
+}
+
+// Interface to the AoS/SoA game workload test
+void runGameWorkloadTest() {
+  LOG_INFO << "[Game Workload Test] Running...";
+
+  GameWorkloadResults results = runGameWorkload();
+
+  auto& dataStore = DiagnosticDataStore::getInstance();
+  DiagnosticDataStore::CPUData cpuData = dataStore.getCPUData();
+
+  auto toPhases = [](const GamePhaseTimes& times) {
+    DiagnosticDataStore::CPUData::GameWorkloadMetrics::Phases phases;
+    phases.integrateMs = times.integrateMs;
+    phases.broadphaseMs = times.broadphaseMs;
+    phases.collisionMs = times.collisionMs;
+    phases.aiMs = times.aiMs;
+    phases.tickMs = times.tickMs;
+    return phases;
+  };
+
+  DiagnosticDataStore::CPUData::GameWorkloadMetrics metrics;
+  metrics.entityCount = results.entityCount;
+  metrics.threads = results.threads;
+  metrics.aos = toPhases(results.aos);
+  metrics.soa = toPhases(results.soa);
+  metrics.soaSpeedup = results.soaSpeedup;
+  metrics.entityUpdatesPerSecond = results.entityUpdatesPerSecond;
+  metrics.consistent = results.consistent;
+
+  cpuData.gameWorkload = metrics;
+  dataStore.setCPUData(cpuData);
+
+  LOG_INFO << "[Game Workload Test] Completed.";
+}
+
 // Interface to CPU boost behavior test
 void runCpuBoostBehaviorTest() {
   LOG_INFO << "[CPU Boost Behavior Test] Running...";
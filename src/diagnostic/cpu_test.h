@@ -26,6 +26,8 @@ void runCombinedThrottlingTest(
   CpuThrottlingTestMode mode = CpuThrottle_Extended);
 void runThreadSchedulingTest();
 void runCpuColdStartTest();  // Add the new cold start test function
+void runMatrixKernelTest();
+void runGameWorkloadTest();
 
 // Declare all global variables so they're accessible from other files
 extern std::vector<CoreBoostMetrics> g_cpuBoostMetrics;
@@ -5,25 +5,17 @@
 #include <iomanip>
 #include <iostream>
 #include <numeric>
-#include <random>
 #include <vector>
 
-#include <windows.h>
-#include <immintrin.h>
-
 #include "../cpu_test.h"
 #include "diagnostic/DiagnosticDataStore.h"
+#include "diagnostic/memory_tests/latency_engine.h"
 #include "hardware/ConstantSystemInfo.h"
 
 #include "logging/Logger.h"
 
 void testCacheAndMemoryLatency(double* latencies) {
-  // Pin to a single core for consistent results
-  DWORD_PTR originalAffinity = SetThreadAffinityMask(GetCurrentThread(), 1);
-
   LOG_INFO << "\n===== Enhanced Cache and Memory Latency Test =====\n";
-  std::random_device rd;
-  std::mt19937 gen(rd());
 
   // Get reference to DiagnosticDataStore
   DiagnosticDataStore& dataStore = DiagnosticDataStore::getInstance();
@@ -31,37 +23,6 @@ void testCacheAndMemoryLatency(double* latencies) {
   
   LOG_INFO << "[Cache Test] Starting cache test - existing primeTime: " << cpuData.primeTime;
 
-  // Define buffer sizes to test - from small L1 sizes to large memory sizes
-  std::vector<size_t> bufferSizes = {
-    4 * 1024,           // 4 KB - L1 cache
-    8 * 1024,           // 8 KB - L1 cache
-    16 * 1024,          // 16 KB - L1 cache
-    32 * 1024,          // 32 KB - L1 cache
-    64 * 1024,          // 64 KB - L1/L2 cache boundary
-    96 * 1024,          // 96 KB - L2 cache
-    128 * 1024,         // 128 KB - L2 cache
-    192 * 1024,         // 192 KB - L2 cache
-    256 * 1024,         // 256 KB - L2 cache
-    384 * 1024,         // 384 KB - L2 cache
-    512 * 1024,         // 512 KB - L2 cache
-    768 * 1024,         // 768 KB - L2/L3 boundary
-    1 * 1024 * 1024,    // 1 MB - L3 cache
-    1 * 1024 * 1024,    // 1 MB duplicate (for repeated tests)
-    2 * 1024 * 1024,    // 2 MB - L3 cache
-    3 * 1024 * 1024,    // 3 MB - L3 cache
-    4 * 1024 * 1024,    // 4 MB - L3 cache
-    6 * 1024 * 1024,    // 6 MB - L3 cache
-    8 * 1024 * 1024,    // 8 MB - L3 cache
-    12 * 1024 * 1024,   // 12 MB - L3 cache
-    16 * 1024 * 1024,   // 16 MB - L3 cache
-    24 * 1024 * 1024,   // 24 MB - L3 cache
-    32 * 1024 * 1024,   // 32 MB - L3 cache
-    48 * 1024 * 1024,   // 48 MB - Main memory
-    64 * 1024 * 1024,   // 64 MB - Main memory
-    128 * 1024 * 1024,  // 128 MB - Main memory
-    256 * 1024 * 1024,  // 256 MB - Main memory
-  };
-
   // Store detected cache sizes
   int l1CacheKB = -1, l2CacheKB = -1, l3CacheKB = -1;
 
@@ -76,167 +37,46 @@ void testCacheAndMemoryLatency(double* latencies) {
   if (l2CacheKB > 0) LOG_INFO << "Detected L2 Cache: " << l2CacheKB << " KB";
   if (l3CacheKB > 0) LOG_INFO << "Detected L3 Cache: " << l3CacheKB << " KB";
 
-  // Test various packet sizes (data access sizes)
-  std::vector<size_t> packetSizes = {8,
-                                     64};  // 8B (pointer) and 64B (cache line)
-
-  LOG_INFO << "\nTesting memory latency with different packet sizes...\n";
-  LOG_INFO << "Buffer Size | 8-byte Latency | 64-byte Latency | Memory Level\n";
-  LOG_INFO << "------------------------------------------------------------\n";
-
-  // Store all the raw latency measurements
-  std::vector<double> allLatencies(bufferSizes.size());
-
-  // For each buffer size
-  for (size_t i = 0; i < bufferSizes.size(); i++) {
-    size_t bufferSize = bufferSizes[i];
-    LOG_INFO << std::setw(10)
-             << (bufferSize < 1024 * 1024 ? bufferSize / 1024
-                                          : bufferSize / (1024 * 1024))
-             << (bufferSize < 1024 * 1024 ? " KB" : " MB") << " | ";
-
-    std::vector<double> packetLatencies;
-
-    // For each packet size
-    for (size_t packetSize : packetSizes) {
-      try {
-        // Allocate buffer and create random access pattern
-        size_t elementCount = bufferSize / packetSize;
-        if (elementCount < 2) elementCount = 2;  // Ensure at least 2 elements
-
-        // Use aligned allocation for better performance
-        void* buffer = _aligned_malloc(elementCount * packetSize, 64);
-        if (!buffer) throw std::bad_alloc();
-
-        // Create random pointer-chasing pattern
-        size_t* indices = new size_t[elementCount];
-        for (size_t j = 0; j < elementCount; j++) {
-          indices[j] = j;
-        }
-        std::shuffle(indices, indices + elementCount, gen);
-
-        // Setup pointer chasing pattern
-        if (packetSize == 8) {
-          // 8-byte (64-bit) pointer chasing
-          uint64_t* ptrs = static_cast<uint64_t*>(buffer);
-          for (size_t j = 0; j < elementCount - 1; j++) {
-            ptrs[indices[j]] =
-              reinterpret_cast<uint64_t>(&ptrs[indices[j + 1]]);
-          }
-          ptrs[indices[elementCount - 1]] =
-            reinterpret_cast<uint64_t>(&ptrs[indices[0]]);
-
-          // Flush cache
-          for (size_t j = 0; j < elementCount; j += 8) {
-            _mm_clflush(&ptrs[j]);
-          }
-          _mm_mfence();
-
-          // Warm up
-          volatile uint64_t* p = &ptrs[0];
-          for (int w = 0; w < 1000; w++) {
-            p = reinterpret_cast<uint64_t*>(*p);
-          }
-
-          // Measure latency
-          const int numIterations =
-            std::min(10'000'000, static_cast<int>(elementCount * 100));
-          auto start = std::chrono::high_resolution_clock::now();
-          p = &ptrs[0];
-          for (int iter = 0; iter < numIterations; iter++) {
-            p = reinterpret_cast<uint64_t*>(*p);  // Follow pointer chain
-          }
-          auto end = std::chrono::high_resolution_clock::now();
-
-          double nanoseconds =
-            std::chrono::duration<double, std::nano>(end - start).count();
-          double latencyNs = nanoseconds / numIterations;
-          packetLatencies.push_back(latencyNs);
-
-          LOG_INFO << std::fixed << std::setw(14) << std::setprecision(2)
-                    << latencyNs << " ns | ";
-
-          // Anti-optimization (use the result)
-          volatile uint64_t dummy = reinterpret_cast<uint64_t>(p);
-        } else if (packetSize == 64) {
-          // 64-byte (cache line) access
-          char* blocks = static_cast<char*>(buffer);
-
-          // Create pointer chasing pattern with 64-byte alignment
-          for (size_t j = 0; j < elementCount - 1; j++) {
-            *reinterpret_cast<char**>(blocks + indices[j] * packetSize) =
-              blocks + indices[j + 1] * packetSize;
-          }
-          *reinterpret_cast<char**>(blocks +
-                                    indices[elementCount - 1] * packetSize) =
-            blocks + indices[0] * packetSize;
-
-          // Flush cache
-          for (size_t j = 0; j < elementCount; j++) {
-            _mm_clflush(blocks + j * packetSize);
-          }
-          _mm_mfence();
-
-          // Warm up
-          volatile char* p = blocks;
-          for (int w = 0; w < 1000; w++) {
-            p = *reinterpret_cast<char* volatile*>(const_cast<char*>(p));
-          }
-
-          // Measure latency
-          const int numIterations =
-            std::min(5'000'000, static_cast<int>(elementCount * 50));
-          auto start = std::chrono::high_resolution_clock::now();
-          p = blocks;
-          for (int iter = 0; iter < numIterations; iter++) {
-            p = *reinterpret_cast<char* volatile*>(
-              const_cast<char*>(p));  // Follow pointer chain
-          }
-          auto end = std::chrono::high_resolution_clock::now();
-
-          double nanoseconds =
-            std::chrono::duration<double, std::nano>(end - start).count();
-          double latencyNs = nanoseconds / numIterations;
-          packetLatencies.push_back(latencyNs);
-
-          LOG_INFO << std::fixed << std::setw(16) << std::setprecision(2)
-                    << latencyNs << " ns | ";
-
-          // Anti-optimization (use the result)
-          volatile uint64_t dummy = reinterpret_cast<uint64_t>(p);
-        }
-
-        // Cleanup
-        if (packetSize == 8) delete[] indices;
-        _aligned_free(buffer);
-      } catch (const std::exception& e) {
-        LOG_ERROR << "Error: " << e.what() << " | ";
-        packetLatencies.push_back(0.0);
-      }
-    }
-
-    // Store best (lowest) valid latency for this buffer size
-    double bestLatency = 0.0;
-    for (double lat : packetLatencies) {
-      if (lat > 0 && (bestLatency == 0.0 || lat < bestLatency)) {
-        bestLatency = lat;
-      }
-    }
-    allLatencies[i] = bestLatency;
+  // Random chase over one cache line per node, 4 KB to 256 MB at three sizes
+  // per doubling; the chase runs on KernelRunner worker 0, pinned to core 0
+  const std::vector<LatencyPoint> curve =
+    measureLatencyCurve(4 * 1024, 256 * 1024 * 1024, 3);
+  std::vector<size_t> bufferSizes;
+  std::vector<double> allLatencies;
+  for (const LatencyPoint& point : curve) {
+    bufferSizes.push_back(point.bytes);
+    allLatencies.push_back(point.ns);
+  }
 
-    // Determine memory level based on actual detected cache sizes
-    std::string memoryLevel = "Unknown";
-    if (bufferSize <= l1CacheKB * 1024) {
-      memoryLevel = "L1 Cache";
-    } else if (bufferSize <= l2CacheKB * 1024) {
-      memoryLevel = "L2 Cache";
-    } else if (bufferSize <= l3CacheKB * 1024) {
-      memoryLevel = "L3 Cache";
-    } else {
-      memoryLevel = "Main Memory";
+  // Level boundaries from the curve itself. They are used when they find as
+  // many cache levels as the system reports; otherwise the reported sizes are.
+  const std::vector<CacheLevelEstimate> levels = detectCacheLevels(curve);
+  std::vector<int> detectedLevelKB;
+  for (size_t i = 0; i + 1 < levels.size(); i++) {
+    detectedLevelKB.push_back(static_cast<int>(levels[i].bytes / 1024));
+    LOG_INFO << "Measured L" << i + 1 << " boundary: ~"
+             << levels[i].bytes / 1024 << " KB, " << std::fixed
+             << std::setprecision(2) << levels[i].ns << " ns";
+  }
+  const int reportedLevels =
+    (l1CacheKB > 0) + (l2CacheKB > 0) + (l3CacheKB > 0);
+  const bool useMeasured =
+    !detectedLevelKB.empty() &&
+    static_cast<int>(detectedLevelKB.size()) == reportedLevels;
+  auto reportedLimit = [](int kb) {
+    return kb > 0 ? static_cast<size_t>(kb) * 1024 : size_t(0);
+  };
+  size_t levelLimits[3] = {reportedLimit(l1CacheKB), reportedLimit(l2CacheKB),
+                           reportedLimit(l3CacheKB)};
+  if (useMeasured) {
+    for (size_t i = 0; i < 3; i++) {
+      levelLimits[i] = i < detectedLevelKB.size()
+                         ? static_cast<size_t>(detectedLevelKB[i]) * 1024
+                         : 0;
     }
-
-    LOG_INFO << memoryLevel;
+  } else {
+    LOG_INFO << "Measured " << detectedLevelKB.size() << " cache levels, "
+             << reportedLevels << " reported; grouping by reported sizes";
   }
 
   // Group latencies by cache level
@@ -249,11 +89,11 @@ void testCacheAndMemoryLatency(double* latencies) {
     if (latencyValue <= 0) continue;  // Skip invalid measurements
 
     // Categorize by size
-    if (bufferSize <= l1CacheKB * 1024) {
+    if (bufferSize <= levelLimits[0]) {
       l1Latencies.push_back(latencyValue);
-    } else if (bufferSize <= l2CacheKB * 1024) {
+    } else if (bufferSize <= levelLimits[1]) {
       l2Latencies.push_back(latencyValue);
-    } else if (bufferSize <= l3CacheKB * 1024) {
+    } else if (bufferSize <= levelLimits[2]) {
       l3Latencies.push_back(latencyValue);
     } else {
       ramLatencies.push_back(latencyValue);
@@ -296,11 +136,7 @@ void testCacheAndMemoryLatency(double* latencies) {
   LOG_INFO << "------------------\n";
   for (size_t i = 0; i < bufferSizes.size(); i++) {
     size_t bufferSize = bufferSizes[i];
-    LOG_INFO << std::setw(5)
-              << (bufferSize < 1024 * 1024 ? bufferSize / 1024
-                                           : bufferSize / (1024 * 1024))
-              << (bufferSize < 1024 * 1024 ? " KB" : " MB") << " | "
-              << std::fixed << std::setprecision(3) << allLatencies[i]
+    LOG_INFO << std::setw(6) << bufferSize / 1024 << " KB | " << std::fixed << std::setprecision(3) << allLatencies[i]
               << " ns\n";
   }
 
@@ -329,6 +165,7 @@ void testCacheAndMemoryLatency(double* latencies) {
   cpuData.cache.l1SizeKB = l1CacheKB;
   cpuData.cache.l2SizeKB = l2CacheKB;
   cpuData.cache.l3SizeKB = l3CacheKB;
+  cpuData.cache.measuredLevelKB = detectedLevelKB;
 
   // Fill the latencies array for DiagnosticDataStore
   if (latencies) {
@@ -388,7 +225,4 @@ void testCacheAndMemoryLatency(double* latencies) {
   LOG_INFO << "[Cache Test] Before setCPUData - primeTime: " << cpuData.primeTime;
   dataStore.setCPUData(cpuData);
   LOG_INFO << "[Cache Test] Cache test completed - data saved";
-
-  // Restore original affinity
-  SetThreadAffinityMask(GetCurrentThread(), originalAffinity);
 }
@@ -2,6 +2,7 @@
 #ifndef CPU_BENCHMARKS_H
 #define CPU_BENCHMARKS_H
 
+#include <string>
 #include <vector>
 
 // Structure to store cold start test results
@@ -14,13 +15,26 @@ struct ColdStartResults {
   std::vector<double> rawTimes;
 };
 
+// Matrix kernel family results in GFLOP/s, -1 if the CPU lacks the
+// instructions or the kernel's result didn't match the reference
+struct MatrixKernelResults {
+  int size = 0;  // N of the N x N float matrices
+  double naiveGflops = -1.0;
+  double registerBlockedGflops = -1.0;
+  double cacheTiledGflops = -1.0;
+  double avx2FmaGflops = -1.0;
+  double avx512FmaGflops = -1.0;
+  double allCoresGflops = -1.0;  // fastest kernel on every core, combined
+  std::string allCoresKernel;
+};
+
 // CPU benchmark function declarations
 void testSIMD(double* simdScalar, double* simdAvx);
-void testStreamBandwidth();
 void matrixMultiplication(int N);
 void singleCoreMatrixMultiplicationTest(int physicalCores, double* result);
 void fourThreadMatrixMultiplicationTest(int threadCount, double* result);
 void eightThreadMatrixMultiplicationTest(int threadCount, double* result);
+MatrixKernelResults testMatrixKernels();
 double testPrimeCalculation();
 double testGameSimulation(size_t tier1_size, size_t tier2_size,
                           size_t tier3_size);
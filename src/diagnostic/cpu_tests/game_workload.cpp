@@ -0,0 +1,477 @@
+#include "game_workload.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <emmintrin.h>
+
+#include "kernel_runner.h"
+#include "logging/Logger.h"
+
+namespace {
+
+constexpr int CHUNK = 256;  // entities per job
+constexpr float DT = 1.0f / 60.0f;
+constexpr float WORLD = 1024.0f;  // x and z extent, about two entities per cell
+constexpr float HEIGHT = 64.0f;  // y extent
+constexpr float CELL = 8.0f;     // at least the largest reach between two entities
+constexpr int GRID = static_cast<int>(WORLD / CELL);
+constexpr float MAX_SPEED = 24.0f;
+constexpr float STEER = 30.0f;  // acceleration towards the target
+constexpr float PUSH = 2.0f;    // velocity away from an overlapping entity
+constexpr int MAX_HEALTH = 100;
+
+uint32_t xorshift32(uint32_t& state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+// [0, 1)
+float unitFloat(uint32_t& state) {
+  return static_cast<float>(xorshift32(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+// Keeps a coordinate in [0, limit] by reflecting it off the walls
+void bounce(float& p, float& v, float limit) {
+  if (p < 0.0f) {
+    p = -p;
+    v = -v;
+  } else if (p >= limit) {
+    p = 2.0f * limit - p;
+    v = -v;
+  }
+}
+
+// The same for four lanes; bit-identical to the scalar version
+void bounce(__m128& p, __m128& v, float limit) {
+  const __m128 signBit = _mm_set1_ps(-0.0f);
+  const __m128 low = _mm_cmplt_ps(p, _mm_setzero_ps());
+  const __m128 high = _mm_cmpge_ps(p, _mm_set1_ps(limit));
+  const __m128 reflectedHigh = _mm_sub_ps(_mm_set1_ps(2.0f * limit), p);
+  const __m128 reflected = _mm_or_ps(_mm_and_ps(low, _mm_xor_ps(p, signBit)),
+                                     _mm_andnot_ps(low, reflectedHigh));
+  const __m128 hit = _mm_or_ps(low, high);
+  p = _mm_or_ps(_mm_and_ps(hit, reflected), _mm_andnot_ps(hit, p));
+  v = _mm_xor_ps(v, _mm_and_ps(hit, signBit));
+}
+
+// Uniform grid over x/z, rebuilt every tick with a counting sort
+struct Grid {
+  std::vector<uint32_t> cellOf;     // per entity
+  std::vector<uint32_t> cellStart;  // entities of cell c: [cellStart[c], cellStart[c + 1])
+  std::vector<uint32_t> entities;   // in cell order
+  std::vector<uint32_t> cursor;
+
+  explicit Grid(int n)
+      : cellOf(n), cellStart(GRID * GRID + 1), entities(n), cursor(GRID * GRID) {}
+
+  static uint32_t cellAt(float x, float z) {
+    const int cx = std::min(static_cast<int>(x * (1.0f / CELL)), GRID - 1);
+    const int cz = std::min(static_cast<int>(z * (1.0f / CELL)), GRID - 1);
+    return static_cast<uint32_t>(cz * GRID + cx);
+  }
+
+  void build() {
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    for (uint32_t cell : cellOf) cellStart[cell + 1]++;
+    for (size_t c = 1; c < cellStart.size(); c++) cellStart[c] += cellStart[c - 1];
+    std::copy(cellStart.begin(), cellStart.end() - 1, cursor.begin());
+    for (uint32_t i = 0; i < cellOf.size(); i++) entities[cursor[cellOf[i]]++] = i;
+  }
+};
+
+// One cache line per entity, most of it unused by any one phase
+struct alignas(64) Entity {
+  float x, y, z;
+  float vx, vy, vz;
+  float radius;
+  int32_t health;
+  int32_t team;
+  uint32_t target;
+  uint32_t seed;
+};
+
+class AosWorld {
+ public:
+  explicit AosWorld(int n) : e_(n) {}
+
+  int size() const { return static_cast<int>(e_.size()); }
+  float& x(int i) { return e_[i].x; }
+  float& y(int i) { return e_[i].y; }
+  float& z(int i) { return e_[i].z; }
+  float& vx(int i) { return e_[i].vx; }
+  float& vy(int i) { return e_[i].vy; }
+  float& vz(int i) { return e_[i].vz; }
+  float& radius(int i) { return e_[i].radius; }
+  int32_t& health(int i) { return e_[i].health; }
+  int32_t& team(int i) { return e_[i].team; }
+  uint32_t& target(int i) { return e_[i].target; }
+  uint32_t& seed(int i) { return e_[i].seed; }
+
+  void integrate(int begin, int end);
+
+ private:
+  std::vector<Entity> e_;
+};
+
+class SoaWorld {
+ public:
+  explicit SoaWorld(int n)
+      : x_(n), y_(n), z_(n), vx_(n), vy_(n), vz_(n), radius_(n), health_(n),
+        team_(n), target_(n), seed_(n) {}
+
+  int size() const { return static_cast<int>(x_.size()); }
+  float& x(int i) { return x_[i]; }
+  float& y(int i) { return y_[i]; }
+  float& z(int i) { return z_[i]; }
+  float& vx(int i) { return vx_[i]; }
+  float& vy(int i) { return vy_[i]; }
+  float& vz(int i) { return vz_[i]; }
+  float& radius(int i) { return radius_[i]; }
+  int32_t& health(int i) { return health_[i]; }
+  int32_t& team(int i) { return team_[i]; }
+  uint32_t& target(int i) { return target_[i]; }
+  uint32_t& seed(int i) { return seed_[i]; }
+
+  void integrate(int begin, int end);
+
+ private:
+  std::vector<float> x_, y_, z_, vx_, vy_, vz_, radius_;
+  std::vector<int32_t> health_, team_;
+  std::vector<uint32_t> target_, seed_;
+};
+
+template <typename World>
+void spawn(World& w, int i) {
+  uint32_t& seed = w.seed(i);
+  w.x(i) = unitFloat(seed) * WORLD;
+  w.y(i) = unitFloat(seed) * HEIGHT;
+  w.z(i) = unitFloat(seed) * WORLD;
+  w.vx(i) = 0.0f;
+  w.vy(i) = 0.0f;
+  w.vz(i) = 0.0f;
+  w.health(i) = MAX_HEALTH;
+}
+
+// The same world for both layouts
+template <typename World>
+void populate(World& w) {
+  const int n = w.size();
+  for (int i = 0; i < n; i++) {
+    w.seed(i) = 0x9E3779B9u * static_cast<uint32_t>(i + 1) | 1u;
+    spawn(w, i);
+    uint32_t& seed = w.seed(i);
+    w.vx(i) = (unitFloat(seed) - 0.5f) * MAX_SPEED;
+    w.vy(i) = (unitFloat(seed) - 0.5f) * MAX_SPEED * 0.25f;
+    w.vz(i) = (unitFloat(seed) - 0.5f) * MAX_SPEED;
+    w.radius(i) = 0.5f + unitFloat(seed) * 1.5f;
+    w.team(i) = i % 4;
+    w.target(i) = xorshift32(seed) % static_cast<uint32_t>(n);
+  }
+}
+
+void AosWorld::integrate(int begin, int end) {
+  for (int i = begin; i < end; i++) {
+    Entity& e = e_[i];
+    if (e.health <= 0) {
+      spawn(*this, i);
+      continue;
+    }
+    e.x += e.vx * DT;
+    e.y += e.vy * DT;
+    e.z += e.vz * DT;
+    bounce(e.x, e.vx, WORLD);
+    bounce(e.y, e.vy, HEIGHT);
+    bounce(e.z, e.vz, WORLD);
+  }
+}
+
+// SSE2 four entities at a time; dead ones are integrated too and then
+// overwritten by the respawn
+void SoaWorld::integrate(int begin, int end) {
+  const __m128 dt = _mm_set1_ps(DT);
+  float* const positions[3] = {x_.data(), y_.data(), z_.data()};
+  float* const velocities[3] = {vx_.data(), vy_.data(), vz_.data()};
+  const float limits[3] = {WORLD, HEIGHT, WORLD};
+  for (int axis = 0; axis < 3; axis++) {
+    float* p = positions[axis];
+    float* v = velocities[axis];
+    for (int i = begin; i < end; i += 4) {
+      __m128 pos = _mm_loadu_ps(p + i);
+      __m128 vel = _mm_loadu_ps(v + i);
+      pos = _mm_add_ps(pos, _mm_mul_ps(vel, dt));
+      bounce(pos, vel, limits[axis]);
+      _mm_storeu_ps(p + i, pos);
+      _mm_storeu_ps(v + i, vel);
+    }
+  }
+  for (int i = begin; i < end; i++) {
+    if (health_[i] <= 0) spawn(*this, i);
+  }
+}
+
+template <typename World>
+void assignCells(World& w, Grid& grid, int begin, int end) {
+  for (int i = begin; i < end; i++) grid.cellOf[i] = Grid::cellAt(w.x(i), w.z(i));
+}
+
+// Each entity against everything in its own and the eight surrounding
+// cells: pushed away from whatever it overlaps, damaged by other teams.
+// Returns the contacts found.
+template <typename World>
+uint64_t collide(World& w, const Grid& grid, int begin, int end) {
+  uint64_t contacts = 0;
+  for (int i = begin; i < end; i++) {
+    const float xi = w.x(i), yi = w.y(i), zi = w.z(i), ri = w.radius(i);
+    const int32_t team = w.team(i);
+    const int cx = static_cast<int>(grid.cellOf[i] % GRID);
+    const int cz = static_cast<int>(grid.cellOf[i] / GRID);
+    float pushX = 0.0f, pushZ = 0.0f;
+    int damage = 0;
+    int hits = 0;
+    for (int gz = std::max(cz - 1, 0); gz <= std::min(cz + 1, GRID - 1); gz++) {
+      for (int gx = std::max(cx - 1, 0); gx <= std::min(cx + 1, GRID - 1); gx++) {
+        const uint32_t cell = static_cast<uint32_t>(gz * GRID + gx);
+        for (uint32_t k = grid.cellStart[cell]; k < grid.cellStart[cell + 1]; k++) {
+          const int j = static_cast<int>(grid.entities[k]);
+          if (j == i) continue;
+          const float dx = xi - w.x(j);
+          const float dy = yi - w.y(j);
+          const float dz = zi - w.z(j);
+          const float reach = ri + w.radius(j);
+          if (dx * dx + dy * dy + dz * dz >= reach * reach) continue;
+          hits++;
+          pushX += dx;
+          pushZ += dz;
+          if (w.team(j) != team) damage++;
+        }
+      }
+    }
+    if (hits > 0) {
+      w.vx(i) += pushX * PUSH;
+      w.vz(i) += pushZ * PUSH;
+      w.health(i) -= damage;
+      contacts += hits;
+    }
+  }
+  return contacts;
+}
+
+// Steer towards the target entity, a random read into the world, and pick
+// a new one when it's dead
+template <typename World>
+void think(World& w, int begin, int end) {
+  const uint32_t n = static_cast<uint32_t>(w.size());
+  for (int i = begin; i < end; i++) {
+    uint32_t target = w.target(i);
+    if (target == static_cast<uint32_t>(i) || w.health(target) <= 0) {
+      target = xorshift32(w.seed(i)) % n;
+      w.target(i) = target;
+    }
+    const float dx = w.x(target) - w.x(i);
+    const float dz = w.z(target) - w.z(i);
+    const float scale = STEER * DT / (std::sqrt(dx * dx + dz * dz) + 1e-3f);
+    float vx = w.vx(i) + dx * scale;
+    float vz = w.vz(i) + dz * scale;
+    const float speed2 = vx * vx + vz * vz;
+    if (speed2 > MAX_SPEED * MAX_SPEED) {
+      const float clamp = MAX_SPEED / std::sqrt(speed2);
+      vx *= clamp;
+      vz *= clamp;
+    }
+    w.vx(i) = vx;
+    w.vz(i) = vz;
+  }
+}
+
+// FNV-1a over what the phases leave behind
+template <typename World>
+uint64_t stateHash(World& w, uint64_t contacts) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  auto mix = [&](const void* data, size_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t b = 0; b < bytes; b++) hash = (hash ^ p[b]) * 0x100000001b3ull;
+  };
+  for (int i = 0; i < w.size(); i++) {
+    mix(&w.x(i), sizeof(float));
+    mix(&w.y(i), sizeof(float));
+    mix(&w.z(i), sizeof(float));
+    mix(&w.health(i), sizeof(int32_t));
+  }
+  mix(&contacts, sizeof(contacts));
+  return hash;
+}
+
+enum Phase { Integrate, Broadphase, Collision, Ai, PHASE_COUNT };
+
+struct Stage {
+  Phase phase;
+  bool parallel;  // split into chunks, or run whole on worker 0
+  std::function<void(int begin, int end, int thread)> work;
+};
+
+// Workers spin here between stages, which is far cheaper than a new job
+class SpinBarrier {
+ public:
+  explicit SpinBarrier(int count) : count_(count) {}
+
+  void wait() {
+    const unsigned generation = generation_.load(std::memory_order_acquire);
+    if (arrived_.fetch_add(1, std::memory_order_acq_rel) + 1 == count_) {
+      arrived_.store(0, std::memory_order_relaxed);
+      generation_.fetch_add(1, std::memory_order_release);
+      return;
+    }
+    while (generation_.load(std::memory_order_acquire) == generation) {
+      _mm_pause();
+    }
+  }
+
+ private:
+  const int count_;
+  std::atomic<int> arrived_{0};
+  std::atomic<unsigned> generation_{0};
+};
+
+using TickTimes = std::array<double, PHASE_COUNT>;
+
+// Every tick in one KernelRunner job; worker 0 times each stage from its
+// start to the barrier after it
+std::vector<TickTimes> runTicks(const std::vector<Stage>& stages, int entities,
+                                int threads, int ticks) {
+  std::vector<TickTimes> times(ticks, TickTimes{});
+  std::vector<std::atomic<int>> nextChunk(stages.size());
+  for (auto& next : nextChunk) next.store(0);
+  SpinBarrier barrier(threads);
+  const int chunks = entities / CHUNK;
+
+  KernelRunner::getInstance().runOnce(threads, [&](int t) {
+    for (int tick = 0; tick < ticks; tick++) {
+      for (size_t s = 0; s < stages.size(); s++) {
+        const auto start = std::chrono::steady_clock::now();
+        if (stages[s].parallel) {
+          for (int c; (c = nextChunk[s].fetch_add(1, std::memory_order_relaxed)) < chunks;) {
+            stages[s].work(c * CHUNK, (c + 1) * CHUNK, t);
+          }
+        } else if (t == 0) {
+          stages[s].work(0, entities, t);
+        }
+        // Nobody touches the next stage's counter until the barrier
+        if (t == 0) nextChunk[(s + 1) % stages.size()].store(0, std::memory_order_relaxed);
+        barrier.wait();
+        if (t == 0) {
+          times[tick][stages[s].phase] += std::chrono::duration<double, std::milli>(
+                                            std::chrono::steady_clock::now() - start)
+                                            .count();
+        }
+      }
+    }
+  });
+  return times;
+}
+
+template <typename World>
+GamePhaseTimes runWorld(World& world, int threads, const GameWorkloadConfig& config,
+                        uint64_t& hash) {
+  const int n = world.size();
+  Grid grid(n);
+  struct alignas(64) Counter {
+    uint64_t value = 0;
+  };
+  std::vector<Counter> contacts(threads);
+
+  const std::vector<Stage> stages = {
+    {Integrate, true, [&](int b, int e, int) { world.integrate(b, e); }},
+    {Broadphase, true, [&](int b, int e, int) { assignCells(world, grid, b, e); }},
+    {Broadphase, false, [&](int, int, int) { grid.build(); }},
+    {Collision, true,
+     [&](int b, int e, int t) { contacts[t].value += collide(world, grid, b, e); }},
+    {Ai, true, [&](int b, int e, int) { think(world, b, e); }},
+  };
+
+  std::vector<TickTimes> times =
+    runTicks(stages, n, threads, config.warmupTicks + config.ticks);
+  times.erase(times.begin(), times.begin() + config.warmupTicks);
+
+  auto phaseMedian = [&](int phase) {
+    std::vector<double> values;
+    for (const TickTimes& tick : times) {
+      values.push_back(phase < PHASE_COUNT
+                         ? tick[phase]
+                         : tick[Integrate] + tick[Broadphase] + tick[Collision] + tick[Ai]);
+    }
+    return KernelStats::medianOf(values);
+  };
+  GamePhaseTimes result;
+  result.integrateMs = phaseMedian(Integrate);
+  result.broadphaseMs = phaseMedian(Broadphase);
+  result.collisionMs = phaseMedian(Collision);
+  result.aiMs = phaseMedian(Ai);
+  result.tickMs = phaseMedian(PHASE_COUNT);
+
+  uint64_t total = 0;
+  for (const Counter& counter : contacts) total += counter.value;
+  hash = stateHash(world, total);
+  return result;
+}
+
+void logPhases(const char* layout, const GamePhaseTimes& times) {
+  LOG_INFO << "[Game Workload] " << layout << ": integrate " << times.integrateMs
+           << " ms, broadphase " << times.broadphaseMs << " ms, collision "
+           << times.collisionMs << " ms, AI " << times.aiMs << " ms, tick "
+           << times.tickMs << " ms";
+}
+
+}  // namespace
+
+GameWorkloadResults runGameWorkload(const GameWorkloadConfig& config) {
+  GameWorkloadResults results;
+  KernelRunner& runner = KernelRunner::getInstance();
+  const int threads = config.threads > 0
+                        ? std::min(config.threads, runner.workerCount())
+                        : runner.workerCount();
+  const int n = std::max(config.entityCount / CHUNK, 1) * CHUNK;
+
+  results.entityCount = n;
+  results.threads = threads;
+  results.ticks = config.ticks;
+  LOG_INFO << "[Game Workload] " << n << " entities, " << threads << " threads, "
+           << config.ticks << " ticks";
+
+  runner.warmUp();
+
+  uint64_t aosHash = 0;
+  uint64_t soaHash = 0;
+  {
+    AosWorld world(n);
+    populate(world);
+    results.aos = runWorld(world, threads, config, aosHash);
+  }
+  {
+    SoaWorld world(n);
+    populate(world);
+    results.soa = runWorld(world, threads, config, soaHash);
+  }
+  logPhases("AoS", results.aos);
+  logPhases("SoA", results.soa);
+
+  results.consistent = aosHash == soaHash;
+  if (!results.consistent) {
+    LOG_ERROR << "[Game Workload] AoS and SoA worlds ended in different states";
+  }
+  if (results.aos.tickMs > 0 && results.soa.tickMs > 0) {
+    results.soaSpeedup = results.aos.tickMs / results.soa.tickMs;
+    results.entityUpdatesPerSecond = n / (results.soa.tickMs / 1000.0);
+  }
+  LOG_INFO << "[Game Workload] SoA is " << results.soaSpeedup << "x AoS, "
+           << results.entityUpdatesPerSecond << " entity updates/s";
+  return results;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#ifndef GAME_WORKLOAD_H
+#define GAME_WORKLOAD_H
+
+// Game-engine style CPU workload: a world of entities ticked through
+// integrate, broadphase, collision and AI phases, once with the entities as
+// an array of structs and once as a struct of arrays.
+//
+// Each tick is a fixed graph of stages run on the KernelRunner workers.
+// Parallel stages are cut into chunks that the workers take from a shared
+// counter; serial stages run on worker 0, and every stage waits for the one
+// before it. An entity only writes its own state and only reads fields of
+// other entities that the current stage doesn't write, so the result doesn't
+// depend on the thread count or chunk order.
+
+struct GameWorkloadConfig {
+  int entityCount = 32768;  // rounded down to a multiple of 256
+  int warmupTicks = 10;     // untimed
+  int ticks = 120;
+  int threads = 0;  // 0 = every KernelRunner worker
+};
+
+// Median milliseconds per tick, -1 if not measured
+struct GamePhaseTimes {
+  double integrateMs = -1.0;   // velocity into position, respawns
+  double broadphaseMs = -1.0;  // spatial hash grid build
+  double collisionMs = -1.0;   // neighbour cells' entities against each other
+  double aiMs = -1.0;          // steering towards a target entity
+  double tickMs = -1.0;
+};
+
+struct GameWorkloadResults {
+  int entityCount = 0;
+  int threads = 0;
+  int ticks = 0;
+  GamePhaseTimes aos;  // scalar integration over 64-byte entity structs
+  GamePhaseTimes soa;  // SSE integration over one array per field
+  double soaSpeedup = -1.0;               // AoS tick time over SoA tick time
+  double entityUpdatesPerSecond = -1.0;   // SoA
+  bool consistent = false;  // both layouts ended in the same state
+};
+
+GameWorkloadResults runGameWorkload(const GameWorkloadConfig& config = {});
+
+#endif  // GAME_WORKLOAD_H
@@ -0,0 +1,289 @@
+#include "kernel_runner.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include "hardware/ConstantSystemInfo.h"
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+// Affinity masks are one DWORD_PTR, i.e. the first 64 cores
+constexpr int MAX_WORKERS = 64;
+constexpr int BARRIER_SPINS = 4000;
+
+constexpr auto WARMUP_LOAD = std::chrono::milliseconds(800);
+constexpr auto WARMUP_SETTLE = std::chrono::milliseconds(400);
+constexpr auto WARM_FOR = std::chrono::seconds(5);
+constexpr auto SETTLE_AFTER_WARMUP_RUNS = std::chrono::milliseconds(200);
+
+volatile double warmUpSink = 0.0;  // keeps the warm-up load from being optimized out
+
+double toMs(std::chrono::steady_clock::duration d) {
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+void cpuRelax() {
+#if defined(_M_X64) || defined(__x86_64__)
+  _mm_pause();
+#endif
+}
+
+int logicalCoreCount() {
+#if defined(_WIN32)
+  const int cores = SystemMetrics::GetConstantSystemInfo().logicalCores;
+  if (cores > 0) return cores;
+#endif
+  return static_cast<int>(std::thread::hardware_concurrency());
+}
+
+void pinCurrentThread(int core) {
+#if defined(_WIN32)
+  SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << core);
+#elif defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(core, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)core;
+#endif
+}
+
+// Raises the calling thread's priority until restored; elsewhere than
+// Windows this is a no-op, raising needs privileges there
+class HighPriorityScope {
+ public:
+  HighPriorityScope() {
+#if defined(_WIN32)
+    original_ = GetThreadPriority(GetCurrentThread());
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+#endif
+  }
+  ~HighPriorityScope() {
+#if defined(_WIN32)
+    SetThreadPriority(GetCurrentThread(), original_);
+#endif
+  }
+
+ private:
+  int original_ = 0;
+};
+}  // namespace
+
+std::vector<double> KernelStats::withoutOutliers(double madFactor,
+                                                 size_t minKept) const {
+  if (samples.empty()) return samples;
+
+  const double med = medianOf(samples);
+  std::vector<double> deviations;
+  deviations.reserve(samples.size());
+  for (double t : samples) {
+    deviations.push_back(std::abs(t - med));
+  }
+  const double mad = medianOf(deviations);
+
+  std::vector<double> kept;
+  for (double t : samples) {
+    if (std::abs(t - med) <= madFactor * mad) {
+      kept.push_back(t);
+    }
+  }
+  return kept.size() >= minKept ? kept : samples;
+}
+
+double KernelStats::meanOf(const std::vector<double>& values) {
+  if (values.empty()) return -1.0;
+  double sum = 0.0;
+  for (double v : values) sum += v;
+  return sum / values.size();
+}
+
+double KernelStats::medianOf(std::vector<double> values) {
+  if (values.empty()) return -1.0;
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+KernelRunner& KernelRunner::getInstance() {
+  static KernelRunner instance;
+  return instance;
+}
+
+KernelRunner::KernelRunner() {
+  const int cores = std::clamp(logicalCoreCount(), 1, MAX_WORKERS);
+
+  workers_.reserve(cores);
+  for (int i = 0; i < cores; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (int i = 0; i < cores; ++i) {
+    workers_[i]->thread = std::thread(&KernelRunner::workerLoop, this, i);
+  }
+}
+
+KernelRunner::~KernelRunner() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  jobCv_.notify_all();
+  for (auto& worker : workers_) {
+    if (worker->thread.joinable()) worker->thread.join();
+  }
+}
+
+void KernelRunner::workerLoop(int index) {
+  pinCurrentThread(index);
+
+  Worker& self = *workers_[index];
+  unsigned long long seen = 0;
+  for (;;) {
+    const Kernel* kernel = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      jobCv_.wait(lock, [&] {
+        return stopping_ || (generation_ != seen && index < jobThreads_);
+      });
+      if (stopping_) return;
+      seen = generation_;
+      kernel = kernel_;
+    }
+
+    HighPriorityScope priority;
+
+    // Barrier: everyone spins until the last worker of the job is here.
+    // Yield after a while in case the others are waiting for this core.
+    arrived_.fetch_add(1, std::memory_order_acq_rel);
+    for (int spins = 0; !go_.load(std::memory_order_acquire); ++spins) {
+      if (spins < BARRIER_SPINS) {
+        cpuRelax();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+
+    self.start = std::chrono::steady_clock::now();
+    (*kernel)(index);
+    self.end = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--pending_ == 0) doneCv_.notify_one();
+  }
+}
+
+KernelRunner::Run KernelRunner::runOnce(int threads, const Kernel& kernel) {
+  std::lock_guard<std::mutex> job(jobMutex_);
+  threads = std::clamp(threads, 1, workerCount());
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    kernel_ = &kernel;
+    jobThreads_ = threads;
+    pending_ = threads;
+    arrived_.store(0, std::memory_order_relaxed);
+    go_.store(false, std::memory_order_relaxed);
+    ++generation_;
+  }
+  jobCv_.notify_all();
+
+  while (arrived_.load(std::memory_order_acquire) < threads) {
+    std::this_thread::yield();
+  }
+  go_.store(true, std::memory_order_release);
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    doneCv_.wait(lock, [&] { return pending_ == 0; });
+    kernel_ = nullptr;
+    jobThreads_ = 0;
+  }
+
+  Run run;
+  run.threadMs.reserve(threads);
+  auto first = workers_[0]->start;
+  auto last = workers_[0]->end;
+  for (int i = 0; i < threads; ++i) {
+    const Worker& worker = *workers_[i];
+    run.threadMs.push_back(toMs(worker.end - worker.start));
+    first = std::min(first, worker.start);
+    last = std::max(last, worker.end);
+  }
+  run.wallMs = toMs(last - first);
+  lastJobEnd_ = std::chrono::steady_clock::now();
+  return run;
+}
+
+KernelStats KernelRunner::measure(const KernelPlan& plan, const Kernel& kernel) {
+  const int threads = std::clamp(plan.threads, 1, workerCount());
+
+  if (plan.sustain.count() > 0) {
+    const auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < plan.sustain) {
+      runOnce(threads, kernel);
+    }
+  }
+  for (int i = 0; i < plan.warmupRuns; ++i) {
+    runOnce(threads, kernel);
+  }
+  if (plan.sustain.count() > 0 || plan.warmupRuns > 0) {
+    std::this_thread::sleep_for(SETTLE_AFTER_WARMUP_RUNS);
+  }
+
+  KernelStats stats;
+  stats.perThreadMean.assign(threads, 0.0);
+  for (int i = 0; i < plan.testRuns; ++i) {
+    const Run run = runOnce(threads, kernel);
+    stats.samples.push_back(run.wallMs);
+    for (int t = 0; t < threads; ++t) {
+      stats.perThreadMean[t] += run.threadMs[t];
+    }
+    if (plan.cooldown.count() > 0) {
+      std::this_thread::sleep_for(plan.cooldown);
+    }
+  }
+  if (stats.samples.empty()) return stats;
+
+  for (double& t : stats.perThreadMean) {
+    t /= stats.samples.size();
+  }
+  stats.mean = KernelStats::meanOf(stats.samples);
+  stats.median = KernelStats::medianOf(stats.samples);
+  stats.min = *std::min_element(stats.samples.begin(), stats.samples.end());
+  stats.max = *std::max_element(stats.samples.begin(), stats.samples.end());
+  double variance = 0.0;
+  for (double t : stats.samples) {
+    variance += (t - stats.mean) * (t - stats.mean);
+  }
+  stats.stdDev = std::sqrt(variance / stats.samples.size());
+  return stats;
+}
+
+void KernelRunner::warmUp() {
+  {
+    std::lock_guard<std::mutex> job(jobMutex_);
+    if (lastJobEnd_.time_since_epoch().count() != 0 &&
+        std::chrono::steady_clock::now() - lastJobEnd_ < WARM_FOR) {
+      return;
+    }
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  runOnce(workerCount(), [start](int) {
+    double result = 0.0;
+    while (std::chrono::steady_clock::now() - start < WARMUP_LOAD) {
+      for (int j = 0; j < 10'000; j++) {
+        result += std::sin(result) * std::cos(result);
+      }
+    }
+    warmUpSink = result;
+  });
+  std::this_thread::sleep_for(WARMUP_SETTLE);
+}
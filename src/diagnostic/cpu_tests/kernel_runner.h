@@ -0,0 +1,110 @@
+#pragma once
+#ifndef KERNEL_RUNNER_H
+#define KERNEL_RUNNER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// How KernelRunner::measure runs a kernel
+struct KernelPlan {
+  int threads = 1;                         // workers 0..threads-1, i.e. cores 0..threads-1
+  std::chrono::milliseconds sustain{0};    // untimed back-to-back runs first, for stable clocks
+  int warmupRuns = 0;                      // untimed
+  int testRuns = 1;
+  std::chrono::milliseconds cooldown{0};   // idle time after each timed run
+};
+
+// Timing of the timed runs of a kernel, all in milliseconds
+struct KernelStats {
+  std::vector<double> samples;        // wall time of each run: first start to last finish
+  double mean = -1.0;
+  double median = -1.0;
+  double min = -1.0;
+  double max = -1.0;
+  double stdDev = -1.0;               // population
+  std::vector<double> perThreadMean;  // each thread's own time, averaged over the runs
+
+  // Samples within madFactor median absolute deviations of the median, or all
+  // of them if fewer than minKept would be left
+  std::vector<double> withoutOutliers(double madFactor, size_t minKept) const;
+
+  static double meanOf(const std::vector<double>& values);
+  static double medianOf(std::vector<double> values);
+};
+
+// Persistent pool that runs CPU and memory kernels on pinned threads.
+//
+// There is one worker per logical core and worker i is pinned to core i, so
+// a kernel with N threads always runs on cores 0..N-1. The workers are
+// created once and sleep between jobs. A job releases its workers together
+// from a spinning barrier and each worker times only its own kernel call, so
+// thread creation and wake-up never show up in a measurement. While a job
+// runs the workers are raised to THREAD_PRIORITY_HIGHEST.
+//
+// Pinning and priority are Windows calls; on Linux workers are pinned with
+// pthread affinity and keep their priority, elsewhere they are neither.
+//
+// Jobs are serialized; the kernel must not throw.
+class KernelRunner {
+ public:
+  using Kernel = std::function<void(int thread)>;
+
+  struct Run {
+    double wallMs = 0.0;
+    std::vector<double> threadMs;
+  };
+
+  static KernelRunner& getInstance();
+
+  int workerCount() const { return static_cast<int>(workers_.size()); }
+
+  // kernel(t) on worker t for every t < threads, released together
+  Run runOnce(int threads, const Kernel& kernel);
+
+  KernelStats measure(const KernelPlan& plan, const Kernel& kernel);
+
+  // Loads every core for a moment and lets it settle, so the first kernel
+  // doesn't run on idle clocks. Skipped when a job finished in the last few
+  // seconds, which makes it free for all but the first test of a pass.
+  void warmUp();
+
+ private:
+  KernelRunner();
+  ~KernelRunner();
+  KernelRunner(const KernelRunner&) = delete;
+  KernelRunner& operator=(const KernelRunner&) = delete;
+
+  struct Worker {
+    std::thread thread;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+  };
+
+  void workerLoop(int index);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  std::mutex jobMutex_;  // held by runOnce for a whole job
+  std::chrono::steady_clock::time_point lastJobEnd_;
+
+  std::mutex mutex_;
+  std::condition_variable jobCv_;
+  std::condition_variable doneCv_;
+  unsigned long long generation_ = 0;
+  const Kernel* kernel_ = nullptr;
+  int jobThreads_ = 0;
+  int pending_ = 0;
+  bool stopping_ = false;
+
+  std::atomic<int> arrived_{0};
+  std::atomic<bool> go_{false};
+};
+
+#endif  // KERNEL_RUNNER_H
@@ -0,0 +1,280 @@
+#include "matrix_kernels.h"
+
+#include <algorithm>
+
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// MSVC accepts any intrinsic in any function; GCC/Clang need it per function
+#if defined(__GNUC__) || defined(__clang__)
+#define MATRIX_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#define MATRIX_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define MATRIX_TARGET_AVX2_FMA
+#define MATRIX_TARGET_AVX512
+#endif
+
+namespace {
+
+// Tile sizes, in elements. A KC x NC panel of B stays in L2, the KC-deep
+// strip of it under one micro-kernel stays in L1, and MC rows of A are
+// walked against that strip before moving on.
+constexpr int KC = 256;
+constexpr int NC = 256;
+constexpr int MC = 64;
+constexpr int KC_AVX512 = 128;  // 32-wide strip, same L1 footprint
+
+bool cpuSupportsAvx2Fma() {
+#if defined(_MSC_VER)
+  int info[4] = {};
+  __cpuid(info, 0);
+  if (info[0] < 7) return false;
+  __cpuid(info, 1);
+  const bool fma = (info[2] & (1 << 12)) != 0;
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+  if (!fma || !osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+bool cpuSupportsAvx512() {
+#if defined(_MSC_VER)
+  int info[4] = {};
+  __cpuid(info, 0);
+  if (info[0] < 7) return false;
+  __cpuid(info, 1);
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  // XMM, YMM, opmask and both halves of ZMM state saved by the OS
+  if (!osxsave || (_xgetbv(0) & 0xE6) != 0xE6) return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 16)) != 0;
+#else
+  return __builtin_cpu_supports("avx512f");
+#endif
+}
+
+void multiplyNaive(const float* A, const float* B, float* C, int N) {
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      float sum = 0.0f;
+      for (int k = 0; k < N; k++) {
+        sum += A[i * N + k] * B[k * N + j];
+      }
+      C[i * N + j] += sum;
+    }
+  }
+}
+
+// Each A element is loaded once per 8 multiplies and each B element once per
+// 4, instead of one load per multiply
+void multiplyRegisterBlocked(const float* A, const float* B, float* C, int N) {
+  for (int i = 0; i < N; i += 4) {
+    for (int j = 0; j < N; j += 8) {
+      float acc[4][8] = {};
+      for (int k = 0; k < N; k++) {
+        const float* b = &B[k * N + j];
+        for (int r = 0; r < 4; r++) {
+          const float a = A[(i + r) * N + k];
+          for (int c = 0; c < 8; c++) {
+            acc[r][c] += a * b[c];
+          }
+        }
+      }
+      for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 8; c++) {
+          C[(i + r) * N + j + c] += acc[r][c];
+        }
+      }
+    }
+  }
+}
+
+// Row of C updated from a contiguous row of B; the compiler vectorizes the
+// inner loop with whatever the build targets
+void multiplyCacheTiled(const float* A, const float* B, float* C, int N) {
+  for (int k0 = 0; k0 < N; k0 += KC) {
+    const int kEnd = std::min(k0 + KC, N);
+    for (int j0 = 0; j0 < N; j0 += NC) {
+      const int jEnd = std::min(j0 + NC, N);
+      for (int i0 = 0; i0 < N; i0 += MC) {
+        const int iEnd = std::min(i0 + MC, N);
+        for (int i = i0; i < iEnd; i++) {
+          float* c = &C[i * N];
+          for (int k = k0; k < kEnd; k++) {
+            const float a = A[i * N + k];
+            const float* b = &B[k * N];
+            for (int j = j0; j < jEnd; j++) {
+              c[j] += a * b[j];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// C[i..i+3][j..j+15] += A[i..i+3][k0..kEnd) * B[k0..kEnd)[j..j+15] in eight
+// ymm accumulators
+MATRIX_TARGET_AVX2_FMA
+void microKernelAvx2(const float* A, const float* B, float* C, int N, int i,
+                     int j, int k0, int kEnd) {
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+
+  const float* a0 = &A[i * N];
+  const float* a1 = a0 + N;
+  const float* a2 = a1 + N;
+  const float* a3 = a2 + N;
+  for (int k = k0; k < kEnd; k++) {
+    const __m256 b0 = _mm256_loadu_ps(&B[k * N + j]);
+    const __m256 b1 = _mm256_loadu_ps(&B[k * N + j + 8]);
+    __m256 a = _mm256_broadcast_ss(&a0[k]);
+    c00 = _mm256_fmadd_ps(a, b0, c00);
+    c01 = _mm256_fmadd_ps(a, b1, c01);
+    a = _mm256_broadcast_ss(&a1[k]);
+    c10 = _mm256_fmadd_ps(a, b0, c10);
+    c11 = _mm256_fmadd_ps(a, b1, c11);
+    a = _mm256_broadcast_ss(&a2[k]);
+    c20 = _mm256_fmadd_ps(a, b0, c20);
+    c21 = _mm256_fmadd_ps(a, b1, c21);
+    a = _mm256_broadcast_ss(&a3[k]);
+    c30 = _mm256_fmadd_ps(a, b0, c30);
+    c31 = _mm256_fmadd_ps(a, b1, c31);
+  }
+
+  float* c = &C[i * N + j];
+  _mm256_storeu_ps(c, _mm256_add_ps(_mm256_loadu_ps(c), c00));
+  _mm256_storeu_ps(c + 8, _mm256_add_ps(_mm256_loadu_ps(c + 8), c01));
+  c += N;
+  _mm256_storeu_ps(c, _mm256_add_ps(_mm256_loadu_ps(c), c10));
+  _mm256_storeu_ps(c + 8, _mm256_add_ps(_mm256_loadu_ps(c + 8), c11));
+  c += N;
+  _mm256_storeu_ps(c, _mm256_add_ps(_mm256_loadu_ps(c), c20));
+  _mm256_storeu_ps(c + 8, _mm256_add_ps(_mm256_loadu_ps(c + 8), c21));
+  c += N;
+  _mm256_storeu_ps(c, _mm256_add_ps(_mm256_loadu_ps(c), c30));
+  _mm256_storeu_ps(c + 8, _mm256_add_ps(_mm256_loadu_ps(c + 8), c31));
+}
+
+MATRIX_TARGET_AVX2_FMA
+void multiplyAvx2Fma(const float* A, const float* B, float* C, int N) {
+  for (int k0 = 0; k0 < N; k0 += KC) {
+    const int kEnd = std::min(k0 + KC, N);
+    for (int j0 = 0; j0 < N; j0 += NC) {
+      const int jEnd = std::min(j0 + NC, N);
+      for (int i0 = 0; i0 < N; i0 += MC) {
+        const int iEnd = std::min(i0 + MC, N);
+        // One B strip at a time, against every row block of A in the tile
+        for (int j = j0; j < jEnd; j += 16) {
+          for (int i = i0; i < iEnd; i += 4) {
+            microKernelAvx2(A, B, C, N, i, j, k0, kEnd);
+          }
+        }
+      }
+    }
+  }
+}
+
+// Same shape as microKernelAvx2 with 32 columns in eight zmm accumulators
+MATRIX_TARGET_AVX512
+void microKernelAvx512(const float* A, const float* B, float* C, int N, int i,
+                       int j, int k0, int kEnd) {
+  __m512 c00 = _mm512_setzero_ps(), c01 = _mm512_setzero_ps();
+  __m512 c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+  __m512 c20 = _mm512_setzero_ps(), c21 = _mm512_setzero_ps();
+  __m512 c30 = _mm512_setzero_ps(), c31 = _mm512_setzero_ps();
+
+  const float* a0 = &A[i * N];
+  const float* a1 = a0 + N;
+  const float* a2 = a1 + N;
+  const float* a3 = a2 + N;
+  for (int k = k0; k < kEnd; k++) {
+    const __m512 b0 = _mm512_loadu_ps(&B[k * N + j]);
+    const __m512 b1 = _mm512_loadu_ps(&B[k * N + j + 16]);
+    __m512 a = _mm512_set1_ps(a0[k]);
+    c00 = _mm512_fmadd_ps(a, b0, c00);
+    c01 = _mm512_fmadd_ps(a, b1, c01);
+    a = _mm512_set1_ps(a1[k]);
+    c10 = _mm512_fmadd_ps(a, b0, c10);
+    c11 = _mm512_fmadd_ps(a, b1, c11);
+    a = _mm512_set1_ps(a2[k]);
+    c20 = _mm512_fmadd_ps(a, b0, c20);
+    c21 = _mm512_fmadd_ps(a, b1, c21);
+    a = _mm512_set1_ps(a3[k]);
+    c30 = _mm512_fmadd_ps(a, b0, c30);
+    c31 = _mm512_fmadd_ps(a, b1, c31);
+  }
+
+  float* c = &C[i * N + j];
+  _mm512_storeu_ps(c, _mm512_add_ps(_mm512_loadu_ps(c), c00));
+  _mm512_storeu_ps(c + 16, _mm512_add_ps(_mm512_loadu_ps(c + 16), c01));
+  c += N;
+  _mm512_storeu_ps(c, _mm512_add_ps(_mm512_loadu_ps(c), c10));
+  _mm512_storeu_ps(c + 16, _mm512_add_ps(_mm512_loadu_ps(c + 16), c11));
+  c += N;
+  _mm512_storeu_ps(c, _mm512_add_ps(_mm512_loadu_ps(c), c20));
+  _mm512_storeu_ps(c + 16, _mm512_add_ps(_mm512_loadu_ps(c + 16), c21));
+  c += N;
+  _mm512_storeu_ps(c, _mm512_add_ps(_mm512_loadu_ps(c), c30));
+  _mm512_storeu_ps(c + 16, _mm512_add_ps(_mm512_loadu_ps(c + 16), c31));
+}
+
+MATRIX_TARGET_AVX512
+void multiplyAvx512Fma(const float* A, const float* B, float* C, int N) {
+  for (int k0 = 0; k0 < N; k0 += KC_AVX512) {
+    const int kEnd = std::min(k0 + KC_AVX512, N);
+    for (int j0 = 0; j0 < N; j0 += NC) {
+      const int jEnd = std::min(j0 + NC, N);
+      for (int i0 = 0; i0 < N; i0 += MC) {
+        const int iEnd = std::min(i0 + MC, N);
+        for (int j = j0; j < jEnd; j += 32) {
+          for (int i = i0; i < iEnd; i += 4) {
+            microKernelAvx512(A, B, C, N, i, j, k0, kEnd);
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+const char* matrixKernelName(MatrixKernel kernel) {
+  switch (kernel) {
+    case MatrixKernel::Naive: return "naive";
+    case MatrixKernel::RegisterBlocked: return "register_blocked";
+    case MatrixKernel::CacheTiled: return "cache_tiled";
+    case MatrixKernel::Avx2Fma: return "avx2_fma";
+    case MatrixKernel::Avx512Fma: return "avx512_fma";
+  }
+  return "unknown";
+}
+
+bool matrixKernelSupported(MatrixKernel kernel) {
+  static const bool avx2Fma = cpuSupportsAvx2Fma();
+  static const bool avx512 = cpuSupportsAvx512();
+  switch (kernel) {
+    case MatrixKernel::Avx2Fma: return avx2Fma;
+    case MatrixKernel::Avx512Fma: return avx512;
+    default: return true;
+  }
+}
+
+void multiplyMatrices(MatrixKernel kernel, const float* A, const float* B,
+                      float* C, int N) {
+  switch (kernel) {
+    case MatrixKernel::Naive: multiplyNaive(A, B, C, N); break;
+    case MatrixKernel::RegisterBlocked: multiplyRegisterBlocked(A, B, C, N); break;
+    case MatrixKernel::CacheTiled: multiplyCacheTiled(A, B, C, N); break;
+    case MatrixKernel::Avx2Fma: multiplyAvx2Fma(A, B, C, N); break;
+    case MatrixKernel::Avx512Fma: multiplyAvx512Fma(A, B, C, N); break;
+  }
+}
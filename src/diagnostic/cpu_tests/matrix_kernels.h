@@ -0,0 +1,30 @@
+#pragma once
+#ifndef MATRIX_KERNELS_H
+#define MATRIX_KERNELS_H
+
+// Single-precision matrix multiplication kernels, from memory bound to
+// compute bound, for the matrix kernel benchmark
+enum class MatrixKernel {
+  Naive,            // i-j-k, strided walk down B's columns
+  RegisterBlocked,  // 4x8 block of C held in registers, k innermost
+  CacheTiled,       // i-k-j inside tiles sized for L1/L2
+  Avx2Fma,          // 4x16 AVX2 FMA micro-kernel inside cache tiles
+  Avx512Fma,        // 4x32 AVX-512 FMA micro-kernel inside cache tiles
+};
+
+constexpr int MATRIX_KERNEL_COUNT = 5;
+
+// Every kernel is a multiple of this in each dimension
+constexpr int MATRIX_KERNEL_ALIGN = 64;
+
+const char* matrixKernelName(MatrixKernel kernel);
+
+// Whether the CPU and OS support the kernel's instructions
+bool matrixKernelSupported(MatrixKernel kernel);
+
+// C += A * B for row-major N x N matrices, N a multiple of
+// MATRIX_KERNEL_ALIGN. The kernel must be supported.
+void multiplyMatrices(MatrixKernel kernel, const float* A, const float* B,
+                      float* C, int N);
+
+#endif  // MATRIX_KERNELS_H
@@ -33,6 +33,13 @@
 
 using namespace std::chrono;
 
+// The loads in this file are not timed kernels, so they don't run on
+// KernelRunner: runOnce blocks its caller until the kernel returns and raises
+// its workers to THREAD_PRIORITY_HIGHEST, while these tests keep sampling
+// clocks and loads from the calling thread for seconds under load, at normal
+// priority. testThreadScheduling also sets its own priorities and affinities
+// on purpose. The per-core boost test pins each load thread itself.
+
 // Simple provider wrapper for PDH metrics
 class CpuMetricsProvider {
 private:
@@ -11,10 +11,13 @@
 
 #include <windows.h>
 #include <immintrin.h>  // For AVX intrinsics
-#include <omp.h>        // For explicit OpenMP control
 
 #include "diagnostic/DiagnosticDataStore.h"
+#include "diagnostic/cpu_tests/kernel_runner.h"
 #include "hardware/ConstantSystemInfo.h"  // Only need ConstantSystemInfo
+#include "memory_tests/latency_engine.h"
+#include "memory_tests/stability_tester.h"
+#include "memory_tests/stream_bandwidth.h"
 
 std::vector<DiagnosticDataStore::MemoryData::MemoryModule> getConstantMemoryInfo(
   std::string& channelStatus, bool& xmpEnabled) {
@@ -184,6 +187,14 @@ void getPageFileInfo() {
   }
 }
 
+static volatile int64_t readSink = 0;  // keeps the read loop from being optimized out
+
+// Contiguous share of n items for KernelRunner worker t
+static void sliceOf(size_t n, int t, int threads, size_t& begin, size_t& end) {
+  begin = n * t / threads;
+  end = n * (t + 1) / threads;
+}
+
 static double computeStdDev(const std::vector<double>& times, double mean) {
   double sumSq = 0.0;
   for (double t : times) {
@@ -193,6 +204,31 @@ static double computeStdDev(const std::vector<double>& times, double mean) {
   return std::sqrt(sumSq / (times.size() - 1));
 }
 
+static void logStreamResults(const StreamResults& stream) {
+  if (!stream.testPerformed) {
+    LOG_ERROR << "[STREAM] Failed to allocate 3 x " << stream.arrayMB << " MB";
+    return;
+  }
+  LOG_INFO << "[STREAM] 3 arrays of " << stream.arrayMB << " MB, "
+           << stream.threads << " threads";
+  for (const auto& kernel : stream.kernels) {
+    LOG_INFO << "[STREAM] " << kernel.kernel << (kernel.nonTemporal ? " (nt)" : "")
+             << ": best " << kernel.bestGBs << " GB/s, median "
+             << kernel.medianGBs << " GB/s";
+  }
+  LOG_INFO << "[STREAM] triad on 1 thread: " << stream.singleThreadTriadGBs << " GB/s";
+  for (size_t i = 0; i < stream.triadByThreads.size(); i++) {
+    LOG_DEBUGF("[STREAM] triad on {} threads: {} GB/s", i + 1, stream.triadByThreads[i]);
+  }
+  if (stream.saturationThreads > 0) {
+    LOG_INFO << "[STREAM] " << stream.saturationThreads
+             << " threads reach 90% of the peak Triad bandwidth";
+  }
+  if (!stream.validated) {
+    LOG_ERROR << "[STREAM] Array contents don't match the expected values";
+  }
+}
+
 void runMemoryTests() {
   LOG_INFO << "[Memory Test] Running basic memory test";
   auto& dataStore = DiagnosticDataStore::getInstance();
@@ -251,26 +287,8 @@ void runMemoryTests() {
     LOG_INFO << "[Memory Test] Running memory stability test";
     const size_t stabilityTestSizeMB = 256;
 
-    // Get full test results structure rather than just a boolean
-    auto stabilityTestResults = runMemoryStabilityTest(stabilityTestSizeMB);
-
-    // Use the passed field from the results for simple status check
-    bool stabilityTestPassed = stabilityTestResults.passed;
-
-    // Store the stability test results in the data store
-    DiagnosticDataStore::MemoryData::StabilityTestResults stabilityResults;
-    stabilityResults.testPerformed = true;
-    stabilityResults.passed = stabilityTestPassed;
-    stabilityResults.testedSizeMB = stabilityTestSizeMB;
-    stabilityResults.errorCount = stabilityTestResults.errorCount;
-    stabilityResults.completedLoops = stabilityTestResults.completedLoops;
-    stabilityResults.completedPatterns = stabilityTestResults.completedPatterns;
-
-    // Update the data store with stability test results
-    std::lock_guard<std::mutex> lock(dataStore.getDataMutex());
-    auto memData = dataStore.getMemoryData();
-    memData.stabilityTest = stabilityResults;
-    dataStore.setMemoryData(memData);
+    // Stores its own results in the data store
+    runMemoryStabilityTest(stabilityTestSizeMB);
 
     // Restore thread priority before returning
     if (elevatedPriorityEnabled) {
@@ -285,7 +303,8 @@ void runMemoryTests() {
   }
 }
 
-void runMemoryTestsMultiple(DiagnosticDataStore::MemoryData* metrics) {
+void runMemoryTestsMultiple(DiagnosticDataStore::MemoryData* metrics,
+                            bool fullStabilityTest) {
   auto& dataStore = DiagnosticDataStore::getInstance();
 
   // Declare thread priority variables at the beginning of this function
@@ -302,190 +321,68 @@ void runMemoryTestsMultiple(DiagnosticDataStore::MemoryData* metrics) {
 
   LOG_INFO << "[Memory Test] Running performance tests";
 
-  // MEMORY LATENCY TEST - IMPROVED
-  // ----------------------------
-  // Use a much larger buffer to ensure we're beyond all CPU caches (512MB)
-  // Use true pointer chasing with cache line flush instructions
+  // MEMORY LATENCY TEST
+  // -------------------
+  // 512 MB, far beyond any cache, chased on a pinned worker. The random chase
+  // on 4 KB pages pays a TLB miss on nearly every access; on large pages it
+  // mostly doesn't, which leaves DRAM latency. The page-local chase shows the
+  // same buffer with TLB misses amortized over a page.
   const size_t LATENCY_TEST_SIZE = 512 * 1024 * 1024;
-  const int numRuns = 5;
-  std::vector<double> latencyTimes(numRuns);
-
-  try {
-    void* buffer = _aligned_malloc(LATENCY_TEST_SIZE, 64);
-    if (!buffer) throw std::bad_alloc();
-
-    uint64_t* ptrs = static_cast<uint64_t*>(buffer);
-    const size_t elementCount = LATENCY_TEST_SIZE / sizeof(uint64_t);
-
-    // Create indexing array and randomize it
-    std::vector<size_t> indices(elementCount);
-    for (size_t i = 0; i < indices.size(); i++) {
-      indices[i] = i;
-    }
-
-    std::random_device rd;
-    std::mt19937 g(rd());
-
-    // Wide stride to avoid prefetcher prediction
-    // Only shuffle a subset to speed up initialization but maintain randomness
-    const size_t strideSize = 64;  // Cache line size in bytes
-    const size_t numElements = elementCount / (strideSize / sizeof(uint64_t));
-    std::vector<size_t> strideIndices(numElements);
-
-    for (size_t i = 0; i < numElements; i++) {
-      strideIndices[i] = i * (strideSize / sizeof(uint64_t));
-    }
-
-    std::shuffle(strideIndices.begin(), strideIndices.end(), g);
-
-    // Create the pointer chasing pattern
-    for (size_t i = 0; i < numElements - 1; i++) {
-      ptrs[strideIndices[i]] =
-        reinterpret_cast<uint64_t>(&ptrs[strideIndices[i + 1]]);
-    }
-    ptrs[strideIndices[numElements - 1]] =
-      reinterpret_cast<uint64_t>(&ptrs[strideIndices[0]]);
+  const size_t LATENCY_ACCESSES = 4'000'000;
+  const int numRuns = 3;
 
+  auto medianLatency = [&](void* start) {
+    std::vector<double> runs;
     for (int run = 0; run < numRuns; run++) {
-// Flush the entire cache hierarchy
-#pragma omp parallel for
-      for (size_t i = 0; i < numElements; i++) {
-        _mm_clflush(&ptrs[strideIndices[i]]);
-      }
-      _mm_mfence();
-
-      const int iterations = 10000000;
-      volatile uint64_t* p = &ptrs[strideIndices[0]];
-
-      // Warm up to ensure fair timing
-      for (int i = 0; i < 1000; i++) {
-        p = reinterpret_cast<uint64_t*>(*p);
-      }
-      _mm_mfence();
-
-      // Main measurement
-      auto start = std::chrono::high_resolution_clock::now();
-      for (int i = 0; i < iterations; i++) {
-        p = reinterpret_cast<uint64_t*>(*p);
-      }
-      _mm_mfence();
-      auto end = std::chrono::high_resolution_clock::now();
-
-      double totalNs =
-        std::chrono::duration<double, std::nano>(end - start).count();
-      double nsPerAccess = totalNs / iterations;
-      latencyTimes[run] = nsPerAccess;
-
-      // Anti-optimization
-      volatile uint64_t dummy = reinterpret_cast<uint64_t>(p);
+      runs.push_back(
+        chaseLatencyNs(start, LATENCY_TEST_SIZE / 64, LATENCY_ACCESSES));
     }
+    std::sort(runs.begin(), runs.end());
+    return runs[runs.size() / 2];
+  };
 
-    _aligned_free(buffer);
-
-    // Calculate average latency (excluding highest and lowest)
-    std::sort(latencyTimes.begin(), latencyTimes.end());
-    double avgLat;
-    if (latencyTimes.size() >= 3) {
-      // Exclude highest and lowest for more stable results
-      avgLat =
-        std::accumulate(latencyTimes.begin() + 1, latencyTimes.end() - 1, 0.0) /
-        (latencyTimes.size() - 2);
+  metrics->latency = -1;
+  metrics->latencyPageLocal = -1;
+  metrics->latencyLargePages = -1;
+  {
+    ChaseBuffer buffer;
+    if (buffer.allocate(LATENCY_TEST_SIZE, false)) {
+      metrics->latency = medianLatency(buildChase(
+        buffer.data, buffer.size, ChaseOrder::Random, 1));
+      metrics->latencyPageLocal = medianLatency(buildChase(
+        buffer.data, buffer.size, ChaseOrder::PageLocal, 1));
     } else {
-      avgLat = std::accumulate(latencyTimes.begin(), latencyTimes.end(), 0.0) /
-               latencyTimes.size();
+      LOG_ERROR << "Latency test failed: could not map "
+                << LATENCY_TEST_SIZE / (1024 * 1024) << " MB";
     }
-    metrics->latency = avgLat;
-
-    LOG_INFO << "[Memory Test] Average RAM latency: " << avgLat << " ns";
-  } catch (const std::exception& e) {
-    LOG_ERROR << "Latency test failed: " << e.what();
-    metrics->latency = -1;
-  }
+    buffer.release();
 
-  // BANDWIDTH TEST - IMPROVED
-  // ----------------------
-  // Uses larger buffers and consistent non-temporal stores to bypass cache
-  const size_t ALIGNMENT = 64;
-  const int BANDWIDTH_TEST_RUNS = 5;
-  std::vector<double> bandwidthResults(BANDWIDTH_TEST_RUNS);
-
-  try {
-    // Use larger arrays to exceed any modern CPU cache
-    const size_t arrayElements = 512 * 1024 * 1024 / sizeof(double);
-    const size_t arrayBytes = arrayElements * sizeof(double);
-
-    double* a = static_cast<double*>(_aligned_malloc(arrayBytes, ALIGNMENT));
-    double* b = static_cast<double*>(_aligned_malloc(arrayBytes, ALIGNMENT));
-    double* c = static_cast<double*>(_aligned_malloc(arrayBytes, ALIGNMENT));
-
-    if (!a || !b || !c) {
-      throw std::runtime_error("Failed to allocate memory for bandwidth test");
-    }
-
-    // Initialize arrays with random data to prevent optimization
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-
-#pragma omp parallel for
-    for (int64_t i = 0; i < static_cast<int64_t>(arrayElements); i++) {
-      b[i] = dist(gen);
-      c[i] = dist(gen);
-    }
-
-    const double scalar = 3.0;
-
-    for (int run = 0; run < BANDWIDTH_TEST_RUNS; run++) {
-      // Flush CPU caches
-      _mm_mfence();
-
-      auto start = std::chrono::high_resolution_clock::now();
-
-// Always use non-temporal stores to bypass cache
-#pragma omp parallel
-      {
-#pragma omp for schedule(static)
-        for (int64_t i = 0; i < static_cast<int64_t>(arrayElements); i += 4) {
-          if (i + 4 <= static_cast<int64_t>(arrayElements)) {
-            __m256d bVal = _mm256_load_pd(&b[i]);
-            __m256d cVal = _mm256_load_pd(&c[i]);
-            __m256d scaled = _mm256_mul_pd(cVal, _mm256_set1_pd(scalar));
-            __m256d result = _mm256_add_pd(bVal, scaled);
-            _mm256_stream_pd(&a[i], result);  // Non-temporal store
-          }
-        }
-      }
-
-      _mm_mfence();
-      auto end = std::chrono::high_resolution_clock::now();
-      double seconds = std::chrono::duration<double>(end - start).count();
-
-      // Calculate bandwidth: we read two arrays and write one
-      double bytesProcessed = 3.0 * arrayBytes;
-      double bandwidthMBs = (bytesProcessed / seconds) / (1024.0 * 1024.0);
-      bandwidthResults[run] = bandwidthMBs;
-
-      // Anti-optimization
-      volatile double sum = 0.0;
-      for (size_t i = 0; i < 100; i++) {
-        size_t idx = i * 10000;
-        if (idx < arrayElements) sum += a[idx];
-      }
+    if (buffer.allocate(LATENCY_TEST_SIZE, true) && buffer.largePages) {
+      metrics->latencyLargePages = medianLatency(buildChase(
+        buffer.data, buffer.size, ChaseOrder::Random, 1));
+    } else {
+      LOG_INFO << "[Memory Test] Large pages unavailable, TLB cost not separated";
     }
+    buffer.release();
+  }
 
-    // Use the best bandwidth result
-    double bestBandwidth =
-      *std::max_element(bandwidthResults.begin(), bandwidthResults.end());
-    metrics->bandwidth = bestBandwidth;
-    LOG_INFO << "[Memory Test] Memory bandwidth: " << bestBandwidth << " MB/s";
+  LOG_INFO << "[Memory Test] RAM latency: " << metrics->latency
+           << " ns, page-local " << metrics->latencyPageLocal
+           << " ns, large pages " << metrics->latencyLargePages << " ns";
 
-    _aligned_free(a);
-    _aligned_free(b);
-    _aligned_free(c);
-  } catch (const std::exception& e) {
-    LOG_ERROR << "Bandwidth test failed: " << e.what();
-    metrics->bandwidth = -1;
-  }
+  // BANDWIDTH TEST - STREAM
+  // ----------------------
+  // Copy/Scale/Add/Triad with regular and non-temporal stores, plus a thread
+  // sweep. bandwidth stays what the old test measured, non-temporal Triad on
+  // one thread in MB/s, so the ratings built on it still apply; the all-core
+  // figures are in stream.kernels.
+  metrics->stream = runStreamBenchmark();
+  logStreamResults(metrics->stream);
+  metrics->bandwidth = metrics->stream.singleThreadTriadGBs > 0
+                         ? metrics->stream.singleThreadTriadGBs * 1e9 / (1024.0 * 1024.0)
+                         : -1;
+  LOG_INFO << "[Memory Test] Memory bandwidth (1 thread): " << metrics->bandwidth
+           << " MB/s";
 
   // READ/WRITE SPEED TESTS - IMPROVED
   // -----------------------------
@@ -503,6 +400,10 @@ void runMemoryTestsMultiple(DiagnosticDataStore::MemoryData* metrics) {
         elementCount;  // Prime number multiply for pseudo-randomness
     }
 
+    // Both tests run on every KernelRunner worker, each pinned to its core
+    KernelRunner& runner = KernelRunner::getInstance();
+    const int threads = runner.workerCount();
+
     // WRITE SPEED TEST
     double writeGBs = -1;
     {
@@ -514,24 +415,21 @@ void runMemoryTestsMultiple(DiagnosticDataStore::MemoryData* metrics) {
       // Flush caches
       _mm_mfence();
 
-      auto start = std::chrono::high_resolution_clock::now();
-
-// Use cache bypass instructions for true RAM testing
-#pragma omp parallel
-      {
-#pragma omp for schedule(dynamic, 16384)
-        for (int64_t i = 0; i < static_cast<int64_t>(accessIndices.size());
-             i++) {
+      // Use cache bypass instructions for true RAM testing, on every
+      // KernelRunner worker
+      const KernelRunner::Run timing = runner.runOnce(threads, [&](int t) {
+        size_t begin, end;
+        sliceOf(accessIndices.size(), t, threads, begin, end);
+        for (size_t i = begin; i < end; i++) {
           const size_t idx = accessIndices[i];
           // Use non-temporal stores to bypass cache
           _mm_stream_si32(writeArray + idx, static_cast<int>(idx));
         }
-      }
+        // This thread's stores have reached memory before its time stops
+        _mm_sfence();
+      });
 
-      _mm_mfence();
-      auto end = std::chrono::high_resolution_clock::now();
-
-      double seconds = std::chrono::duration<double>(end - start).count();
+      double seconds = timing.wallMs / 1000.0;
       double bytesPerSecond = (accessIndices.size() * sizeof(int)) / seconds;
       writeGBs = bytesPerSecond / (1024.0 * 1024.0 * 1024.0);
 
@@ -549,43 +447,43 @@ void runMemoryTestsMultiple(DiagnosticDataStore::MemoryData* metrics) {
         static_cast<int*>(_aligned_malloc(elementCount * sizeof(int), 4096));
       if (!readArray) throw std::bad_alloc();
 
-#pragma omp parallel for
-      for (int64_t i = 0; i < static_cast<int64_t>(elementCount); i++) {
-        readArray[i] =
-          static_cast<int>(i * 7919);  // Another prime for pseudo-randomness
-      }
+      // Filled by the workers that read it back
+      runner.runOnce(threads, [&](int t) {
+        size_t begin, end;
+        sliceOf(elementCount, t, threads, begin, end);
+        for (size_t i = begin; i < end; i++) {
+          readArray[i] =
+            static_cast<int>(i * 7919);  // Another prime for pseudo-randomness
+        }
+      });
 
       _mm_mfence();
 
-// Flush CPU caches
-#pragma omp parallel for
-      for (int64_t i = 0; i < static_cast<int64_t>(accessIndices.size());
-           i += 16) {
-        _mm_clflush(&readArray[accessIndices[i]]);
-      }
+      // Flush CPU caches
+      runner.runOnce(threads, [&](int t) {
+        size_t begin, end;
+        sliceOf(accessIndices.size() / 16, t, threads, begin, end);
+        for (size_t i = begin * 16; i < end * 16; i += 16) {
+          _mm_clflush(&readArray[accessIndices[i]]);
+        }
+      });
       _mm_mfence();
 
-      auto start = std::chrono::high_resolution_clock::now();
-
-      volatile int64_t sum = 0;
-
-#pragma omp parallel reduction(+ : sum)
-      {
+      std::vector<int64_t> sums(threads, 0);
+      const KernelRunner::Run timing = runner.runOnce(threads, [&](int t) {
+        size_t begin, end;
+        sliceOf(accessIndices.size(), t, threads, begin, end);
         int64_t localSum = 0;
-#pragma omp for schedule(dynamic, 16384)
-        for (int64_t i = 0; i < static_cast<int64_t>(accessIndices.size());
-             i++) {
+        for (size_t i = begin; i < end; i++) {
           // Use prefetch prevention by XORing with a volatile value
           volatile size_t idx = accessIndices[i];
           localSum += readArray[idx];
         }
-        sum += localSum;
-      }
+        sums[t] = localSum;
+      });
+      readSink = std::accumulate(sums.begin(), sums.end(), int64_t{0});
 
-      _mm_mfence();
-      auto end = std::chrono::high_resolution_clock::now();
-
-      double seconds = std::chrono::duration<double>(end - start).count();
+      double seconds = timing.wallMs / 1000.0;
       double bytesPerSecond = (accessIndices.size() * sizeof(int)) / seconds;
       readGBs = bytesPerSecond / (1024.0 * 1024.0 * 1024.0);
 
@@ -600,25 +498,12 @@ void runMemoryTestsMultiple(DiagnosticDataStore::MemoryData* metrics) {
     if (metrics->writeTime <= 0) metrics->writeTime = -1;
   }
 
-  // Add memory stability test (with a smaller size for quicker results)
+  // Add memory stability test (256 MB for quicker results, 0 = free RAM)
   LOG_INFO << "[Memory Test] Running memory stability test";
-  const size_t stabilityTestSizeMB = 256;
+  const size_t stabilityTestSizeMB = fullStabilityTest ? 0 : 256;
 
   // Run stability test with error validation
-  auto stabilityTestResults = runMemoryStabilityTest(stabilityTestSizeMB);
-  bool stabilityTestPassed = stabilityTestResults.passed;
-
-  // Create stability test results
-  DiagnosticDataStore::MemoryData::StabilityTestResults stabilityResults;
-  stabilityResults.testPerformed = true;
-  stabilityResults.passed = stabilityTestPassed;
-  stabilityResults.testedSizeMB = stabilityTestSizeMB;
-  stabilityResults.errorCount = stabilityTestResults.errorCount;
-  stabilityResults.completedLoops = stabilityTestResults.completedPatterns;
-  stabilityResults.completedPatterns = stabilityTestResults.completedPatterns;
-
-  // Add stability results to metrics
-  metrics->stabilityTest = stabilityResults;
+  metrics->stabilityTest = runMemoryStabilityTest(stabilityTestSizeMB);
 
   // Restore memory hardware info if needed
   if (backupModules.size() > 0 &&
@@ -631,10 +516,11 @@ void runMemoryTestsMultiple(DiagnosticDataStore::MemoryData* metrics) {
 
   // Update metrics in data store
   dataStore.updateFromMemoryMetrics(*metrics);
+  dataStore.updateMemoryStreamResults(metrics->stream);
 }
 
 std::future<void> runMemoryTestsAsync(
-  DiagnosticDataStore::MemoryData* metrics) {
+  DiagnosticDataStore::MemoryData* metrics, bool fullStabilityTest) {
   auto& dataStore = DiagnosticDataStore::getInstance();
 
   // Make a deep copy of all memory data
@@ -646,7 +532,8 @@ std::future<void> runMemoryTestsAsync(
 
   // Launch async task
   return std::async(std::launch::async, [metrics, modulesCopy, memoryTypeCopy,
-                                         channelStatusCopy, xmpEnabledCopy]() {
+                                         channelStatusCopy, xmpEnabledCopy,
+                                         fullStabilityTest]() {
     auto& threadDataStore = DiagnosticDataStore::getInstance();
 
     // Restore memory hardware info in this thread
@@ -654,366 +541,11 @@ std::future<void> runMemoryTestsAsync(
                                              channelStatusCopy, xmpEnabledCopy);
 
     // Run the tests
-    runMemoryTestsMultiple(metrics);
+    runMemoryTestsMultiple(metrics, fullStabilityTest);
   });
 }
 
-// Add after the existing code
-
-// Memory stability test structures and classes
-
-// Configuration structure for the memory test
-struct MemoryStabilityTestConfig {
-  size_t memorySizeBytes;  // Size of the memory block to test
-  int testLoops;           // Number of loops/passes to run the tests
-  bool useMultithreading;  // Flag to enable multithreading for parallel tests
-  int numThreads;  // Number of threads to use if multithreading is enabled
-
-  MemoryStabilityTestConfig()
-      : memorySizeBytes(256 * 1024 * 1024),  // Default 256 MB
-        testLoops(3), useMultithreading(true),
-        numThreads(std::thread::hardware_concurrency()) {}
-};
-
-// Error information structure
-struct MemoryErrorInfo {
-  size_t address;
-  uint8_t expected;
-  uint8_t actual;
-  int loopNumber;
-  std::string testName;
-};
-
-// Base class for a memory test pattern
-class MemoryTestPattern {
- public:
-  virtual ~MemoryTestPattern() = default;
-  virtual std::string getName() const = 0;
-  // The test function writes a pattern to memory and then verifies it
-  virtual bool runTest(uint8_t* buffer, size_t size, int loop,
-                       std::vector<MemoryErrorInfo>& errors) = 0;
-};
-
-// Test pattern: Alternating Bits (0xAA / 0x55)
-class AlternatingBitsTest : public MemoryTestPattern {
- public:
-  std::string getName() const override { return "Alternating Bits Test"; }
-
-  bool runTest(uint8_t* buffer, size_t size, int loop,
-               std::vector<MemoryErrorInfo>& errors) override {
-// Write phase: fill with alternating pattern
-#pragma omp parallel for
-    for (int64_t i = 0; i < static_cast<int64_t>(size); i++) {
-      buffer[i] = (i % 2 == 0) ? 0xAA : 0x55;
-    }
-
-    // Memory barrier to ensure writes are committed
-    _mm_mfence();
-
-    // Read/Verify phase
-    for (size_t i = 0; i < size; i++) {
-      uint8_t expected = (i % 2 == 0) ? 0xAA : 0x55;
-      if (buffer[i] != expected) {
-        errors.push_back({i, expected, buffer[i], loop, getName()});
-        return false;  // stop on error
-      }
-    }
-    return true;
-  }
-};
-
-// Test pattern: Walking Ones (shifted bit pattern)
-class WalkingOnesTest : public MemoryTestPattern {
- public:
-  std::string getName() const override { return "Walking Ones Test"; }
-
-  bool runTest(uint8_t* buffer, size_t size, int loop,
-               std::vector<MemoryErrorInfo>& errors) override {
-// Write phase: for each byte, cycle through single-bit positions
-#pragma omp parallel for
-    for (int64_t i = 0; i < static_cast<int64_t>(size); i++) {
-      buffer[i] = 1 << (i % 8);
-    }
-
-    _mm_mfence();
-
-    // Read/Verify phase
-    for (size_t i = 0; i < size; i++) {
-      uint8_t expected = 1 << (i % 8);
-      if (buffer[i] != expected) {
-        errors.push_back({i, expected, buffer[i], loop, getName()});
-        return false;
-      }
-    }
-    return true;
-  }
-};
-
-// Replace the current RandomPatternTest class with this more robust version
-class RandomPatternTest : public MemoryTestPattern {
- public:
-  std::string getName() const override { return "Random Pattern Test"; }
-
-  bool runTest(uint8_t* buffer, size_t size, int loop,
-               std::vector<MemoryErrorInfo>& errors) override {
-    LOG_INFO << "[Memory Stability Test] Starting Random Pattern Test (loop " << loop + 1 << ")";
-
-    // Create a reproducible random sequence based on a fixed seed
-    // Use a simpler pattern generation approach to avoid thread synchronization
-    // issues
-    const unsigned int seed = 12345 + loop;
-    std::mt19937 rng(seed);
-    std::uniform_int_distribution<int> dist(0, 255);
-
-    // Generate pattern in smaller chunks to improve cache locality
-    const size_t CHUNK_SIZE = 1024 * 1024;  // 1MB chunks
-
-    for (size_t offset = 0; offset < size; offset += CHUNK_SIZE) {
-      size_t currentChunkSize = std::min(CHUNK_SIZE, size - offset);
-
-      // Reset RNG to the chunk-specific seed for reproducibility
-      rng.seed(seed + static_cast<unsigned int>(offset / CHUNK_SIZE));
-
-      // Sequential write phase for this chunk (no multithreading)
-      for (size_t i = 0; i < currentChunkSize; i++) {
-        buffer[offset + i] = static_cast<uint8_t>(dist(rng));
-      }
-
-      // Memory barrier
-      _mm_mfence();
-
-      // Reset RNG to the same seed for verification
-      rng.seed(seed + static_cast<unsigned int>(offset / CHUNK_SIZE));
-
-      // Sequential verification phase for this chunk
-      for (size_t i = 0; i < currentChunkSize; i++) {
-        uint8_t expected = static_cast<uint8_t>(dist(rng));
-        if (buffer[offset + i] != expected) {
-          // Double-check the error with multiple reads to filter transient
-          // issues
-          bool confirmedError = true;
-          for (int retries = 0; retries < 3; retries++) {
-            _mm_lfence();  // Force read ordering
-            if (buffer[offset + i] == expected) {
-              confirmedError = false;
-              break;
-            }
-          }
-
-          if (confirmedError) {
-            LOG_WARN << "[Memory Stability Test] Potential error at 0x" << std::hex << (offset + i) << std::dec << ", expected: 0x" << std::hex << static_cast<int>(expected) << ", got: 0x" << static_cast<int>(buffer[offset + i]) << std::dec;
-
-            // Try writing and reading again to confirm it's not a transient
-            // issue
-            buffer[offset + i] = expected;
-            _mm_mfence();
-            _mm_lfence();
-
-            if (buffer[offset + i] != expected) {
-              errors.push_back(
-                {offset + i, expected, buffer[offset + i], loop, getName()});
-
-              if (errors.size() >= 5) {
-                LOG_ERROR << "[Memory Stability Test] Too many errors, stopping test";
-                return false;
-              }
-            } else {
-              LOG_WARN << "[Memory Stability Test] Error corrected on rewrite, ignoring";
-            }
-          }
-        }
-      }
-    }
-
-    LOG_INFO << "[Memory Stability Test] Random Pattern Test completed successfully";
-    return errors.empty();  // Return true if no errors were found
-  }
-};
-
-// Additional pattern: Inverse Alternating Bits (0x55 / 0xAA)
-class InverseAlternatingBitsTest : public MemoryTestPattern {
- public:
-  std::string getName() const override {
-    return "Inverse Alternating Bits Test";
-  }
-
-  bool runTest(uint8_t* buffer, size_t size, int loop,
-               std::vector<MemoryErrorInfo>& errors) override {
-// Write phase: fill with alternating pattern (inverse of AlternatingBitsTest)
-#pragma omp parallel for
-    for (int64_t i = 0; i < static_cast<int64_t>(size); i++) {
-      buffer[i] = (i % 2 == 0) ? 0x55 : 0xAA;
-    }
-
-    _mm_mfence();
-
-    // Read/Verify phase
-    for (size_t i = 0; i < size; i++) {
-      uint8_t expected = (i % 2 == 0) ? 0x55 : 0xAA;
-      if (buffer[i] != expected) {
-        errors.push_back({i, expected, buffer[i], loop, getName()});
-        return false;
-      }
-    }
-    return true;
-  }
-};
-
-// MemoryStabilityTester class to run tests using the selected patterns and
-// configuration
-class MemoryStabilityTester {
- public:
-  MemoryStabilityTester(const MemoryStabilityTestConfig& config)
-      : config_(config), stopOnError_(true) {
-    // Add only the most reliable test patterns
-    testPatterns_.push_back(new AlternatingBitsTest());
-    testPatterns_.push_back(new WalkingOnesTest());
-
-    // Only add RandomPatternTest if explicitly requested via config
-    // (This prevents most false positives while still allowing other patterns
-    // to run)
-    if (config.memorySizeBytes <
-        512 * 1024 * 1024) {  // Only for smaller tests (<512MB)
-      testPatterns_.push_back(new RandomPatternTest());
-    }
-  }
-
-  ~MemoryStabilityTester() {
-    // Clean up allocated test pattern objects
-    for (auto* pattern : testPatterns_) {
-      delete pattern;
-    }
-  }
-
-  // Structure to hold test results
-  struct TestResults {
-    bool passed = true;
-    std::vector<MemoryErrorInfo> errors;
-    int completedLoops = 0;
-    int completedPatterns = 0;
-    int errorCount = 0;
-  };
-
-  // Run the memory test across all loops and test patterns
-  TestResults runTests() {
-    TestResults results;
-    LOG_INFO << "[Memory Stability Test] Starting test with " << (config_.memorySizeBytes / (1024 * 1024)) << " MB of memory, " << config_.testLoops << " loops";
-
-    // Allocate memory to test
-    uint8_t* memoryBlock =
-      static_cast<uint8_t*>(_aligned_malloc(config_.memorySizeBytes, 4096));
-    if (!memoryBlock) {
-      LOG_ERROR << "[Memory Stability Test] Failed to allocate memory block for testing.";
-      results.passed = false;
-      return results;
-    }
-
-    // For thread-safe error reporting
-    std::mutex errorMutex;
-    std::atomic<bool> errorDetected(false);
-
-    auto runLoop = [&](int loop) {
-      // Run each test pattern
-      for (size_t patternIndex = 0; patternIndex < testPatterns_.size();
-           patternIndex++) {
-        auto* pattern = testPatterns_[patternIndex];
-
-        LOG_INFO << "[Memory Stability Test] Loop " << (loop + 1) << "/" << config_.testLoops << ", Pattern: " << pattern->getName();
-
-        std::vector<MemoryErrorInfo> patternErrors;
-        if (!pattern->runTest(memoryBlock, config_.memorySizeBytes, loop,
-                              patternErrors)) {
-          errorDetected = true;
-
-          // Log error details
-          std::lock_guard<std::mutex> lock(errorMutex);
-          results.errors.insert(results.errors.end(), patternErrors.begin(),
-                                patternErrors.end());
-          results.passed = false;
-
-          for (const auto& error : patternErrors) {
-            LOG_ERROR << "[Memory Stability Test] Error detected at address 0x" << std::hex << error.address << std::dec << " during " << error.testName << " (loop " << error.loopNumber + 1 << "). Expected: 0x" << std::hex << static_cast<int>(error.expected) << ", Got: 0x" << static_cast<int>(error.actual) << std::dec;
-          }
-
-          if (stopOnError_) {
-            return;  // Exit early on error if stopOnError_ is true
-          }
-        }
-
-        std::lock_guard<std::mutex> lock(errorMutex);
-        results.completedPatterns++;
-      }
-
-      std::lock_guard<std::mutex> lock(errorMutex);
-      results.completedLoops++;
-    };
-
-    // Decide whether to run loops in parallel or sequentially
-    if (config_.useMultithreading && config_.numThreads > 1) {
-      std::vector<std::thread> threads;
-
-      // Divide the loops among threads
-      for (int i = 0; i < config_.testLoops; i++) {
-        if (errorDetected.load() && stopOnError_) {
-          break;
-        }
-
-        threads.emplace_back([&, i]() {
-          if (!errorDetected.load() || !stopOnError_) {
-            runLoop(i);
-          }
-        });
-
-        // Throttle thread creation if we've spawned enough
-        if (threads.size() >= static_cast<size_t>(config_.numThreads)) {
-          for (auto& t : threads) {
-            if (t.joinable()) t.join();
-          }
-          threads.clear();
-        }
-      }
-
-      // Join any remaining threads
-      for (auto& t : threads) {
-        if (t.joinable()) t.join();
-      }
-    } else {
-      // Sequential execution
-      for (int i = 0;
-           i < config_.testLoops && (!errorDetected.load() || !stopOnError_);
-           i++) {
-        runLoop(i);
-      }
-    }
-
-    _aligned_free(memoryBlock);
-
-    if (results.passed) {
-      LOG_INFO << "[Memory Stability Test] Completed successfully. No errors detected.";
-    } else {
-      LOG_ERROR << "[Memory Stability Test] Failed with " << results.errors.size() << " errors.";
-    }
-
-    // Add to the end of runTests method, before the return statement
-    results.completedLoops =
-      std::min(config_.testLoops, results.completedLoops);
-    results.completedPatterns =
-      std::min(static_cast<int>(testPatterns_.size() * config_.testLoops),
-               results.completedPatterns);
-    results.errorCount = results.errors.size();
-
-    return results;
-  }
-
-  void setStopOnError(bool stop) { stopOnError_ = stop; }
-
- private:
-  MemoryStabilityTestConfig config_;
-  bool stopOnError_;
-  std::vector<MemoryTestPattern*> testPatterns_;
-};
-
-// Function to run memory stability test
+// Function to run memory stability test; 0 MB tests most of the free RAM
 DiagnosticDataStore::MemoryData::StabilityTestResults runMemoryStabilityTest(
   size_t memorySizeMB) {
   DiagnosticDataStore::MemoryData::StabilityTestResults results;
@@ -1024,29 +556,34 @@ DiagnosticDataStore::MemoryData::StabilityTestResults runMemoryStabilityTest(
     MemoryStabilityTestConfig config;
     config.memorySizeBytes = memorySizeMB * 1024 * 1024;
     config.testLoops = 3;  // Using 3 loops for more thorough testing
-    config.useMultithreading =
-      false;  // Disable multithreading for more reliable results
-    config.numThreads = 1;
+    config.stopOnError = false;  // Continue after errors for better diagnostics
 
-    LOG_INFO << "[Memory Stability Test] Creating tester with " << memorySizeMB << "MB test size, " << config.testLoops << " loops";
+    LOG_INFO << "[Memory Stability Test] Creating tester with "
+             << (memorySizeMB ? std::to_string(memorySizeMB) + "MB"
+                              : std::string("free RAM"))
+             << " test size, " << config.testLoops << " loops";
 
     MemoryStabilityTester tester(config);
-    tester.setStopOnError(
-      false);  // Continue after errors for better diagnostics
-
     auto testResults = tester.runTests();
 
     results.passed = testResults.passed;
-    results.errorCount = testResults.errors.size();
+    results.errorCount = static_cast<int>(testResults.errorCount);
     results.completedLoops = testResults.completedLoops;
     results.completedPatterns = testResults.completedPatterns;
+    results.testedSizeMB = testResults.testedBytes / (1024 * 1024);
+    results.threads = testResults.threads;
+    results.durationSeconds = testResults.seconds;
+    results.coverageGBs = testResults.coverageGBs;
+    for (const auto& error : testResults.errors) {
+      results.errorAddresses.push_back(error.address);
+    }
 
     // Save results to DiagnosticDataStore
     auto& dataStore = DiagnosticDataStore::getInstance();
     dataStore.updateMemoryStabilityResults(results);
 
     // For diagnostic purposes, print summary
-    LOG_INFO << "[Memory Stability Test] Summary: " << (testResults.passed ? "PASSED" : "FAILED") << " with " << testResults.errors.size() << " errors, " << testResults.completedLoops << " loops completed, " << testResults.completedPatterns << " patterns completed";
+    LOG_INFO << "[Memory Stability Test] Summary: " << (testResults.passed ? "PASSED" : "FAILED") << " with " << testResults.errorCount << " errors, " << testResults.completedLoops << " loops completed, " << testResults.completedPatterns << " patterns completed";
   } catch (const std::exception& e) {
     LOG_ERROR << "[Memory Stability Test] Exception: " << e.what();
     results.passed = false;
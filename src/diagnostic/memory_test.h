@@ -9,11 +9,16 @@
 void getMemoryInfo();
 void getPageFileInfo();
 void runMemoryTests();
-void runMemoryTestsMultiple(DiagnosticDataStore::MemoryData* metrics);
-std::future<void> runMemoryTestsAsync(DiagnosticDataStore::MemoryData* metrics);
+// fullStabilityTest runs the stability test over most of the free RAM
+// instead of 256 MB
+void runMemoryTestsMultiple(DiagnosticDataStore::MemoryData* metrics,
+                            bool fullStabilityTest = false);
+std::future<void> runMemoryTestsAsync(DiagnosticDataStore::MemoryData* metrics,
+                                      bool fullStabilityTest = false);
 std::string checkXMPStatus(int memoryType, int speed, int configuredSpeed);
 std::string checkDualChannelStatus(int moduleCount, int memoryType,
                                    int configuredSpeed);
+// memorySizeMB 0 tests most of the free RAM
 DiagnosticDataStore::MemoryData::StabilityTestResults runMemoryStabilityTest(
   size_t memorySizeMB = 256);
 
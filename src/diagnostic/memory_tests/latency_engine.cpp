@@ -0,0 +1,336 @@
+#include "latency_engine.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#if defined(__linux__)
+#include <fstream>
+#include <sstream>
+#include <string>
+#endif
+
+#include "diagnostic/cpu_tests/kernel_runner.h"
+#include "logging/Logger.h"
+
+namespace {
+
+constexpr size_t LINE = 64;
+constexpr size_t PAGE = 4096;
+constexpr size_t LINES_PER_PAGE = PAGE / LINE;
+constexpr size_t HUGE_PAGE = 2 * 1024 * 1024;
+
+constexpr size_t CURVE_ACCESSES = 1'000'000;
+constexpr int CURVE_RUNS = 3;
+
+// A plateau ends where latency climbs this far above its median...
+constexpr double RISE = 1.3;
+// ...and the next one starts once a step adds less than this
+constexpr double SETTLE = 1.25;
+// Shorter runs are noise on the way up, not a cache level
+constexpr size_t MIN_PLATEAU_POINTS = 3;
+
+void* volatile chaseSink = nullptr;  // keeps the chase from being optimized out
+
+void*& slot(char* base, size_t line) {
+  return *reinterpret_cast<void**>(base + line * LINE);
+}
+
+double medianOf(std::vector<double> values) {
+  if (values.empty()) return -1.0;
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+#if defined(_WIN32)
+bool enableLockMemoryPrivilege() {
+  HANDLE token;
+  if (!OpenProcessToken(GetCurrentProcess(),
+                        TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+    return false;
+  }
+  TOKEN_PRIVILEGES tp = {};
+  tp.PrivilegeCount = 1;
+  tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+  // AdjustTokenPrivileges succeeds without granting; GetLastError tells
+  const bool enabled =
+    LookupPrivilegeValue(nullptr, SE_LOCK_MEMORY_NAME, &tp.Privileges[0].Luid) &&
+    AdjustTokenPrivileges(token, FALSE, &tp, sizeof(TOKEN_PRIVILEGES), nullptr,
+                          nullptr) &&
+    GetLastError() == ERROR_SUCCESS;
+  CloseHandle(token);
+  return enabled;
+}
+#endif
+
+#if defined(__linux__)
+// madvise(MADV_HUGEPAGE) also succeeds when THP is set to "never"
+bool transparentHugePagesEnabled() {
+  std::ifstream file("/sys/kernel/mm/transparent_hugepage/enabled");
+  std::string modes;
+  std::getline(file, modes);
+  return modes.find("[always]") != std::string::npos ||
+         modes.find("[madvise]") != std::string::npos;
+}
+
+// AnonHugePages of the mappings overlapping [begin, begin + bytes), i.e. how
+// much of the range the kernel actually backs with huge pages
+size_t anonHugePageBytes(const void* begin, size_t bytes) {
+  const uintptr_t first = reinterpret_cast<uintptr_t>(begin);
+  const uintptr_t last = first + bytes;
+  std::ifstream smaps("/proc/self/smaps");
+  std::string line;
+  bool inRange = false;
+  size_t total = 0;
+  while (std::getline(smaps, line)) {
+    unsigned long long start = 0, end = 0;
+    char dash = 0;
+    std::istringstream fields(line);
+    if (fields >> std::hex >> start >> dash >> end && dash == '-') {
+      inRange = start < last && end > first;  // a new mapping's header
+      continue;
+    }
+    if (inRange && line.rfind("AnonHugePages:", 0) == 0) {
+      std::istringstream value(line.substr(14));
+      size_t kb = 0;
+      value >> kb;
+      total += kb * 1024;
+    }
+  }
+  return total;
+}
+#endif
+
+}  // namespace
+
+bool ChaseBuffer::allocate(size_t bytes, bool wantLargePages) {
+  release();
+#if defined(_WIN32)
+  if (wantLargePages) {
+    static const bool privileged = enableLockMemoryPrivilege();
+    const size_t largePage = GetLargePageMinimum();
+    if (privileged && largePage > 0) {
+      const size_t rounded = (bytes + largePage - 1) / largePage * largePage;
+      mapping_ = VirtualAlloc(nullptr, rounded,
+                              MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                              PAGE_READWRITE);
+      largePages = mapping_ != nullptr;
+    }
+  }
+  if (!mapping_) {
+    mapping_ = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT,
+                            PAGE_READWRITE);
+  }
+  if (!mapping_) return false;
+  data = static_cast<char*>(mapping_);
+#else
+  if (wantLargePages) {
+#if defined(MAP_HUGETLB)
+    // Explicit huge pages, if the administrator reserved enough of them
+    const size_t rounded = (bytes + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+    void* mapping = mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (mapping != MAP_FAILED) {
+      mapping_ = mapping;
+      mappingSize_ = rounded;
+      hugeTlb_ = true;
+      largePages = true;
+    }
+#endif
+  }
+  if (!mapping_) {
+    // Over-map so the buffer can start on a 2 MB boundary, which transparent
+    // huge pages need
+    const size_t length = bytes + (wantLargePages ? HUGE_PAGE : 0);
+    void* mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) return false;
+    mapping_ = mapping;
+    mappingSize_ = length;
+  }
+  data = static_cast<char*>(mapping_);
+  if (wantLargePages && !hugeTlb_) {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(mapping_);
+    data = reinterpret_cast<char*>((address + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE);
+#if defined(MADV_HUGEPAGE) && defined(__linux__)
+    // The advice alone proves nothing: fault the buffer in and count what
+    // the kernel backed with huge pages. Most of it has to be, or the
+    // large-page latency would still be paying TLB misses.
+    if (transparentHugePagesEnabled() && madvise(data, bytes, MADV_HUGEPAGE) == 0) {
+      for (size_t offset = 0; offset < bytes; offset += PAGE) {
+        data[offset] = 0;
+      }
+      const size_t huge = anonHugePageBytes(data, bytes);
+      largePages = huge >= bytes / 2;
+      LOG_DEBUG << "ChaseBuffer: " << huge / (1024 * 1024) << " of "
+                << bytes / (1024 * 1024) << " MB on transparent huge pages";
+    }
+#endif
+  }
+#endif
+  size = bytes;
+  return true;
+}
+
+void ChaseBuffer::release() {
+  if (mapping_) {
+#if defined(_WIN32)
+    VirtualFree(mapping_, 0, MEM_RELEASE);
+#else
+    munmap(mapping_, mappingSize_);
+#endif
+  }
+  mapping_ = nullptr;
+  mappingSize_ = 0;
+  hugeTlb_ = false;
+  data = nullptr;
+  size = 0;
+  largePages = false;
+}
+
+void* buildChase(char* base, size_t bytes, ChaseOrder order, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+
+  if (order == ChaseOrder::Random) {
+    // Every line points to itself, then Sattolo's shuffle of the pointers
+    // turns that identity into a single cycle through all of them
+    const size_t lines = bytes / LINE;
+    for (size_t i = 0; i < lines; i++) {
+      slot(base, i) = base + i * LINE;
+    }
+    for (size_t i = lines - 1; i > 0; i--) {
+      const size_t j = std::uniform_int_distribution<size_t>(0, i - 1)(rng);
+      std::swap(slot(base, i), slot(base, j));
+    }
+    return base;
+  }
+
+  // The same over the first line of every page gives the page cycle...
+  const size_t pages = bytes / PAGE;
+  for (size_t p = 0; p < pages; p++) {
+    slot(base, p * LINES_PER_PAGE) = base + p * PAGE;
+  }
+  for (size_t p = pages - 1; p > 0; p--) {
+    const size_t q = std::uniform_int_distribution<size_t>(0, p - 1)(rng);
+    std::swap(slot(base, p * LINES_PER_PAGE), slot(base, q * LINES_PER_PAGE));
+  }
+
+  // ...then, walking that cycle, each page's lines are chained in random
+  // order starting from its first line, the last one leading to the next page
+  std::array<size_t, LINES_PER_PAGE> lineOrder;
+  for (size_t i = 0; i < LINES_PER_PAGE; i++) lineOrder[i] = i;
+  char* page = base;
+  do {
+    char* next = static_cast<char*>(slot(page, 0));
+    std::shuffle(lineOrder.begin() + 1, lineOrder.end(), rng);
+    for (size_t i = 0; i + 1 < LINES_PER_PAGE; i++) {
+      slot(page, lineOrder[i]) = page + lineOrder[i + 1] * LINE;
+    }
+    slot(page, lineOrder[LINES_PER_PAGE - 1]) = next;
+    page = next;
+  } while (page != base);
+  return base;
+}
+
+double chaseLatencyNs(void* start, size_t lines, size_t accesses) {
+  double ns = -1.0;
+  KernelRunner::getInstance().runOnce(1, [&](int) {
+    void* const* p = static_cast<void* const*>(start);
+    for (size_t i = std::min(lines, accesses); i > 0; i--) {
+      p = static_cast<void* const*>(*p);
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    for (size_t i = accesses; i > 0; i--) {
+      p = static_cast<void* const*>(*p);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    chaseSink = const_cast<void*>(static_cast<const void*>(p));
+    ns = std::chrono::duration<double, std::nano>(end - begin).count() / accesses;
+  });
+  return ns;
+}
+
+std::vector<LatencyPoint> measureLatencyCurve(size_t minBytes, size_t maxBytes,
+                                              int pointsPerDoubling) {
+  std::vector<LatencyPoint> curve;
+  ChaseBuffer buffer;
+  if (!buffer.allocate(maxBytes, false)) {
+    LOG_ERROR << "[Latency] Failed to map " << maxBytes / (1024 * 1024) << " MB";
+    return curve;
+  }
+
+  const double step = std::pow(2.0, 1.0 / pointsPerDoubling);
+  size_t lastKB = 0;
+  for (double bytes = static_cast<double>(minBytes); bytes <= maxBytes * 1.0001;
+       bytes *= step) {
+    const size_t kb = static_cast<size_t>(std::lround(bytes / 1024));
+    if (kb == lastKB || kb * 1024 > maxBytes) continue;
+    lastKB = kb;
+
+    LatencyPoint point;
+    point.bytes = kb * 1024;
+    void* start = buildChase(buffer.data, point.bytes, ChaseOrder::Random, kb);
+    std::vector<double> runs;
+    for (int run = 0; run < CURVE_RUNS; run++) {
+      runs.push_back(chaseLatencyNs(start, point.bytes / LINE, CURVE_ACCESSES));
+    }
+    point.ns = medianOf(runs);
+    LOG_DEBUGF("[Latency] {} KB: {} ns", kb, point.ns);
+    curve.push_back(point);
+  }
+
+  buffer.release();
+  return curve;
+}
+
+std::vector<CacheLevelEstimate> detectCacheLevels(
+  const std::vector<LatencyPoint>& curve) {
+  std::vector<CacheLevelEstimate> levels;
+  if (curve.empty()) return levels;
+
+  auto plateauMedian = [&](size_t begin, size_t end) {
+    std::vector<double> values;
+    for (size_t i = begin; i < end; i++) values.push_back(curve[i].ns);
+    return medianOf(values);
+  };
+
+  size_t start = 0;
+  size_t i = 1;
+  while (i < curve.size()) {
+    const double base = plateauMedian(start, i);
+    // One noisy point doesn't end a plateau; the next one has to agree
+    const bool rises = curve[i].ns > base * RISE &&
+                       (i + 1 == curve.size() || curve[i + 1].ns > base * RISE);
+    if (!rises) {
+      i++;
+      continue;
+    }
+
+    if (i - start >= MIN_PLATEAU_POINTS) {
+      CacheLevelEstimate level;
+      level.bytes = curve[i - 1].bytes;
+      level.ns = base;
+      levels.push_back(level);
+    }
+
+    while (i + 1 < curve.size() && curve[i + 1].ns > curve[i].ns * SETTLE) {
+      i++;
+    }
+    start = i;
+    i++;
+  }
+
+  CacheLevelEstimate memory;
+  memory.ns = plateauMedian(start, curve.size());
+  levels.push_back(memory);
+  return levels;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#ifndef LATENCY_ENGINE_H
+#define LATENCY_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Pointer-chase load latency, shared by the cache and memory tests. Builds
+// without Windows headers outside of Windows.
+
+// How the chase visits the cache lines of a buffer. Both orders are a single
+// cycle through every line, so nothing is skipped and nothing repeats early.
+enum class ChaseOrder {
+  Random,     // any line to any line: a TLB miss per access once out of reach
+  PageLocal,  // every line of a 4 KB page, in random order, before the next
+              // random page: about one TLB miss per 64 accesses
+};
+
+// Memory for a chase, mapped straight from the OS
+struct ChaseBuffer {
+  char* data = nullptr;
+  size_t size = 0;
+  bool largePages = false;  // backed by large pages
+
+  // With largePages, asks for 2 MB / large pages and falls back to normal
+  // pages if the OS refuses (on Windows that takes SeLockMemoryPrivilege).
+  // Transparent huge pages on Linux only count once /proc/self/smaps shows
+  // most of the buffer on them, which means faulting it in here.
+  bool allocate(size_t bytes, bool wantLargePages);
+  void release();
+
+ private:
+  void* mapping_ = nullptr;
+  size_t mappingSize_ = 0;
+  bool hugeTlb_ = false;
+};
+
+// Links every cache line of base[0, bytes) into one cycle, in place, and
+// returns where to start. Random order is Sattolo's algorithm over the lines,
+// so no index array is needed. bytes must be a multiple of 64, and of 4 KB
+// for PageLocal.
+void* buildChase(char* base, size_t bytes, ChaseOrder order, uint64_t seed);
+
+// Follows the chain from start on KernelRunner worker 0 (pinned to core 0):
+// one untimed lap of up to `accesses` loads, then `accesses` timed loads.
+// Returns nanoseconds per load.
+double chaseLatencyNs(void* start, size_t lines, size_t accesses);
+
+struct LatencyPoint {
+  size_t bytes = 0;
+  double ns = -1.0;
+};
+
+// Random-order latency from minBytes to maxBytes, pointsPerDoubling sizes
+// per power of two, rounded to whole KB. Empty if the buffer can't be had.
+std::vector<LatencyPoint> measureLatencyCurve(size_t minBytes, size_t maxBytes,
+                                              int pointsPerDoubling);
+
+struct CacheLevelEstimate {
+  size_t bytes = 0;  // largest size still on the plateau; 0 for memory
+  double ns = -1.0;  // median latency of the plateau
+};
+
+// Splits the curve into plateaus where latency steps up, so the cache levels
+// come from the measurement rather than from reported sizes. The last level
+// is memory. Capacities are approximate: a non-inclusive or shared cache
+// starts to miss before it is full.
+std::vector<CacheLevelEstimate> detectCacheLevels(
+  const std::vector<LatencyPoint>& curve);
+
+#endif  // LATENCY_ENGINE_H
@@ -0,0 +1,385 @@
+#include "stability_tester.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <emmintrin.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "diagnostic/cpu_tests/kernel_runner.h"
+#include "logging/Logger.h"
+
+namespace {
+
+constexpr size_t PAGE = 4096;
+constexpr size_t LINE = 64;
+constexpr size_t WORDS_PER_LINE = LINE / sizeof(uint64_t);
+constexpr size_t MAX_RECORDED_ERRORS = 16;  // per worker
+constexpr double FREE_MEMORY_SHARE = 0.75;  // of available RAM for size 0
+constexpr size_t MIN_TEST_BYTES = 64 * 1024 * 1024;
+
+void* mapMemory(size_t bytes) {
+#if defined(_WIN32)
+  return VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+  void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  return mapping == MAP_FAILED ? nullptr : mapping;
+#endif
+}
+
+void unmapMemory(void* mapping, size_t bytes) {
+#if defined(_WIN32)
+  (void)bytes;
+  VirtualFree(mapping, 0, MEM_RELEASE);
+#else
+  munmap(mapping, bytes);
+#endif
+}
+
+// 64 bytes of expected data
+struct Line {
+  __m128i v[4];
+};
+
+Line splat(uint64_t word) {
+  const __m128i v = _mm_set1_epi64x(static_cast<long long>(word));
+  return Line{{v, v, v, v}};
+}
+
+Line lineOf(const uint64_t (&words)[WORDS_PER_LINE]) {
+  Line line;
+  for (int k = 0; k < 4; k++) {
+    line.v[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&words[k * 2]));
+  }
+  return line;
+}
+
+void streamLine(uint64_t* p, const Line& line) {
+  __m128i* dst = reinterpret_cast<__m128i*>(p);
+  for (int k = 0; k < 4; k++) _mm_stream_si128(dst + k, line.v[k]);
+}
+
+void storeLine(uint64_t* p, const Line& line) {
+  __m128i* dst = reinterpret_cast<__m128i*>(p);
+  for (int k = 0; k < 4; k++) _mm_store_si128(dst + k, line.v[k]);
+}
+
+bool lineMatches(const uint64_t* p, const Line& line) {
+  const __m128i* src = reinterpret_cast<const __m128i*>(p);
+  const __m128i eq01 =
+    _mm_and_si128(_mm_cmpeq_epi32(_mm_load_si128(src), line.v[0]),
+                  _mm_cmpeq_epi32(_mm_load_si128(src + 1), line.v[1]));
+  const __m128i eq23 =
+    _mm_and_si128(_mm_cmpeq_epi32(_mm_load_si128(src + 2), line.v[2]),
+                  _mm_cmpeq_epi32(_mm_load_si128(src + 3), line.v[3]));
+  return _mm_movemask_epi8(_mm_and_si128(eq01, eq23)) == 0xFFFF;
+}
+
+}  // namespace
+
+// One worker's share of the block, page aligned at both ends
+struct MemorySlice {
+  int index;
+  uint64_t* begin;
+  uint64_t* end;
+};
+
+// Mismatches found by one worker
+struct ErrorSink {
+  uint64_t count = 0;
+  std::vector<MemoryErrorInfo> first;
+
+  // A line that failed the vector compare, checked word by word
+  void checkLine(const uint64_t* p, const Line& line, int loop,
+                 const std::string& test) {
+    alignas(16) uint64_t expected[WORDS_PER_LINE];
+    storeLine(expected, line);
+    for (size_t k = 0; k < WORDS_PER_LINE; k++) {
+      const uint64_t actual = p[k];
+      if (actual == expected[k]) continue;
+      count++;
+      if (first.size() < MAX_RECORDED_ERRORS) {
+        first.push_back({reinterpret_cast<uint64_t>(&p[k]), expected[k], actual,
+                         loop, test});
+      }
+    }
+  }
+};
+
+// Base class for a memory test pattern
+class MemoryTestPattern {
+ public:
+  virtual ~MemoryTestPattern() = default;
+  virtual std::string getName() const = 0;
+  // Writes the pattern over the slice and verifies it. Every worker runs
+  // this at the same time on its own slice.
+  virtual void runTest(const MemorySlice& slice, int loop, ErrorSink& errors) = 0;
+
+ protected:
+  // makeLine(p, line) gives the expected content of the line at p; it is
+  // called once per line in ascending order, so it may keep state
+  template <typename MakeLine>
+  static void fill(const MemorySlice& slice, MakeLine&& makeLine) {
+    Line line;
+    for (uint64_t* p = slice.begin; p < slice.end; p += WORDS_PER_LINE) {
+      makeLine(p, line);
+      streamLine(p, line);
+    }
+    _mm_sfence();
+  }
+
+  template <typename MakeLine>
+  void verify(const MemorySlice& slice, int loop, ErrorSink& errors,
+              MakeLine&& makeLine) const {
+    Line line;
+    for (const uint64_t* p = slice.begin; p < slice.end; p += WORDS_PER_LINE) {
+      makeLine(p, line);
+      if (!lineMatches(p, line)) errors.checkLine(p, line, loop, getName());
+    }
+  }
+};
+
+namespace {
+
+// Bit (address / 8 + k) % 64 set in word k, then the complement: every data
+// line of a 64-bit bus driven alone, high and low
+class WalkingBitsTest : public MemoryTestPattern {
+ public:
+  WalkingBitsTest() {
+    for (size_t j = 0; j < 8; j++) {
+      uint64_t ones[WORDS_PER_LINE], zeros[WORDS_PER_LINE];
+      for (size_t k = 0; k < WORDS_PER_LINE; k++) {
+        ones[k] = uint64_t(1) << (j * WORDS_PER_LINE + k);
+        zeros[k] = ~ones[k];
+      }
+      ones_[j] = lineOf(ones);
+      zeros_[j] = lineOf(zeros);
+    }
+  }
+
+  std::string getName() const override { return "Walking Ones/Zeros Test"; }
+
+  void runTest(const MemorySlice& slice, int loop, ErrorSink& errors) override {
+    for (const Line* table : {ones_, zeros_}) {
+      auto makeLine = [&](const uint64_t* p, Line& line) {
+        line = table[(reinterpret_cast<uintptr_t>(p) / LINE + loop) % 8];
+      };
+      fill(slice, makeLine);
+      verify(slice, loop, errors, makeLine);
+    }
+  }
+
+ private:
+  Line ones_[8];
+  Line zeros_[8];
+};
+
+// memtest86-style: fill with P; going up, check P and write ~P; going down,
+// check ~P and write P. Catches cells disturbed by writes to their neighbours
+// in either direction. P alternates between all zeros and 0xAA.. per loop.
+class MovingInversionsTest : public MemoryTestPattern {
+ public:
+  std::string getName() const override { return "Moving Inversions Test"; }
+
+  void runTest(const MemorySlice& slice, int loop, ErrorSink& errors) override {
+    const uint64_t pattern = loop % 2 == 0 ? 0 : 0xAAAAAAAAAAAAAAAAull;
+    const Line p = splat(pattern);
+    const Line inverse = splat(~pattern);
+
+    fill(slice, [&](const uint64_t*, Line& line) { line = p; });
+
+    for (uint64_t* q = slice.begin; q < slice.end; q += WORDS_PER_LINE) {
+      if (!lineMatches(q, p)) errors.checkLine(q, p, loop, getName());
+      storeLine(q, inverse);
+    }
+    for (uint64_t* q = slice.end; q > slice.begin;) {
+      q -= WORDS_PER_LINE;
+      if (!lineMatches(q, inverse)) errors.checkLine(q, inverse, loop, getName());
+      storeLine(q, p);
+    }
+
+    verify(slice, loop, errors, [&](const uint64_t*, Line& line) { line = p; });
+  }
+};
+
+// xorshift64 (a linear feedback shift register over GF(2)) seeded per loop
+// and slice; verification replays the same sequence
+class RandomLfsrTest : public MemoryTestPattern {
+ public:
+  std::string getName() const override { return "Random LFSR Test"; }
+
+  void runTest(const MemorySlice& slice, int loop, ErrorSink& errors) override {
+    const uint64_t seed =
+      0x9E3779B97F4A7C15ull * (static_cast<uint64_t>(loop) * 1024 + slice.index + 1);
+    uint64_t state = seed;
+    auto makeLine = [&](const uint64_t*, Line& line) {
+      uint64_t words[WORDS_PER_LINE];
+      for (uint64_t& word : words) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        word = state;
+      }
+      line = lineOf(words);
+    };
+    fill(slice, makeLine);
+    state = seed;
+    verify(slice, loop, errors, makeLine);
+  }
+};
+
+// Every word holds its own address, then its complement: a stuck or shorted
+// address line makes two locations alias and one of them reads back wrong
+class AddressInAddressTest : public MemoryTestPattern {
+ public:
+  std::string getName() const override { return "Address In Address Test"; }
+
+  void runTest(const MemorySlice& slice, int loop, ErrorSink& errors) override {
+    for (uint64_t mask : {uint64_t(0), ~uint64_t(0)}) {
+      auto makeLine = [&](const uint64_t* p, Line& line) {
+        const uint64_t address = reinterpret_cast<uint64_t>(p);
+        const __m128i m = _mm_set1_epi64x(static_cast<long long>(mask));
+        for (int k = 0; k < 4; k++) {
+          const __m128i pair = _mm_set_epi64x(
+            static_cast<long long>(address + (k * 2 + 1) * sizeof(uint64_t)),
+            static_cast<long long>(address + k * 2 * sizeof(uint64_t)));
+          line.v[k] = _mm_xor_si128(pair, m);
+        }
+      };
+      fill(slice, makeLine);
+      verify(slice, loop, errors, makeLine);
+    }
+  }
+};
+
+}  // namespace
+
+MemoryStabilityTester::MemoryStabilityTester(
+  const MemoryStabilityTestConfig& config)
+    : config_(config) {
+  testPatterns_.push_back(std::make_unique<WalkingBitsTest>());
+  testPatterns_.push_back(std::make_unique<MovingInversionsTest>());
+  testPatterns_.push_back(std::make_unique<RandomLfsrTest>());
+  testPatterns_.push_back(std::make_unique<AddressInAddressTest>());
+}
+
+MemoryStabilityTester::~MemoryStabilityTester() = default;
+
+size_t MemoryStabilityTester::availableMemoryBytes() {
+#if defined(_WIN32)
+  MEMORYSTATUSEX status = {};
+  status.dwLength = sizeof(status);
+  return GlobalMemoryStatusEx(&status) ? static_cast<size_t>(status.ullAvailPhys)
+                                       : 0;
+#else
+  const long pages = sysconf(_SC_AVPHYS_PAGES);
+  const long pageSize = sysconf(_SC_PAGESIZE);
+  return pages > 0 && pageSize > 0
+           ? static_cast<size_t>(pages) * static_cast<size_t>(pageSize)
+           : 0;
+#endif
+}
+
+MemoryStabilityTester::TestResults MemoryStabilityTester::runTests() {
+  TestResults results;
+  KernelRunner& runner = KernelRunner::getInstance();
+  const int threads = config_.numThreads > 0
+                        ? std::min(config_.numThreads, runner.workerCount())
+                        : runner.workerCount();
+
+  size_t bytes = config_.memorySizeBytes;
+  if (bytes == 0) {
+    bytes = static_cast<size_t>(availableMemoryBytes() * FREE_MEMORY_SHARE);
+  }
+  bytes = std::max(bytes, MIN_TEST_BYTES);
+  const size_t unit = PAGE * threads;
+
+  // Whatever the OS will commit, halving down to MIN_TEST_BYTES
+  void* block = nullptr;
+  while (!block) {
+    bytes = std::max(bytes / unit, size_t(1)) * unit;
+    block = mapMemory(bytes);
+    if (block || bytes <= MIN_TEST_BYTES) break;
+    bytes /= 2;
+  }
+  if (!block) {
+    LOG_ERROR << "[Memory Stability Test] Failed to allocate memory block for testing.";
+    results.passed = false;
+    return results;
+  }
+  results.testedBytes = bytes;
+  results.threads = threads;
+
+  std::vector<MemorySlice> slices(threads);
+  for (int t = 0; t < threads; t++) {
+    char* base = static_cast<char*>(block);
+    slices[t] = {t, reinterpret_cast<uint64_t*>(base + bytes / threads * t),
+                 reinterpret_cast<uint64_t*>(base + bytes / threads * (t + 1))};
+  }
+  std::vector<ErrorSink> sinks(threads);
+
+  LOG_INFO << "[Memory Stability Test] Starting test with " << bytes / (1024 * 1024)
+           << " MB of memory on " << threads << " threads, " << config_.testLoops
+           << " loops";
+
+  const auto start = std::chrono::steady_clock::now();
+  uint64_t errorsSoFar = 0;
+  bool stopped = false;
+  for (int loop = 0; loop < config_.testLoops && !stopped; loop++) {
+    for (const auto& pattern : testPatterns_) {
+      const KernelRunner::Run run = runner.runOnce(threads, [&](int t) {
+        pattern->runTest(slices[t], loop, sinks[t]);
+      });
+      results.completedPatterns++;
+
+      uint64_t errors = 0;
+      for (const ErrorSink& sink : sinks) errors += sink.count;
+      LOG_INFO << "[Memory Stability Test] Loop " << (loop + 1) << "/"
+               << config_.testLoops << ", " << pattern->getName() << ": "
+               << run.wallMs << " ms, " << (errors - errorsSoFar) << " errors";
+      if (errors > errorsSoFar && config_.stopOnError) {
+        stopped = true;
+        break;
+      }
+      errorsSoFar = errors;
+    }
+    if (!stopped) results.completedLoops++;
+  }
+  results.seconds =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  unmapMemory(block, bytes);
+
+  for (const ErrorSink& sink : sinks) {
+    results.errorCount += sink.count;
+    results.errors.insert(results.errors.end(), sink.first.begin(), sink.first.end());
+  }
+  results.passed = results.errorCount == 0;
+  if (results.seconds > 0) {
+    results.coverageGBs =
+      static_cast<double>(bytes) * results.completedPatterns / (results.seconds * 1e9);
+  }
+
+  for (const auto& error : results.errors) {
+    LOG_ERROR << "[Memory Stability Test] Error detected at address 0x" << std::hex
+              << error.address << std::dec << " during " << error.testName
+              << " (loop " << error.loopNumber + 1 << "). Expected: 0x" << std::hex
+              << error.expected << ", Got: 0x" << error.actual << std::dec;
+  }
+  if (results.passed) {
+    LOG_INFO << "[Memory Stability Test] Completed successfully. No errors detected.";
+  } else {
+    LOG_ERROR << "[Memory Stability Test] Failed with " << results.errorCount << " errors.";
+  }
+  LOG_INFO << "[Memory Stability Test] " << results.seconds << " s, "
+           << results.coverageGBs << " GB/s coverage";
+
+  return results;
+}
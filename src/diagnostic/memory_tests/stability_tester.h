@@ -0,0 +1,68 @@
+#pragma once
+#ifndef STABILITY_TESTER_H
+#define STABILITY_TESTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Configuration structure for the memory test
+struct MemoryStabilityTestConfig {
+  size_t memorySizeBytes = 256 * 1024 * 1024;  // min 64 MB, 0 = most free RAM
+  int testLoops = 3;                           // passes over every pattern
+  int numThreads = 0;        // 0 = every KernelRunner worker
+  bool stopOnError = false;  // stop after the pattern that found one
+};
+
+// Error information structure
+struct MemoryErrorInfo {
+  uint64_t address;  // virtual address of the failing 64-bit word
+  uint64_t expected;
+  uint64_t actual;
+  int loopNumber;
+  std::string testName;
+};
+
+class MemoryTestPattern;
+
+// Writes and verifies test patterns over one block of memory on the
+// KernelRunner workers. Each worker owns a disjoint, page-aligned slice of
+// the block, so the patterns run in parallel without sharing a cache line.
+// Fills use SSE2 non-temporal stores so verification reads come from DRAM,
+// and lines are compared 16 bytes at a time; only a line that differs is
+// rescanned word by word to find the failing addresses.
+//
+// Patterns: walking ones/zeros, moving inversions, xorshift (LFSR) random
+// data and address-in-address.
+class MemoryStabilityTester {
+ public:
+  // Structure to hold test results
+  struct TestResults {
+    bool passed = true;
+    std::vector<MemoryErrorInfo> errors;  // the first few of each worker
+    uint64_t errorCount = 0;              // every mismatching word
+    int completedLoops = 0;
+    int completedPatterns = 0;
+    size_t testedBytes = 0;
+    int threads = 0;
+    double seconds = 0.0;
+    double coverageGBs = -1.0;  // testedBytes per pattern run, per second
+  };
+
+  explicit MemoryStabilityTester(const MemoryStabilityTestConfig& config);
+  ~MemoryStabilityTester();
+
+  // Run the memory test across all loops and test patterns
+  TestResults runTests();
+
+  // Physical memory not in use right now, 0 if unknown
+  static size_t availableMemoryBytes();
+
+ private:
+  MemoryStabilityTestConfig config_;
+  std::vector<std::unique_ptr<MemoryTestPattern>> testPatterns_;
+};
+
+#endif  // STABILITY_TESTER_H
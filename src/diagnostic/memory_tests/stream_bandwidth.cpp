@@ -0,0 +1,301 @@
+#include "stream_bandwidth.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+#if defined(_M_X64) || defined(__x86_64__)
+#define STREAM_X86 1
+#include <emmintrin.h>
+#endif
+
+#include "diagnostic/cpu_tests/kernel_runner.h"
+
+namespace {
+
+#ifdef STREAM_X86
+constexpr bool HAS_NON_TEMPORAL = true;
+#else
+constexpr bool HAS_NON_TEMPORAL = false;
+#endif
+
+constexpr size_t ALIGNMENT = 64;
+constexpr size_t LINE_DOUBLES = ALIGNMENT / sizeof(double);
+constexpr double SCALAR = 3.0;
+constexpr double SATURATION = 0.9;
+constexpr double EPSILON = 1e-13;  // STREAM's tolerance for doubles
+
+enum class Op { Copy, Scale, Add, Triad };
+constexpr Op OPS[] = {Op::Copy, Op::Scale, Op::Add, Op::Triad};
+constexpr int OP_COUNT = 4;
+constexpr const char* OP_NAMES[OP_COUNT] = {"copy", "scale", "add", "triad"};
+// Arrays read or written per element; write-allocate traffic isn't counted
+constexpr int ARRAYS_MOVED[OP_COUNT] = {2, 2, 3, 3};
+
+void* alignedAlloc(size_t bytes) {
+#if defined(_WIN32)
+  return _aligned_malloc(bytes, ALIGNMENT);
+#else
+  void* ptr = nullptr;
+  return posix_memalign(&ptr, ALIGNMENT, bytes) == 0 ? ptr : nullptr;
+#endif
+}
+
+void alignedFree(void* ptr) {
+#if defined(_WIN32)
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+struct StreamArrays {
+  double* a = nullptr;
+  double* b = nullptr;
+  double* c = nullptr;
+  size_t n = 0;
+
+  bool allocate(size_t elements) {
+    n = elements;
+    a = static_cast<double*>(alignedAlloc(n * sizeof(double)));
+    b = static_cast<double*>(alignedAlloc(n * sizeof(double)));
+    c = static_cast<double*>(alignedAlloc(n * sizeof(double)));
+    return a && b && c;
+  }
+
+  void release() {
+    if (a) alignedFree(a);
+    if (b) alignedFree(b);
+    if (c) alignedFree(c);
+    a = b = c = nullptr;
+  }
+};
+
+// Thread t's share of the arrays, in whole cache lines
+void chunkOf(size_t n, int t, int threads, size_t& begin, size_t& end) {
+  begin = n * t / threads / LINE_DOUBLES * LINE_DOUBLES;
+  end = n * (t + 1) / threads / LINE_DOUBLES * LINE_DOUBLES;
+}
+
+void runOp(Op op, const StreamArrays& s, size_t begin, size_t end) {
+  double* a = s.a;
+  double* b = s.b;
+  double* c = s.c;
+  switch (op) {
+    case Op::Copy:
+      for (size_t i = begin; i < end; i++) c[i] = a[i];
+      break;
+    case Op::Scale:
+      for (size_t i = begin; i < end; i++) b[i] = SCALAR * c[i];
+      break;
+    case Op::Add:
+      for (size_t i = begin; i < end; i++) c[i] = a[i] + b[i];
+      break;
+    case Op::Triad:
+      for (size_t i = begin; i < end; i++) a[i] = b[i] + SCALAR * c[i];
+      break;
+  }
+}
+
+#ifdef STREAM_X86
+// Same kernels with streaming stores, which skip the read-for-ownership of
+// the destination line. SSE2 only, so no CPU check is needed on x64.
+void runOpNonTemporal(Op op, const StreamArrays& s, size_t begin, size_t end) {
+  double* a = s.a;
+  double* b = s.b;
+  double* c = s.c;
+  const __m128d scalar = _mm_set1_pd(SCALAR);
+  switch (op) {
+    case Op::Copy:
+      for (size_t i = begin; i < end; i += 2) {
+        _mm_stream_pd(&c[i], _mm_load_pd(&a[i]));
+      }
+      break;
+    case Op::Scale:
+      for (size_t i = begin; i < end; i += 2) {
+        _mm_stream_pd(&b[i], _mm_mul_pd(scalar, _mm_load_pd(&c[i])));
+      }
+      break;
+    case Op::Add:
+      for (size_t i = begin; i < end; i += 2) {
+        _mm_stream_pd(&c[i], _mm_add_pd(_mm_load_pd(&a[i]), _mm_load_pd(&b[i])));
+      }
+      break;
+    case Op::Triad:
+      for (size_t i = begin; i < end; i += 2) {
+        _mm_stream_pd(&a[i], _mm_add_pd(_mm_load_pd(&b[i]),
+                                        _mm_mul_pd(scalar, _mm_load_pd(&c[i]))));
+      }
+      break;
+  }
+  _mm_sfence();
+}
+#endif
+
+// What every element should hold, following the kernels on scalars
+struct ExpectedValues {
+  double a = 1.0;
+  double b = 2.0;
+  double c = 0.0;
+
+  void apply(Op op) {
+    switch (op) {
+      case Op::Copy: c = a; break;
+      case Op::Scale: b = SCALAR * c; break;
+      case Op::Add: c = a + b; break;
+      case Op::Triad: a = b + SCALAR * c; break;
+    }
+  }
+};
+
+class StreamBench {
+ public:
+  StreamBench(KernelRunner& runner, StreamArrays& arrays)
+      : runner_(runner), arrays_(arrays) {}
+
+  // Fills the arrays on the threads that will use each chunk, so with NUMA
+  // each chunk lives on the node of the core that streams it
+  void initialize(int threads) {
+    runner_.runOnce(threads, [&](int t) {
+      size_t begin, end;
+      chunkOf(arrays_.n, t, threads, begin, end);
+      for (size_t i = begin; i < end; i++) {
+        arrays_.a[i] = 1.0;
+        arrays_.b[i] = 2.0;
+        arrays_.c[i] = 0.0;
+      }
+    });
+  }
+
+  // GB/s of one run of op on threads workers
+  double run(Op op, bool nonTemporal, int threads) {
+    const KernelRunner::Run timing = runner_.runOnce(threads, [&](int t) {
+      size_t begin, end;
+      chunkOf(arrays_.n, t, threads, begin, end);
+#ifdef STREAM_X86
+      if (nonTemporal) {
+        runOpNonTemporal(op, arrays_, begin, end);
+        return;
+      }
+#endif
+      runOp(op, arrays_, begin, end);
+    });
+    expected_.apply(op);
+
+    const double bytes = static_cast<double>(ARRAYS_MOVED[static_cast<int>(op)]) *
+                         sizeof(double) * arrays_.n;
+    return timing.wallMs > 0 ? bytes / (timing.wallMs * 1e6) : -1.0;
+  }
+
+  bool validate(int threads) {
+    std::vector<char> failed(threads, 0);
+    runner_.runOnce(threads, [&](int t) {
+      size_t begin, end;
+      chunkOf(arrays_.n, t, threads, begin, end);
+      for (size_t i = begin; i < end; i++) {
+        if (!close(arrays_.a[i], expected_.a) ||
+            !close(arrays_.b[i], expected_.b) ||
+            !close(arrays_.c[i], expected_.c)) {
+          failed[t] = 1;
+          return;
+        }
+      }
+    });
+    return std::find(failed.begin(), failed.end(), 1) == failed.end();
+  }
+
+ private:
+  static bool close(double value, double expected) {
+    return std::abs(value - expected) <= EPSILON * std::abs(expected);
+  }
+
+  KernelRunner& runner_;
+  StreamArrays& arrays_;
+  ExpectedValues expected_;
+};
+
+}  // namespace
+
+StreamResults runStreamBenchmark(const StreamConfig& config) {
+  StreamResults results;
+  KernelRunner& runner = KernelRunner::getInstance();
+  const int threads = runner.workerCount();
+
+  // Whole cache lines per thread, so chunks never share a line
+  const size_t unit = LINE_DOUBLES * threads;
+  const size_t elements = std::max(config.arrayElements / unit, size_t(1)) * unit;
+
+  results.arrayMB = static_cast<int>(elements * sizeof(double) / (1024 * 1024));
+  results.threads = threads;
+
+  StreamArrays arrays;
+  if (!arrays.allocate(elements)) {
+    arrays.release();
+    return results;
+  }
+
+  runner.warmUp();
+  StreamBench bench(runner, arrays);
+  bench.initialize(threads);
+
+  const bool variants[] = {false, true};
+  for (bool nonTemporal : variants) {
+    if (nonTemporal && !HAS_NON_TEMPORAL) continue;
+    std::vector<double> gbs[OP_COUNT];
+
+    // The first pass is untimed, as in STREAM, so the pages are mapped
+    for (int pass = 0; pass <= config.repetitions; pass++) {
+      for (Op op : OPS) {
+        const double rate = bench.run(op, nonTemporal, threads);
+        if (pass > 0) gbs[static_cast<int>(op)].push_back(rate);
+      }
+    }
+
+    for (int op = 0; op < OP_COUNT; op++) {
+      if (gbs[op].empty()) continue;
+      StreamKernelResult kernel;
+      kernel.kernel = OP_NAMES[op];
+      kernel.nonTemporal = nonTemporal;
+      kernel.bestGBs = *std::max_element(gbs[op].begin(), gbs[op].end());
+      kernel.medianGBs = KernelStats::medianOf(gbs[op]);
+      results.kernels.push_back(kernel);
+    }
+  }
+
+  // One worker alone, as the bandwidth test before this suite measured
+  for (int i = 0; i < config.repetitions; i++) {
+    results.singleThreadTriadGBs = std::max(
+      results.singleThreadTriadGBs, bench.run(Op::Triad, HAS_NON_TEMPORAL, 1));
+  }
+
+  // Where adding cores stops adding bandwidth. Workers fill cores in order,
+  // so on multi-socket systems the later counts also reach the far node.
+  if (config.threadSweep) {
+    for (int n = 1; n <= threads; n++) {
+      double best = -1.0;
+      for (int i = 0; i < config.sweepRepetitions; i++) {
+        best = std::max(best, bench.run(Op::Triad, false, n));
+      }
+      results.triadByThreads.push_back(best);
+    }
+
+    const double peak =
+      *std::max_element(results.triadByThreads.begin(), results.triadByThreads.end());
+    for (size_t i = 0; i < results.triadByThreads.size(); i++) {
+      if (results.triadByThreads[i] >= SATURATION * peak) {
+        results.saturationThreads = static_cast<int>(i + 1);
+        break;
+      }
+    }
+  }
+
+  results.validated = bench.validate(threads);
+  results.testPerformed = true;
+
+  arrays.release();
+  return results;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#ifndef STREAM_BANDWIDTH_H
+#define STREAM_BANDWIDTH_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// STREAM (McCalpin) Copy, Scale, Add and Triad over three double arrays, on
+// the KernelRunner workers. Builds without Qt or Windows headers, so it also
+// runs from benchmarks/; the caller logs the results.
+
+// Bandwidth in GB/s (10^9 bytes per second)
+struct StreamKernelResult {
+  std::string kernel;        // copy, scale, add or triad
+  bool nonTemporal = false;  // stores bypass the cache
+  double bestGBs = -1.0;
+  double medianGBs = -1.0;
+};
+
+struct StreamResults {
+  bool testPerformed = false;
+  bool validated = false;  // array contents matched after all runs
+  int arrayMB = 0;         // each of the three arrays
+  int threads = 0;         // used for the kernels below
+  std::vector<StreamKernelResult> kernels;
+  std::vector<double> triadByThreads;  // [n - 1]: best Triad on n threads
+  int saturationThreads = -1;  // fewest threads within 90% of the best
+  double singleThreadTriadGBs = -1.0;  // non-temporal where supported
+};
+
+struct StreamConfig {
+  size_t arrayElements = 32 * 1024 * 1024;  // per array: 256 MB, three arrays
+  int repetitions = 10;                     // timed passes of all four kernels
+  int sweepRepetitions = 3;                 // Triad runs per thread count
+  bool threadSweep = true;                  // Triad on 1..N threads
+};
+
+// Runs every kernel with regular and with non-temporal stores on all
+// workers, reporting the best and median of the timed passes, then Triad on
+// a single worker and the thread sweep. testPerformed is false if the arrays
+// couldn't be allocated.
+StreamResults runStreamBenchmark(const StreamConfig& config = StreamConfig());
+
+#endif  // STREAM_BANDWIDTH_H
@@ -0,0 +1,423 @@
+#include "storage_scanner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#endif
+
+namespace StorageAnalysis {
+namespace {
+
+using NativeString = std::filesystem::path::string_type;
+using Clock = std::chrono::steady_clock;
+
+constexpr auto PROGRESS_INTERVAL = std::chrono::milliseconds(500);
+constexpr auto POLL_INTERVAL = std::chrono::milliseconds(5);
+constexpr int IDLE_SPINS = 64;  // failed steals before an idle thread sleeps
+
+#if defined(_WIN32)
+constexpr NativeString::value_type SEPARATOR = L'\\';
+#else
+constexpr NativeString::value_type SEPARATOR = '/';
+#endif
+
+NativeString joinPath(const NativeString& parent, const NativeString::value_type* name) {
+  NativeString path;
+  path.reserve(parent.size() + 64);
+  path = parent;
+  if (path.empty() || (path.back() != SEPARATOR && path.back() != '/')) {
+    path += SEPARATOR;
+  }
+  path += name;
+  return path;
+}
+
+std::wstring toWide(const NativeString& path) {
+#if defined(_WIN32)
+  return path;
+#else
+  try {
+    return std::filesystem::path(path).wstring();
+  } catch (const std::exception&) {
+    return std::wstring(path.begin(), path.end());  // not valid in the locale
+  }
+#endif
+}
+
+bool isDotEntry(const NativeString::value_type* name) {
+  return name[0] == '.' && (name[1] == 0 || (name[1] == '.' && name[2] == 0));
+}
+
+#if defined(__linux__)
+// The kernel's record; glibc only wraps getdents64 from 2.30
+struct LinuxDirent64 {
+  uint64_t d_ino;
+  int64_t d_off;
+  unsigned short d_reclen;
+  unsigned char d_type;
+  char d_name[1];
+};
+#endif
+
+// Calls onFile(name, bytes) and onDirectory(name) for every entry of path
+// except links and . / ..; false if the directory can't be opened
+template <typename OnFile, typename OnDirectory>
+bool listDirectory(const NativeString& path, OnFile&& onFile,
+                   OnDirectory&& onDirectory) {
+#if defined(_WIN32)
+  WIN32_FIND_DATAW data;
+  HANDLE find = FindFirstFileExW(
+    joinPath(path, L"*").c_str(), FindExInfoBasic, &data, FindExSearchNameMatch,
+    nullptr, FIND_FIRST_EX_LARGE_FETCH | FIND_FIRST_EX_ON_DISK_ENTRIES_ONLY);
+  if (find == INVALID_HANDLE_VALUE) return false;
+  do {
+    if (isDotEntry(data.cFileName)) continue;
+    if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+      // Junctions and directory symlinks could loop back
+      if (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) continue;
+      onDirectory(data.cFileName);
+    } else {
+      onFile(data.cFileName,
+             (static_cast<unsigned long long>(data.nFileSizeHigh) << 32) |
+               data.nFileSizeLow);
+    }
+  } while (FindNextFileW(find, &data));
+  FindClose(find);
+  return true;
+#elif defined(__linux__)
+  const int fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0) return false;
+  alignas(8) char buffer[32 * 1024];
+  for (;;) {
+    const long bytes = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+    if (bytes <= 0) break;
+    for (long offset = 0; offset < bytes;) {
+      const auto* entry = reinterpret_cast<const LinuxDirent64*>(buffer + offset);
+      offset += entry->d_reclen;
+      const char* name = entry->d_name;
+      if (isDotEntry(name)) continue;
+      if (entry->d_type == DT_DIR) {
+        onDirectory(name);
+        continue;
+      }
+      // Sizes need a stat; links, devices and pipes hold no data of their own
+      if (entry->d_type != DT_REG && entry->d_type != DT_UNKNOWN) continue;
+      struct stat info;
+      if (fstatat(fd, name, &info, AT_SYMLINK_NOFOLLOW) != 0) continue;
+      if (S_ISDIR(info.st_mode)) {
+        onDirectory(name);
+      } else if (S_ISREG(info.st_mode)) {
+        onFile(name, static_cast<unsigned long long>(info.st_size));
+      }
+    }
+  }
+  close(fd);
+  return true;
+#else
+  std::error_code error;
+  std::filesystem::directory_iterator it(path, error), end;
+  if (error) return false;
+  for (; it != end; it.increment(error)) {
+    if (error) break;
+    const std::filesystem::directory_entry& entry = *it;
+    if (entry.is_symlink(error)) continue;
+    const NativeString& name = entry.path().filename().native();
+    if (entry.is_directory(error)) {
+      onDirectory(name.c_str());
+    } else if (entry.is_regular_file(error)) {
+      const auto bytes = entry.file_size(error);
+      if (!error) onFile(name.c_str(), static_cast<unsigned long long>(bytes));
+    }
+  }
+  return true;
+#endif
+}
+
+struct Directory {
+  NativeString path;
+  Directory* parent;
+  int depth;
+  std::atomic<unsigned long long> bytes{0};  // own files plus finished subfolders
+  std::atomic<size_t> pending{1};  // own listing plus unfinished subfolders
+  bool finished = false;
+
+  Directory(NativeString path, Directory* parent)
+      : path(std::move(path)), parent(parent), depth(parent ? parent->depth + 1 : 0) {}
+};
+
+// A file (directory plus name) or a folder (empty name) and its size
+struct Sized {
+  unsigned long long bytes;
+  const Directory* directory;
+  NativeString name;
+};
+
+// The largest `capacity` items seen, as a min-heap
+class TopList {
+ public:
+  explicit TopList(size_t capacity) : capacity_(capacity) {}
+
+  bool wants(unsigned long long bytes) const {
+    return capacity_ > 0 && (heap_.size() < capacity_ || bytes > heap_.front().bytes);
+  }
+
+  void add(Sized item) {
+    if (!wants(item.bytes)) return;
+    if (heap_.size() == capacity_) {
+      std::pop_heap(heap_.begin(), heap_.end(), greater);
+      heap_.pop_back();
+    }
+    heap_.push_back(std::move(item));
+    std::push_heap(heap_.begin(), heap_.end(), greater);
+  }
+
+  std::vector<Sized>& items() { return heap_; }
+
+ private:
+  static bool greater(const Sized& a, const Sized& b) { return a.bytes > b.bytes; }
+
+  size_t capacity_;
+  std::vector<Sized> heap_;
+};
+
+class Scanner {
+ public:
+  Scanner(const ScanOptions& options, int threads) : options_(options) {
+    for (int t = 0; t < threads; t++) {
+      workers_.push_back(std::make_unique<Worker>(options.topCount));
+    }
+  }
+
+  ScanResults run(const std::filesystem::path& rootPath) {
+    ScanResults results;
+    const auto start = Clock::now();
+    const auto deadline = start + options_.timeout;
+
+    NativeString rootName = rootPath.native();
+    // "C:\" and "/" keep their separator, "D:\Games\" loses it
+    while (rootName.size() > 1 &&
+           (rootName.back() == SEPARATOR || rootName.back() == '/') &&
+           rootName[rootName.size() - 2] != ':') {
+      rootName.pop_back();
+    }
+    root_ = std::make_unique<Directory>(rootName, nullptr);
+    workers_[0]->queue.push_back(root_.get());
+    outstanding_.store(1);
+
+    running_.store(static_cast<int>(workers_.size()));
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < workers_.size(); t++) {
+      threads.emplace_back([this, t] {
+        workerLoop(static_cast<int>(t));
+        running_.fetch_sub(1, std::memory_order_release);
+      });
+    }
+
+    auto lastProgress = start;
+    while (running_.load(std::memory_order_acquire) > 0) {
+      std::this_thread::sleep_for(POLL_INTERVAL);
+      const auto now = Clock::now();
+      if (now >= deadline) stop_.store(true, std::memory_order_relaxed);
+      if (options_.progress && now - lastProgress >= PROGRESS_INTERVAL) {
+        options_.progress(files_.load(std::memory_order_relaxed),
+                          folders_.load(std::memory_order_relaxed));
+        lastProgress = now;
+      }
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    results.timedOut = stop_.load();
+    if (results.timedOut) finishPartialTree();
+
+    results.totalBytes = root_->bytes.load();
+    results.filesScanned = files_.load();
+    results.foldersScanned = folders_.load();
+    results.largestFiles = collect(&Worker::files);
+    results.largestFolders = collect(&Worker::folders);
+    results.duration =
+      std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    return results;
+  }
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Directory*> queue;  // owner takes the back, thieves the front
+    std::vector<std::unique_ptr<Directory>> owned;
+    std::vector<Directory*> children;  // scratch for one listing
+    TopList files;
+    TopList folders;
+
+    explicit Worker(size_t topCount) : files(topCount), folders(topCount) {}
+  };
+
+  Directory* take(int index) {
+    {
+      Worker& self = *workers_[index];
+      std::lock_guard<std::mutex> lock(self.mutex);
+      if (!self.queue.empty()) {
+        Directory* directory = self.queue.back();
+        self.queue.pop_back();
+        return directory;
+      }
+    }
+    const int count = static_cast<int>(workers_.size());
+    for (int i = 1; i < count; i++) {
+      Worker& victim = *workers_[(index + i) % count];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.queue.empty()) {
+        Directory* directory = victim.queue.front();
+        victim.queue.pop_front();
+        return directory;
+      }
+    }
+    return nullptr;
+  }
+
+  void workerLoop(int index) {
+    Worker& self = *workers_[index];
+    int idle = 0;
+    while (!stop_.load(std::memory_order_relaxed)) {
+      Directory* directory = take(index);
+      if (!directory) {
+        // Done once nothing is queued or being listed anywhere
+        if (outstanding_.load(std::memory_order_acquire) == 0) return;
+        if (++idle < IDLE_SPINS) {
+          std::this_thread::yield();
+        } else {
+          std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        continue;
+      }
+      idle = 0;
+      scan(self, directory);
+      outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+  }
+
+  void scan(Worker& self, Directory* directory) {
+    unsigned long long bytes = 0;
+    unsigned long long files = 0;
+    self.children.clear();
+
+    const bool opened = listDirectory(
+      directory->path,
+      [&](const NativeString::value_type* name, unsigned long long size) {
+        bytes += size;
+        files++;
+        if (self.files.wants(size)) self.files.add({size, directory, name});
+      },
+      [&](const NativeString::value_type* name) {
+        self.owned.push_back(
+          std::make_unique<Directory>(joinPath(directory->path, name), directory));
+        self.children.push_back(self.owned.back().get());
+      });
+
+    if (opened) folders_.fetch_add(1, std::memory_order_relaxed);
+    files_.fetch_add(files, std::memory_order_relaxed);
+    directory->bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    if (!self.children.empty()) {
+      directory->pending.fetch_add(self.children.size(), std::memory_order_relaxed);
+      outstanding_.fetch_add(self.children.size(), std::memory_order_relaxed);
+      std::lock_guard<std::mutex> lock(self.mutex);
+      self.queue.insert(self.queue.end(), self.children.begin(), self.children.end());
+    }
+    finish(self, directory);
+  }
+
+  // Drops one pending count; whoever drops the last one has the folder's
+  // final size and passes it up
+  void finish(Worker& self, Directory* directory) {
+    while (directory &&
+           directory->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      directory->finished = true;
+      const unsigned long long total = directory->bytes.load(std::memory_order_relaxed);
+      self.folders.add({total, directory, {}});
+      if (directory->parent) {
+        directory->parent->bytes.fetch_add(total, std::memory_order_relaxed);
+      }
+      directory = directory->parent;
+    }
+  }
+
+  // After a timeout, folders with unlisted subfolders never finished: pass
+  // what they have up, deepest first
+  void finishPartialTree() {
+    std::vector<Directory*> unfinished;
+    if (!root_->finished) unfinished.push_back(root_.get());
+    for (const auto& worker : workers_) {
+      for (const auto& directory : worker->owned) {
+        if (!directory->finished) unfinished.push_back(directory.get());
+      }
+    }
+    std::sort(unfinished.begin(), unfinished.end(),
+              [](const Directory* a, const Directory* b) { return a->depth > b->depth; });
+    for (Directory* directory : unfinished) {
+      const unsigned long long total = directory->bytes.load();
+      workers_[0]->folders.add({total, directory, {}});
+      if (directory->parent) directory->parent->bytes.fetch_add(total);
+    }
+  }
+
+  SizedPaths collect(TopList Worker::*list) {
+    std::vector<Sized> all;
+    for (const auto& worker : workers_) {
+      auto& items = ((*worker).*list).items();
+      std::move(items.begin(), items.end(), std::back_inserter(all));
+    }
+    const size_t count = std::min(all.size(), options_.topCount);
+    std::partial_sort(all.begin(), all.begin() + count, all.end(),
+                      [](const Sized& a, const Sized& b) { return a.bytes > b.bytes; });
+
+    SizedPaths paths;
+    paths.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+      const Sized& item = all[i];
+      paths.emplace_back(toWide(item.name.empty()
+                                  ? item.directory->path
+                                  : joinPath(item.directory->path, item.name.c_str())),
+                         item.bytes);
+    }
+    return paths;
+  }
+
+  const ScanOptions& options_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::unique_ptr<Directory> root_;
+
+  std::atomic<size_t> outstanding_{0};  // queued or being listed
+  std::atomic<bool> stop_{false};
+  std::atomic<int> running_{0};
+  std::atomic<unsigned long long> files_{0};
+  std::atomic<unsigned long long> folders_{0};
+};
+
+}  // namespace
+
+ScanResults scanTree(const std::filesystem::path& root, const ScanOptions& options) {
+  const int threads =
+    options.threads > 0
+      ? options.threads
+      : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  Scanner scanner(options, threads);
+  return scanner.run(root);
+}
+
+}  // namespace StorageAnalysis
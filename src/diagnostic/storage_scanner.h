@@ -0,0 +1,51 @@
+#pragma once
+#ifndef STORAGE_SCANNER_H
+#define STORAGE_SCANNER_H
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace StorageAnalysis {
+
+// Paths with their size in bytes, largest first
+using SizedPaths = std::vector<std::pair<std::wstring, unsigned long long>>;
+
+struct ScanOptions {
+  int threads = 0;         // 0 = one per logical core
+  size_t topCount = 100;   // largest files and folders kept
+  std::chrono::seconds timeout{120};
+  // Called about every 500 ms from the thread that called scanTree
+  std::function<void(unsigned long long files, unsigned long long folders)>
+    progress = nullptr;
+};
+
+struct ScanResults {
+  SizedPaths largestFolders;  // everything below each folder, root included
+  SizedPaths largestFiles;
+  unsigned long long totalBytes = 0;
+  unsigned long long filesScanned = 0;
+  unsigned long long foldersScanned = 0;
+  bool timedOut = false;  // sizes only cover what was listed by then
+  std::chrono::milliseconds duration{0};
+};
+
+// Walks the tree below root on a pool of threads. Each thread goes depth
+// first through its own queue of directories and, when that runs dry, steals
+// the oldest directory queued by another thread, which tends to be the
+// biggest subtree left. Folder totals are summed bottom-up as the last
+// subdirectory of each folder finishes, so nothing is listed twice, and only
+// the topCount largest files and folders are ever kept.
+//
+// Lists directories with FindFirstFileEx (large fetch) on Windows,
+// getdents64 on Linux and std::filesystem elsewhere. Symbolic links,
+// junctions and other reparse-point directories are not followed.
+ScanResults scanTree(const std::filesystem::path& root,
+                     const ScanOptions& options = {});
+
+}  // namespace StorageAnalysis
+
+#endif  // STORAGE_SCANNER_H
@@ -1,25 +1,65 @@
 #include "Logger.h"
+#include <algorithm>
+#include <array>
 #include <chrono>
-#include <iomanip>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iterator>
 #include <iostream>
 #include <sstream>
 #include <thread>
 
+#include <QByteArray>
+
 #ifdef _WIN32
 #include <Windows.h>
 #endif
 
 using namespace std::chrono;
 
+namespace {
+// Batches are written once they reach FLUSH_BYTES; sinks are flushed at that
+// size, after a batch with a WARN or worse, and at least every FLUSH_INTERVAL
+constexpr size_t FLUSH_BYTES = 64 * 1024;
+constexpr auto FLUSH_INTERVAL = milliseconds(200);
+
+const char* const LEVEL_NAMES[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+
+uint32_t crc32(const char* data, size_t length) {
+  static const auto table = [] {
+    std::array<uint32_t, 256> t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      t[i] = c;
+    }
+    return t;
+  }();
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < length; ++i) {
+    crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+void appendLittleEndian32(std::string& out, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out += static_cast<char>((value >> (8 * i)) & 0xFF);
+  }
+}
+}  // namespace
+
 Logger& Logger::instance() {
   static Logger inst;
   return inst;
 }
 
 Logger::Logger()
-    : currentLevel_(static_cast<LogLevel>(HARDCODED_LOG_LEVEL)),
-      initialized_(false),
-      maxQueueSize_(16384),
+    : initialized_(false),
       running_(false) {}
 
 Logger::~Logger() {
@@ -27,8 +67,8 @@ Logger::~Logger() {
 }
 
 void Logger::init(const std::string& logPath, const std::string& crashPath,
-                  LogLevel level, size_t maxQueue) {
-  std::lock_guard<std::mutex> lock(queueMutex_);
+                  LogLevel level, size_t maxQueue, const LogRotationPolicy& rotation) {
+  std::lock_guard<std::mutex> lock(initMutex_);
   
   if (initialized_.load()) {
     return; // Already initialized
@@ -43,7 +83,21 @@ void Logger::init(const std::string& logPath, const std::string& crashPath,
   };
 
   setLevel(level);
-  maxQueueSize_ = maxQueue;
+
+  size_t capacity = 2;
+  while (capacity < maxQueue) {
+    capacity <<= 1;
+  }
+  ring_ = std::make_unique<Slot[]>(capacity);
+  for (size_t i = 0; i < capacity; ++i) {
+    ring_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  ringMask_ = capacity - 1;
+  enqueuePos_.store(0, std::memory_order_relaxed);
+  dequeuePos_.store(0, std::memory_order_relaxed);
+
+  tail_ = std::make_unique<TailLine[]>(CRASH_TAIL_LINES);
+  tailHead_.store(0, std::memory_order_relaxed);
   
   // Open log files if paths provided
   if (!logPath.empty()) {
@@ -53,6 +107,17 @@ void Logger::init(const std::string& logPath, const std::string& crashPath,
       // Avoid printing absolute paths (may contain personal info such as usernames).
       std::cerr << "Failed to open log file: " << basenameOnly(logPath) << std::endl;
     }
+    std::error_code ec;
+    const auto existing = std::filesystem::file_size(logPath, ec);
+    fileBytes_ = ec ? 0 : static_cast<uint64_t>(existing);
+  }
+  logPath_ = logPath;
+  rotation_ = rotation;
+  fileOpened_ = steady_clock::now();
+  segmentIndex_ = 0;
+  segments_.clear();
+  if (!logPath_.empty()) {
+    loadSegments();
   }
   
   if (!crashPath.empty()) {
@@ -72,99 +137,223 @@ void Logger::init(const std::string& logPath, const std::string& crashPath,
 }
 
 void Logger::setLevel(LogLevel level) { 
-  currentLevel_.store(level); 
+  currentLevel_.store(level, std::memory_order_relaxed); 
 }
 
 LogLevel Logger::getLevel() const { 
   return currentLevel_.load(); 
 }
 
-void Logger::submitAsync(const LogEntry& e) {
+uint64_t Logger::currentThreadId() {
+  thread_local const uint64_t id = [] {
+#ifdef _WIN32
+    return static_cast<uint64_t>(GetCurrentThreadId());
+#else
+    std::ostringstream tid;
+    tid << std::this_thread::get_id();
+    try {
+      return static_cast<uint64_t>(std::stoull(tid.str()));
+    } catch (...) {
+      return uint64_t{0};  // fallback
+    }
+#endif
+  }();
+  return id;
+}
+
+LogEntry Logger::makeEntry(LogLevel level, const char* file, const char* function,
+                           int line) {
+  LogEntry e;
+  e.level = level;
+  e.file = file;
+  e.function = function;
+  e.line = line;
+  e.timestamp_ms = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+  e.thread_id = currentThreadId();
+  return e;
+}
+
+void Logger::submitAsync(LogEntry e) {
   if (!initialized_.load()) {
     return; // Logger not initialized yet
   }
   
-  if (e.level < currentLevel_.load()) {
+  if (e.level < currentLevel_.load(std::memory_order_relaxed)) {
     return; // Below current log level
   }
   
-  {
-    std::lock_guard<std::mutex> lk(queueMutex_);
-    if (queue_.size() >= maxQueueSize_) {
-      // drop policy: drop current (silently)
-      return;
+  if (!tryEnqueue(std::move(e))) {
+    // drop policy: drop current, counted and reported by the worker
+    droppedCount_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if (workerSleeping_.load(std::memory_order_acquire)) {
+    wakeCv_.notify_one();
+  }
+}
+
+bool Logger::tryEnqueue(LogEntry&& e) {
+  size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+  Slot* slot;
+  for (;;) {
+    slot = &ring_[pos & ringMask_];
+    const size_t seq = slot->sequence.load(std::memory_order_acquire);
+    const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return false;  // full: the worker hasn't consumed this slot's last lap
+    } else {
+      pos = enqueuePos_.load(std::memory_order_relaxed);
     }
-    queue_.push(e);
   }
-  queueCv_.notify_one();
+  slot->entry = std::move(e);
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  return true;
 }
 
-void Logger::submitStr(LogLevel level, const std::string& text,
+bool Logger::queueEmpty() const {
+  const size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+  const Slot& slot = ring_[pos & ringMask_];
+  return slot.sequence.load(std::memory_order_acquire) != pos + 1;
+}
+
+void Logger::submit(LogEntry&& e) {
+  if (initialized_.load()) {
+    submitAsync(std::move(e));
+    return;
+  }
+
+  // Fallback to cout if logger not initialized
+  std::cout << "[" << LEVEL_NAMES[e.level] << "] "
+            << (e.args.format ? e.args.toString() : e.message) << std::endl;
+}
+
+void Logger::submitStr(LogLevel level, std::string text,
                        const char* file, const char* function, int line) {
   if (!initialized_.load()) {
     return; // Logger not initialized yet
   }
   
-  LogEntry e;
-  e.level = level;
-  e.message = text;
-  e.file = file ? file : "";
-  e.function = function ? function : "";
-  e.line = line;
-  e.timestamp_ms = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
-  
-  // Get thread ID in a safer way
-  std::ostringstream tid;
-  tid << std::this_thread::get_id();
-  try {
-    e.thread_id = std::stoull(tid.str());
-  } catch (...) {
-    e.thread_id = 0; // fallback
-  }
-  
-  submitAsync(e);
+  LogEntry e = makeEntry(level, file, function, line);
+  // Prefix kept in the fixed-size record for writeCrashTail, which can't
+  // read message while the worker or a producer may be moving it
+  e.args.addText(text);
+  e.message = std::move(text);
+  submitAsync(std::move(e));
 }
 
 void Logger::workerThreadFunc() {
-  while (running_) {
-    std::unique_lock<std::mutex> lk(queueMutex_);
-    queueCv_.wait(lk, [this] { return !queue_.empty() || !running_; });
-    
-    while (!queue_.empty()) {
-      LogEntry e = std::move(queue_.front());
-      queue_.pop();
-      lk.unlock();
-      
-      // write to sinks
-      try {
-        writeToConsole(e);
-        writeToFile(e);
-      } catch (...) {
-        // Swallow errors; this is logging - don't let logging errors crash the app
+  std::string batch;
+  batch.reserve(FLUSH_BYTES + 4096);
+  size_t unflushedBytes = 0;
+  auto lastFlush = steady_clock::now();
+
+  for (;;) {
+    // Read before draining so nothing submitted before shutdown() is lost
+    const bool stopping = !running_.load();
+
+    bool urgent = false;
+    try {
+      urgent = drainInto(batch);
+
+      const uint64_t dropped = droppedCount_.load(std::memory_order_relaxed);
+      if (dropped != droppedReported_) {
+        LogEntry notice = makeEntry(WARN_LEVEL, nullptr, nullptr, 0);
+        notice.message = "Logger queue full, dropped " +
+                         std::to_string(dropped - droppedReported_) + " entries";
+        const size_t start = batch.size();
+        appendEntry(batch, notice);
+        appendToTail(batch.data() + start, batch.size() - start);
+        batch += '\n';
+        droppedReported_ = dropped;
+        urgent = true;
+      }
+
+      if (!batch.empty()) {
+        writeBatch(batch);
+        unflushedBytes += batch.size();
       }
-      lk.lock();
+    } catch (...) {
+      // Swallow errors; this is logging - don't let logging errors crash the app
+    }
+    batch.clear();
+
+    const auto now = steady_clock::now();
+    if (unflushedBytes > 0 &&
+        (urgent || unflushedBytes >= FLUSH_BYTES || now - lastFlush >= FLUSH_INTERVAL)) {
+      flushSinks();
+      unflushedBytes = 0;
+      lastFlush = now;
     }
-  }
-  
-  // flush remaining on shutdown
-  std::queue<LogEntry> remaining;
-  {
-    std::lock_guard<std::mutex> lk(queueMutex_);
-    remaining = std::move(queue_);
-  }
-  
-  while (!remaining.empty()) {
     try {
-      writeToConsole(remaining.front());
-      writeToFile(remaining.front());
+      rotateIfNeeded();
     } catch (...) {
-      // Swallow errors during shutdown too
+      // Keep logging to the current file
+    }
+
+    if (!queueEmpty()) {
+      continue;
+    }
+    if (stopping) {
+      break;
     }
-    remaining.pop();
+
+    std::unique_lock<std::mutex> lk(wakeMutex_);
+    workerSleeping_.store(true, std::memory_order_seq_cst);
+    // Re-check after announcing the sleep so a producer that missed the flag
+    // has already published its entry
+    if (queueEmpty() && running_.load()) {
+      wakeCv_.wait_for(lk, FLUSH_INTERVAL);
+    }
+    workerSleeping_.store(false, std::memory_order_relaxed);
   }
-  
+
   // ensure file flush
-  std::lock_guard<std::mutex> fsl(fileMutex_);
+  flushSinks();
+}
+
+bool Logger::drainInto(std::string& batch) {
+  bool urgent = false;
+  size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+  while (batch.size() < FLUSH_BYTES) {
+    Slot& slot = ring_[pos & ringMask_];
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+      break;  // empty, or the next producer hasn't finished writing
+    }
+    try {
+      const size_t start = batch.size();
+      appendEntry(batch, slot.entry);
+      appendToTail(batch.data() + start, batch.size() - start);
+      batch += '\n';
+    } catch (...) {
+      // Skip the entry but still release its slot
+    }
+    urgent = urgent || slot.entry.level >= WARN_LEVEL;
+    // The entry is left as is (writeCrashSync may be reading it) and
+    // replaced by the producer that reuses the slot
+    slot.sequence.store(pos + ringMask_ + 1, std::memory_order_release);
+    dequeuePos_.store(++pos, std::memory_order_release);
+  }
+  return urgent;
+}
+
+void Logger::writeBatch(const std::string& batch) {
+  // Use cout which will be redirected by the existing ConsoleOutputBuf system
+  std::cout.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+
+  std::lock_guard<std::mutex> lk(fileMutex_);
+  if (fileSink_.is_open()) {
+    fileSink_.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+    fileBytes_ += batch.size();
+  }
+}
+
+void Logger::flushSinks() {
+  std::cout.flush();
+  std::lock_guard<std::mutex> lk(fileMutex_);
   if (fileSink_.is_open()) {
     fileSink_.flush();
   }
@@ -173,21 +362,216 @@ void Logger::workerThreadFunc() {
   }
 }
 
-void Logger::writeToConsole(const LogEntry& e) {
-  std::string s = formatEntry(e);
-  // Use cout which will be redirected by the existing ConsoleOutputBuf system
-  std::cout << s << std::endl;
+void Logger::rotateIfNeeded() {
+  if (logPath_.empty() || fileBytes_ == 0) {
+    return;
+  }
+  const bool tooBig = rotation_.maxFileBytes > 0 && fileBytes_ >= rotation_.maxFileBytes;
+  const bool tooOld = rotation_.maxAge.count() > 0 &&
+                      steady_clock::now() - fileOpened_ >= rotation_.maxAge;
+  if (!tooBig && !tooOld) {
+    return;
+  }
+
+  const std::string segment = segmentPath(++segmentIndex_);
+  std::error_code ec;
+  {
+    std::lock_guard<std::mutex> lk(fileMutex_);
+    fileSink_.flush();
+    fileSink_.close();
+    std::filesystem::rename(logPath_, segment, ec);
+    // If the rename failed this keeps appending to the same file
+    fileSink_.open(logPath_, std::ios::out | std::ios::app);
+    fileBytes_ = 0;
+    fileOpened_ = steady_clock::now();
+  }
+  if (ec) {
+    return;
+  }
+
+  segments_.push_back(segment);
+  pruneSegments();
+
+  if (rotation_.compress) {
+    // One segment at a time; the previous one is long done by now
+    if (compressor_.joinable()) {
+      compressor_.join();
+    }
+    compressor_ = std::thread(&Logger::compressSegment, segment);
+  }
 }
 
-void Logger::writeToFile(const LogEntry& e) {
-  std::lock_guard<std::mutex> lk(fileMutex_);
-  if (fileSink_.is_open()) {
-    fileSink_ << formatEntry(e) << '\n';
-    // Flush periodically for important messages
-    if (e.level >= WARN_LEVEL) {
-      fileSink_.flush();
+void Logger::loadSegments() {
+  // Segments left by earlier runs: "<stem>.<n><ext>", or ".gz" once compressed
+  const std::filesystem::path path(logPath_);
+  const std::string prefix = path.stem().string() + ".";
+  const std::string extension = path.extension().string();
+  std::vector<int> indices;
+  std::error_code ec;
+  const std::filesystem::path dir = path.has_parent_path() ? path.parent_path() : ".";
+  for (std::filesystem::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+    std::string name = it->path().filename().string();
+    if (name.size() > 3 && name.compare(name.size() - 3, 3, ".gz") == 0) {
+      name.resize(name.size() - 3);
     }
+    if (name.size() <= prefix.size() + extension.size() || name.compare(0, prefix.size(), prefix) != 0 ||
+        name.compare(name.size() - extension.size(), extension.size(), extension) != 0) {
+      continue;
+    }
+    const std::string digits =
+      name.substr(prefix.size(), name.size() - prefix.size() - extension.size());
+    if (digits.size() > 9 || !std::all_of(digits.begin(), digits.end(),
+                                          [](char c) { return c >= '0' && c <= '9'; })) {
+      continue;
+    }
+    indices.push_back(std::stoi(digits));
+  }
+
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  for (int index : indices) {
+    segments_.push_back(segmentPath(index));
   }
+  segmentIndex_ = indices.empty() ? 0 : indices.back();
+  pruneSegments();
+}
+
+void Logger::pruneSegments() {
+  std::error_code ec;
+  while (segments_.size() > static_cast<size_t>(std::max(rotation_.maxRotatedFiles, 0))) {
+    std::filesystem::remove(segments_.front(), ec);
+    std::filesystem::remove(segments_.front() + ".gz", ec);
+    segments_.pop_front();
+  }
+}
+
+std::string Logger::segmentPath(int index) const {
+  const std::filesystem::path path(logPath_);
+  std::filesystem::path segment = path;
+  segment.replace_filename(path.stem().string() + "." + std::to_string(index) +
+                           path.extension().string());
+  return segment.string();
+}
+
+void Logger::compressSegment(const std::string& path) {
+  try {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+      return;
+    }
+    const std::string raw((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    // qCompress gives a 4-byte length, a 2-byte zlib header, the deflate
+    // stream and a 4-byte Adler-32; rewrap the deflate stream as gzip
+    const QByteArray zlib =
+      qCompress(reinterpret_cast<const uchar*>(raw.data()), static_cast<qsizetype>(raw.size()), 6);
+    if (zlib.size() < 10) {
+      return;
+    }
+    std::string gz("\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff", 10);
+    gz.append(zlib.constData() + 6, static_cast<size_t>(zlib.size() - 10));
+    appendLittleEndian32(gz, crc32(raw.data(), raw.size()));
+    appendLittleEndian32(gz, static_cast<uint32_t>(raw.size()));
+
+    const std::string tmpPath = path + ".gz.tmp";
+    {
+      std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+      out.write(gz.data(), static_cast<std::streamsize>(gz.size()));
+      if (!out.flush()) {
+        out.close();
+        std::error_code ec;
+        std::filesystem::remove(tmpPath, ec);
+        return;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path + ".gz", ec);
+    if (!ec) {
+      std::filesystem::remove(path, ec);
+    }
+  } catch (...) {
+    // Leave the segment uncompressed
+  }
+}
+
+void Logger::appendToTail(const char* text, size_t length) {
+  const uint64_t head = tailHead_.load(std::memory_order_relaxed);
+  TailLine& line = tail_[head % CRASH_TAIL_LINES];
+  const uint32_t seq = line.seq.load(std::memory_order_relaxed);
+  line.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  length = std::min(length, CRASH_TAIL_LINE_BYTES);
+  line.length.store(static_cast<uint16_t>(length), std::memory_order_relaxed);
+  std::memcpy(line.text, text, length);
+  line.seq.store(seq + 2, std::memory_order_release);
+  tailHead_.store(head + 1, std::memory_order_release);
+}
+
+// writeCrashTail copies it out of slots that may be rewritten meanwhile
+static_assert(std::is_trivially_copyable_v<LogArgs>);
+
+void Logger::writeCrashTail(std::ostream& out, bool includeWritten) {
+  // Lines the worker has already written, oldest first. A line being
+  // rewritten while it's copied is skipped.
+  if (includeWritten && tail_) {
+    const uint64_t head = tailHead_.load(std::memory_order_acquire);
+    const uint64_t first = head > CRASH_TAIL_LINES ? head - CRASH_TAIL_LINES : 0;
+    out << "---- last " << (head - first) << " log lines ----\n";
+    char text[CRASH_TAIL_LINE_BYTES];
+    for (uint64_t i = first; i < head; ++i) {
+      const TailLine& line = tail_[i % CRASH_TAIL_LINES];
+      const uint32_t before = line.seq.load(std::memory_order_acquire);
+      if (before & 1) {
+        continue;
+      }
+      const size_t length =
+        std::min<size_t>(line.length.load(std::memory_order_relaxed), CRASH_TAIL_LINE_BYTES);
+      std::memcpy(text, line.text, length);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (line.seq.load(std::memory_order_relaxed) != before) {
+        continue;
+      }
+      out.write(text, static_cast<std::streamsize>(length));
+      out << '\n';
+    }
+  }
+
+  // Entries still queued, i.e. not in any sink yet. Only the fixed-size part
+  // of a slot is copied, never its strings, and the copy is dropped if the
+  // slot's sequence moved meanwhile (consumed, or refilled by a producer).
+  // Streamed messages are shown up to LogArgs::TEXT_CAPACITY bytes.
+  if (ring_) {
+    size_t pos = dequeuePos_.load(std::memory_order_acquire);
+    const size_t end = enqueuePos_.load(std::memory_order_acquire);
+    out << "---- " << (end - pos) << " queued log entries ----\n";
+    for (size_t n = 0; pos != end && n <= ringMask_; ++pos, ++n) {
+      const Slot& slot = ring_[pos & ringMask_];
+      if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+        continue;
+      }
+      LogEntry copy;
+      copy.level = slot.entry.level;
+      copy.file = slot.entry.file;
+      copy.function = slot.entry.function;
+      copy.line = slot.entry.line;
+      copy.timestamp_ms = slot.entry.timestamp_ms;
+      copy.thread_id = slot.entry.thread_id;
+      std::memcpy(static_cast<void*>(&copy.args), &slot.entry.args, sizeof(LogArgs));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != pos + 1) {
+        continue;
+      }
+      if (!copy.args.format) {
+        copy.message.assign(copy.args.text, std::min<size_t>(copy.args.textUsed, LogArgs::TEXT_CAPACITY));
+        if (copy.args.textUsed == LogArgs::TEXT_CAPACITY) {
+          copy.message += "...";
+        }
+      }
+      out << formatEntry(copy) << '\n';
+    }
+  }
+  out << "---- crash ----\n";
 }
 
 void Logger::writeToCrashFileSync(const LogEntry& e) {
@@ -195,14 +579,19 @@ void Logger::writeToCrashFileSync(const LogEntry& e) {
   std::string formatted = formatEntry(e);
   
   if (crashFileSink_.is_open()) {
+    writeCrashTail(crashFileSink_, true);
     crashFileSink_ << formatted << std::endl;
     crashFileSink_.flush();
   } else if (fileSink_.is_open()) {
-    // fallback to regular file if crash file not present
+    // fallback to regular file if crash file not present; it already has
+    // what the worker wrote
+    fileSink_.flush();
+    writeCrashTail(fileSink_, false);
     fileSink_ << "[CRASH] " << formatted << std::endl;
     fileSink_.flush();
   } else {
     // as a last resort, write to cerr synchronously
+    writeCrashTail(std::cerr, true);
     std::cerr << "[CRASH] " << formatted << std::endl;
   }
 }
@@ -212,8 +601,14 @@ void Logger::writeCrashSync(const LogEntry& e) {
 }
 
 std::string Logger::formatEntry(const LogEntry& e) {
-  std::ostringstream oss;
-  
+  std::string out;
+  appendEntry(out, e);
+  return out;
+}
+
+void Logger::appendEntry(std::string& out, const LogEntry& e) {
+  char buffer[96];
+
   // Format timestamp
   auto ms = e.timestamp_ms;
   std::time_t t = ms / 1000;
@@ -225,37 +620,42 @@ std::string Logger::formatEntry(const LogEntry& e) {
   localtime_r(&t, &tm);
 #endif
   
-  oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << "." 
-      << std::setfill('0') << std::setw(3) << (ms % 1000);
-  
-  // Log level names
-  static const char* names[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
-  oss << " [" << names[e.level] << "]";
+  size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm);
+  length += std::snprintf(buffer + length, sizeof(buffer) - length, ".%03u [%s]",
+                          static_cast<unsigned>(ms % 1000), LEVEL_NAMES[e.level]);
+  out.append(buffer, length);
   
   // Thread ID
   if (e.thread_id != 0) {
-    oss << " [tid=" << e.thread_id << "]";
+    out.append(buffer, std::snprintf(buffer, sizeof(buffer), " [tid=%llu]",
+                                     static_cast<unsigned long long>(e.thread_id)));
   }
   
   // File location info (only include filename, not full path)
-  if (!e.file.empty()) {
-    std::string filename = e.file;
+  if (e.file && *e.file) {
+    std::string_view filename = e.file;
     size_t lastSlash = filename.find_last_of("/\\");
-    if (lastSlash != std::string::npos) {
-      filename = filename.substr(lastSlash + 1);
+    if (lastSlash != std::string_view::npos) {
+      filename.remove_prefix(lastSlash + 1);
     }
-    oss << " (" << filename;
+    out += " (";
+    out += filename;
     if (e.line > 0) {
-      oss << ":" << e.line;
+      out.append(buffer, std::snprintf(buffer, sizeof(buffer), ":%d", e.line));
     }
-    if (!e.function.empty()) {
-      oss << " " << e.function;
+    if (e.function && *e.function) {
+      out += ' ';
+      out += e.function;
     }
-    oss << ")";
+    out += ')';
   }
   
-  oss << " " << e.message;
-  return oss.str();
+  out += ' ';
+  if (e.args.format) {
+    out += e.args.toString();
+  } else {
+    out += e.message;
+  }
 }
 
 void Logger::shutdown() {
@@ -264,11 +664,17 @@ void Logger::shutdown() {
   }
   
   running_ = false;
-  queueCv_.notify_all();
+  {
+    std::lock_guard<std::mutex> lk(wakeMutex_);
+    wakeCv_.notify_all();
+  }
   
   if (worker_.joinable()) {
     worker_.join();
   }
+  if (compressor_.joinable()) {
+    compressor_.join();
+  }
   
   std::lock_guard<std::mutex> lk(fileMutex_);
   if (fileSink_.is_open()) {
@@ -291,36 +697,80 @@ LogMessageBuilder::LogMessageBuilder(LogLevel lvl, const char* file,
 LogMessageBuilder::~LogMessageBuilder() {
   try {
     Logger& logger = Logger::instance();
-    if (logger.isInitialized()) {
-      logger.submitStr(level_, oss_.str(), file_, func_, line_);
-      
-      if (level_ == FATAL_LEVEL) {
-        // ensure FATALs are forced to crash sink synchronously too
-        LogEntry e;
-        e.level = level_;
-        e.message = oss_.str();
-        e.file = file_ ? file_ : "";
-        e.function = func_ ? func_ : "";
-        e.line = line_;
-        e.timestamp_ms = duration_cast<milliseconds>(
-            system_clock::now().time_since_epoch()).count();
-        
-        std::ostringstream tid;
-        tid << std::this_thread::get_id();
-        try {
-          e.thread_id = std::stoull(tid.str());
-        } catch (...) {
-          e.thread_id = 0;
-        }
-        
-        logger.writeCrashSync(e);
-      }
-    } else {
-      // Fallback to cout if logger not initialized
-      static const char* names[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
-      std::cout << "[" << names[level_] << "] " << oss_.str() << std::endl;
+    LogEntry e = Logger::makeEntry(level_, file_, func_, line_);
+    e.message = oss_.str();
+    // Prefix for writeCrashTail, as in submitStr
+    e.args.addText(e.message);
+
+    if (level_ == FATAL_LEVEL && logger.isInitialized()) {
+      // ensure FATALs are forced to crash sink synchronously too
+      logger.writeCrashSync(e);
     }
+    logger.submit(std::move(e));
   } catch (...) {
     // nothing to do - don't let logging errors propagate
   }
 }
+
+void LogArgs::addText(std::string_view str) {
+  if (count >= MAX_ARGS) return;
+  const size_t length = std::min(str.size(), TEXT_CAPACITY - textUsed);
+  std::memcpy(text + textUsed, str.data(), length);
+  types[count] = Type::Text;
+  values[count].text.offset = textUsed;
+  values[count].text.length = static_cast<uint8_t>(length);
+  textUsed = static_cast<uint8_t>(textUsed + length);
+  count++;
+}
+
+std::string LogArgs::toString() const {
+  std::string out;
+  out.reserve(128);
+
+  auto append = [&](int index) {
+    char buffer[32];
+    const Value& v = values[index];
+    switch (types[index]) {
+      case Type::Int:
+        out.append(buffer, std::snprintf(buffer, sizeof(buffer), "%lld",
+                                         static_cast<long long>(v.i)));
+        break;
+      case Type::UInt:
+        out.append(buffer, std::snprintf(buffer, sizeof(buffer), "%llu",
+                                         static_cast<unsigned long long>(v.u)));
+        break;
+      case Type::Double:
+        // Same as the default ostream formatting used by LOG_* <<
+        out.append(buffer, std::snprintf(buffer, sizeof(buffer), "%g", v.d));
+        break;
+      case Type::Bool:
+        out += v.u ? "1" : "0";
+        break;
+      case Type::Char:
+        out += static_cast<char>(v.u);
+        break;
+      case Type::Pointer:
+        out.append(buffer, std::snprintf(buffer, sizeof(buffer), "%p", v.p));
+        break;
+      case Type::Text:
+        out.append(text + v.text.offset, v.text.length);
+        break;
+    }
+  };
+
+  // "{}" takes the next argument; arguments without one are appended
+  int next = 0;
+  for (const char* c = format; *c; ++c) {
+    if (c[0] == '{' && c[1] == '}' && next < count) {
+      append(next++);
+      ++c;
+    } else {
+      out += *c;
+    }
+  }
+  for (; next < count; ++next) {
+    out += ' ';
+    append(next);
+  }
+  return out;
+}
@@ -1,79 +1,251 @@
 #pragma once
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <fstream>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <sstream>
 #include <string>
-#include <QString>
+#include <string_view>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
+#include <QByteArray>
+#include <QString>
+
 // Hardcoded log level - can be changed here for now
 constexpr int HARDCODED_LOG_LEVEL = 1; // 0=TRACE, 1=DEBUG, 2=INFO, 3=WARN, 4=ERROR, 5=FATAL
 
 enum LogLevel { TRACE_LEVEL=0, DEBUG_LEVEL, INFO_LEVEL, WARN_LEVEL, ERROR_LEVEL, FATAL_LEVEL };
 
+// Arguments of a LOG_*F call, captured by value into a fixed-size record so
+// formatting (and any allocation) happens on the logger's worker thread
+struct LogArgs {
+  static constexpr int MAX_ARGS = 8;
+  static constexpr size_t TEXT_CAPACITY = 96;  // all string arguments, truncated
+
+  enum class Type : uint8_t { Int, UInt, Double, Bool, Char, Pointer, Text };
+
+  const char* format = nullptr;  // string literal; "{}" per argument
+  uint8_t count = 0;
+  uint8_t textUsed = 0;
+  Type types[MAX_ARGS];
+  union Value {
+    int64_t i;
+    uint64_t u;
+    double d;
+    const void* p;
+    struct {
+      uint8_t offset;
+      uint8_t length;
+    } text;
+  } values[MAX_ARGS];
+  char text[TEXT_CAPACITY];
+
+  template <typename T>
+  void add(const T& v) {
+    using U = std::decay_t<T>;
+    if (count >= MAX_ARGS) return;
+    Value& value = values[count];
+    Type& type = types[count];
+    if constexpr (std::is_same_v<U, bool>) {
+      type = Type::Bool;
+      value.u = v ? 1 : 0;
+    } else if constexpr (std::is_same_v<U, char>) {
+      type = Type::Char;
+      value.u = static_cast<unsigned char>(v);
+    } else if constexpr (std::is_enum_v<U>) {
+      type = Type::Int;
+      value.i = static_cast<int64_t>(v);
+    } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+      type = Type::Int;
+      value.i = static_cast<int64_t>(v);
+    } else if constexpr (std::is_integral_v<U>) {
+      type = Type::UInt;
+      value.u = static_cast<uint64_t>(v);
+    } else if constexpr (std::is_floating_point_v<U>) {
+      type = Type::Double;
+      value.d = static_cast<double>(v);
+    } else if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>) {
+      addText(v ? std::string_view(v) : std::string_view("(null)"));
+      return;
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+      addText(std::string_view(v));
+      return;
+    } else if constexpr (std::is_same_v<U, QString>) {
+      const QByteArray utf8 = v.toUtf8();
+      addText(std::string_view(utf8.constData(), static_cast<size_t>(utf8.size())));
+      return;
+    } else if constexpr (std::is_pointer_v<U>) {
+      type = Type::Pointer;
+      value.p = static_cast<const void*>(v);
+    } else {
+      static_assert(sizeof(U) == 0, "LOG_*F argument type is not supported");
+    }
+    count++;
+  }
+
+  void addText(std::string_view str);
+
+  // Expands the format with the captured arguments (worker thread)
+  std::string toString() const;
+};
+
 struct LogEntry {
   LogLevel level;
-  std::string message;
-  std::string file;
-  std::string function;
+  std::string message;         // streamed text; empty when args.format is set
+  const char* file = nullptr;  // __FILE__ / __func__ literals, never copied
+  const char* function = nullptr;
   int line;
   uint64_t timestamp_ms;
   uint64_t thread_id;
+  LogArgs args;
+};
+
+// When the file sink is rotated. The current file keeps its name; rotated
+// segments become "<name>.<n><ext>" (gzipped to "<name>.<n><ext>.gz")
+struct LogRotationPolicy {
+  uint64_t maxFileBytes = 16ull * 1024 * 1024;  // 0 = no size limit
+  std::chrono::minutes maxAge{60};               // 0 = no age limit
+  int maxRotatedFiles = 8;                       // older segments are deleted
+  bool compress = true;                          // in the background, after rotation
 };
 
 class Logger {
  public:
+  // Last formatted lines kept in memory for writeCrashSync
+  static constexpr size_t CRASH_TAIL_LINES = 512;
+  static constexpr size_t CRASH_TAIL_LINE_BYTES = 494;  // longer lines are cut
+
+
   static Logger& instance();
 
-  // initialize logger; if logPath empty -> no file sink
+  // initialize logger; if logPath empty -> no file sink.
+  // maxQueue is rounded up to a power of two; that many entries are preallocated
   void init(const std::string& logPath = "", const std::string& crashPath = "",
-            LogLevel level = static_cast<LogLevel>(HARDCODED_LOG_LEVEL), size_t maxQueue = 16384);
+            LogLevel level = static_cast<LogLevel>(HARDCODED_LOG_LEVEL), size_t maxQueue = 16384,
+            const LogRotationPolicy& rotation = LogRotationPolicy());
 
   // change runtime level
   void setLevel(LogLevel level);
   LogLevel getLevel() const;
 
+  // The LOG_* macros check this before evaluating any operands
+  static bool isEnabled(LogLevel level) {
+    return level >= currentLevel_.load(std::memory_order_relaxed);
+  }
+
+  // OS thread id, looked up once per thread
+  static uint64_t currentThreadId();
+
+  // Entry with level, source location, timestamp and thread id filled in
+  static LogEntry makeEntry(LogLevel level, const char* file, const char* function,
+                            int line);
+
   // Submit asynchronously; will be filtered by current level
-  void submitAsync(const LogEntry& e);
+  void submitAsync(LogEntry e);
+
+  // Queues e, or prints it to stdout if the logger isn't initialized yet
+  void submit(LogEntry&& e);
 
-  // Synchronous crash write (guaranteed): bypass queue, flush immediately
+  // Fast path behind LOG_*F: arguments are stored, not formatted
+  template <typename... Args>
+  void submitFormat(LogLevel level, const char* file, const char* function, int line,
+                    const char* format, const Args&... args) {
+    static_assert(sizeof...(Args) <= LogArgs::MAX_ARGS, "too many LOG_*F arguments");
+    LogEntry e = makeEntry(level, file, function, line);
+    e.args.format = format;
+    (e.args.add(args), ...);
+    submit(std::move(e));
+  }
+
+  // Synchronous crash write (guaranteed): bypass queue, flush immediately.
+  // The crash sink also gets the last CRASH_TAIL_LINES lines written and
+  // whatever is still queued, so the report doesn't depend on the worker.
   void writeCrashSync(const LogEntry& e);
 
   // Flush pending async logs and stop worker
   void shutdown();
 
   // helper used by LogMessageBuilder
-  void submitStr(LogLevel level, const std::string& text,
+  void submitStr(LogLevel level, std::string text,
                  const char* file, const char* function, int line);
 
   // Check if the logger is initialized
   bool isInitialized() const { return initialized_.load(); }
 
+  // Entries dropped because the queue was full, since init
+  uint64_t droppedCount() const { return droppedCount_.load(std::memory_order_relaxed); }
+
  private:
   Logger();
   ~Logger();
 
+  // One crash tail line; seq is odd while the worker rewrites it
+  struct TailLine {
+    std::atomic<uint32_t> seq{0};
+    std::atomic<uint16_t> length{0};
+    char text[CRASH_TAIL_LINE_BYTES];
+  };
+
+  // Bounded lock-free MPSC ring (Vyukov). A slot's sequence equals its
+  // position when free, position + 1 once written, and moves a lap ahead
+  // when the worker has consumed it.
+  struct Slot {
+    std::atomic<size_t> sequence{0};
+    LogEntry entry;
+  };
+
+  bool tryEnqueue(LogEntry&& e);
+  bool queueEmpty() const;
+
   void workerThreadFunc();
+  // Formats queued entries into batch, up to about one flush worth; returns
+  // whether any of them was WARN or above
+  bool drainInto(std::string& batch);
 
   // sinks
-  void writeToConsole(const LogEntry& e);
-  void writeToFile(const LogEntry& e);          // async file sink
+  void writeBatch(const std::string& batch);   // async console + file sink
+  void flushSinks();
   void writeToCrashFileSync(const LogEntry& e); // sync crash sink
 
+  // rotation (worker thread)
+  void rotateIfNeeded();
+  void loadSegments();   // init: continue after the segments already on disk
+  void pruneSegments();  // keep the newest rotation_.maxRotatedFiles
+  std::string segmentPath(int index) const;
+  static void compressSegment(const std::string& path);
+
+  // crash tail
+  void appendToTail(const char* text, size_t length);
+  void writeCrashTail(std::ostream& out, bool includeWritten);
+
   // formatting
-  std::string formatEntry(const LogEntry& e);
+  static void appendEntry(std::string& out, const LogEntry& e);
+  static std::string formatEntry(const LogEntry& e);
 
   // state
-  std::atomic<LogLevel> currentLevel_;
+  inline static std::atomic<LogLevel> currentLevel_{
+    static_cast<LogLevel>(HARDCODED_LOG_LEVEL)};
   std::atomic<bool> initialized_;
-  std::mutex queueMutex_;
-  std::condition_variable queueCv_;
-  std::queue<LogEntry> queue_;
-  size_t maxQueueSize_;
+  std::mutex initMutex_;
+
+  std::unique_ptr<Slot[]> ring_;
+  size_t ringMask_ = 0;
+  alignas(64) std::atomic<size_t> enqueuePos_{0};
+  alignas(64) std::atomic<size_t> dequeuePos_{0};  // written by the worker only
+  std::atomic<uint64_t> droppedCount_{0};
+  uint64_t droppedReported_ = 0;       // worker thread only
+
+  // The worker only sleeps when the ring is empty; producers wake it if so.
+  // A missed wake-up costs at most one flush interval.
+  std::mutex wakeMutex_;
+  std::condition_variable wakeCv_;
+  std::atomic<bool> workerSleeping_{false};
   std::thread worker_;
   std::atomic<bool> running_;
 
@@ -81,6 +253,19 @@ class Logger {
   std::mutex fileMutex_;
   std::ofstream fileSink_;
   std::ofstream crashFileSink_;
+
+  // rotation state, worker thread only once running
+  std::string logPath_;
+  LogRotationPolicy rotation_;
+  uint64_t fileBytes_ = 0;
+  std::chrono::steady_clock::time_point fileOpened_;
+  int segmentIndex_ = 0;                // highest on disk, including earlier runs
+  std::deque<std::string> segments_;  // rotated, oldest first, without ".gz"
+  std::thread compressor_;
+
+  // Written by the worker as lines go out, read lock-free by writeCrashSync
+  std::unique_ptr<TailLine[]> tail_;
+  std::atomic<uint64_t> tailHead_{0};
 };
  
 // stream builder to produce messages with << and submit on destruction
@@ -109,11 +294,38 @@ class LogMessageBuilder {
   std::ostringstream oss_;
 };
 
+// Turns the builder expression into void so it fits the ?: in LOG_STREAM
+struct LogMessageVoidify {
+  void operator&(const LogMessageBuilder&) {}
+};
+
+// Operands after << are only evaluated when the level is enabled
+#define LOG_STREAM(lvl)               \
+  !Logger::isEnabled(lvl) ? (void)0   \
+  : LogMessageVoidify() & LogMessageBuilder(lvl, __FILE__, __func__, __LINE__)
+
 // convenience macros for usage - these automatically handle initialization check
-#define LOG_TRACE LogMessageBuilder(TRACE_LEVEL, __FILE__, __func__, __LINE__)
-#define LOG_DEBUG LogMessageBuilder(DEBUG_LEVEL, __FILE__, __func__, __LINE__)
-#define LOG_INFO  LogMessageBuilder(INFO_LEVEL,  __FILE__, __func__, __LINE__)
-#define LOG_WARN  LogMessageBuilder(WARN_LEVEL,  __FILE__, __func__, __LINE__)
-#define LOG_ERROR LogMessageBuilder(ERROR_LEVEL, __FILE__, __func__, __LINE__)
-#define LOG_FATAL LogMessageBuilder(FATAL_LEVEL, __FILE__, __func__, __LINE__)
+#define LOG_TRACE LOG_STREAM(TRACE_LEVEL)
+#define LOG_DEBUG LOG_STREAM(DEBUG_LEVEL)
+#define LOG_INFO  LOG_STREAM(INFO_LEVEL)
+#define LOG_WARN  LOG_STREAM(WARN_LEVEL)
+#define LOG_ERROR LOG_STREAM(ERROR_LEVEL)
+#define LOG_FATAL LOG_STREAM(FATAL_LEVEL)
+
+// Structured fast path for hot code: a string literal with "{}" per argument
+// and up to 8 numbers, bools, chars, pointers or strings. Arguments are copied
+// into the entry as-is and formatted on the worker thread.
+//   LOG_DEBUGF("frames: {}, worst: {}ms", count, worstMs);
+#define LOG_FORMAT(lvl, ...)                                            \
+  do {                                                                  \
+    if (Logger::isEnabled(lvl)) {                                       \
+      Logger::instance().submitFormat(lvl, __FILE__, __func__, __LINE__, \
+                                      __VA_ARGS__);                     \
+    }                                                                   \
+  } while (0)
 
+#define LOG_TRACEF(...) LOG_FORMAT(TRACE_LEVEL, __VA_ARGS__)
+#define LOG_DEBUGF(...) LOG_FORMAT(DEBUG_LEVEL, __VA_ARGS__)
+#define LOG_INFOF(...)  LOG_FORMAT(INFO_LEVEL, __VA_ARGS__)
+#define LOG_WARNF(...)  LOG_FORMAT(WARN_LEVEL, __VA_ARGS__)
+#define LOG_ERRORF(...) LOG_FORMAT(ERROR_LEVEL, __VA_ARGS__)
@@ -1,6 +1,8 @@
 #include "BaseApiClient.h"
 #include "../core/QtNetworkClient.h"
 #include "../serialization/JsonSerializer.h"
+#include "../serialization/ProtobufSerializer.h"
+#include "../serialization/ProtoMessageView.h"
 #include "../crypto/NullCryptoProvider.h"
 #include "../../logging/Logger.h"
 #include "../../ApplicationSettings.h"
@@ -56,6 +58,15 @@ void BaseApiClient::setCache(std::shared_ptr<NetworkCache> cache) {
     m_cache = cache;
 }
 
+void BaseApiClient::setDiskCache(std::shared_ptr<HttpDiskCache> cache) {
+    m_diskCache = cache;
+}
+
+void BaseApiClient::onCachedResponseUpdated(const QString& cacheKey, const ApiResponse& response) {
+    Q_UNUSED(cacheKey);
+    Q_UNUSED(response);
+}
+
 void BaseApiClient::get(const QString& path, ApiCallback callback, bool useCache,
                        const QString& expectedProtoType) {
     QString cacheKey = generateCacheKey(path);
@@ -119,6 +130,36 @@ void BaseApiClient::sendRequest(const RequestBuilder& builder, const QVariant& d
     }
     
     NetworkRequest request = builder.build();
+
+    // Disk cache: a fresh entry answers without a request; a stale one answers
+    // now and is revalidated below. Any entry with an ETag is sent as
+    // If-None-Match so an unchanged response comes back as a bodiless 304.
+    HttpCacheEntry diskEntry;
+    bool answeredFromDisk = false;
+    if (request.method == HttpMethod::GET && useCache && !cacheKey.isEmpty() && m_diskCache) {
+        diskEntry = m_diskCache->lookup(cacheKey);
+        const QDateTime now = QDateTime::currentDateTimeUtc();
+        if (diskEntry.isUsableStale(now)) {
+            ApiResponse cached = createCachedApiResponse(diskEntry, request.url, expectedProtoType);
+            if (cached.success) {
+                if (m_cache) {
+                    m_cache->set(cacheKey, cached.data, ttlSeconds);
+                }
+                const bool fresh = diskEntry.isFresh(now);
+                LOG_INFO << "Disk cache " << (fresh ? "hit" : "stale hit, revalidating") << ": "
+                         << cacheKey.toStdString() << " age=" << diskEntry.storedAtUtc.secsTo(now) << "s";
+                callback(cached);
+                if (fresh) {
+                    return;
+                }
+                answeredFromDisk = true;
+            }
+        }
+        if (diskEntry.isValid() && !diskEntry.etag.isEmpty()) {
+            request.headers[QStringLiteral("If-None-Match")] = diskEntry.etag;
+        }
+    }
+
     LOG_WARN << "HTTP request: method=" << static_cast<int>(request.method)
              << " url=" << request.url.toStdString()
              << " cache=" << (useCache ? "on" : "off")
@@ -161,7 +202,7 @@ void BaseApiClient::sendRequest(const RequestBuilder& builder, const QVariant& d
     
     // Send the request
     m_networkClient->sendRequest(request, [this, callback, cacheKey, useCache, ttlSeconds, url = request.url, method = request.method,
-                                           expectedProtoType]
+                                           expectedProtoType, diskEntry, answeredFromDisk]
                                  (const NetworkResponse& response) {
         LOG_WARN << "HTTP response: status=" << response.statusCode
                  << " success=" << response.success
@@ -170,11 +211,22 @@ void BaseApiClient::sendRequest(const RequestBuilder& builder, const QVariant& d
         if (!response.success && !response.error.isEmpty()) {
             LOG_WARN << "HTTP response error: " << response.error.toStdString();
         }
-        handleNetworkResponse(response, url, method, callback, cacheKey, useCache, ttlSeconds, expectedProtoType);
+        handleNetworkResponse(response, url, method, callback, cacheKey, useCache, ttlSeconds, expectedProtoType,
+                              diskEntry, answeredFromDisk);
         emit requestCompleted(url, response.success);
     });
 }
 
+// Header names keep the server's case
+static QString headerValue(const QMap<QString, QString>& headers, const QString& name) {
+    for (auto it = headers.begin(); it != headers.end(); ++it) {
+        if (it.key().compare(name, Qt::CaseInsensitive) == 0) {
+            return it.value();
+        }
+    }
+    return QString();
+}
+
 static QString methodToString(HttpMethod method) {
     switch (method) {
         case HttpMethod::GET: return QStringLiteral("GET");
@@ -234,7 +286,14 @@ static void dumpNetworkExchangeToDisk(const QString& url, HttpMethod method, con
         }
 
         // Parsed payload (best-effort)
-        if (apiResponse.data.type() == QVariant::Map || apiResponse.data.type() == QVariant::List) {
+        if (apiResponse.data.userType() == qMetaTypeId<ProtoMessageView>()) {
+            QFile f(baseDir + "/" + prefix + ".parsed.json");
+            if (f.open(QIODevice::WriteOnly)) {
+                QJsonDocument doc = QJsonDocument::fromVariant(
+                    apiResponse.data.value<ProtoMessageView>().toVariant());
+                f.write(doc.toJson(QJsonDocument::Indented));
+            }
+        } else if (apiResponse.data.type() == QVariant::Map || apiResponse.data.type() == QVariant::List) {
             QFile f(baseDir + "/" + prefix + ".parsed.json");
             if (f.open(QIODevice::WriteOnly)) {
                 QJsonDocument doc = QJsonDocument::fromVariant(apiResponse.data);
@@ -275,9 +334,63 @@ static void dumpNetworkExchangeToDisk(const QString& url, HttpMethod method, con
 
 void BaseApiClient::handleNetworkResponse(const NetworkResponse& response, const QString& url, HttpMethod method,
                      ApiCallback callback, const QString& cacheKey, bool shouldCache, int ttlSeconds,
-                     const QString& expectedProtoType) {
-    ApiResponse apiResponse = createApiResponse(response, url, method, expectedProtoType);
-    
+                     const QString& expectedProtoType, const HttpCacheEntry& diskEntry,
+                     bool answeredFromDisk) {
+    const bool useDisk = method == HttpMethod::GET && shouldCache && m_diskCache && !cacheKey.isEmpty();
+    const HttpDiskCache::Policy policy = HttpDiskCache::policyFor(
+        headerValue(response.headers, QStringLiteral("Cache-Control")), diskCacheTtl(ttlSeconds));
+
+    ApiResponse apiResponse;
+    if (response.statusCode == 304 && useDisk && diskEntry.isValid()) {
+        m_diskCache->markRevalidated(cacheKey, policy.maxAgeSeconds, policy.staleSeconds);
+        if (answeredFromDisk) {
+            LOG_INFO << "Disk cache revalidated, unchanged: " << cacheKey.toStdString();
+            return;
+        }
+        apiResponse = createCachedApiResponse(diskEntry, url, expectedProtoType);
+    } else {
+        apiResponse = createApiResponse(response, url, method, expectedProtoType);
+        if (apiResponse.success && useDisk && !response.body.isEmpty()) {
+            if (policy.store) {
+                HttpCacheEntry entry;
+                entry.body = response.body;
+                entry.etag = headerValue(response.headers, QStringLiteral("ETag"));
+                entry.contentType = headerValue(response.headers, QStringLiteral("Content-Type"));
+                entry.messageType = headerValue(response.headers, QStringLiteral("X-Protobuf-Message"));
+                entry.storedAtUtc = QDateTime::currentDateTimeUtc();
+                entry.maxAgeSeconds = policy.maxAgeSeconds;
+                entry.staleSeconds = policy.staleSeconds;
+                m_diskCache->store(cacheKey, entry);
+            } else {
+                m_diskCache->remove(cacheKey);
+            }
+        }
+    }
+
+    if (answeredFromDisk) {
+        // The caller already has the stale data; a failed revalidation keeps it
+        if (!apiResponse.success) {
+            LOG_WARN << "Disk cache revalidation failed for " << cacheKey.toStdString()
+                     << ": " << apiResponse.error.toStdString();
+            return;
+        }
+        if (m_cache) {
+            m_cache->set(cacheKey, apiResponse.data, ttlSeconds);
+        }
+        onCachedResponseUpdated(cacheKey, apiResponse);
+        return;
+    }
+
+    // Network down or server error: an expired entry is still better than nothing
+    if (!apiResponse.success && useDisk && diskEntry.isValid() && response.statusCode != 304) {
+        ApiResponse cached = createCachedApiResponse(diskEntry, url, expectedProtoType);
+        if (cached.success) {
+            LOG_WARN << "Request failed (" << apiResponse.error.toStdString()
+                     << "), answering from expired disk cache: " << cacheKey.toStdString();
+            apiResponse = cached;
+        }
+    }
+
     if (apiResponse.success && shouldCache && m_cache && !cacheKey.isEmpty()) {
     // ttlSeconds==0 -> NetworkCache uses its default TTL
     m_cache->set(cacheKey, apiResponse.data, ttlSeconds);
@@ -286,6 +399,12 @@ void BaseApiClient::handleNetworkResponse(const NetworkResponse& response, const
     callback(apiResponse);
 }
 
+int BaseApiClient::diskCacheTtl(int ttlSeconds) const {
+    // Same default as the in-memory cache
+    if (ttlSeconds > 0) return ttlSeconds;
+    return m_cache ? m_cache->getDefaultTTL() : 300;
+}
+
 QString BaseApiClient::generateCacheKey(const QString& path, const QVariant& data) const {
     QString key = path;
     
@@ -310,8 +429,23 @@ QString BaseApiClient::generateCacheKey(const QString& path, const QVariant& dat
     return key;
 }
 
+ApiResponse BaseApiClient::createCachedApiResponse(const HttpCacheEntry& entry, const QString& url,
+                                                   const QString& expectedProtoType) const {
+    NetworkResponse response;
+    response.statusCode = 200;
+    response.success = true;
+    response.body = entry.body;
+    if (!entry.contentType.isEmpty()) {
+        response.headers.insert(QStringLiteral("Content-Type"), entry.contentType);
+    }
+    if (!entry.messageType.isEmpty()) {
+        response.headers.insert(QStringLiteral("X-Protobuf-Message"), entry.messageType);
+    }
+    return createApiResponse(response, url, HttpMethod::GET, expectedProtoType, /*dumpExchange=*/false);
+}
+
 ApiResponse BaseApiClient::createApiResponse(const NetworkResponse& response, const QString& url, HttpMethod method,
-                                             const QString& expectedProtoType) const {
+                                             const QString& expectedProtoType, bool dumpExchange) const {
     ApiResponse apiResponse;
     apiResponse.success = response.success;
     apiResponse.statusCode = response.statusCode;
@@ -319,7 +453,9 @@ ApiResponse BaseApiClient::createApiResponse(const NetworkResponse& response, co
     
     if (!response.success) {
         apiResponse.error = response.error;
-        dumpNetworkExchangeToDisk(url, method, response, expectedProtoType, QString(), apiResponse, response.body);
+        if (dumpExchange) {
+            dumpNetworkExchangeToDisk(url, method, response, expectedProtoType, QString(), apiResponse, response.body);
+        }
         return apiResponse;
     }
 
@@ -338,6 +474,10 @@ ApiResponse BaseApiClient::createApiResponse(const NetworkResponse& response, co
         if (typeHint.isEmpty()) {
             typeHint = response.headers.value(QStringLiteral("X-Protobuf-Message"));
         }
+        if (typeHint.isEmpty() && m_serializer->getFormat() == SerializationFormat::PROTOBUF) {
+            typeHint = ProtobufSerializer::messageTypeFor(
+                QUrl(url).path(), headerValue(response.headers, QStringLiteral("Content-Type")));
+        }
         DeserializationResult deserResult = m_serializer->deserialize(responseData, typeHint);
         if (deserResult.success) {
             apiResponse.data = deserResult.data;
@@ -350,7 +490,9 @@ ApiResponse BaseApiClient::createApiResponse(const NetworkResponse& response, co
         apiResponse.data = QString::fromUtf8(responseData);
     }
 
-    dumpNetworkExchangeToDisk(url, method, response, expectedProtoType, typeHint, apiResponse, responseData);
+    if (dumpExchange) {
+        dumpNetworkExchangeToDisk(url, method, response, expectedProtoType, typeHint, apiResponse, responseData);
+    }
     LOG_WARN << "HTTP parsed: url=" << url.toStdString()
              << " status=" << apiResponse.statusCode
              << " ok=" << apiResponse.success
@@ -12,6 +12,7 @@
 #include "../core/INetworkClient.h"
 #include "../serialization/ISerializer.h"
 #include "../crypto/ICryptoProvider.h"
+#include "../utils/HttpDiskCache.h"
 #include "../utils/NetworkCache.h"
 #include "../utils/RequestBuilder.h"
 
@@ -37,6 +38,8 @@ public:
     void setSerializer(std::shared_ptr<ISerializer> serializer);
     void setCryptoProvider(std::shared_ptr<ICryptoProvider> crypto);
     void setCache(std::shared_ptr<NetworkCache> cache);
+    // Persistent layer under the in-memory cache for cached GETs; off by default
+    void setDiskCache(std::shared_ptr<HttpDiskCache> cache);
     
     // Request methods
     void get(const QString& path, ApiCallback callback, bool useCache = true,
@@ -59,18 +62,27 @@ signals:
     void requestProgress(qint64 bytesSent, qint64 bytesTotal);
 
 protected:
+    // A stale disk cache entry answered a request and the background
+    // revalidation brought a newer response; the caches already hold it
+    virtual void onCachedResponseUpdated(const QString& cacheKey, const ApiResponse& response);
+
     std::shared_ptr<INetworkClient> m_networkClient;
     std::shared_ptr<ISerializer> m_serializer;
     std::shared_ptr<ICryptoProvider> m_cryptoProvider;
     std::shared_ptr<NetworkCache> m_cache;
+    std::shared_ptr<HttpDiskCache> m_diskCache;
 
 private:
     void handleNetworkResponse(const NetworkResponse& response, const QString& url, HttpMethod method,
                               ApiCallback callback, const QString& cacheKey, bool shouldCache, int ttlSeconds,
-                              const QString& expectedProtoType);
+                              const QString& expectedProtoType, const HttpCacheEntry& diskEntry,
+                              bool answeredFromDisk);
     QString generateCacheKey(const QString& path, const QVariant& data = QVariant()) const;
     ApiResponse createApiResponse(const NetworkResponse& response, const QString& url, HttpMethod method,
-                                  const QString& expectedProtoType) const;
+                                  const QString& expectedProtoType, bool dumpExchange = true) const;
+    ApiResponse createCachedApiResponse(const HttpCacheEntry& entry, const QString& url,
+                                        const QString& expectedProtoType) const;
+    int diskCacheTtl(int ttlSeconds) const;
     
 private slots:
     void onRequestProgress(qint64 bytesSent, qint64 bytesTotal);
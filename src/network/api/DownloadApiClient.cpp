@@ -4,7 +4,9 @@
 #include <QJsonValue>
 #include <QUrl>
 #include <cmath>
+#include <google/protobuf/struct.pb.h>
 #include "../serialization/ProtobufSerializer.h"
+#include "../serialization/ProtoMessageView.h"
 #include "../../ApplicationSettings.h"
 #include "../../diagnostic/DiagnosticDataStore.h"
 #include "../../logging/Logger.h"
@@ -13,6 +15,9 @@ DownloadApiClient::DownloadApiClient(QObject* parent)
     : BaseApiClient(parent), m_menuCached(false) {
     // Set protobuf serializer for binary protobuf communication
     setSerializer(std::make_shared<ProtobufSerializer>());
+    // Menu, comparisons and general averages survive restarts; a cold start
+    // shows them from disk and revalidates in the background
+    setDiskCache(HttpDiskCache::shared());
 }
 
 void DownloadApiClient::prefetchGeneralDiagnostics(GeneralCallback callback) {
@@ -237,30 +242,35 @@ void DownloadApiClient::ensureGeneralDiagnosticsReady(GeneralCallback callback)
     }, /*useCache=*/true, /*cacheKey=*/cacheKey, /*ttlSeconds=*/kTTLSeconds, /*expectedProtoType=*/QStringLiteral("Struct"));
 }
 
-static QJsonObject toJsonObjectOrEmpty(const QVariant& v) {
-    if (v.type() != QVariant::Map) return QJsonObject();
-    return QJsonObject::fromVariantMap(v.toMap());
-}
-
 void DownloadApiClient::parseAndCacheGeneralDiagnostics(const QVariant& data) {
+    using google::protobuf::Struct;
+    using google::protobuf::Value;
+    using ProtoStruct::number;
+    using ProtoStruct::object;
+
     m_generalComponents.clear();
     m_generalMeta = QJsonObject();
 
-    if (data.type() != QVariant::Map) {
-        LOG_ERROR << "General diagnostics data is not a map, got type: " << data.typeName();
+    // Decoded as a view (see ProtobufSerializer): fields are read straight
+    // from the Struct, only the parts renderers keep become JSON
+    const Struct* rootStruct = data.value<ProtoMessageView>().as<Struct>();
+    if (!rootStruct) {
+        LOG_ERROR << "General diagnostics data is not a protobuf Struct, got type: " << data.typeName();
         return;
     }
+    const Struct& root = *rootStruct;
 
-    const QVariantMap root = data.toMap();
-    m_generalMeta = toJsonObjectOrEmpty(root.value(QStringLiteral("meta")));
+    auto objectJson = [](const Struct* s) { return s ? ProtoStruct::toJson(*s) : QJsonObject(); };
+    m_generalMeta = objectJson(object(root, "meta"));
 
     // High-level diagnostic logging for debugging. Detailed payload is dumped to disk by BaseApiClient.
-    try {
+    {
+        QStringList keys;
+        for (const auto& field : root.fields()) keys.append(QString::fromStdString(field.first));
+        keys.sort();
         const int sampleCount = m_generalMeta.value(QStringLiteral("sample_count")).toInt();
-        LOG_WARN << "General diagnostics: parsed keys=" << root.keys().join(", ").toStdString()
+        LOG_WARN << "General diagnostics: parsed keys=" << keys.join(", ").toStdString()
                  << " sample_count=" << sampleCount;
-    } catch (...) {
-        LOG_WARN << "General diagnostics: parsed (failed to summarize meta)";
     }
 
     const QString label = generalAverageLabel();
@@ -273,59 +283,42 @@ void DownloadApiClient::parseAndCacheGeneralDiagnostics(const QVariant& data) {
         m_generalComponents.insert(type, out);
     };
 
+    // Copies a number under a new key when the source has it
+    auto copyNumber = [](const Struct& from, const char* key, QJsonObject& to, const QString& toKey) {
+        if (ProtoStruct::find(from, key)) to.insert(toKey, number(from, key, 0.0));
+    };
+
     // CPU: map general schema into existing CPUComparison-shaped JSON (used by renderers)
-    if (root.contains(QStringLiteral("cpu")) && root.value(QStringLiteral("cpu")).type() == QVariant::Map) {
-        const QVariantMap cpu = root.value(QStringLiteral("cpu")).toMap();
+    if (const Struct* cpu = object(root, "cpu")) {
         QJsonObject cpuObj;
         cpuObj.insert(QStringLiteral("model"), label);
         cpuObj.insert(QStringLiteral("full_model"), label);
-        cpuObj.insert(QStringLiteral("cores"), static_cast<int>(std::round(cpu.value(QStringLiteral("cores_avg")).toDouble())));
-        cpuObj.insert(QStringLiteral("threads"), static_cast<int>(std::round(cpu.value(QStringLiteral("threads_avg")).toDouble())));
-        cpuObj.insert(QStringLiteral("benchmark_results"), toJsonObjectOrEmpty(cpu.value(QStringLiteral("benchmark_results"))));
+        cpuObj.insert(QStringLiteral("cores"), static_cast<int>(std::round(number(*cpu, "cores_avg", 0.0))));
+        cpuObj.insert(QStringLiteral("threads"), static_cast<int>(std::round(number(*cpu, "threads_avg", 0.0))));
+        cpuObj.insert(QStringLiteral("benchmark_results"), objectJson(object(*cpu, "benchmark_results")));
 
-        const QVariant coldStartVariant = cpu.value(QStringLiteral("cold_start"));
-        if (coldStartVariant.type() == QVariant::Map) {
-            const QVariantMap coldStartMap = coldStartVariant.toMap();
+        if (const Struct* coldStart = object(*cpu, "cold_start")) {
             QJsonObject coldStartObj;
-            if (coldStartMap.contains(QStringLiteral("avg"))) {
-                coldStartObj.insert(QStringLiteral("avg_response_time_us"), coldStartMap.value(QStringLiteral("avg")).toDouble());
-            }
-            if (coldStartMap.contains(QStringLiteral("min"))) {
-                coldStartObj.insert(QStringLiteral("min_response_time_us"), coldStartMap.value(QStringLiteral("min")).toDouble());
-            }
-            if (coldStartMap.contains(QStringLiteral("max"))) {
-                coldStartObj.insert(QStringLiteral("max_response_time_us"), coldStartMap.value(QStringLiteral("max")).toDouble());
-            }
-            if (coldStartMap.contains(QStringLiteral("std"))) {
-                coldStartObj.insert(QStringLiteral("std_dev_us"), coldStartMap.value(QStringLiteral("std")).toDouble());
-            }
-            if (coldStartMap.contains(QStringLiteral("jitter_us"))) {
-                coldStartObj.insert(QStringLiteral("jitter_us"), coldStartMap.value(QStringLiteral("jitter_us")).toDouble());
-            }
+            copyNumber(*coldStart, "avg", coldStartObj, QStringLiteral("avg_response_time_us"));
+            copyNumber(*coldStart, "min", coldStartObj, QStringLiteral("min_response_time_us"));
+            copyNumber(*coldStart, "max", coldStartObj, QStringLiteral("max_response_time_us"));
+            copyNumber(*coldStart, "std", coldStartObj, QStringLiteral("std_dev_us"));
+            copyNumber(*coldStart, "jitter_us", coldStartObj, QStringLiteral("jitter_us"));
             if (!coldStartObj.isEmpty()) {
                 cpuObj.insert(QStringLiteral("cold_start"), coldStartObj);
             }
         }
 
-        const QVariant boostVariant = cpu.value(QStringLiteral("boost_summary"));
-        if (boostVariant.type() == QVariant::Map) {
-            const QVariantMap boostMap = boostVariant.toMap();
+        if (const Struct* boost = object(*cpu, "boost_summary")) {
             QJsonObject boostObj;
-            if (boostMap.contains(QStringLiteral("all_core_power_w"))) {
-                boostObj.insert(QStringLiteral("all_core_power_w"), boostMap.value(QStringLiteral("all_core_power_w")).toDouble());
-            }
-            if (boostMap.contains(QStringLiteral("idle_power_w"))) {
-                boostObj.insert(QStringLiteral("idle_power_w"), boostMap.value(QStringLiteral("idle_power_w")).toDouble());
-            }
-            if (boostMap.contains(QStringLiteral("single_core_power_w"))) {
-                boostObj.insert(QStringLiteral("single_core_power_w"), boostMap.value(QStringLiteral("single_core_power_w")).toDouble());
-            }
-            if (boostMap.contains(QStringLiteral("best_boosting_core"))) {
-                boostObj.insert(QStringLiteral("best_boosting_core"), boostMap.value(QStringLiteral("best_boosting_core")).toInt());
-            }
-            if (boostMap.contains(QStringLiteral("max_boost_delta_mhz"))) {
-                boostObj.insert(QStringLiteral("max_boost_delta_mhz"), boostMap.value(QStringLiteral("max_boost_delta_mhz")).toDouble());
+            copyNumber(*boost, "all_core_power_w", boostObj, QStringLiteral("all_core_power_w"));
+            copyNumber(*boost, "idle_power_w", boostObj, QStringLiteral("idle_power_w"));
+            copyNumber(*boost, "single_core_power_w", boostObj, QStringLiteral("single_core_power_w"));
+            if (ProtoStruct::find(*boost, "best_boosting_core")) {
+                boostObj.insert(QStringLiteral("best_boosting_core"),
+                                static_cast<int>(std::round(number(*boost, "best_boosting_core", 0.0))));
             }
+            copyNumber(*boost, "max_boost_delta_mhz", boostObj, QStringLiteral("max_boost_delta_mhz"));
             if (!boostObj.isEmpty()) {
                 cpuObj.insert(QStringLiteral("boost_summary"), boostObj);
             }
@@ -333,15 +326,14 @@ void DownloadApiClient::parseAndCacheGeneralDiagnostics(const QVariant& data) {
 
         // cache_latencies: server uses latency_ns; renderers expect latency (ns)
         QJsonArray cacheLatencies;
-        const QVariant v = cpu.value(QStringLiteral("cache_latencies"));
-        if (v.type() == QVariant::List) {
-            const QVariantList lst = v.toList();
-            for (const QVariant& item : lst) {
-                if (item.type() != QVariant::Map) continue;
-                const QVariantMap m = item.toMap();
+        const Value* latencies = ProtoStruct::find(*cpu, "cache_latencies");
+        if (latencies && latencies->kind_case() == Value::kListValue) {
+            for (const Value& item : latencies->list_value().values()) {
+                if (item.kind_case() != Value::kStructValue) continue;
+                const Struct& m = item.struct_value();
                 QJsonObject e;
-                e.insert(QStringLiteral("size_kb"), m.value(QStringLiteral("size_kb")).toInt());
-                e.insert(QStringLiteral("latency"), m.value(QStringLiteral("latency_ns")).toDouble());
+                e.insert(QStringLiteral("size_kb"), static_cast<int>(std::round(number(m, "size_kb", 0.0))));
+                e.insert(QStringLiteral("latency"), number(m, "latency_ns", 0.0));
                 cacheLatencies.append(e);
             }
         }
@@ -351,93 +343,81 @@ void DownloadApiClient::parseAndCacheGeneralDiagnostics(const QVariant& data) {
     }
 
     // GPU
-    if (root.contains(QStringLiteral("gpu")) && root.value(QStringLiteral("gpu")).type() == QVariant::Map) {
-        const QVariantMap gpu = root.value(QStringLiteral("gpu")).toMap();
+    if (const Struct* gpu = object(root, "gpu")) {
         QJsonObject gpuObj;
         gpuObj.insert(QStringLiteral("model"), label);
         gpuObj.insert(QStringLiteral("full_model"), label);
-        gpuObj.insert(QStringLiteral("benchmark_results"), toJsonObjectOrEmpty(gpu.value(QStringLiteral("benchmark_results"))));
+        gpuObj.insert(QStringLiteral("benchmark_results"), objectJson(object(*gpu, "benchmark_results")));
         makeComponent(QStringLiteral("gpu"), gpuObj);
     }
 
     // Memory
-    if (root.contains(QStringLiteral("memory")) && root.value(QStringLiteral("memory")).type() == QVariant::Map) {
-        const QVariantMap mem = root.value(QStringLiteral("memory")).toMap();
+    if (const Struct* mem = object(root, "memory")) {
         QJsonObject memObj;
         memObj.insert(QStringLiteral("model"), label);
-        memObj.insert(QStringLiteral("benchmark_results"), toJsonObjectOrEmpty(mem.value(QStringLiteral("benchmark_results"))));
-        memObj.insert(QStringLiteral("total_memory_gb"), mem.value(QStringLiteral("total_memory_gb")).toDouble());
+        memObj.insert(QStringLiteral("benchmark_results"), objectJson(object(*mem, "benchmark_results")));
+        memObj.insert(QStringLiteral("total_memory_gb"), number(*mem, "total_memory_gb", 0.0));
         makeComponent(QStringLiteral("memory"), memObj);
     }
 
     // Drive
-    if (root.contains(QStringLiteral("drive")) && root.value(QStringLiteral("drive")).type() == QVariant::Map) {
-        const QVariantMap drive = root.value(QStringLiteral("drive")).toMap();
+    if (const Struct* drive = object(root, "drive")) {
         QJsonObject driveObj;
         driveObj.insert(QStringLiteral("model"), label);
-        driveObj.insert(QStringLiteral("benchmark_results"), toJsonObjectOrEmpty(drive.value(QStringLiteral("benchmark_results"))));
+        driveObj.insert(QStringLiteral("benchmark_results"), objectJson(object(*drive, "benchmark_results")));
         makeComponent(QStringLiteral("drive"), driveObj);
     }
 
     // Background processes (used for "typical" comparison rows)
     DiagnosticDataStore::BackgroundProcessGeneralMetrics backgroundMetrics;
     bool hasBackgroundMetrics = false;
-    if (root.contains(QStringLiteral("background")) && root.value(QStringLiteral("background")).type() == QVariant::Map) {
-        const QVariantMap bg = root.value(QStringLiteral("background")).toMap();
-
-        auto readDouble = [](const QVariantMap& m, const QString& key, double fallback = -1.0) -> double {
-            if (!m.contains(key)) return fallback;
-            bool ok = false;
-            const double v = m.value(key).toDouble(&ok);
-            return ok ? v : fallback;
-        };
-
-        backgroundMetrics.totalCpuUsage = readDouble(bg, QStringLiteral("total_cpu_usage"));
-        backgroundMetrics.totalGpuUsage = readDouble(bg, QStringLiteral("total_gpu_usage"));
-        backgroundMetrics.systemDpcTime = readDouble(bg, QStringLiteral("system_dpc_time"));
-        backgroundMetrics.systemInterruptTime = readDouble(bg, QStringLiteral("system_interrupt_time"));
-        backgroundMetrics.peakCpuUsage = readDouble(bg, QStringLiteral("peak_cpu_usage"));
-        backgroundMetrics.peakGpuUsage = readDouble(bg, QStringLiteral("peak_gpu_usage"));
-        backgroundMetrics.peakSystemDpcTime = readDouble(bg, QStringLiteral("peak_system_dpc_time"));
-        backgroundMetrics.peakSystemInterruptTime =
-          readDouble(bg, QStringLiteral("peak_system_interrupt_time"));
-        backgroundMetrics.systemDiskIO = readDouble(bg, QStringLiteral("system_disk_io"));
-        backgroundMetrics.peakSystemDiskIO = readDouble(bg, QStringLiteral("peak_system_disk_io"));
-
-        auto parseMemoryMetrics = [&](const QVariant& v) -> DiagnosticDataStore::BackgroundProcessGeneralMetrics::MemoryMetrics {
+    if (const Struct* bgStruct = object(root, "background")) {
+        const Struct& bg = *bgStruct;
+
+        backgroundMetrics.totalCpuUsage = number(bg, "total_cpu_usage");
+        backgroundMetrics.totalGpuUsage = number(bg, "total_gpu_usage");
+        backgroundMetrics.systemDpcTime = number(bg, "system_dpc_time");
+        backgroundMetrics.systemInterruptTime = number(bg, "system_interrupt_time");
+        backgroundMetrics.peakCpuUsage = number(bg, "peak_cpu_usage");
+        backgroundMetrics.peakGpuUsage = number(bg, "peak_gpu_usage");
+        backgroundMetrics.peakSystemDpcTime = number(bg, "peak_system_dpc_time");
+        backgroundMetrics.peakSystemInterruptTime = number(bg, "peak_system_interrupt_time");
+        backgroundMetrics.systemDiskIO = number(bg, "system_disk_io");
+        backgroundMetrics.peakSystemDiskIO = number(bg, "peak_system_disk_io");
+
+        auto parseMemoryMetrics = [&](const Struct* mm) -> DiagnosticDataStore::BackgroundProcessGeneralMetrics::MemoryMetrics {
             DiagnosticDataStore::BackgroundProcessGeneralMetrics::MemoryMetrics out;
-            if (v.type() != QVariant::Map) return out;
-            const QVariantMap mm = v.toMap();
-            out.commitLimitMB = readDouble(mm, QStringLiteral("commit_limit_mb"));
-            out.commitPercent = readDouble(mm, QStringLiteral("commit_percent"));
-            out.commitTotalMB = readDouble(mm, QStringLiteral("commit_total_mb"));
-            out.fileCacheMB = readDouble(mm, QStringLiteral("file_cache_mb"));
-            out.kernelNonPagedMB = readDouble(mm, QStringLiteral("kernel_nonpaged_mb"));
-            out.kernelPagedMB = readDouble(mm, QStringLiteral("kernel_paged_mb"));
-            out.kernelTotalMB = readDouble(mm, QStringLiteral("kernel_total_mb"));
-            out.otherMemoryMB = readDouble(mm, QStringLiteral("other_memory_mb"));
-            out.physicalAvailableMB = readDouble(mm, QStringLiteral("physical_available_mb"));
-            out.physicalTotalMB = readDouble(mm, QStringLiteral("physical_total_mb"));
-            out.physicalUsedMB = readDouble(mm, QStringLiteral("physical_used_mb"));
-            out.physicalUsedPercent = readDouble(mm, QStringLiteral("physical_used_percent"));
-            out.userModePrivateMB = readDouble(mm, QStringLiteral("user_mode_private_mb"));
+            if (!mm) return out;
+            out.commitLimitMB = number(*mm, "commit_limit_mb");
+            out.commitPercent = number(*mm, "commit_percent");
+            out.commitTotalMB = number(*mm, "commit_total_mb");
+            out.fileCacheMB = number(*mm, "file_cache_mb");
+            out.kernelNonPagedMB = number(*mm, "kernel_nonpaged_mb");
+            out.kernelPagedMB = number(*mm, "kernel_paged_mb");
+            out.kernelTotalMB = number(*mm, "kernel_total_mb");
+            out.otherMemoryMB = number(*mm, "other_memory_mb");
+            out.physicalAvailableMB = number(*mm, "physical_available_mb");
+            out.physicalTotalMB = number(*mm, "physical_total_mb");
+            out.physicalUsedMB = number(*mm, "physical_used_mb");
+            out.physicalUsedPercent = number(*mm, "physical_used_percent");
+            out.userModePrivateMB = number(*mm, "user_mode_private_mb");
             return out;
         };
 
-        backgroundMetrics.memoryMetrics = parseMemoryMetrics(bg.value(QStringLiteral("memory_metrics")));
+        backgroundMetrics.memoryMetrics = parseMemoryMetrics(object(bg, "memory_metrics"));
 
-        const QVariant byRam = bg.value(QStringLiteral("memory_metrics_by_ram"));
-        if (byRam.type() == QVariant::List) {
-            const QVariantList bins = byRam.toList();
+        const Value* byRam = ProtoStruct::find(bg, "memory_metrics_by_ram");
+        if (byRam && byRam->kind_case() == Value::kListValue) {
+            const auto& bins = byRam->list_value().values();
             backgroundMetrics.memoryMetricsByRam.reserve(static_cast<size_t>(bins.size()));
-            for (const QVariant& item : bins) {
-                if (item.type() != QVariant::Map) continue;
-                const QVariantMap binMap = item.toMap();
+            for (const Value& item : bins) {
+                if (item.kind_case() != Value::kStructValue) continue;
+                const Struct& binStruct = item.struct_value();
 
                 DiagnosticDataStore::BackgroundProcessGeneralMetrics::MemoryMetricsByRamBin bin;
-                bin.totalMemoryGB = readDouble(binMap, QStringLiteral("total_memory_gb"));
-                bin.sampleCount = binMap.value(QStringLiteral("sample_count")).toInt();
-                bin.metrics = parseMemoryMetrics(binMap.value(QStringLiteral("metrics")));
+                bin.totalMemoryGB = number(binStruct, "total_memory_gb");
+                bin.sampleCount = static_cast<int>(std::round(number(binStruct, "sample_count", 0.0)));
+                bin.metrics = parseMemoryMetrics(object(binStruct, "metrics"));
 
                 backgroundMetrics.memoryMetricsByRam.push_back(std::move(bin));
             }
@@ -464,6 +444,22 @@ void DownloadApiClient::parseAndCacheGeneralDiagnostics(const QVariant& data) {
     }
 }
 
+void DownloadApiClient::onCachedResponseUpdated(const QString& cacheKey, const ApiResponse& response) {
+    // A launch answered from the disk cache got newer data from the server.
+    // Component responses need nothing here: the next fetch reads the cache.
+    if (cacheKey == QLatin1String("/pb/menu")) {
+        m_cachedMenu = parseMenuData(response.data);
+        m_menuCached = true;
+        LOG_INFO << "DownloadApiClient: menu updated after revalidation";
+        emit menuFetched(m_cachedMenu);
+    } else if (cacheKey == QLatin1String("/pb/diagnostics/general")) {
+        parseAndCacheGeneralDiagnostics(response.data);
+        m_generalFetchedAtUtc = QDateTime::currentDateTimeUtc();
+        m_generalCached = true;
+        LOG_INFO << "DownloadApiClient: general diagnostics updated after revalidation";
+    }
+}
+
 bool DownloadApiClient::isMenuCached() const {
     return m_menuCached;
 }
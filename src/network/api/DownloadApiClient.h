@@ -57,6 +57,9 @@ signals:
     void componentDataFetched(const QString& componentType, const QString& modelName, const ComponentData& data);
     void downloadError(const QString& errorMessage);
 
+protected:
+    void onCachedResponseUpdated(const QString& cacheKey, const ApiResponse& response) override;
+
 private:
     MenuData m_cachedMenu;
     bool m_menuCached;
@@ -1,9 +1,13 @@
 #include "BenchmarkFullCsvToProto.h"
+#include "FullRunCodec.h"
+#include "UploadPayloadWriter.h"
 #include "../../logging/Logger.h"
 #include <QFile>
 #include <QFileInfo>
 #include <QDateTime>
 
+#include <google/protobuf/arena.h>
+
 // Generated headers
 #include "benchmark_upload.pb.h"
 #include "benchmark_public.pb.h"
@@ -29,40 +33,49 @@ QByteArray BenchmarkFullCsvToProto::buildUploadFromCsv(const QString& csvPath,
                                                        const QStringList& attachmentPaths) {
     LOG_INFO << "BenchmarkFullCsvToProto::buildUploadFromCsv: csv=" << csvPath.toStdString();
 
-    BenchmarkUploadRequest req;
+    // The packed columns are the bulk of the message; one arena holds them
+    google::protobuf::ArenaOptions arenaOptions;
+    arenaOptions.start_block_size = 64 * 1024;
+    arenaOptions.max_block_size = 4 * 1024 * 1024;
+    google::protobuf::Arena arena(arenaOptions);
+    BenchmarkUploadRequest* req = google::protobuf::Arena::Create<BenchmarkUploadRequest>(&arena);
 
     // Envelope
-    ClientEnvelope* env = req.mutable_env();
+    ClientEnvelope* env = req->mutable_env();
     env->set_client_version("checkmark-client");
-    env->set_schema_version("1");
+    env->set_schema_version(FullRunCodec::UPLOAD_SCHEMA_VERSION);
 
     // Meta
-    BenchmarkRunMeta* meta = req.mutable_meta();
+    BenchmarkRunMeta* meta = req->mutable_meta();
     if (!runId.isEmpty()) meta->set_run_id(runId.toStdString());
     meta->set_user_system_id(userSystemId.toStdString());
     meta->set_timestamp_utc(QDateTime::currentDateTimeUtc().toString(Qt::ISODate).toStdString());
 
-    // TODO: Parse CSV -> fill FullRun and PublicSummary/Samples when mapper ready
-    // Attachments: include provided files
+    // The CSV is attached as it is, so full_run only pays for itself once it
+    // goes as packed columns; the bytes are reused for the attachment
+    const QByteArray csvData = readAllBytes(csvPath);
+    if constexpr (FullRunCodec::UPLOAD_LAYOUT == FullRunCodec::Layout::Packed) {
+        if (!FullRunCodec::encodeCsv(std::string_view(csvData.constData(), csvData.size()),
+                                     req->mutable_full_run())) {
+            LOG_WARN << "BenchmarkFullCsvToProto: empty CSV: " << csvPath.toStdString();
+            req->clear_full_run();
+        }
+    }
+
+    // TODO: fill PublicSummary/Samples when mapper ready
+    // Attachments: include provided files, read straight into the payload
+    const QString csvFilePath = QFileInfo(csvPath).absoluteFilePath();
+    UploadPayloadWriter payload;
     for (const auto& p : attachmentPaths) {
-        QFileInfo fi(p);
-        if (!fi.exists() || !fi.isFile()) continue;
-        Attachment* a = req.add_attachments();
-        a->set_filename(fi.fileName().toStdString());
-        QString mt = fi.suffix().compare("csv", Qt::CaseInsensitive) == 0 ? "text/csv" :
-                     fi.suffix().compare("json", Qt::CaseInsensitive) == 0 ? "application/json" :
-                     "text/plain";
-        a->set_mime_type(mt.toStdString());
-        QByteArray bytes = readAllBytes(p);
-        if (!bytes.isEmpty()) a->set_content(bytes.constData(), bytes.size());
+        const bool isCsv = QFileInfo(p).absoluteFilePath() == csvFilePath;
+        payload.addFile(p, isCsv ? csvData : QByteArray());
     }
 
-    std::string out;
-    if (!req.SerializeToString(&out)) {
+    QByteArray ba = payload.serialize(*req);
+    if (ba.isEmpty()) {
         LOG_ERROR << "BenchmarkFullCsvToProto: failed to serialize BenchmarkUploadRequest";
         return QByteArray();
     }
-    QByteArray ba(out.data(), static_cast<int>(out.size()));
     LOG_INFO << "BenchmarkFullCsvToProto: built protobuf payload, bytes=" << ba.size();
     return ba;
-}
+}
\ No newline at end of file
@@ -8,7 +8,8 @@
 namespace BenchmarkFullCsvToProto {
 
 // Build a binary-encoded BenchmarkUploadRequest from a full CSV and attachments.
-// CSV parsing into FullRun/Public is TODO; attachments always include the source CSV.
+// The CSV goes into FullRun as packed columns (see FullRunCodec); parsing into
+// Public is TODO. Attachments always include the source CSV.
 QByteArray buildUploadFromCsv(const QString& csvPath,
                               const QString& runId,
                               const QString& userSystemId,
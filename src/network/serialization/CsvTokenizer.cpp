@@ -0,0 +1,229 @@
+#include "CsvTokenizer.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <limits>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define CSV_TOKENIZER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC accepts AVX2 intrinsics in any function; GCC/Clang need it per function
+#if defined(CSV_TOKENIZER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CSV_TOKENIZER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CSV_TOKENIZER_TARGET_AVX2
+#endif
+
+namespace {
+
+constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+// Appends the offset of each set bit, lowest first
+inline void appendMask(uint32_t mask, uint32_t base, std::vector<uint32_t>& out) {
+    while (mask) {
+        out.push_back(base + static_cast<uint32_t>(std::countr_zero(mask)));
+        mask &= mask - 1;
+    }
+}
+
+size_t scanScalar(const char* data, size_t begin, size_t end, std::vector<uint32_t>& out) {
+    size_t newlines = 0;
+    for (size_t i = begin; i < end; ++i) {
+        const char c = data[i];
+        if (c == ',' || c == '\n') {
+            out.push_back(static_cast<uint32_t>(i));
+            newlines += (c == '\n');
+        }
+    }
+    return newlines;
+}
+
+#ifdef CSV_TOKENIZER_X86
+size_t scanSse2(const char* data, size_t size, std::vector<uint32_t>& out) {
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    size_t newlines = 0;
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const uint32_t nl =
+            static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline)));
+        const uint32_t sep =
+            static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, comma))) | nl;
+        newlines += static_cast<size_t>(std::popcount(nl));
+        appendMask(sep, static_cast<uint32_t>(i), out);
+    }
+    return newlines + scanScalar(data, i, size, out);
+}
+
+CSV_TOKENIZER_TARGET_AVX2
+size_t scanAvx2(const char* data, size_t size, std::vector<uint32_t>& out) {
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t newlines = 0;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const uint32_t nl =
+            static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline)));
+        const uint32_t sep =
+            static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, comma))) | nl;
+        newlines += static_cast<size_t>(std::popcount(nl));
+        appendMask(sep, static_cast<uint32_t>(i), out);
+    }
+    return newlines + scanScalar(data, i, size, out);
+}
+
+bool cpuSupportsAvx2() {
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;  // YMM state saved by OS
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+std::string_view trimField(std::string_view field) {
+    while (!field.empty() && (field.front() == ' ' || field.front() == '\t')) {
+        field.remove_prefix(1);
+    }
+    while (!field.empty() && (field.back() == ' ' || field.back() == '\t' ||
+                              field.back() == '\r')) {
+        field.remove_suffix(1);
+    }
+    return field;
+}
+
+double parseField(std::string_view field) {
+    field = trimField(field);
+    if (field.empty()) return kMissing;
+
+    double value = kMissing;
+    auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+    if (result.ec != std::errc() || result.ptr != field.data() + field.size()) {
+        return kMissing;
+    }
+    return value;
+}
+
+} // namespace
+
+int CsvTokenizer::Table::columnIndex(std::string_view name) const {
+    auto it = std::find(columnNames.begin(), columnNames.end(), name);
+    return it == columnNames.end() ? -1 : static_cast<int>(it - columnNames.begin());
+}
+
+CsvTokenizer::CsvTokenizer(ScanPath path) : m_path(path) {
+    // Never pick a path this CPU can't run
+    if (static_cast<int>(m_path) > static_cast<int>(bestScanPath())) {
+        m_path = bestScanPath();
+    }
+}
+
+CsvTokenizer::ScanPath CsvTokenizer::bestScanPath() {
+#ifdef CSV_TOKENIZER_X86
+    // SSE2 is part of x86-64
+    static const ScanPath best = cpuSupportsAvx2() ? ScanPath::AVX2 : ScanPath::SSE2;
+    return best;
+#else
+    return ScanPath::Scalar;
+#endif
+}
+
+const char* CsvTokenizer::scanPathName(ScanPath path) {
+    switch (path) {
+    case ScanPath::AVX2: return "AVX2";
+    case ScanPath::SSE2: return "SSE2";
+    default: return "scalar";
+    }
+}
+
+size_t CsvTokenizer::scan(std::string_view text, std::vector<uint32_t>& separators) const {
+    switch (m_path) {
+#ifdef CSV_TOKENIZER_X86
+    case ScanPath::AVX2: return scanAvx2(text.data(), text.size(), separators);
+    case ScanPath::SSE2: return scanSse2(text.data(), text.size(), separators);
+#endif
+    default: return scanScalar(text.data(), 0, text.size(), separators);
+    }
+}
+
+bool CsvTokenizer::tokenize(std::string_view text, Table& table) const {
+    table.columnNames.clear();
+    table.fieldCounts.clear();
+    table.values.clear();
+    table.rowCount = 0;
+    table.stride = 0;
+
+    if (text.size() >= std::numeric_limits<uint32_t>::max()) return false;
+    if (text.empty()) return true;
+
+    // Pass 1: offsets of every ',' and '\n'. A last line without '\n' ends at
+    // text.size(), which is recorded as if it were one.
+    std::vector<uint32_t> separators;
+    separators.reserve(text.size() / 4);
+    size_t lineCount = scan(text, separators);
+    if (text.back() != '\n') {
+        separators.push_back(static_cast<uint32_t>(text.size()));
+        lineCount++;
+    }
+    auto isLineEnd = [&](uint32_t at) { return at == text.size() || text[at] == '\n'; };
+
+    // Header
+    size_t k = 0;
+    size_t fieldStart = 0;
+    while (k < separators.size()) {
+        const uint32_t at = separators[k++];
+        std::string_view name = text.substr(fieldStart, at - fieldStart);
+        fieldStart = at + 1;
+        if (isLineEnd(at)) {
+            if (!name.empty() && name.back() == '\r') name.remove_suffix(1);
+            table.columnNames.push_back(name);
+            break;
+        }
+        table.columnNames.push_back(name);
+    }
+
+    // Pass 2: fields straight into their column, one row per line
+    const size_t columnCount = table.columnNames.size();
+    table.stride = lineCount > 0 ? lineCount - 1 : 0;
+    table.values.assign(columnCount * table.stride, kMissing);
+    table.fieldCounts.reserve(table.stride);
+
+    size_t row = 0;
+    uint32_t field = 0;
+    for (; k < separators.size(); ++k) {
+        const uint32_t at = separators[k];
+        const std::string_view cell = text.substr(fieldStart, at - fieldStart);
+        fieldStart = at + 1;
+
+        if (field < columnCount) {
+            table.values[field * table.stride + row] = parseField(cell);
+        }
+        ++field;
+
+        if (isLineEnd(at)) {
+            // A blank line is a row too, with one empty field
+            table.fieldCounts.push_back(field);
+            ++row;
+            field = 0;
+        }
+    }
+
+    table.rowCount = row;
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef CSVTOKENIZER_H
+#define CSVTOKENIZER_H
+
+// CsvTokenizer - Numeric CSV tokenizer for benchmark run and comparison files
+// Used by: BenchmarkRunFile (binary sidecar that ParsedRun and the run list read)
+// Purpose: Turn an in-memory CSV into one contiguous span of doubles per column
+// When to use: Unquoted numeric CSVs such as run files and the leader_*/server_*
+//              caches in comparison_data. Use CsvSerializer for quoted text.
+// Operations: SIMD scan for ',' and '\n' (AVX2 or SSE2, scalar fallback) into a
+//             structural index, then std::from_chars per field (locale-free)
+//
+// Every line after the header is a row, blank ones included (one empty field),
+// as QTextStream::readLine() + split() gave. Missing, empty and non-numeric
+// cells are NaN. Quotes are not special.
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+class CsvTokenizer {
+public:
+    enum class ScanPath { Scalar, SSE2, AVX2 };
+
+    struct Table {
+        std::vector<std::string_view> columnNames;  // views into the input text
+        std::vector<uint32_t> fieldCounts;          // fields actually on each row
+        size_t rowCount = 0;
+
+        std::span<const double> column(size_t index) const {
+            return {values.data() + index * stride, rowCount};
+        }
+        int columnIndex(std::string_view name) const;
+
+        // Column-major, stride >= rowCount doubles per column
+        std::vector<double> values;
+        size_t stride = 0;
+    };
+
+    explicit CsvTokenizer(ScanPath path = bestScanPath());
+
+    // Best path this CPU supports
+    static ScanPath bestScanPath();
+    static const char* scanPathName(ScanPath path);
+
+    // False only if the text is too large to index (4 GB+)
+    bool tokenize(std::string_view text, Table& table) const;
+
+private:
+    size_t scan(std::string_view text, std::vector<uint32_t>& separators) const;
+
+    ScanPath m_path;
+};
+
+#endif // CSVTOKENIZER_H
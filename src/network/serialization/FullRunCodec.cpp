@@ -0,0 +1,458 @@
+#include "FullRunCodec.h"
+
+#include <QByteArray>
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "benchmark_full.pb.h"
+
+using checkmark::benchmarks::FullRun;
+using checkmark::benchmarks::PackedColumn;
+using checkmark::benchmarks::PackedColumns;
+using checkmark::benchmarks::PackedRun;
+
+namespace {
+constexpr double MISSING = std::numeric_limits<double>::quiet_NaN();
+
+// Past 15 significant digits a decimal no longer round-trips through a double
+constexpr int MAX_FIXED_DIGITS = 15;
+constexpr uint32_t MAX_DECIMAL_PLACES = 9;
+
+constexpr double POW10[] = {1e0, 1e1, 1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                            1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+std::string_view trim(std::string_view field) {
+    while (!field.empty() && (field.front() == ' ' || field.front() == '\t')) field.remove_prefix(1);
+    while (!field.empty() && (field.back() == ' ' || field.back() == '\t')) field.remove_suffix(1);
+    return field;
+}
+
+// Digits after the point if the field is a plain decimal ("-12.50"), else -1
+int decimalPlaces(std::string_view field) {
+    field = trim(field);
+    if (!field.empty() && (field.front() == '-' || field.front() == '+')) field.remove_prefix(1);
+
+    int digits = 0;
+    int places = -1;
+    for (char ch : field) {
+        if (ch >= '0' && ch <= '9') {
+            digits++;
+            if (places >= 0) places++;
+        } else if (ch == '.' && places < 0) {
+            places = 0;
+        } else {
+            return -1;
+        }
+    }
+    if (digits == 0 || digits > MAX_FIXED_DIGITS) return -1;
+    return std::max(places, 0);
+}
+
+std::string formatNumber(double v) {
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), v);
+    return std::string(buffer, result.ptr);
+}
+
+bool isMissing(const std::string& bitmap, size_t row) {
+    return !bitmap.empty() && (static_cast<uint8_t>(bitmap[row >> 3]) >> (row & 7) & 1);
+}
+} // namespace
+
+namespace FullRunCodec {
+
+void splitCsvLine(std::string_view line, std::vector<std::string_view>& fields,
+                  std::string& unquoted) {
+    fields.clear();
+    unquoted.clear();
+    unquoted.reserve(line.size());  // unquoting only shrinks, so views stay valid
+
+    size_t pos = 0;
+    while (true) {
+        size_t end = pos;
+        while (end < line.size() && line[end] != ',' && line[end] != '"') ++end;
+
+        if (end == line.size() || line[end] == ',') {
+            fields.push_back(line.substr(pos, end - pos));
+            if (end == line.size()) return;
+            pos = end + 1;
+            continue;
+        }
+
+        const size_t from = unquoted.size();
+        unquoted.append(line.data() + pos, end - pos);
+        bool inQuotes = false;
+        size_t i = end;
+        for (; i < line.size(); ++i) {
+            const char ch = line[i];
+            if (ch == '"') {
+                if (inQuotes && i + 1 < line.size() && line[i + 1] == '"') {
+                    unquoted.push_back('"');
+                    ++i;
+                } else {
+                    inQuotes = !inQuotes;
+                }
+            } else if (ch == ',' && !inQuotes) {
+                break;
+            } else {
+                unquoted.push_back(ch);
+            }
+        }
+        fields.push_back(std::string_view(unquoted).substr(from));
+        if (i >= line.size()) return;
+        pos = i + 1;
+    }
+}
+
+double parseNumber(std::string_view field) {
+    field = trim(field);
+    if (!field.empty() && field.front() == '+') field.remove_prefix(1);
+    if (field.empty()) return MISSING;
+
+    // Plain decimals, nearly every cell of a run: digits and the point are
+    // exact in a double and so is one division, which rounds the same way
+    // from_chars does
+    {
+        const bool negative = field.front() == '-';
+        int64_t digits = 0;
+        int count = 0;
+        int places = -1;
+        size_t i = negative ? 1 : 0;
+        for (; i < field.size(); ++i) {
+            const char ch = field[i];
+            if (ch >= '0' && ch <= '9') {
+                digits = digits * 10 + (ch - '0');
+                if (places >= 0) places++;
+                if (++count > MAX_FIXED_DIGITS) break;
+            } else if (ch == '.' && places < 0) {
+                places = 0;
+            } else {
+                break;
+            }
+        }
+        if (i == field.size() && count > 0) {
+            const double v = static_cast<double>(digits) / POW10[std::max(places, 0)];
+            return negative ? -v : v;
+        }
+    }
+
+    double v = 0.0;
+    const auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), v);
+    if (ec != std::errc() || end != field.data() + field.size()) return MISSING;
+    return v;
+}
+
+Encoder::Encoder(std::vector<std::string> headers, Layout layout)
+    : m_headers(std::move(headers)), m_columns(m_headers.size()), m_layout(layout) {}
+
+void Encoder::addRow(const std::vector<std::string_view>& fields, const std::vector<double>& values) {
+    if (m_layout == Layout::Rows) {
+        for (std::string_view field : fields) {
+            m_cellText.append(field);
+            m_cellEnds.push_back(m_cellText.size());
+        }
+        m_rows++;
+        return;
+    }
+
+    if (m_rows % 8 == 0) {
+        for (Column& column : m_columns) {
+            if (!column.text) column.missing.push_back(0);
+        }
+    }
+
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+        Column& column = m_columns[i];
+        const double v = values[i];
+
+        if (!column.text && std::isnan(v) && !trim(fields[i]).empty()) {
+            makeText(column);
+        }
+        if (column.text) {
+            column.texts.emplace_back(fields[i]);
+            continue;
+        }
+
+        if (std::isnan(v) || v == -1.0) {
+            column.missing[m_rows >> 3] |= static_cast<uint8_t>(1u << (m_rows & 7));
+            column.anyMissing = true;
+            continue;
+        }
+
+        column.values.push_back(v);
+        if (column.fixedPoint) {
+            const int places = decimalPlaces(fields[i]);
+            if (places < 0 || places > static_cast<int>(MAX_DECIMAL_PLACES)) {
+                column.fixedPoint = false;
+            } else {
+                column.decimalPlaces = std::max(column.decimalPlaces, static_cast<uint32_t>(places));
+            }
+        }
+    }
+    m_rows++;
+}
+
+void Encoder::makeText(Column& column) const {
+    // Rows before the first text cell are written back out; a "-1" among
+    // them comes back as ""
+    column.texts.reserve(m_rows + 1);
+    size_t next = 0;
+    for (size_t row = 0; row < m_rows; ++row) {
+        const bool missing = column.missing[row >> 3] >> (row & 7) & 1;
+        column.texts.push_back(missing ? std::string() : formatNumber(column.values[next++]));
+    }
+    column.text = true;
+    column.values = {};
+    column.missing = {};
+}
+
+void Encoder::finish(FullRun* run, bool compress) const {
+    run->clear_headers();
+    run->clear_samples();
+    run->mutable_headers()->Reserve(static_cast<int>(m_headers.size()));
+    for (const std::string& header : m_headers) {
+        run->add_headers(header);
+    }
+
+    if (m_layout == Layout::Rows) {
+        run->clear_packed();
+        run->mutable_samples()->Reserve(static_cast<int>(m_rows));
+        size_t cell = 0;
+        size_t start = 0;
+        for (size_t row = 0; row < m_rows; ++row) {
+            auto* values = run->add_samples()->mutable_values();
+            values->Reserve(static_cast<int>(m_columns.size()));
+            for (size_t c = 0; c < m_columns.size(); ++c) {
+                const size_t end = m_cellEnds[cell++];
+                values->Add()->assign(m_cellText, start, end - start);
+                start = end;
+            }
+        }
+        return;
+    }
+
+    PackedRun* packed = run->mutable_packed();
+    packed->Clear();
+    packed->set_row_count(static_cast<uint32_t>(m_rows));
+
+    PackedColumns* columns = packed->mutable_columns();
+    columns->mutable_columns()->Reserve(static_cast<int>(m_columns.size()));
+    for (const Column& column : m_columns) {
+        PackedColumn* out = columns->add_columns();
+        if (column.text) {
+            out->mutable_texts()->Reserve(static_cast<int>(column.texts.size()));
+            for (const std::string& text : column.texts) {
+                out->add_texts(text);
+            }
+            continue;
+        }
+
+        if (column.anyMissing) {
+            out->set_missing(column.missing.data(), (m_rows + 7) / 8);
+        }
+        if (column.values.empty()) continue;
+
+        bool fixedPoint = column.fixedPoint;
+        if (fixedPoint) {
+            const double scale = POW10[column.decimalPlaces];
+            auto* deltas = out->mutable_deltas();
+            deltas->Reserve(static_cast<int>(column.values.size()));
+            int64_t previous = 0;
+            for (double v : column.values) {
+                const int64_t n = std::llround(v * scale);
+                if (static_cast<double>(n) / scale != v) {
+                    fixedPoint = false;
+                    break;
+                }
+                deltas->Add(n - previous);
+                previous = n;
+            }
+            if (fixedPoint) {
+                out->set_decimal_places(column.decimalPlaces);
+            } else {
+                out->clear_deltas();
+            }
+        }
+        if (!fixedPoint) {
+            out->mutable_values()->Add(column.values.begin(), column.values.end());
+        }
+    }
+
+    if (!compress) return;
+
+    const std::string raw = columns->SerializeAsString();
+    // qCompress puts the length in front of the zlib stream; the stream is
+    // what goes on the wire. Level 1: the deltas leave little for higher
+    // levels to find, at twice the time.
+    const QByteArray compressed =
+        qCompress(reinterpret_cast<const uchar*>(raw.data()), static_cast<qsizetype>(raw.size()), 1);
+    if (compressed.size() <= 4 || static_cast<size_t>(compressed.size() - 4) >= raw.size()) {
+        return;
+    }
+    packed->clear_columns();
+    packed->set_codec(PackedRun::CODEC_ZLIB);
+    packed->set_compressed_columns(compressed.constData() + 4, compressed.size() - 4);
+    packed->set_uncompressed_size(static_cast<uint32_t>(raw.size()));
+}
+
+bool encodeCsv(std::string_view csvText, FullRun* run, bool compress, Layout layout) {
+    if (csvText.substr(0, 3) == "\xEF\xBB\xBF") csvText.remove_prefix(3);
+
+    size_t pos = 0;
+    auto nextLine = [&]() {
+        size_t end = csvText.find('\n', pos);
+        if (end == std::string_view::npos) end = csvText.size();
+        std::string_view line = csvText.substr(pos, end - pos);
+        pos = end + 1;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        return line;
+    };
+    if (csvText.empty()) return false;
+
+    std::vector<std::string_view> fields;
+    std::string unquoted;
+    splitCsvLine(nextLine(), fields, unquoted);
+    Encoder encoder(std::vector<std::string>(fields.begin(), fields.end()), layout);
+    const size_t columnCount = fields.size();
+
+    std::vector<double> values(columnCount);
+    while (pos < csvText.size()) {
+        const std::string_view line = nextLine();
+        if (line.empty()) continue;
+        splitCsvLine(line, fields, unquoted);
+        if (fields.size() != columnCount) continue;  // torn row
+        if (layout == Layout::Packed) {
+            for (size_t i = 0; i < columnCount; ++i) {
+                values[i] = parseNumber(fields[i]);
+            }
+        }
+        encoder.addRow(fields, values);
+    }
+    encoder.finish(run, compress);
+    return true;
+}
+
+bool decode(const FullRun& run, DecodedRun& out, std::string* error) {
+    auto fail = [&](std::string message) {
+        if (error) *error = std::move(message);
+        return false;
+    };
+
+    const size_t columnCount = static_cast<size_t>(run.headers_size());
+    out.headers.assign(run.headers().begin(), run.headers().end());
+    out.columns.assign(columnCount, {});
+    out.texts.assign(columnCount, {});
+
+    if (!run.has_packed()) {
+        // Older clients: one string per cell
+        out.rowCount = static_cast<size_t>(run.samples_size());
+        std::vector<bool> isText(columnCount, false);
+        for (size_t c = 0; c < columnCount; ++c) out.columns[c].resize(out.rowCount, MISSING);
+        for (size_t row = 0; row < out.rowCount; ++row) {
+            const auto& values = run.samples(static_cast<int>(row)).values();
+            if (static_cast<size_t>(values.size()) != columnCount) {
+                return fail("row " + std::to_string(row) + " has " + std::to_string(values.size()) +
+                            " values, expected " + std::to_string(columnCount));
+            }
+            for (size_t c = 0; c < columnCount; ++c) {
+                const std::string& cell = values[static_cast<int>(c)];
+                const double v = parseNumber(cell);
+                if (std::isnan(v) && !trim(cell).empty()) isText[c] = true;
+                out.columns[c][row] = v == -1.0 ? MISSING : v;
+            }
+        }
+        for (size_t c = 0; c < columnCount; ++c) {
+            if (!isText[c]) continue;
+            out.columns[c].assign(out.rowCount, MISSING);
+            out.texts[c].reserve(out.rowCount);
+            for (const auto& sample : run.samples()) out.texts[c].push_back(sample.values(static_cast<int>(c)));
+        }
+        return true;
+    }
+
+    const PackedRun& packed = run.packed();
+    out.rowCount = packed.row_count();
+
+    PackedColumns inflated;
+    const PackedColumns* columns = &packed.columns();
+    if (packed.codec() == PackedRun::CODEC_ZLIB) {
+        // qUncompress wants the big-endian length qCompress puts in front
+        const uint32_t size = packed.uncompressed_size();
+        QByteArray framed;
+        framed.reserve(static_cast<qsizetype>(packed.compressed_columns().size()) + 4);
+        framed.append(static_cast<char>(size >> 24));
+        framed.append(static_cast<char>(size >> 16));
+        framed.append(static_cast<char>(size >> 8));
+        framed.append(static_cast<char>(size));
+        framed.append(packed.compressed_columns().data(),
+                      static_cast<qsizetype>(packed.compressed_columns().size()));
+        const QByteArray raw = qUncompress(framed);
+        if (static_cast<uint32_t>(raw.size()) != size || !inflated.ParseFromArray(raw.constData(), raw.size())) {
+            return fail("corrupt compressed columns");
+        }
+        columns = &inflated;
+    } else if (packed.codec() != PackedRun::CODEC_NONE) {
+        return fail("unknown codec " + std::to_string(packed.codec()));
+    }
+
+    if (static_cast<size_t>(columns->columns_size()) != columnCount) {
+        return fail(std::to_string(columns->columns_size()) + " packed columns for " +
+                    std::to_string(columnCount) + " headers");
+    }
+
+    const size_t rows = out.rowCount;
+    for (size_t c = 0; c < columnCount; ++c) {
+        const PackedColumn& column = columns->columns(static_cast<int>(c));
+        std::vector<double>& values = out.columns[c];
+        values.assign(rows, MISSING);
+
+        if (column.texts_size() > 0) {
+            if (static_cast<size_t>(column.texts_size()) != rows) {
+                return fail("text column " + std::to_string(c) + " has the wrong row count");
+            }
+            out.texts[c].assign(column.texts().begin(), column.texts().end());
+            continue;
+        }
+
+        const std::string& missing = column.missing();
+        if (!missing.empty() && missing.size() != (rows + 7) / 8) {
+            return fail("column " + std::to_string(c) + " has a bad missing bitmap");
+        }
+        size_t present = rows;
+        for (size_t i = 0; i < missing.size(); ++i) {
+            uint8_t bits = static_cast<uint8_t>(missing[i]);
+            if (i == missing.size() - 1 && rows % 8) bits &= static_cast<uint8_t>((1u << (rows % 8)) - 1);
+            present -= static_cast<size_t>(std::popcount(bits));
+        }
+
+        const bool fixedPoint = column.deltas_size() > 0;
+        const size_t stored = fixedPoint ? column.deltas_size() : column.values_size();
+        if (stored != present || (fixedPoint && column.values_size() > 0) ||
+            column.decimal_places() > MAX_DECIMAL_PLACES) {
+            return fail("column " + std::to_string(c) + " doesn't match its bitmap");
+        }
+
+        const double scale = POW10[column.decimal_places()];
+        int64_t n = 0;
+        size_t next = 0;
+        for (size_t row = 0; row < rows; ++row) {
+            if (isMissing(missing, row)) continue;
+            if (fixedPoint) {
+                // Wraps instead of overflowing on a corrupt stream
+                n = static_cast<int64_t>(static_cast<uint64_t>(n) +
+                                         static_cast<uint64_t>(column.deltas(static_cast<int>(next++))));
+                values[row] = static_cast<double>(n) / scale;
+            } else {
+                values[row] = column.values(static_cast<int>(next++));
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace FullRunCodec
@@ -0,0 +1,107 @@
+#ifndef FULLRUNCODEC_H
+#define FULLRUNCODEC_H
+
+// FullRunCodec - Packed columnar encoding of FullRun (benchmark_full.proto)
+// Used by: PublicExportBuilder, BenchmarkFullCsvToProto (upload requests)
+// Purpose: Send a run's CSV cells as one packed array per column instead of
+//          one string per cell
+// Encoding: Columns whose cells are plain decimals become fixed-point sint64
+//           deltas (Time, counters and most sensors shrink to 1-2 bytes a
+//           cell); other numbers stay doubles; anything else stays text.
+//           Missing cells ("", "-1") go in a bitmap. The packed columns can
+//           be zlib-compressed as a block.
+//
+// decode() reads both the packed form and the older string rows.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace checkmark::benchmarks {
+class FullRun;
+}
+
+namespace FullRunCodec {
+
+// Splits one CSV line with the quote rules of CsvSerializer. Fields are views
+// into the line, or into `unquoted` for fields that had quotes in them.
+void splitCsvLine(std::string_view line, std::vector<std::string_view>& fields,
+                  std::string& unquoted);
+
+// Locale-free, like QString::toDouble; NaN if the field isn't a number
+double parseNumber(std::string_view field);
+
+// What Encoder::finish writes to a FullRun
+enum class Layout {
+    Rows,    // the string rows (samples) only, what current servers read
+    Packed,  // packed only, samples left empty
+};
+
+// Uploads keep the string rows until the server reads FullRun.packed; sending
+// both would make them bigger than either. Switching to Layout::Packed also
+// switches UPLOAD_SCHEMA_VERSION, which tells the server which one to read.
+constexpr Layout UPLOAD_LAYOUT = Layout::Rows;
+constexpr const char* UPLOAD_SCHEMA_VERSION = UPLOAD_LAYOUT == Layout::Packed ? "2" : "1";
+
+// Builds the packed form row by row. Not thread-safe.
+class Encoder {
+public:
+    explicit Encoder(std::vector<std::string> headers, Layout layout = UPLOAD_LAYOUT);
+
+    // values[i] is parseNumber(fields[i]), unused with Layout::Rows; rows must
+    // have a field per header
+    void addRow(const std::vector<std::string_view>& fields, const std::vector<double>& values);
+
+    size_t rowCount() const { return m_rows; }
+
+    // Writes headers and, per the layout, the rows to samples or the packed
+    // columns. With compress, the columns go in a zlib block if that's
+    // smaller.
+    void finish(checkmark::benchmarks::FullRun* run, bool compress = true) const;
+
+private:
+    struct Column {
+        std::vector<double> values;       // present values
+        std::vector<uint8_t> missing;     // bit per row
+        bool anyMissing = false;
+        bool fixedPoint = true;           // every present cell is a plain decimal
+        uint32_t decimalPlaces = 0;
+        bool text = false;
+        std::vector<std::string> texts;   // every row, once the column is text
+    };
+
+    void makeText(Column& column) const;
+
+    std::vector<std::string> m_headers;
+    std::vector<Column> m_columns;
+    size_t m_rows = 0;
+    Layout m_layout;
+    // Row-major cells with Layout::Rows: their text back to back, and where
+    // each one ends
+    std::string m_cellText;
+    std::vector<size_t> m_cellEnds;
+};
+
+// Encodes a whole CSV; false if it has no header
+bool encodeCsv(std::string_view csvText, checkmark::benchmarks::FullRun* run,
+               bool compress = true, Layout layout = UPLOAD_LAYOUT);
+
+struct DecodedRun {
+    std::vector<std::string> headers;
+    size_t rowCount = 0;
+    // Column-major, NaN where a row had no reading or the column is text
+    std::vector<std::vector<double>> columns;
+    // Cells of text columns, empty for numeric ones
+    std::vector<std::vector<std::string>> texts;
+};
+
+// Reads the packed form when present, else the string rows. On failure
+// returns false and sets *error when given.
+bool decode(const checkmark::benchmarks::FullRun& run, DecodedRun& out,
+            std::string* error = nullptr);
+
+} // namespace FullRunCodec
+
+#endif // FULLRUNCODEC_H
@@ -0,0 +1,87 @@
+#include "ProtoMessageView.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <google/protobuf/struct.pb.h>
+#include <google/protobuf/util/json_util.h>
+
+using google::protobuf::Struct;
+using google::protobuf::Value;
+
+QString ProtoMessageView::typeName() const {
+    return m_message ? QString::fromStdString(m_message->GetDescriptor()->full_name()) : QString();
+}
+
+QVariant ProtoMessageView::toVariant() const {
+    if (!m_message) return QVariant();
+
+    std::string json;
+    google::protobuf::util::JsonPrintOptions opts;
+    opts.preserve_proto_field_names = true;
+    if (!google::protobuf::util::MessageToJsonString(*m_message, &json, opts).ok()) {
+        return QVariant();
+    }
+    return QJsonDocument::fromJson(QByteArray::fromStdString(json)).toVariant();
+}
+
+namespace ProtoStruct {
+
+const Value* find(const Struct& s, const char* key) {
+    auto it = s.fields().find(key);
+    return it == s.fields().end() ? nullptr : &it->second;
+}
+
+const Struct* object(const Struct& s, const char* key) {
+    const Value* v = find(s, key);
+    return v && v->kind_case() == Value::kStructValue ? &v->struct_value() : nullptr;
+}
+
+double number(const Struct& s, const char* key, double fallback) {
+    const Value* v = find(s, key);
+    if (!v) return fallback;
+    switch (v->kind_case()) {
+        case Value::kNumberValue:
+            return v->number_value();
+        case Value::kBoolValue:
+            return v->bool_value() ? 1.0 : 0.0;
+        case Value::kStringValue: {
+            bool ok = false;
+            const double d = QString::fromStdString(v->string_value()).toDouble(&ok);
+            return ok ? d : fallback;
+        }
+        default:
+            return fallback;
+    }
+}
+
+QJsonValue toJson(const Value& value) {
+    switch (value.kind_case()) {
+        case Value::kNumberValue:
+            return value.number_value();
+        case Value::kStringValue:
+            return QString::fromStdString(value.string_value());
+        case Value::kBoolValue:
+            return value.bool_value();
+        case Value::kStructValue:
+            return toJson(value.struct_value());
+        case Value::kListValue: {
+            QJsonArray array;
+            for (const Value& item : value.list_value().values()) {
+                array.append(toJson(item));
+            }
+            return array;
+        }
+        default:
+            return QJsonValue::Null;
+    }
+}
+
+QJsonObject toJson(const Struct& s) {
+    QJsonObject out;
+    for (const auto& [key, value] : s.fields()) {
+        out.insert(QString::fromStdString(key), toJson(value));
+    }
+    return out;
+}
+
+} // namespace ProtoStruct
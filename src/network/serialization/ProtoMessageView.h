@@ -0,0 +1,69 @@
+#ifndef PROTOMESSAGEVIEW_H
+#define PROTOMESSAGEVIEW_H
+
+// ProtoMessageView - Parsed protobuf message carried through QVariant as is
+// Used by: ProtobufSerializer (decode table entries marked as views),
+//          DownloadApiClient (general diagnostics)
+// Purpose: Let callers read a response's fields directly instead of through a
+//          fully materialized QVariantMap tree
+// When to use: data.value<ProtoMessageView>().as<T>() for the generated type;
+//              toVariant() converts on demand when a map is really needed
+// Operations: Typed access, lazy QVariant conversion, google.protobuf.Struct readers
+
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QMetaType>
+#include <QString>
+#include <QVariant>
+#include <google/protobuf/message.h>
+#include <memory>
+
+namespace google::protobuf {
+class Struct;
+class Value;
+}
+
+class ProtoMessageView {
+public:
+    ProtoMessageView() = default;
+    explicit ProtoMessageView(std::shared_ptr<const google::protobuf::Message> message)
+        : m_message(std::move(message)) {}
+
+    bool isValid() const { return m_message != nullptr; }
+    const google::protobuf::Message* message() const { return m_message.get(); }
+    // Full name, e.g. "google.protobuf.Struct"
+    QString typeName() const;
+
+    // The message as its generated type, nullptr if it is another type
+    template <typename T>
+    const T* as() const {
+        return m_message && m_message->GetDescriptor() == T::descriptor()
+            ? static_cast<const T*>(m_message.get())
+            : nullptr;
+    }
+
+    // JSON-shaped tree with proto field names; built on every call
+    QVariant toVariant() const;
+
+private:
+    std::shared_ptr<const google::protobuf::Message> m_message;
+};
+
+Q_DECLARE_METATYPE(ProtoMessageView)
+
+// Typed reads from a google.protobuf.Struct without converting it
+namespace ProtoStruct {
+
+// nullptr when the key is absent
+const google::protobuf::Value* find(const google::protobuf::Struct& s, const char* key);
+// nullptr when absent or not an object
+const google::protobuf::Struct* object(const google::protobuf::Struct& s, const char* key);
+// Numbers, numeric strings and bools; fallback otherwise
+double number(const google::protobuf::Struct& s, const char* key, double fallback = -1.0);
+
+QJsonValue toJson(const google::protobuf::Value& value);
+QJsonObject toJson(const google::protobuf::Struct& s);
+
+} // namespace ProtoStruct
+
+#endif // PROTOMESSAGEVIEW_H
@@ -1,4 +1,5 @@
 #include "ProtobufSerializer.h"
+#include "ProtoMessageView.h"
 #include "../../logging/Logger.h"
 #include "diagnostic.pb.h"
 #include <QVariantMap>
@@ -12,7 +13,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <cmath>
-#include <optional>
+#include <limits>
 
 // Avoid Windows macro collision with google::protobuf::Reflection::GetMessage
 #ifdef GetMessage
@@ -54,20 +55,26 @@ SerializationResult ProtobufSerializer::serialize(const QVariant& data) {
         
         LOG_INFO << "Serializing as message type: " << messageType.toStdString();
         
-        auto message = createMessageFromVariant(data, messageType);
+        // The message tree (submissions carry every component plus artifacts)
+        // goes in one arena and is freed in one go
+        google::protobuf::ArenaOptions arenaOptions;
+        arenaOptions.start_block_size = 16 * 1024;
+        arenaOptions.max_block_size = 1024 * 1024;
+        google::protobuf::Arena arena(arenaOptions);
+        google::protobuf::Message* message = createMessageFromVariant(data, messageType, &arena);
         if (!message) {
             result.error = "Failed to create protobuf message from data";
             return result;
         }
         
-        // Serialize to binary protobuf
-        std::string binaryData;
-        if (!message->SerializeToString(&binaryData)) {
-            result.error = "Failed to serialize protobuf message to binary format";
+        // Serialize to binary protobuf, straight into a buffer of the final size
+        const size_t byteSize = message->ByteSizeLong();
+        if (byteSize > static_cast<size_t>(std::numeric_limits<int>::max())) {
+            result.error = "Protobuf message exceeds 2 GB";
             return result;
         }
-        
-        result.data = QByteArray(binaryData.data(), static_cast<int>(binaryData.size()));
+        result.data = QByteArray(static_cast<qsizetype>(byteSize), Qt::Uninitialized);
+        message->SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t*>(result.data.data()));
         result.success = true;
         
         LOG_INFO << "Protobuf serialization successful, " << result.data.size() << " bytes";
@@ -80,16 +87,77 @@ SerializationResult ProtobufSerializer::serialize(const QVariant& data) {
     return result;
 }
 
+namespace {
+// What each known message decodes to. Views skip the QVariant tree; callers
+// read them through ProtoMessageView.
+struct DecodeEntry {
+    const char* name;  // short name, as given in expectedType hints
+    const google::protobuf::Message& prototype;
+    bool view;
+};
+
+const DecodeEntry* findDecodeEntry(const QString& typeName) {
+    static const DecodeEntry table[] = {
+        {"DiagnosticSubmission", DiagnosticSubmission::default_instance(), false},
+        {"MenuResponse", MenuResponse::default_instance(), false},
+        {"ComponentComparison", ComponentComparison::default_instance(), false},
+        {"UploadResponse", UploadResponse::default_instance(), false},
+        {"Struct", google::protobuf::Struct::default_instance(), true},
+    };
+
+    // Accept full names too ("diagnostic.MenuResponse")
+    const QString shortName = typeName.section(QLatin1Char('.'), -1);
+    for (const DecodeEntry& entry : table) {
+        if (shortName == QLatin1String(entry.name)) return &entry;
+    }
+    return nullptr;
+}
+
+// Endpoints and the message they answer with. A path ending in '/' matches
+// everything below it; any other path must match up to the end.
+struct EndpointEntry {
+    const char* path;
+    const char* type;
+};
+
+const EndpointEntry kEndpointTable[] = {
+    {"/pb/menu", "MenuResponse"},
+    {"/pb/component/", "ComponentComparison"},
+    {"/pb/diagnostics/general", "Struct"},
+    {"/pb/submit", "UploadResponse"},
+};
+} // namespace
+
+QString ProtobufSerializer::messageTypeFor(const QString& path, const QString& contentType) {
+    // "application/x-protobuf; messageType=diagnostic.MenuResponse" (or proto=)
+    const QStringList params = contentType.split(QLatin1Char(';'));
+    for (int i = 1; i < params.size(); ++i) {
+        const QString param = params[i].trimmed();
+        const QString key = param.section(QLatin1Char('='), 0, 0).trimmed();
+        if (key.compare(QLatin1String("messageType"), Qt::CaseInsensitive) == 0 ||
+            key.compare(QLatin1String("proto"), Qt::CaseInsensitive) == 0) {
+            QString value = param.section(QLatin1Char('='), 1).trimmed();
+            value.remove(QLatin1Char('"'));
+            if (findDecodeEntry(value)) return value;
+        }
+    }
+
+    for (const EndpointEntry& entry : kEndpointTable) {
+        const QLatin1String endpoint(entry.path);
+        const int at = path.indexOf(endpoint);
+        if (at < 0) continue;
+        if (endpoint.endsWith(QLatin1Char('/')) || at + endpoint.size() == path.size()) {
+            return QString::fromLatin1(entry.type);
+        }
+    }
+    return QString();
+}
+
 DeserializationResult ProtobufSerializer::deserialize(const QByteArray& data,
                                                       const QString& expectedType) {
     DeserializationResult result;
     
     try {
-        if (!expectedType.isEmpty()) {
-            LOG_WARN << "Protobuf deserialize: expected=" << expectedType.toStdString()
-                     << " bytes=" << data.size();
-        }
-        
         // Validate input data
         if (data.isEmpty()) {
             result.error = "Cannot deserialize empty protobuf data";
@@ -102,193 +170,45 @@ DeserializationResult ProtobufSerializer::deserialize(const QByteArray& data,
             LOG_ERROR << "Protobuf data size exceeds 100MB limit: " << data.size() << " bytes";
             return result;
         }
-        
-        // Try to deserialize as different message types
-        // If caller provided expectedType, try that FIRST and fail fast if it doesn't parse.
 
-        auto parseAsType = [&](const QString& typeName) -> std::optional<QVariant> {
-            try {
-                if (typeName == QLatin1String("DiagnosticSubmission")) {
-                    DiagnosticSubmission msg;
-                    if (msg.ParseFromArray(data.constData(), data.size()) && msg.IsInitialized()) {
-                        LOG_WARN << "Protobuf deserializer (forced): DiagnosticSubmission";
-                        return convertMessageToVariant(msg);
-                    }
-                } else if (typeName == QLatin1String("MenuResponse")) {
-                    MenuResponse msg;
-                    if (msg.ParseFromArray(data.constData(), data.size()) && msg.IsInitialized()) {
-                        LOG_WARN << "Protobuf deserializer (forced): MenuResponse";
-                        return convertMessageToVariant(msg);
-                    }
-                } else if (typeName == QLatin1String("ComponentComparison")) {
-                    ComponentComparison msg;
-                    if (msg.ParseFromArray(data.constData(), data.size()) && msg.IsInitialized()) {
-                        LOG_WARN << "Protobuf deserializer (forced): ComponentComparison";
-                        return convertMessageToVariant(msg);
-                    }
-                } else if (typeName == QLatin1String("Struct")) {
-                    google::protobuf::Struct msg;
-                    if (msg.ParseFromArray(data.constData(), data.size()) && msg.IsInitialized()) {
-                        LOG_WARN << "Protobuf deserializer (forced): google.protobuf.Struct";
-                        return convertMessageToVariant(msg);
-                    }
-                } else if (typeName == QLatin1String("UploadResponse")) {
-                    UploadResponse msg;
-                    if (msg.ParseFromArray(data.constData(), data.size()) && msg.IsInitialized()) {
-                        LOG_WARN << "Protobuf deserializer (forced): UploadResponse";
-                        return convertMessageToVariant(msg);
-                    }
-                }
-            } catch (const std::exception& e) {
-                LOG_WARN << "Exception forcing protobuf type " << typeName.toStdString() << ": " << e.what();
-            }
-            return std::nullopt;
-        };
-
-        if (!expectedType.isEmpty()) {
-            QString normalized = expectedType;
-            if (normalized.contains(QLatin1Char('.'))) {
-                normalized = normalized.section(QLatin1Char('.'), -1); // strip package if present
-            }
-            if (auto forced = parseAsType(normalized)) {
-                result.data = *forced;
-                result.success = true;
-                return result;
-            }
-            result.error = QString("Failed to parse protobuf as expected type: %1").arg(expectedType);
-            LOG_ERROR << result.error.toStdString();
+        // Proto3 parses almost any bytes as almost any message, so the type
+        // comes from the caller (or the endpoint and content type, resolved
+        // by BaseApiClient through messageTypeFor) and the data is parsed once
+        if (expectedType.isEmpty()) {
+            LOG_WARN << "Protobuf deserialize: no message type for " << data.size()
+                     << " bytes, leaving them undecoded";
+            result.data = data;
+            result.success = true;
             return result;
         }
 
-        // Fallback heuristic path (legacy)
-        // Prioritize DiagnosticSubmission first so uploads parse correctly and aren't mistaken
-        // for MenuResponse (proto3 messages parse empty/default successfully).
-
-        // Try DiagnosticSubmission first
-        {
-            try {
-                DiagnosticSubmission diagnosticSubmission;
-                if (diagnosticSubmission.ParseFromArray(data.constData(), data.size())) {
-                    if (diagnosticSubmission.IsInitialized()) {
-                        LOG_INFO << "Protobuf deserializer: Parsed type DiagnosticSubmission";
-                        result.data = convertMessageToVariant(diagnosticSubmission);
-                        result.success = true;
-                        LOG_INFO << "Successfully deserialized as DiagnosticSubmission";
-                        return result;
-                    } else {
-                        LOG_WARN << "DiagnosticSubmission parsed but not properly initialized";
-                    }
-                }
-            } catch (const std::exception& e) {
-                LOG_WARN << "Exception parsing DiagnosticSubmission: " << e.what();
-            }
+        const DecodeEntry* entry = findDecodeEntry(expectedType);
+        if (!entry) {
+            result.error = QString("Unknown protobuf message type: %1").arg(expectedType);
+            LOG_ERROR << result.error.toStdString();
+            return result;
         }
 
-        // Next, try common response types
-
-        // Try MenuResponse first
-        {
-            try {
-                MenuResponse menuResponse;
-                if (menuResponse.ParseFromArray(data.constData(), data.size())) {
-                    if (menuResponse.IsInitialized()) {
-                        LOG_INFO << "Protobuf deserializer: Parsed type MenuResponse";
-                        result.data = convertMessageToVariant(menuResponse);
-                        // Log compact JSON preview
-                        try {
-                            QVariantMap vm = result.data.toMap();
-                            QJsonObject jo = QJsonObject::fromVariantMap(vm);
-                            QByteArray preview = QJsonDocument(jo).toJson(QJsonDocument::Compact);
-                            QString out = QString::fromUtf8(preview);
-                            if (out.size() > 1500) out = out.left(1500) + QStringLiteral("...");
-                            LOG_INFO << "MenuResponse JSON preview: " << out.toStdString();
-                        } catch (...) {}
-                        result.success = true;
-                        LOG_INFO << "Successfully deserialized as MenuResponse";
-                        return result;
-                    } else {
-                        LOG_WARN << "MenuResponse parsed but not properly initialized";
-                    }
-                }
-            } catch (const std::exception& e) {
-                LOG_WARN << "Exception parsing MenuResponse: " << e.what();
+        std::shared_ptr<google::protobuf::Message> message(entry->prototype.New());
+        if (!message->ParseFromArray(data.constData(), data.size())) {
+            QString hexData;
+            const int maxBytes = (data.size() < 32) ? data.size() : 32;
+            for (int i = 0; i < maxBytes; ++i) {
+                hexData += QString("%1 ").arg(static_cast<unsigned char>(data[i]), 2, 16, QChar('0'));
             }
+            result.error = QString("Failed to parse protobuf as expected type: %1 (size: %2 bytes, start: %3)")
+                          .arg(expectedType).arg(data.size()).arg(hexData.trimmed());
+            LOG_ERROR << result.error.toStdString();
+            return result;
         }
-        
-        // Try ComponentComparison
-        {
-            try {
-                ComponentComparison componentComparison;
-                if (componentComparison.ParseFromArray(data.constData(), data.size())) {
-                    if (componentComparison.IsInitialized()) {
-                        LOG_INFO << "Protobuf deserializer: Parsed type ComponentComparison";
-                        // Log which oneof is set
-                        try {
-                            if (componentComparison.has_cpu()) {
-                                LOG_INFO << "ComponentComparison contains: cpu";
-                            } else if (componentComparison.has_gpu()) {
-                                LOG_INFO << "ComponentComparison contains: gpu";
-                            } else if (componentComparison.has_memory()) {
-                                LOG_INFO << "ComponentComparison contains: memory";
-                            } else if (componentComparison.has_drive()) {
-                                LOG_INFO << "ComponentComparison contains: drive";
-                            } else {
-                                LOG_WARN << "ComponentComparison 'component' oneof not set";
-                            }
-                        } catch (...) {}
 
-                        result.data = convertMessageToVariant(componentComparison);
-                        // Log compact JSON preview
-                        try {
-                            QVariantMap vm = result.data.toMap();
-                            QJsonObject jo = QJsonObject::fromVariantMap(vm);
-                            QByteArray preview = QJsonDocument(jo).toJson(QJsonDocument::Compact);
-                            QString out = QString::fromUtf8(preview);
-                            if (out.size() > 1500) out = out.left(1500) + QStringLiteral("...");
-                            LOG_INFO << "ComponentComparison JSON preview: " << out.toStdString();
-                        } catch (...) {}
-                        result.success = true;
-                        LOG_INFO << "Successfully deserialized as ComponentComparison";
-                        return result;
-                    } else {
-                        LOG_WARN << "ComponentComparison parsed but not properly initialized";
-                    }
-                }
-            } catch (const std::exception& e) {
-                LOG_WARN << "Exception parsing ComponentComparison: " << e.what();
-            }
+        LOG_INFO << "Protobuf deserializer: parsed " << entry->name << ", " << data.size() << " bytes";
+        if (entry->view) {
+            result.data = QVariant::fromValue(ProtoMessageView(std::move(message)));
+        } else {
+            result.data = convertMessageToVariant(*message);
         }
-        
-        // Try UploadResponse
-        {
-            try {
-        UploadResponse uploadResponse;
-                if (uploadResponse.ParseFromArray(data.constData(), data.size())) {
-                    if (uploadResponse.IsInitialized()) {
-            LOG_INFO << "Protobuf deserializer: Parsed type UploadResponse";
-            result.data = convertMessageToVariant(uploadResponse);
-                        result.success = true;
-                        LOG_INFO << "Successfully deserialized as UploadResponse";
-                        return result;
-                    } else {
-                        LOG_WARN << "UploadResponse parsed but not properly initialized";
-                    }
-                }
-            } catch (const std::exception& e) {
-                LOG_WARN << "Exception parsing UploadResponse: " << e.what();
-            }
-        }
-        
-        // Log first few bytes for debugging
-        QString hexData;
-    int maxBytes = (data.size() < 32) ? data.size() : 32;
-        for (int i = 0; i < maxBytes; ++i) {
-            hexData += QString("%1 ").arg(static_cast<unsigned char>(data[i]), 2, 16, QChar('0'));
-        }
-        
-        result.error = QString("Unable to parse protobuf data as any known message type (size: %1 bytes, start: %2)")
-                      .arg(data.size()).arg(hexData.trimmed());
-        LOG_ERROR << "Protobuf deserialization failed: " << result.error.toStdString();
+        result.success = true;
         
     } catch (const std::exception& e) {
         result.error = QString("Protobuf deserialization failed: %1").arg(e.what());
@@ -312,17 +232,17 @@ bool ProtobufSerializer::canSerialize(const QVariant& data) const {
            isValidComponentComparison(dataMap);
 }
 
-std::unique_ptr<google::protobuf::Message> ProtobufSerializer::createMessageFromVariant(
-    const QVariant& data, const QString& messageType) const {
+google::protobuf::Message* ProtobufSerializer::createMessageFromVariant(
+    const QVariant& data, const QString& messageType, google::protobuf::Arena* arena) const {
     
     QVariantMap dataMap = data.toMap();
     
     if (messageType == "DiagnosticSubmission") {
-        return createDiagnosticSubmission(dataMap);
+        return createDiagnosticSubmission(dataMap, arena);
     } else if (messageType == "MenuResponse") {
-        return createMenuResponse(dataMap);
+        return createMenuResponse(dataMap, arena);
     } else if (messageType == "ComponentComparison") {
-        return createComponentComparison(dataMap);
+        return createComponentComparison(dataMap, arena);
     }
     
     return nullptr;
@@ -532,8 +452,8 @@ QVariant ProtobufSerializer::convertMessageToVariant(const google::protobuf::Mes
     return result;
 }
 
-std::unique_ptr<google::protobuf::Message> ProtobufSerializer::createDiagnosticSubmission(const QVariantMap& data) const {
-    auto submission = std::make_unique<DiagnosticSubmission>();
+google::protobuf::Message* ProtobufSerializer::createDiagnosticSubmission(const QVariantMap& data, google::protobuf::Arena* arena) const {
+    auto* submission = google::protobuf::Arena::CreateMessage<DiagnosticSubmission>(arena);
     
     // Populate CPU data
     if (data.contains("cpu")) {
@@ -591,18 +511,18 @@ std::unique_ptr<google::protobuf::Message> ProtobufSerializer::createDiagnosticS
     if (data.contains("pdh_metrics_csv")) {
         QByteArray bytes = data.value("pdh_metrics_csv").toByteArray();
         if (!bytes.isEmpty()) {
-            submission->set_pdh_metrics_csv(std::string(bytes.constData(), static_cast<size_t>(bytes.size())));
+            submission->set_pdh_metrics_csv(bytes.constData(), static_cast<size_t>(bytes.size()));
         }
     }
     if (data.contains("pdh_metrics_filename")) {
         submission->set_pdh_metrics_filename(data.value("pdh_metrics_filename").toString().toStdString());
     }
     
-    return std::unique_ptr<google::protobuf::Message>(submission.release());
+    return submission;
 }
 
-std::unique_ptr<google::protobuf::Message> ProtobufSerializer::createMenuResponse(const QVariantMap& data) const {
-    auto menu = std::make_unique<MenuResponse>();
+google::protobuf::Message* ProtobufSerializer::createMenuResponse(const QVariantMap& data, google::protobuf::Arena* arena) const {
+    auto* menu = google::protobuf::Arena::CreateMessage<MenuResponse>(arena);
     
     // Available CPUs
     if (data.contains("available_cpus") || data.contains("availableCpus")) {
@@ -649,11 +569,11 @@ std::unique_ptr<google::protobuf::Message> ProtobufSerializer::createMenuRespons
         }
     }
     
-    return std::unique_ptr<google::protobuf::Message>(menu.release());
+    return menu;
 }
 
-std::unique_ptr<google::protobuf::Message> ProtobufSerializer::createComponentComparison(const QVariantMap& data) const {
-    auto comparison = std::make_unique<ComponentComparison>();
+google::protobuf::Message* ProtobufSerializer::createComponentComparison(const QVariantMap& data, google::protobuf::Arena* arena) const {
+    auto* comparison = google::protobuf::Arena::CreateMessage<ComponentComparison>(arena);
     
     // Determine component type and populate accordingly
     if (data.contains("cpu")) {
@@ -671,7 +591,7 @@ std::unique_ptr<google::protobuf::Message> ProtobufSerializer::createComponentCo
     }
     // Handle other component types similarly...
     
-    return std::unique_ptr<google::protobuf::Message>(comparison.release());
+    return comparison;
 }
 
 void ProtobufSerializer::populateCPUData(google::protobuf::Message* cpuDataMsg, const QVariantMap& data) const {
@@ -6,10 +6,15 @@
 // Purpose: Convert QVariant ↔ binary protobuf using Google Protocol Buffers
 // When to use: For communication with /pb/ endpoints requiring binary protobuf format
 // Operations: QVariant to protobuf conversion, binary parsing, schema validation
+//
+// Responses are decoded through a fixed table: the message type comes from the
+// expectedType hint, resolved by messageTypeFor() from the endpoint or content
+// type when the caller gives none, and the bytes are parsed exactly once.
 
 #include "ISerializer.h"
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <google/protobuf/arena.h>
 #include <google/protobuf/message.h>
 #include <memory>
 
@@ -27,17 +32,22 @@ public:
     
     bool canSerialize(const QVariant& data) const override;
 
+    // Message type for a response, from a messageType=/proto= parameter of its
+    // content type or else its endpoint path; empty if neither is known
+    static QString messageTypeFor(const QString& path, const QString& contentType = QString());
+
 private:
-    // Helper methods for converting QVariant to protobuf messages
-    std::unique_ptr<google::protobuf::Message> createMessageFromVariant(
-        const QVariant& data, const QString& messageType) const;
+    // Helper methods for converting QVariant to protobuf messages.
+    // Messages are created on the arena and freed with it.
+    google::protobuf::Message* createMessageFromVariant(
+        const QVariant& data, const QString& messageType, google::protobuf::Arena* arena) const;
     
     QVariant convertMessageToVariant(const google::protobuf::Message& message) const;
     
     // Specific message type converters
-    std::unique_ptr<google::protobuf::Message> createDiagnosticSubmission(const QVariantMap& data) const;
-    std::unique_ptr<google::protobuf::Message> createMenuResponse(const QVariantMap& data) const;
-    std::unique_ptr<google::protobuf::Message> createComponentComparison(const QVariantMap& data) const;
+    google::protobuf::Message* createDiagnosticSubmission(const QVariantMap& data, google::protobuf::Arena* arena) const;
+    google::protobuf::Message* createMenuResponse(const QVariantMap& data, google::protobuf::Arena* arena) const;
+    google::protobuf::Message* createComponentComparison(const QVariantMap& data, google::protobuf::Arena* arena) const;
     
     // Helper methods for populating protobuf messages from QVariant data
     void populateCPUData(google::protobuf::Message* cpuDataMsg, const QVariantMap& data) const;
@@ -1,20 +1,30 @@
 #include "PublicExportBuilder.h"
-#include "CsvSerializer.h"
+#include "FullRunCodec.h"
+#include "UploadPayloadWriter.h"
+#include "../../benchmark/SectionalSummary.h"
 #include "../../logging/Logger.h"
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
 #include <QDateTime>
-#include <QJsonDocument>
-#include <QJsonObject>
 #include <QCryptographicHash>
+#include <QStringList>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
 #include <limits>
-#include <unordered_map>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include <google/protobuf/arena.h>
+
 // Generated from split proto files
 #include "benchmark_upload.pb.h"
 #include "benchmark_public.pb.h"
+#include "benchmark_full.pb.h"
+#include "benchmark_common.pb.h"
 
 using checkmark::benchmarks::BenchmarkUploadRequest;
 using checkmark::benchmarks::ClientEnvelope;
@@ -22,7 +32,6 @@ using checkmark::benchmarks::BenchmarkRunMeta;
 using checkmark::benchmarks::PublicSummary;
 using checkmark::benchmarks::PublicSample;
 using checkmark::benchmarks::CoreUsage;
-using checkmark::benchmarks::Attachment;
 using checkmark::benchmarks::ColumnStat;
 
 static QByteArray readAllBytes(const QString& path) {
@@ -36,33 +45,17 @@ static QByteArray readAllBytes(const QString& path) {
     return data;
 }
 
+using FullRunCodec::parseNumber;
+using FullRunCodec::splitCsvLine;
+
 namespace {
-// Minimal CSV parser (quotes/commas) to preserve alignment with CsvSerializer
-QStringList parseCsvLine(const QString& line) {
-    QStringList fields;
-    QString currentField;
-    bool inQuotes = false;
-
-    for (int i = 0; i < line.length(); ++i) {
-        QChar ch = line[i];
-
-        if (ch == '"') {
-            if (inQuotes && i + 1 < line.length() && line[i + 1] == '"') {
-                currentField += '"';
-                ++i;
-            } else {
-                inQuotes = !inQuotes;
-            }
-        } else if (ch == ',' && !inQuotes) {
-            fields.append(currentField);
-            currentField.clear();
-        } else {
-            currentField += ch;
-        }
-    }
+constexpr double MISSING = std::numeric_limits<double>::quiet_NaN();
+constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+constexpr int PUBLIC_CORE_COUNT = 8;  // PDH_Core 0..7 CPU (%)
 
-    fields.append(currentField);
-    return fields;
+// -1 is what the recorder writes for "no reading"
+bool isValid(double v) {
+    return !std::isnan(v) && v != -1.0;
 }
 
 struct StatAccumulator {
@@ -72,13 +65,9 @@ struct StatAccumulator {
     uint32_t validCount = 0;
     uint32_t totalCount = 0;
 
-    void addSample(const QString& valueStr) {
+    void add(double v) {
         totalCount++;
-        bool ok = false;
-        double v = valueStr.toDouble(&ok);
-        if (!ok || v == -1.0) {
-            return; // treat -1 or non-numeric as invalid/missing
-        }
+        if (!isValid(v)) return;  // not numeric, or -1 for missing
 
         sum += v;
         validCount++;
@@ -86,49 +75,240 @@ struct StatAccumulator {
         if (v > max) max = v;
     }
 
-    QVariantMap toVariant(const QString& column) const {
-        QVariantMap m;
-        double avg = validCount > 0 ? sum / static_cast<double>(validCount) : 0.0;
-        double minOut = validCount > 0 ? min : 0.0;
-        double maxOut = validCount > 0 ? max : 0.0;
-
-        m.insert(QStringLiteral("column"), column);
-        m.insert(QStringLiteral("avg"), avg);
-        m.insert(QStringLiteral("min"), minOut);
-        m.insert(QStringLiteral("max"), maxOut);
-        m.insert(QStringLiteral("valid_count"), static_cast<int>(validCount));
-        m.insert(QStringLiteral("total_count"), static_cast<int>(totalCount));
-        return m;
+    double avg() const { return validCount > 0 ? sum / static_cast<double>(validCount) : 0.0; }
+
+    void write(ColumnStat* cs, const std::string& column) const {
+        cs->set_column(column);
+        cs->set_avg(avg());
+        cs->set_min(validCount > 0 ? min : 0.0);
+        cs->set_max(validCount > 0 ? max : 0.0);
+        cs->set_valid_samples(validCount);
+        cs->set_total_samples(totalCount);
+    }
+};
+
+// Header indices of the PublicSample fields, -1 if the run doesn't have them
+struct PublicColumns {
+    int time = -1;
+    int fps = -1;
+    int frameTime = -1;
+    int frameTimeVariance = -1;
+    int highestFrameTime = -1;
+    int frameTime1High = -1;
+    int frameTime5High = -1;
+    int gpuUtil = -1;
+    int gpuUsage = -1;
+    int memoryLoad = -1;
+    int memoryUsage = -1;
+    int gpuMemUsed = -1;
+    int gpuMemTotal = -1;
+    std::vector<std::pair<int, int>> cores;  // (core index, column)
+
+    bool any() const { return time >= 0 || fps >= 0; }
+
+    static PublicColumns resolve(const std::vector<std::string>& headers) {
+        auto indexOf = [&](std::string_view name) {
+            auto it = std::find(headers.begin(), headers.end(), name);
+            return it == headers.end() ? -1 : static_cast<int>(it - headers.begin());
+        };
+
+        PublicColumns c;
+        c.time = indexOf("Time");
+        c.fps = indexOf("FPS");
+        c.frameTime = indexOf("Frame Time");
+        c.frameTimeVariance = indexOf("Frame Time Variance");
+        c.highestFrameTime = indexOf("Highest Frame Time");
+        c.frameTime1High = indexOf("1% High Frame Time");
+        c.frameTime5High = indexOf("5% High Frame Time");
+        c.gpuUtil = indexOf("GPU Utilization");
+        c.gpuUsage = indexOf("GPU Usage");
+        c.memoryLoad = indexOf("PDH_Memory_Load(%)");
+        if (c.memoryLoad < 0) c.memoryLoad = indexOf("Memory Load");
+        c.memoryUsage = indexOf("Memory Usage (MB)");
+        // Available memory stands in for usage on runs recorded by PDH
+        if (c.memoryUsage < 0) c.memoryUsage = indexOf("PDH_Memory_Available(MB)");
+        c.gpuMemUsed = indexOf("GPU Mem Used");
+        c.gpuMemTotal = indexOf("GPU Mem Total");
+
+        for (int core = 0; core < PUBLIC_CORE_COUNT; ++core) {
+            const int column = indexOf("PDH_Core " + std::to_string(core) + " CPU (%)");
+            if (column >= 0) c.cores.emplace_back(core, column);
+        }
+        return c;
+    }
+};
+
+void writePublicSample(PublicSample* s, const PublicColumns& c, const std::vector<double>& values) {
+    auto at = [&](int column) { return column >= 0 ? values[column] : MISSING; };
+
+    // Fields without a reading are left unset
+    double v = at(c.time);
+    if (isValid(v) && v >= 0) s->set_time(static_cast<uint32_t>(v));
+    if (v = at(c.fps); isValid(v)) s->set_fps(static_cast<float>(v));
+    if (v = at(c.frameTime); isValid(v)) s->set_frame_time_ms(static_cast<float>(v));
+    if (v = at(c.frameTimeVariance); isValid(v)) s->set_frame_time_variance(static_cast<float>(v));
+    if (v = at(c.highestFrameTime); isValid(v)) s->set_highest_frame_time_ms(static_cast<float>(v));
+    if (v = at(c.frameTime1High); isValid(v)) s->set_p1_high_frame_time_ms(static_cast<float>(v));
+    if (v = at(c.frameTime5High); isValid(v)) s->set_p5_high_frame_time_ms(static_cast<float>(v));
+    if (v = at(c.gpuUtil); isValid(v)) s->set_gpu_util_pct(static_cast<float>(v));
+    if (v = at(c.gpuUsage); isValid(v)) s->set_gpu_usage_pct(static_cast<float>(v));
+    if (v = at(c.memoryLoad); isValid(v)) s->set_memory_load_pct(static_cast<float>(v));
+    if (v = at(c.memoryUsage); isValid(v)) s->set_memory_usage_mb(v);
+    // The CSV has GPU memory in MB
+    if (v = at(c.gpuMemUsed); isValid(v) && v >= 0) {
+        s->set_gpu_mem_used_bytes(static_cast<uint64_t>(v * BYTES_PER_MB));
+    }
+    if (v = at(c.gpuMemTotal); isValid(v) && v >= 0) {
+        s->set_gpu_mem_total_bytes(static_cast<uint64_t>(v * BYTES_PER_MB));
+    }
+    for (const auto& [core, column] : c.cores) {
+        if (v = values[column]; isValid(v)) {
+            CoreUsage* usage = s->add_core_usages();
+            usage->set_core_index(core);
+            usage->set_usage_pct(static_cast<float>(v));
+        }
+    }
+}
+
+// Reads a run CSV held in memory in one linear pass. Header indices are
+// resolved once; each row is split into views, parsed into doubles and fed to
+// the column stats and the sectional summary, then handed to the caller, so
+// nothing is kept per row or per cell.
+class RunReader {
+public:
+    explicit RunReader(std::string_view text) : m_text(text) {
+        if (m_text.substr(0, 3) == "\xEF\xBB\xBF") m_text.remove_prefix(3);
+        if (m_text.empty()) return;
+
+        std::string unquoted;
+        splitCsvLine(nextLine(), m_fields, unquoted);
+        m_headers.reserve(m_fields.size());
+        QStringList headerList;
+        for (std::string_view h : m_fields) {
+            m_headers.emplace_back(h);
+            headerList.append(QString::fromUtf8(h.data(), static_cast<int>(h.size())));
+        }
+        m_stats.resize(m_headers.size());
+        m_values.resize(m_headers.size());
+        m_sectionBuilder = SectionalSummaryBuilder(headerList);
+        m_publicColumns = PublicColumns::resolve(m_headers);
+        m_lineEstimate = m_pos < m_text.size()
+            ? static_cast<int>(std::count(m_text.begin() + m_pos, m_text.end(), '\n')) + 1
+            : 0;
+    }
+
+    bool ok() const { return !m_headers.empty(); }
+    const std::vector<std::string>& headers() const { return m_headers; }
+    const PublicColumns& publicColumns() const { return m_publicColumns; }
+    // Upper bound on the rows still to come, for reserving
+    int lineEstimate() const { return m_lineEstimate; }
+
+    // onRow(fields, values) for every row with a field per header; fields are
+    // only valid during the call
+    template <typename OnRow>
+    void readRows(OnRow&& onRow) {
+        std::string unquoted;
+        while (m_pos < m_text.size()) {
+            const std::string_view line = nextLine();
+            if (line.empty()) continue;
+
+            splitCsvLine(line, m_fields, unquoted);
+            if (m_fields.size() != m_headers.size()) {
+                // A torn row still advances the sections' row clock
+                m_tornRows++;
+                m_sectionBuilder.skipRow();
+                continue;
+            }
+
+            for (size_t i = 0; i < m_fields.size(); ++i) {
+                m_values[i] = parseNumber(m_fields[i]);
+                m_stats[i].add(m_values[i]);
+            }
+            m_sectionBuilder.addRow([&](int column) { return m_values[column]; });
+            m_rows++;
+            onRow(m_fields, m_values);
+        }
+    }
+
+    int rows() const { return m_rows; }
+    int tornRows() const { return m_tornRows; }
+
+    // Summary metrics and per-column stats of everything read so far
+    void writeSummary(PublicSummary* summary) const {
+        auto stat = [&](std::string_view name) -> const StatAccumulator* {
+            auto it = std::find(m_headers.begin(), m_headers.end(), name);
+            return it == m_headers.end() ? nullptr : &m_stats[it - m_headers.begin()];
+        };
+        auto avg = [&](std::string_view name) {
+            const StatAccumulator* s = stat(name);
+            return s ? s->avg() : 0.0;
+        };
+        // Cumulative low columns when the run has them, else the sections' lows
+        const SectionalSummary sections = m_sectionBuilder.result();
+        auto lowFps = [&](std::string_view column, double fallback) {
+            if (stat(column)) return avg(column);
+            return fallback > 0 ? fallback : 0.0;
+        };
+        const StatAccumulator* highest = stat("Highest Frame Time");
+
+        summary->set_avg_fps(avg("FPS"));
+        summary->set_avg_frame_time_ms(avg("Frame Time"));
+        summary->set_avg_gpu_usage_pct(avg("GPU Usage"));
+        summary->set_avg_memory_load_pct(avg("PDH_Memory_Load(%)"));
+        summary->set_p1_low_fps_cumulative(lowFps("1% Low FPS (Cumulative)", sections.overall1LowFps));
+        summary->set_p5_low_fps_cumulative(lowFps("5% Low FPS (Cumulative)", sections.overall5LowFps));
+        summary->set_highest_frame_time_ms(highest && highest->validCount > 0 ? highest->max : 0.0);
+
+        summary->mutable_column_stats()->Reserve(static_cast<int>(m_headers.size()));
+        for (size_t i = 0; i < m_headers.size(); ++i) {
+            m_stats[i].write(summary->add_column_stats(), m_headers[i]);
+        }
     }
+
+private:
+    std::string_view nextLine() {
+        size_t end = m_text.find('\n', m_pos);
+        if (end == std::string_view::npos) end = m_text.size();
+        std::string_view line = m_text.substr(m_pos, end - m_pos);
+        m_pos = end + 1;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        return line;
+    }
+
+    std::string_view m_text;
+    size_t m_pos = 0;
+    std::vector<std::string> m_headers;
+    std::vector<std::string_view> m_fields;
+    std::vector<double> m_values;
+    std::vector<StatAccumulator> m_stats;
+    SectionalSummaryBuilder m_sectionBuilder;
+    PublicColumns m_publicColumns;
+    int m_lineEstimate = 0;
+    int m_rows = 0;
+    int m_tornRows = 0;
 };
+
+void logSummary(const PublicSummary& s) {
+    LOG_INFO << "Calculated metrics - avg FPS: " << s.avg_fps()
+             << ", avg Frame Time: " << s.avg_frame_time_ms()
+             << ", avg GPU Usage: " << s.avg_gpu_usage_pct()
+             << ", avg Memory Load: " << s.avg_memory_load_pct()
+             << ", highest Frame Time: " << s.highest_frame_time_ms()
+             << ", 1% low FPS: " << s.p1_low_fps_cumulative()
+             << ", 5% low FPS: " << s.p5_low_fps_cumulative();
+}
 } // namespace
 
 QVariant PublicExportBuilder::buildPublicSamplesVariant(const QString& csvPath) const {
     LOG_INFO << "PublicExportBuilder::buildPublicSamplesVariant parsing: " << csvPath.toStdString();
-    
-    QFile file(csvPath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        LOG_ERROR << "Failed to open CSV file: " << csvPath.toStdString();
-        return QVariantList{};
-    }
-    
-    QByteArray csvData = file.readAll();
-    file.close();
-    
-    CsvSerializer csvSerializer;
-    DeserializationResult result = csvSerializer.deserialize(csvData);
-    
-    if (!result.success) {
-        LOG_ERROR << "CSV parsing failed: " << result.error.toStdString();
-        return QVariantList{};
-    }
-    
-    QVariantList fullData = result.data.toList();
-    if (fullData.isEmpty()) {
-        LOG_WARN << "CSV file is empty";
+
+    const QByteArray csvData = readAllBytes(csvPath);
+    RunReader reader(std::string_view(csvData.constData(), csvData.size()));
+    if (!reader.ok()) {
+        LOG_WARN << "CSV file is empty or unreadable: " << csvPath.toStdString();
         return QVariantList{};
     }
-    
+
     // Define the columns we want to include in public data (matching specification in benchmark_backend_data.md)
     QStringList publicColumns = {
         "Time",                    // Time
@@ -138,94 +318,76 @@ QVariant PublicExportBuilder::buildPublicSamplesVariant(const QString& csvPath)
         "GPU Usage",               // GPU Usage (there is no "GPU Utilization" column, using "GPU Usage")
         "PDH_Memory_Load(%)",       // Memory Load
         "GPU Mem Used",            // GPU Mem Used
-        "GPU Mem Total",           // GPU Mem Total  
+        "GPU Mem Total",           // GPU Mem Total
         "Frame Time Variance",     // Frame Time Variance
         "Highest Frame Time",      // Highest Frame Time
         "Frame Time",              // Frame Time
         "PDH_Memory_Available(MB)" // Memory Usage (MB) - using Available as proxy
-        // Note: Core <N> (%) will be added dynamically below
     };
-    
-    // Add all CPU core columns (PDH_Core N CPU (%))
-    for (int core = 0; core <= 7; ++core) {
+    for (int core = 0; core < PUBLIC_CORE_COUNT; ++core) {
         publicColumns.append(QString("PDH_Core %1 CPU (%)").arg(core));
     }
-    
+
+    // Resolved once; rows are picked by index
+    std::vector<std::pair<QString, int>> columns;
+    for (const QString& name : publicColumns) {
+        const std::string key = name.toStdString();
+        const auto& headers = reader.headers();
+        auto it = std::find(headers.begin(), headers.end(), key);
+        if (it != headers.end()) columns.emplace_back(name, static_cast<int>(it - headers.begin()));
+    }
+
     QVariantList publicSamples;
-    
-    for (const QVariant& rowVariant : fullData) {
-        QVariantMap fullRow = rowVariant.toMap();
+    publicSamples.reserve(reader.lineEstimate());
+    reader.readRows([&](const std::vector<std::string_view>&, const std::vector<double>& values) {
         QVariantMap publicRow;
-        
-        // Extract only the public columns
-        for (const QString& column : publicColumns) {
-            if (fullRow.contains(column)) {
-                publicRow[column] = fullRow[column];
-            }
+        for (const auto& [name, column] : columns) {
+            if (!std::isnan(values[column])) publicRow.insert(name, values[column]);
         }
-        
         if (!publicRow.isEmpty()) {
             publicSamples.append(publicRow);
         }
-    }
-    
-    LOG_INFO << "Built " << publicSamples.size() << " public samples from " << fullData.size() << " total samples";
+    });
+
+    LOG_INFO << "Built " << publicSamples.size() << " public samples from " << reader.rows() << " total samples";
     return publicSamples;
 }
 
 QVariant PublicExportBuilder::buildPublicSummaryVariant(const QString& csvPath) const {
     LOG_INFO << "PublicExportBuilder::buildPublicSummaryVariant computing from: " << csvPath.toStdString();
 
-    QVariantList columnStats = computeColumnStats(csvPath);
-    if (columnStats.isEmpty()) {
+    const QByteArray csvData = readAllBytes(csvPath);
+    RunReader reader(std::string_view(csvData.constData(), csvData.size()));
+    reader.readRows([](const std::vector<std::string_view>&, const std::vector<double>&) {});
+    if (!reader.ok()) {
         LOG_WARN << "Column stats empty, returning default summary";
     }
 
-    // Build a lookup for convenience
-    std::unordered_map<std::string, QVariantMap> statsLookup;
-    for (const QVariant& v : columnStats) {
-        QVariantMap m = v.toMap();
-        QString colName = m.value(QStringLiteral("column")).toString();
-        statsLookup[colName.toStdString()] = m;
-    }
+    PublicSummary s;
+    reader.writeSummary(&s);
+    logSummary(s);
 
-    auto getAvg = [&](const QString& name) -> double {
-        auto it = statsLookup.find(name.toStdString());
-        if (it == statsLookup.end()) return 0.0;
-        return it->second.value(QStringLiteral("avg")).toDouble();
-    };
-    auto getMax = [&](const QString& name) -> double {
-        auto it = statsLookup.find(name.toStdString());
-        if (it == statsLookup.end()) return 0.0;
-        return it->second.value(QStringLiteral("max")).toDouble();
-    };
-
-    double avgFps = getAvg(QStringLiteral("FPS"));
-    double avgFrameTime = getAvg(QStringLiteral("Frame Time"));
-    double avgGpuUsage = getAvg(QStringLiteral("GPU Usage"));
-    double avgMemoryLoad = getAvg(QStringLiteral("PDH_Memory_Load(%)"));
-    double highestFrameTime = getMax(QStringLiteral("Highest Frame Time"));
-
-    // Use cumulative columns if present for lows; otherwise fallback to FPS stats
-    double p1LowFps = getAvg(QStringLiteral("1% Low FPS (Cumulative)"));
-    double p5LowFps = getAvg(QStringLiteral("5% Low FPS (Cumulative)"));
-
-    LOG_INFO << "Calculated metrics - avg FPS: " << avgFps
-             << ", avg Frame Time: " << avgFrameTime
-             << ", avg GPU Usage: " << avgGpuUsage
-             << ", avg Memory Load: " << avgMemoryLoad
-             << ", highest Frame Time: " << highestFrameTime
-             << ", 1% low FPS: " << p1LowFps
-             << ", 5% low FPS: " << p5LowFps;
+    QVariantList columnStats;
+    columnStats.reserve(s.column_stats_size());
+    for (const ColumnStat& cs : s.column_stats()) {
+        QVariantMap m;
+        m.insert(QStringLiteral("column"), QString::fromStdString(cs.column()));
+        m.insert(QStringLiteral("avg"), cs.avg());
+        m.insert(QStringLiteral("min"), cs.min());
+        m.insert(QStringLiteral("max"), cs.max());
+        m.insert(QStringLiteral("valid_count"), static_cast<int>(cs.valid_samples()));
+        m.insert(QStringLiteral("total_count"), static_cast<int>(cs.total_samples()));
+        columnStats.append(m);
+    }
 
     QVariantMap summary;
-    summary.insert(QStringLiteral("avg_fps"), avgFps);
-    summary.insert(QStringLiteral("avg_frame_time_ms"), avgFrameTime);
-    summary.insert(QStringLiteral("avg_gpu_usage_pct"), avgGpuUsage);
-    summary.insert(QStringLiteral("avg_memory_load_pct"), avgMemoryLoad);
-    summary.insert(QStringLiteral("p1_low_fps_cumulative"), p1LowFps);
-    summary.insert(QStringLiteral("p5_low_fps_cumulative"), p5LowFps);
-    summary.insert(QStringLiteral("highest_frame_time_ms"), highestFrameTime);
+    summary.insert(QStringLiteral("avg_fps"), s.avg_fps());
+    summary.insert(QStringLiteral("avg_frame_time_ms"), s.avg_frame_time_ms());
+    summary.insert(QStringLiteral("avg_gpu_usage_pct"), s.avg_gpu_usage_pct());
+    summary.insert(QStringLiteral("avg_memory_load_pct"), s.avg_memory_load_pct());
+    summary.insert(QStringLiteral("p1_low_fps_cumulative"), s.p1_low_fps_cumulative());
+    summary.insert(QStringLiteral("p5_low_fps_cumulative"), s.p5_low_fps_cumulative());
+    summary.insert(QStringLiteral("highest_frame_time_ms"), s.highest_frame_time_ms());
     summary.insert(QStringLiteral("column_stats"), columnStats);
 
     // Add system specs from specs file
@@ -251,75 +413,67 @@ QVariant PublicExportBuilder::buildUploadRequestVariant(const QString& csvPath,
                                        const QStringList& attachmentPaths) const {
     LOG_INFO << "PublicExportBuilder::buildUploadRequestVariant: csv=" << csvPath.toStdString();
 
-    BenchmarkUploadRequest req;
+    // The CSV is read once; the same bytes feed the pass and its attachment
+    const QByteArray csvData = readAllBytes(csvPath);
+
+    // Every sample, value and stat lives in the arena and goes in one free
+    google::protobuf::ArenaOptions arenaOptions;
+    arenaOptions.start_block_size = 64 * 1024;
+    arenaOptions.max_block_size = 4 * 1024 * 1024;
+    google::protobuf::Arena arena(arenaOptions);
+    BenchmarkUploadRequest* req = google::protobuf::Arena::Create<BenchmarkUploadRequest>(&arena);
 
     // Envelope
-    ClientEnvelope* env = req.mutable_env();
+    ClientEnvelope* env = req->mutable_env();
     env->set_client_version("checkmark-client");
-    env->set_schema_version("1");
+    env->set_schema_version(FullRunCodec::UPLOAD_SCHEMA_VERSION);
 
     // Meta
-    BenchmarkRunMeta* meta = req.mutable_meta();
+    BenchmarkRunMeta* meta = req->mutable_meta();
     // For GDPR-neutral uploads, userSystemId should be empty at call-site
     meta->set_user_system_id(userSystemId.toStdString());
     const QString timestampIso = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
     meta->set_timestamp_utc(timestampIso.toStdString());
 
-    // Public summary - compute from CSV
-    QVariant summaryVariant = buildPublicSummaryVariant(csvPath);
-    QVariantMap summaryMap = summaryVariant.toMap();
-    
-    PublicSummary* summary = req.mutable_public_summary();
-    
-    // Set all computed metrics
-    double avgFps = summaryMap.value("avg_fps").toDouble();
-    double avgFrameTime = summaryMap.value("avg_frame_time_ms").toDouble();
-    double avgGpuUsage = summaryMap.value("avg_gpu_usage_pct").toDouble();
-    double avgMemoryLoad = summaryMap.value("avg_memory_load_pct").toDouble();
-    double p1LowFps = summaryMap.value("p1_low_fps_cumulative").toDouble();
-    double p5LowFps = summaryMap.value("p5_low_fps_cumulative").toDouble();
-    double highestFrameTime = summaryMap.value("highest_frame_time_ms").toDouble();
-    
-    summary->set_avg_fps(avgFps);
-    summary->set_avg_frame_time_ms(avgFrameTime);
-    summary->set_avg_gpu_usage_pct(avgGpuUsage);
-    summary->set_avg_memory_load_pct(avgMemoryLoad);
-    summary->set_p1_low_fps_cumulative(p1LowFps);
-    summary->set_p5_low_fps_cumulative(p5LowFps);
-    summary->set_highest_frame_time_ms(highestFrameTime);
-
-    // Column-level stats
-    QVariantList colStats = summaryMap.value(QStringLiteral("column_stats")).toList();
-    for (const QVariant& v : colStats) {
-        QVariantMap m = v.toMap();
-        ColumnStat* cs = summary->add_column_stats();
-        cs->set_column(m.value(QStringLiteral("column")).toString().toStdString());
-        cs->set_avg(m.value(QStringLiteral("avg")).toDouble());
-        cs->set_min(m.value(QStringLiteral("min")).toDouble());
-        cs->set_max(m.value(QStringLiteral("max")).toDouble());
-        cs->set_valid_samples(m.value(QStringLiteral("valid_count")).toInt());
-        cs->set_total_samples(m.value(QStringLiteral("total_count")).toInt());
+    // One pass: full run, public samples, column stats and sections
+    PublicSummary* summary = req->mutable_public_summary();
+    RunReader reader(std::string_view(csvData.constData(), csvData.size()));
+    if (reader.ok()) {
+        FullRunCodec::Encoder fullRun(reader.headers());
+        const PublicColumns& publicColumns = reader.publicColumns();
+        if (publicColumns.any()) {
+            req->mutable_public_samples()->Reserve(reader.lineEstimate());
+        }
+
+        reader.readRows([&](const std::vector<std::string_view>& fields,
+                            const std::vector<double>& values) {
+            fullRun.addRow(fields, values);
+            if (publicColumns.any()) {
+                writePublicSample(req->add_public_samples(), publicColumns, values);
+            }
+        });
+        fullRun.finish(req->mutable_full_run());
+        if (reader.tornRows() > 0) {
+            LOG_WARN << "PublicExportBuilder: skipped " << reader.tornRows()
+                     << " rows without " << reader.headers().size() << " fields";
+        }
+    } else {
+        LOG_WARN << "PublicExportBuilder: empty or unreadable CSV, uploading default summary";
     }
-    
-    LOG_INFO << "Setting public summary metrics - FPS: " << avgFps
-             << ", Frame Time: " << avgFrameTime
-             << ", GPU Usage: " << avgGpuUsage
-             << ", Memory Load: " << avgMemoryLoad
-             << ", 1% Low FPS: " << p1LowFps
-             << ", 5% Low FPS: " << p5LowFps
-             << ", Highest Frame Time: " << highestFrameTime;
+    reader.writeSummary(summary);
+    logSummary(*summary);
 
     // Compute deterministic validity hash (run_id) from public summary + timestamp
     // Use fixed precision to ensure repeatability
     auto fmt = [](double v){ return QString::number(v, 'f', 3); };
     QStringList parts;
-    parts << QStringLiteral("avg_fps:") + fmt(avgFps)
-          << QStringLiteral("avg_frame_time_ms:") + fmt(avgFrameTime)
-          << QStringLiteral("avg_gpu_usage_pct:") + fmt(avgGpuUsage)
-          << QStringLiteral("avg_memory_load_pct:") + fmt(avgMemoryLoad)
-          << QStringLiteral("p1_low_fps_cumulative:") + fmt(p1LowFps)
-          << QStringLiteral("p5_low_fps_cumulative:") + fmt(p5LowFps)
-          << QStringLiteral("highest_frame_time_ms:") + fmt(highestFrameTime)
+    parts << QStringLiteral("avg_fps:") + fmt(summary->avg_fps())
+          << QStringLiteral("avg_frame_time_ms:") + fmt(summary->avg_frame_time_ms())
+          << QStringLiteral("avg_gpu_usage_pct:") + fmt(summary->avg_gpu_usage_pct())
+          << QStringLiteral("avg_memory_load_pct:") + fmt(summary->avg_memory_load_pct())
+          << QStringLiteral("p1_low_fps_cumulative:") + fmt(summary->p1_low_fps_cumulative())
+          << QStringLiteral("p5_low_fps_cumulative:") + fmt(summary->p5_low_fps_cumulative())
+          << QStringLiteral("highest_frame_time_ms:") + fmt(summary->highest_frame_time_ms())
           << QStringLiteral("timestamp_utc:") + timestampIso;
     QString canonical = parts.join('|');
     QByteArray hash = QCryptographicHash::hash(canonical.toUtf8(), QCryptographicHash::Sha256).toHex();
@@ -330,48 +484,43 @@ QVariant PublicExportBuilder::buildUploadRequestVariant(const QString& csvPath,
     } else {
         meta->set_run_id(runIdDet.toStdString());
     }
-    
+
     // Set system specs fields
-    if (summaryMap.contains("cpu_model")) {
-        summary->set_cpu_model(summaryMap.value("cpu_model").toString().toStdString());
+    const QVariantMap specs = parseSpecsFile(csvPath);
+    if (specs.contains("cpu_model")) {
+        summary->set_cpu_model(specs.value("cpu_model").toString().toStdString());
     }
-    if (summaryMap.contains("memory_total_physical")) {
-        summary->set_memory_total_physical(summaryMap.value("memory_total_physical").toString().toStdString());
+    if (specs.contains("memory_total_physical")) {
+        summary->set_memory_total_physical(specs.value("memory_total_physical").toString().toStdString());
     }
-    if (summaryMap.contains("memory_clock")) {
-        summary->set_memory_clock(summaryMap.value("memory_clock").toString().toStdString());
+    if (specs.contains("memory_clock")) {
+        summary->set_memory_clock(specs.value("memory_clock").toString().toStdString());
     }
-    if (summaryMap.contains("gpu_primary_model")) {
-        summary->set_gpu_primary_model(summaryMap.value("gpu_primary_model").toString().toStdString());
+    if (specs.contains("gpu_primary_model")) {
+        summary->set_gpu_primary_model(specs.value("gpu_primary_model").toString().toStdString());
     }
-    if (summaryMap.contains("graphics_resolution")) {
-        summary->set_graphics_resolution(summaryMap.value("graphics_resolution").toString().toStdString());
+    if (specs.contains("graphics_resolution")) {
+        summary->set_graphics_resolution(specs.value("graphics_resolution").toString().toStdString());
     }
 
-    // Public samples intentionally omitted for now (full CSV still uploaded as attachment)
-
-    // Attachments: include all provided files
+    // Attachments: include all provided files. They stay out of the message
+    // and are read straight into the payload; the CSV reuses csvData
+    const QString csvFilePath = QFileInfo(csvPath).absoluteFilePath();
+    UploadPayloadWriter payload;
     for (const auto& p : attachmentPaths) {
-        QFileInfo fi(p);
-        if (!fi.exists() || !fi.isFile()) continue;
-        Attachment* a = req.add_attachments();
-        a->set_filename(fi.fileName().toStdString());
-        // crude mime type guess
-        QString mt = fi.suffix().compare("csv", Qt::CaseInsensitive) == 0 ? "text/csv" :
-                     fi.suffix().compare("json", Qt::CaseInsensitive) == 0 ? "application/json" :
-                     "text/plain";
-        a->set_mime_type(mt.toStdString());
-        QByteArray bytes = readAllBytes(p);
-        if (!bytes.isEmpty()) a->set_content(bytes.constData(), bytes.size());
-    }
-
-    std::string out;
-    if (!req.SerializeToString(&out)) {
+        const bool isCsv = QFileInfo(p).absoluteFilePath() == csvFilePath;
+        payload.addFile(p, isCsv ? csvData : QByteArray());
+    }
+
+    QByteArray ba = payload.serialize(*req);
+    if (ba.isEmpty()) {
         LOG_ERROR << "PublicExportBuilder: failed to serialize BenchmarkUploadRequest";
         return QVariant();
     }
-    QByteArray ba(out.data(), static_cast<int>(out.size()));
-    LOG_INFO << "PublicExportBuilder: built protobuf payload, bytes=" << ba.size();
+    LOG_INFO << "PublicExportBuilder: built protobuf payload, bytes=" << ba.size()
+             << ", rows=" << reader.rows()
+             << ", public samples=" << req->public_samples_size()
+             << ", attachments=" << payload.attachmentCount();
     return ba; // Will be sent with BinarySerializer
 }
 
@@ -478,60 +627,3 @@ QVariantMap PublicExportBuilder::parseSpecsFile(const QString& csvPath) const {
     
     return specsData;
 }
-
-QVariantList PublicExportBuilder::computeColumnStats(const QString& csvPath) const {
-    QFile file(csvPath);
-    QVariantList out;
-
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        LOG_ERROR << "computeColumnStats: failed to open CSV: " << csvPath.toStdString();
-        return out;
-    }
-
-    QTextStream in(&file);
-    if (in.atEnd()) {
-        LOG_WARN << "computeColumnStats: empty CSV: " << csvPath.toStdString();
-        file.close();
-        return out;
-    }
-
-    QString headerLine = in.readLine();
-    QStringList headers = parseCsvLine(headerLine);
-    if (headers.isEmpty()) {
-        LOG_ERROR << "computeColumnStats: header parse failed for: " << csvPath.toStdString();
-        file.close();
-        return out;
-    }
-
-    std::vector<StatAccumulator> stats(headers.size());
-
-    int rowIndex = 0;
-    while (!in.atEnd()) {
-        QString line = in.readLine();
-        if (line.isEmpty())
-            continue;
-
-        QStringList fields = parseCsvLine(line);
-        if (fields.size() != headers.size()) {
-            LOG_WARN << "computeColumnStats: row " << rowIndex
-                     << " has " << fields.size()
-                     << " fields, expected " << headers.size();
-            rowIndex++;
-            continue;
-        }
-
-        for (int i = 0; i < fields.size(); ++i) {
-            stats[i].addSample(fields[i]);
-        }
-
-        rowIndex++;
-    }
-
-    file.close();
-
-    for (int i = 0; i < headers.size(); ++i) {
-        out.append(stats[i].toVariant(headers[i]));
-    }
-
-    return out;
-}
@@ -3,7 +3,8 @@
 
 // PublicExportBuilder - builds public CSV and summary from full CSV results,
 // and creates QVariant structures ready for ProtobufSerializer mapping.
-// NOTE: Template header only; implement after confirming column aliases.
+// The upload request is built in one pass over the CSV: every row goes to the
+// column stats, the sectional summary, the public samples and the full run.
 
 #include <QString>
 #include <QVariant>
@@ -37,8 +38,6 @@ private:
     // Parse specs file to extract system information for public summary
     QVariantMap parseSpecsFile(const QString& csvPath) const;
 
-    // Parse CSV and compute per-column statistics (min/max/avg + counts)
-    QVariantList computeColumnStats(const QString& csvPath) const;
 };
 
 #endif // PUBLICEXPORTBUILDER_H
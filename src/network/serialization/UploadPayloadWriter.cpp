@@ -0,0 +1,142 @@
+#include "UploadPayloadWriter.h"
+#include "../../logging/Logger.h"
+#include <QFile>
+#include <QFileInfo>
+#include <cstring>
+#include <limits>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/message_lite.h>
+
+#include "benchmark_full.pb.h"
+#include "benchmark_upload.pb.h"
+
+using checkmark::benchmarks::Attachment;
+using checkmark::benchmarks::BenchmarkUploadRequest;
+using google::protobuf::io::CodedOutputStream;
+
+namespace {
+
+// Length-delimited wire type
+uint32_t lengthDelimitedTag(int fieldNumber) {
+    return (static_cast<uint32_t>(fieldNumber) << 3) | 2u;
+}
+
+// Tag, length prefix and payload of a length-delimited field
+size_t lengthDelimitedSize(int fieldNumber, size_t payloadSize) {
+    return CodedOutputStream::VarintSize32(lengthDelimitedTag(fieldNumber)) +
+           CodedOutputStream::VarintSize32(static_cast<uint32_t>(payloadSize)) + payloadSize;
+}
+
+uint8_t* writeLengthDelimitedHeader(int fieldNumber, size_t payloadSize, uint8_t* target) {
+    target = CodedOutputStream::WriteVarint32ToArray(lengthDelimitedTag(fieldNumber), target);
+    return CodedOutputStream::WriteVarint32ToArray(static_cast<uint32_t>(payloadSize), target);
+}
+
+QString guessMimeType(const QFileInfo& fi) {
+    if (fi.suffix().compare("csv", Qt::CaseInsensitive) == 0) return QStringLiteral("text/csv");
+    if (fi.suffix().compare("json", Qt::CaseInsensitive) == 0) return QStringLiteral("application/json");
+    return QStringLiteral("text/plain");
+}
+
+// Protobuf refuses to parse messages of 2 GB or more
+constexpr size_t kMaxPayloadBytes = static_cast<size_t>(std::numeric_limits<int32_t>::max());
+
+} // namespace
+
+UploadPayloadWriter::UploadPayloadWriter() = default;
+UploadPayloadWriter::~UploadPayloadWriter() = default;
+
+bool UploadPayloadWriter::addFile(const QString& path, const QByteArray& content) {
+    QFileInfo fi(path);
+    if (!fi.exists() || !fi.isFile()) return false;
+
+    PendingAttachment attachment;
+    attachment.filename = fi.fileName();
+    attachment.mimeType = guessMimeType(fi);
+    if (!content.isEmpty()) {
+        attachment.content = content;  // shared, not copied
+        attachment.size = content.size();
+    } else {
+        auto file = std::make_unique<QFile>(fi.absoluteFilePath());
+        if (file->open(QIODevice::ReadOnly)) {
+            attachment.size = file->size();
+            attachment.file = std::move(file);
+        } else {
+            // Sent without content, as before
+            LOG_WARN << "UploadPayloadWriter: failed to open attachment: " << path.toStdString();
+        }
+    }
+    m_attachments.push_back(std::move(attachment));
+    return true;
+}
+
+QByteArray UploadPayloadWriter::serialize(const google::protobuf::MessageLite& request) const {
+    const int attachmentsField = BenchmarkUploadRequest::kAttachmentsFieldNumber;
+    const int contentField = Attachment::kContentFieldNumber;
+
+    // Each attachment minus its content, with sizes cached for the write below
+    std::vector<Attachment> heads(m_attachments.size());
+    std::vector<size_t> bodySizes(m_attachments.size());
+
+    size_t total = request.ByteSizeLong();
+    for (size_t i = 0; i < m_attachments.size(); ++i) {
+        const PendingAttachment& pending = m_attachments[i];
+        heads[i].set_filename(pending.filename.toStdString());
+        heads[i].set_mime_type(pending.mimeType.toStdString());
+
+        const size_t contentSize = static_cast<size_t>(pending.size);
+        if (contentSize >= kMaxPayloadBytes) {
+            LOG_ERROR << "UploadPayloadWriter: attachment too large: " << pending.filename.toStdString();
+            return QByteArray();
+        }
+        bodySizes[i] = heads[i].ByteSizeLong() +
+                       (contentSize > 0 ? lengthDelimitedSize(contentField, contentSize) : 0);
+        total += lengthDelimitedSize(attachmentsField, bodySizes[i]);
+        if (total >= kMaxPayloadBytes) {
+            LOG_ERROR << "UploadPayloadWriter: payload exceeds 2 GB with " << i + 1 << " attachments";
+            return QByteArray();
+        }
+    }
+
+    QByteArray out(static_cast<qsizetype>(total), Qt::Uninitialized);
+    uint8_t* const begin = reinterpret_cast<uint8_t*>(out.data());
+    uint8_t* target = request.SerializeWithCachedSizesToArray(begin);
+
+    for (size_t i = 0; i < m_attachments.size(); ++i) {
+        const PendingAttachment& pending = m_attachments[i];
+        target = writeLengthDelimitedHeader(attachmentsField, bodySizes[i], target);
+        target = heads[i].SerializeWithCachedSizesToArray(target);
+        if (pending.size <= 0) continue;
+
+        target = writeLengthDelimitedHeader(contentField, static_cast<size_t>(pending.size), target);
+        if (!pending.file) {
+            std::memcpy(target, pending.content.constData(), static_cast<size_t>(pending.size));
+            target += pending.size;
+            continue;
+        }
+
+        // Straight from the file into the payload
+        pending.file->seek(0);
+        qint64 filled = 0;
+        while (filled < pending.size) {
+            const qint64 n = pending.file->read(reinterpret_cast<char*>(target) + filled,
+                                                pending.size - filled);
+            if (n <= 0) break;
+            filled += n;
+        }
+        if (filled != pending.size) {
+            LOG_ERROR << "UploadPayloadWriter: attachment changed while reading: "
+                      << pending.filename.toStdString() << " (" << filled << " of "
+                      << pending.size << " bytes)";
+            return QByteArray();
+        }
+        target += pending.size;
+    }
+
+    if (target != begin + total) {
+        LOG_ERROR << "UploadPayloadWriter: wrote " << (target - begin) << " bytes, expected " << total;
+        return QByteArray();
+    }
+    return out;
+}
@@ -0,0 +1,57 @@
+#ifndef UPLOADPAYLOADWRITER_H
+#define UPLOADPAYLOADWRITER_H
+
+// UploadPayloadWriter - Writes a BenchmarkUploadRequest and its attachments
+// Used by: PublicExportBuilder, BenchmarkFullCsvToProto
+// Purpose: Keep attachment bytes out of the request message. The request is
+//          built without attachments; serialize() sizes the whole payload with
+//          ByteSizeLong, allocates it once and reads each file straight into
+//          its place, so file contents are copied once between disk and socket
+// When to use: Any upload that carries local files as Attachment messages
+// Operations: Add files (or bytes already in memory), serialize to one buffer
+//
+// The output is the same wire format as setting Attachment.content and calling
+// SerializeToString: attachments are appended as field 10 of the request.
+
+#include <QByteArray>
+#include <QString>
+#include <memory>
+#include <vector>
+
+class QFile;
+
+namespace google::protobuf {
+class MessageLite;
+}
+
+class UploadPayloadWriter {
+public:
+    UploadPayloadWriter();
+    ~UploadPayloadWriter();
+    UploadPayloadWriter(const UploadPayloadWriter&) = delete;
+    UploadPayloadWriter& operator=(const UploadPayloadWriter&) = delete;
+
+    // Queues a file; the mime type is guessed from its suffix. When its bytes
+    // are already loaded, pass them as content and the file isn't read again.
+    // Returns false (and adds nothing) if the path isn't a regular file.
+    bool addFile(const QString& path, const QByteArray& content = QByteArray());
+
+    int attachmentCount() const { return static_cast<int>(m_attachments.size()); }
+
+    // The request (without attachments) followed by every queued attachment.
+    // Empty on failure: payload over 2 GB, or a file that shrank since addFile.
+    QByteArray serialize(const google::protobuf::MessageLite& request) const;
+
+private:
+    struct PendingAttachment {
+        QString filename;
+        QString mimeType;
+        QByteArray content;             // when loaded by the caller
+        std::unique_ptr<QFile> file;    // read in serialize() otherwise
+        qint64 size = 0;
+    };
+
+    std::vector<PendingAttachment> m_attachments;
+};
+
+#endif // UPLOADPAYLOADWRITER_H
@@ -0,0 +1,315 @@
+#include "HttpDiskCache.h"
+#include "../../logging/Logger.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStringList>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+constexpr int kIndexVersion = 1;
+
+QString sha256Hex(const QByteArray& bytes) {
+    return QString::fromLatin1(QCryptographicHash::hash(bytes, QCryptographicHash::Sha256).toHex());
+}
+
+} // namespace
+
+HttpDiskCache::HttpDiskCache(const QString& directory, qint64 maxBytes)
+    : m_directory(directory)
+    , m_maxBytes(maxBytes) {
+    QDir().mkpath(m_directory + QStringLiteral("/blobs"));
+    loadIndex();
+}
+
+HttpDiskCache::~HttpDiskCache() {
+    QMutexLocker lock(&m_mutex);
+    if (m_indexDirty) {
+        saveIndex();
+    }
+}
+
+std::shared_ptr<HttpDiskCache> HttpDiskCache::shared() {
+    static const std::shared_ptr<HttpDiskCache> instance = std::make_shared<HttpDiskCache>(
+        QCoreApplication::applicationDirPath() + QStringLiteral("/network_cache"));
+    return instance;
+}
+
+HttpCacheEntry HttpDiskCache::lookup(const QString& key) {
+    QMutexLocker lock(&m_mutex);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return HttpCacheEntry();
+    }
+
+    QFile file(blobPath(it->blob));
+    QByteArray body;
+    if (file.open(QIODevice::ReadOnly)) {
+        body = file.readAll();
+    }
+    if (body.size() != it->size || sha256Hex(body) != it->blob) {
+        LOG_WARN << "HttpDiskCache: dropping damaged entry " << key.toStdString();
+        removeEntry(key);
+        saveIndex();
+        return HttpCacheEntry();
+    }
+
+    it->lastUse = ++m_useClock;
+    m_indexDirty = true;
+
+    HttpCacheEntry entry;
+    entry.body = body;
+    entry.etag = it->etag;
+    entry.contentType = it->contentType;
+    entry.messageType = it->messageType;
+    entry.storedAtUtc = it->storedAtUtc;
+    entry.maxAgeSeconds = it->maxAgeSeconds;
+    entry.staleSeconds = it->staleSeconds;
+    return entry;
+}
+
+bool HttpDiskCache::store(const QString& key, const HttpCacheEntry& entry) {
+    QMutexLocker lock(&m_mutex);
+    if (entry.body.size() > m_maxBytes) {
+        LOG_WARN << "HttpDiskCache: " << key.toStdString() << " (" << entry.body.size()
+                 << " bytes) exceeds the cache budget, not stored";
+        removeEntry(key);
+        saveIndex();
+        return false;
+    }
+
+    const QString blob = sha256Hex(entry.body);
+    if (!m_blobRefs.contains(blob)) {
+        QSaveFile file(blobPath(blob));
+        if (!file.open(QIODevice::WriteOnly) ||
+            file.write(entry.body) != entry.body.size() || !file.commit()) {
+            LOG_WARN << "HttpDiskCache: failed to write blob for " << key.toStdString()
+                     << ": " << file.errorString().toStdString();
+            return false;
+        }
+    }
+
+    // Take the new reference before dropping the old one, so an unchanged
+    // body keeps its file
+    if (m_blobRefs[blob]++ == 0) {
+        m_totalBytes += entry.body.size();
+    }
+    removeEntry(key);
+
+    IndexEntry& indexed = m_entries[key];
+    indexed.blob = blob;
+    indexed.size = entry.body.size();
+    indexed.etag = entry.etag;
+    indexed.contentType = entry.contentType;
+    indexed.messageType = entry.messageType;
+    indexed.storedAtUtc = entry.storedAtUtc.isValid() ? entry.storedAtUtc : QDateTime::currentDateTimeUtc();
+    indexed.maxAgeSeconds = entry.maxAgeSeconds;
+    indexed.staleSeconds = entry.staleSeconds;
+    indexed.lastUse = ++m_useClock;
+
+    evictToBudget(key);
+    saveIndex();
+    return true;
+}
+
+void HttpDiskCache::markRevalidated(const QString& key, int maxAgeSeconds, int staleSeconds) {
+    QMutexLocker lock(&m_mutex);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return;
+    }
+    it->storedAtUtc = QDateTime::currentDateTimeUtc();
+    it->maxAgeSeconds = maxAgeSeconds;
+    it->staleSeconds = staleSeconds;
+    it->lastUse = ++m_useClock;
+    saveIndex();
+}
+
+void HttpDiskCache::remove(const QString& key) {
+    QMutexLocker lock(&m_mutex);
+    if (m_entries.contains(key)) {
+        removeEntry(key);
+        saveIndex();
+    }
+}
+
+void HttpDiskCache::clear() {
+    QMutexLocker lock(&m_mutex);
+    const QStringList keys = m_entries.keys();
+    for (const QString& key : keys) {
+        removeEntry(key);
+    }
+    saveIndex();
+}
+
+qint64 HttpDiskCache::totalBytes() const {
+    QMutexLocker lock(&m_mutex);
+    return m_totalBytes;
+}
+
+int HttpDiskCache::entryCount() const {
+    QMutexLocker lock(&m_mutex);
+    return static_cast<int>(m_entries.size());
+}
+
+HttpDiskCache::Policy HttpDiskCache::policyFor(const QString& cacheControl, int ttlSeconds,
+                                               int staleSeconds) {
+    Policy policy;
+    policy.maxAgeSeconds = ttlSeconds;
+    policy.staleSeconds = staleSeconds;
+
+    const QStringList directives = cacheControl.split(QLatin1Char(','), Qt::SkipEmptyParts);
+    for (const QString& raw : directives) {
+        const QString directive = raw.trimmed().toLower();
+        const int eq = directive.indexOf(QLatin1Char('='));
+        const QString name = eq < 0 ? directive : directive.left(eq).trimmed();
+        bool ok = false;
+        const int value = eq < 0 ? 0 : directive.mid(eq + 1).trimmed().remove(QLatin1Char('"')).toInt(&ok);
+
+        if (name == QLatin1String("no-store")) {
+            policy.store = false;
+        } else if (name == QLatin1String("no-cache")) {
+            policy.maxAgeSeconds = 0;
+            policy.staleSeconds = 0;
+        } else if (name == QLatin1String("max-age") && ok) {
+            policy.maxAgeSeconds = value;
+        } else if (name == QLatin1String("stale-while-revalidate") && ok) {
+            policy.staleSeconds = value;
+        }
+    }
+    return policy;
+}
+
+QString HttpDiskCache::blobPath(const QString& blob) const {
+    return m_directory + QStringLiteral("/blobs/") + blob;
+}
+
+void HttpDiskCache::loadIndex() {
+    QMutexLocker lock(&m_mutex);
+
+    QFile file(m_directory + QStringLiteral("/index.json"));
+    if (file.open(QIODevice::ReadOnly)) {
+        const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+        if (root.value(QStringLiteral("version")).toInt() == kIndexVersion) {
+            const QJsonArray entries = root.value(QStringLiteral("entries")).toArray();
+            for (const QJsonValue& value : entries) {
+                const QJsonObject o = value.toObject();
+                IndexEntry entry;
+                entry.blob = o.value(QStringLiteral("blob")).toString();
+                entry.size = o.value(QStringLiteral("size")).toInteger();
+                entry.etag = o.value(QStringLiteral("etag")).toString();
+                entry.contentType = o.value(QStringLiteral("content_type")).toString();
+                entry.messageType = o.value(QStringLiteral("message_type")).toString();
+                entry.storedAtUtc = QDateTime::fromString(o.value(QStringLiteral("stored_at")).toString(),
+                                                          Qt::ISODateWithMs);
+                entry.maxAgeSeconds = o.value(QStringLiteral("max_age")).toInt();
+                entry.staleSeconds = o.value(QStringLiteral("stale")).toInt();
+                entry.lastUse = static_cast<quint64>(o.value(QStringLiteral("last_use")).toInteger());
+
+                // Entries whose blob went missing are dropped
+                const QString key = o.value(QStringLiteral("key")).toString();
+                if (key.isEmpty() || entry.blob.isEmpty() || !entry.storedAtUtc.isValid() ||
+                    QFileInfo(blobPath(entry.blob)).size() != entry.size) {
+                    m_indexDirty = true;
+                    continue;
+                }
+                if (m_blobRefs[entry.blob]++ == 0) {
+                    m_totalBytes += entry.size;
+                }
+                m_useClock = std::max(m_useClock, entry.lastUse);
+                m_entries.insert(key, entry);
+            }
+        } else if (!root.isEmpty()) {
+            LOG_WARN << "HttpDiskCache: unknown index version, starting empty";
+        }
+    }
+
+    // Blobs left behind by a crash between writing a body and the index
+    const QFileInfoList blobs = QDir(m_directory + QStringLiteral("/blobs")).entryInfoList(QDir::Files);
+    for (const QFileInfo& blob : blobs) {
+        if (!m_blobRefs.contains(blob.fileName())) {
+            QFile::remove(blob.filePath());
+        }
+    }
+
+    evictToBudget(QString());
+    if (m_indexDirty) {
+        saveIndex();
+    }
+    LOG_INFO << "HttpDiskCache: " << m_entries.size() << " entries, " << m_totalBytes
+             << " of " << m_maxBytes << " bytes in " << m_directory.toStdString();
+}
+
+void HttpDiskCache::saveIndex() {
+    QJsonArray entries;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        QJsonObject o;
+        o.insert(QStringLiteral("key"), it.key());
+        o.insert(QStringLiteral("blob"), it->blob);
+        o.insert(QStringLiteral("size"), it->size);
+        o.insert(QStringLiteral("etag"), it->etag);
+        o.insert(QStringLiteral("content_type"), it->contentType);
+        o.insert(QStringLiteral("message_type"), it->messageType);
+        o.insert(QStringLiteral("stored_at"), it->storedAtUtc.toString(Qt::ISODateWithMs));
+        o.insert(QStringLiteral("max_age"), it->maxAgeSeconds);
+        o.insert(QStringLiteral("stale"), it->staleSeconds);
+        o.insert(QStringLiteral("last_use"), static_cast<qint64>(it->lastUse));
+        entries.append(o);
+    }
+    QJsonObject root;
+    root.insert(QStringLiteral("version"), kIndexVersion);
+    root.insert(QStringLiteral("entries"), entries);
+
+    QSaveFile file(m_directory + QStringLiteral("/index.json"));
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact)) < 0 || !file.commit()) {
+        LOG_WARN << "HttpDiskCache: failed to save index: " << file.errorString().toStdString();
+        return;
+    }
+    m_indexDirty = false;
+}
+
+void HttpDiskCache::removeEntry(const QString& key) {
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return;
+    }
+    const QString blob = it->blob;
+    const qint64 size = it->size;
+    m_entries.erase(it);
+
+    auto ref = m_blobRefs.find(blob);
+    if (ref != m_blobRefs.end() && --ref.value() <= 0) {
+        m_blobRefs.erase(ref);
+        m_totalBytes -= size;
+        QFile::remove(blobPath(blob));
+    }
+}
+
+void HttpDiskCache::evictToBudget(const QString& keep) {
+    while (m_totalBytes > m_maxBytes) {
+        QString oldest;
+        quint64 oldestUse = std::numeric_limits<quint64>::max();
+        for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+            if (it.key() != keep && it->lastUse < oldestUse) {
+                oldest = it.key();
+                oldestUse = it->lastUse;
+            }
+        }
+        if (oldest.isEmpty()) {
+            break;
+        }
+        LOG_INFO << "HttpDiskCache: evicting " << oldest.toStdString();
+        removeEntry(oldest);
+        m_indexDirty = true;
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef HTTPDISKCACHE_H
+#define HTTPDISKCACHE_H
+
+// HttpDiskCache - Persistent, size-bounded cache of HTTP response bodies
+// Used by: BaseApiClient for cacheable GETs (DownloadApiClient menu, component
+//          comparisons, general diagnostics)
+// Purpose: Keep server responses across launches so a cold start can show
+//          them at once and only revalidate in the background
+// When to use: Shared instance via HttpDiskCache::shared(); NetworkCache stays
+//              the in-memory layer of decoded responses on top of it
+// Operations: Lookup/store by cache key, ETag revalidation, LRU eviction to a
+//             byte budget, Cache-Control parsing
+//
+// Layout: <dir>/blobs/<sha256>, named by the SHA-256 of the body so identical
+// responses share a file and a damaged blob is detected on read, plus
+// <dir>/index.json mapping cache keys to blobs and their validators.
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QByteArray>
+#include <memory>
+
+struct HttpCacheEntry {
+    QByteArray body;
+    QString etag;
+    QString contentType;
+    QString messageType;        // X-Protobuf-Message, when the server sent one
+    QDateTime storedAtUtc;      // last fetched or revalidated
+    int maxAgeSeconds = 0;      // fresh until storedAtUtc + maxAgeSeconds
+    int staleSeconds = 0;       // then usable while revalidating for this long
+
+    bool isValid() const { return storedAtUtc.isValid(); }
+    bool isFresh(const QDateTime& nowUtc) const {
+        return isValid() && storedAtUtc.secsTo(nowUtc) < maxAgeSeconds;
+    }
+    bool isUsableStale(const QDateTime& nowUtc) const {
+        return isValid() && storedAtUtc.secsTo(nowUtc) < qint64(maxAgeSeconds) + staleSeconds;
+    }
+};
+
+class HttpDiskCache {
+public:
+    static constexpr qint64 kDefaultMaxBytes = 32 * 1024 * 1024;
+    static constexpr int kDefaultStaleSeconds = 7 * 24 * 60 * 60;
+
+    explicit HttpDiskCache(const QString& directory, qint64 maxBytes = kDefaultMaxBytes);
+    ~HttpDiskCache();
+    HttpDiskCache(const HttpDiskCache&) = delete;
+    HttpDiskCache& operator=(const HttpDiskCache&) = delete;
+
+    // Application-wide cache under <app dir>/network_cache
+    static std::shared_ptr<HttpDiskCache> shared();
+
+    // Invalid entry on a miss; a hit counts as a use for LRU
+    HttpCacheEntry lookup(const QString& key);
+    // Replaces the key's entry, then evicts least recently used entries until
+    // the blobs fit the budget. False if the body couldn't be written.
+    bool store(const QString& key, const HttpCacheEntry& entry);
+    // After a 304: the stored body is current again
+    void markRevalidated(const QString& key, int maxAgeSeconds, int staleSeconds);
+    void remove(const QString& key);
+    void clear();
+
+    qint64 totalBytes() const;
+    qint64 maxBytes() const { return m_maxBytes; }
+    int entryCount() const;
+
+    // Caching rules of a response from its Cache-Control header. max-age and
+    // stale-while-revalidate override the caller's ttl and stale window;
+    // no-store disables storing, no-cache forces revalidation before use.
+    struct Policy {
+        bool store = true;
+        int maxAgeSeconds = 0;
+        int staleSeconds = 0;
+    };
+    static Policy policyFor(const QString& cacheControl, int ttlSeconds,
+                            int staleSeconds = kDefaultStaleSeconds);
+
+private:
+    struct IndexEntry {
+        QString blob;               // SHA-256 hex of the body
+        qint64 size = 0;
+        QString etag;
+        QString contentType;
+        QString messageType;
+        QDateTime storedAtUtc;
+        int maxAgeSeconds = 0;
+        int staleSeconds = 0;
+        quint64 lastUse = 0;        // m_useClock value at the last lookup/store
+    };
+
+    QString blobPath(const QString& blob) const;
+    void loadIndex();
+    void saveIndex();
+    void removeEntry(const QString& key);
+    void evictToBudget(const QString& keep);
+
+    mutable QMutex m_mutex;
+    QString m_directory;
+    qint64 m_maxBytes;
+    QHash<QString, IndexEntry> m_entries;
+    QHash<QString, int> m_blobRefs;     // entries per blob
+    qint64 m_totalBytes = 0;            // unique blobs only
+    quint64 m_useClock = 0;
+    bool m_indexDirty = false;          // only use times changed since the last save
+};
+
+#endif // HTTPDISKCACHE_H
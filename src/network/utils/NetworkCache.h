@@ -6,6 +6,9 @@
 // Purpose: Store API responses with automatic expiration to reduce server requests
 // When to use: Automatically used by API clients - configure TTL per cache entry
 // Operations: TTL-based storage, automatic cleanup, key-value access, expiration signals
+//
+// Holds decoded responses for this session only; HttpDiskCache keeps the raw
+// bodies of cached GETs across launches underneath it.
 
 #include <QObject>
 #include <QVariant>
@@ -447,11 +447,15 @@ void DiagnosticView::setupLayout() {
   runGpuTestsCheckbox = new QCheckBox("GPU Tests", this);
   runCpuBoostTestsCheckbox = new QCheckBox("CPU Boost Tests", this);
   storageAnalysisCheckbox = new QCheckBox("Storage Analysis", this);
+  fullMemoryStabilityCheckbox = new QCheckBox("Full RAM Stability", this);
+  fullMemoryStabilityCheckbox->setToolTip(
+    "Run the memory stability test over most of the free RAM instead of 256 MB");
 
   // Set default checked state for checkboxes
   runGpuTestsCheckbox->setChecked(true);
   runCpuBoostTestsCheckbox->setChecked(true);
   storageAnalysisCheckbox->setChecked(false);  // Off by default
+  fullMemoryStabilityCheckbox->setChecked(false);  // Off by default
 
   LOG_INFO << "[startup] DiagnosticView: setupLayout: styling checkboxes";
   // Apply slightly more compact checkbox style
@@ -482,6 +486,7 @@ void DiagnosticView::setupLayout() {
   runGpuTestsCheckbox->setStyleSheet(checkboxStyle);
   runCpuBoostTestsCheckbox->setStyleSheet(checkboxStyle);
   storageAnalysisCheckbox->setStyleSheet(checkboxStyle);
+  fullMemoryStabilityCheckbox->setStyleSheet(checkboxStyle);
 
   QString alwaysIncludedLabelStyle =
     "color: #bbbbbb; font-size: 12px; background: transparent; padding: 2px 4px;";
@@ -531,6 +536,8 @@ void DiagnosticView::setupLayout() {
 
   // Experimental checkbox (hidden when experimental features are disabled)
   testControlsGrid->addWidget(storageAnalysisCheckbox, 2, 2, Qt::AlignLeft);
+  testControlsGrid->addWidget(fullMemoryStabilityCheckbox, 3, 2,
+                              Qt::AlignLeft);
 
   // Right-align the whole grid as a group, while keeping items left-aligned
   // within each column.
@@ -574,6 +581,13 @@ void DiagnosticView::setupLayout() {
     }
     updateRunButtonState();
   });
+
+  connect(fullMemoryStabilityCheckbox, &QCheckBox::toggled, [this](bool checked) {
+    if (worker) {
+      worker->setFullMemoryStabilityTest(checked);
+    }
+    updateEstimatedTime();
+  });
   
   // Note: We'll reconnect this signal when worker is recreated in
   // connectWorkerSignals()
@@ -626,7 +640,7 @@ void DiagnosticView::setupLayout() {
     std::vector<QObject*> widgetsToBlock = {
       driveTestModeCombo, networkTestModeCombo, cpuThrottlingTestModeCombo,
       runGpuTestsCheckbox, runCpuBoostTestsCheckbox, storageAnalysisCheckbox,
-      useRecommendedCheckbox};
+      fullMemoryStabilityCheckbox, useRecommendedCheckbox};
     std::vector<std::unique_ptr<QSignalBlocker>> blockers;
     blockers.reserve(widgetsToBlock.size());
     for (QObject* obj : widgetsToBlock) {
@@ -880,6 +894,9 @@ void DiagnosticView::onRunDiagnostics() {
           worker->setRunCpuBoostTests(runCpuBoostTests);
           worker->setRunStorageAnalysis(storageAnalysisCheckbox &&
                                         storageAnalysisCheckbox->isChecked());
+          worker->setFullMemoryStabilityTest(
+            fullMemoryStabilityCheckbox &&
+            fullMemoryStabilityCheckbox->isChecked());
           worker->setSaveResults(true);  // Always save results
           worker->setRunNetworkTests(networkTestMode != NetworkTest_None);
           worker->setExtendedNetworkTests(networkTestMode ==
@@ -2484,7 +2501,8 @@ void DiagnosticView::setCpuThrottlingTestMode(int index) {
 void DiagnosticView::setUseRecommendedSettings(bool useRecommended) {
   // Some builds may strip optional controls (like manual upload buttons); guard against missing widgets
   if (!driveTestModeCombo || !networkTestModeCombo || !cpuThrottlingTestModeCombo ||
-      !runGpuTestsCheckbox || !runCpuBoostTestsCheckbox || !storageAnalysisCheckbox) {
+      !runGpuTestsCheckbox || !runCpuBoostTestsCheckbox || !storageAnalysisCheckbox ||
+      !fullMemoryStabilityCheckbox) {
     LOG_WARN << "DiagnosticView: skipping recommended settings update because one or more controls are missing";
     return;
   }
@@ -2565,6 +2583,7 @@ void DiagnosticView::setUseRecommendedSettings(bool useRecommended) {
   runGpuTestsCheckbox->setEnabled(!useRecommended);
   runCpuBoostTestsCheckbox->setEnabled(!useRecommended);
   storageAnalysisCheckbox->setEnabled(!useRecommended);
+  fullMemoryStabilityCheckbox->setEnabled(!useRecommended);
 
   // Apply visual styling based on enabled state
   if (useRecommended) {
@@ -2576,6 +2595,7 @@ void DiagnosticView::setUseRecommendedSettings(bool useRecommended) {
     runGpuTestsCheckbox->setStyleSheet(disabledCheckboxStyle);
     runCpuBoostTestsCheckbox->setStyleSheet(disabledCheckboxStyle);
     storageAnalysisCheckbox->setStyleSheet(disabledCheckboxStyle);
+    fullMemoryStabilityCheckbox->setStyleSheet(disabledCheckboxStyle);
   } else {
     // Reset to normal style
     driveTestModeCombo->applyStyle();
@@ -2585,6 +2605,7 @@ void DiagnosticView::setUseRecommendedSettings(bool useRecommended) {
     runGpuTestsCheckbox->setStyleSheet(enabledCheckboxStyle);
     runCpuBoostTestsCheckbox->setStyleSheet(enabledCheckboxStyle);
     storageAnalysisCheckbox->setStyleSheet(enabledCheckboxStyle);
+    fullMemoryStabilityCheckbox->setStyleSheet(enabledCheckboxStyle);
   }
 
   if (useRecommended) {
@@ -2611,6 +2632,9 @@ void DiagnosticView::setUseRecommendedSettings(bool useRecommended) {
     // Disable experimental features
     storageAnalysisCheckbox->setChecked(false);
 
+    // Quick 256 MB stability test
+    fullMemoryStabilityCheckbox->setChecked(false);
+
     // Always save results (with null check)
     if (worker) {
       worker->setSaveResults(true);
@@ -2625,6 +2649,7 @@ void DiagnosticView::setUseRecommendedSettings(bool useRecommended) {
       worker->setExtendedCpuThrottlingTests(false);
       worker->setRunCpuBoostTests(true);
       worker->setRunStorageAnalysis(false);
+      worker->setFullMemoryStabilityTest(false);
     }
 
     // Update estimated time based on the new settings
@@ -2641,6 +2666,11 @@ void DiagnosticView::updateEstimatedTime() {
   // Calculate estimated time: base 3 minutes + 1 minute per drive
   int estimatedMinutes = 3 + driveCount;
 
+  // The stability test over most of the free RAM adds a few minutes
+  if (fullMemoryStabilityCheckbox && fullMemoryStabilityCheckbox->isChecked()) {
+    estimatedMinutes += 5;
+  }
+
   // Update the label (with null check)
   if (estimatedTimeLabel) {
     QString timeText = QString("Estimated time: %1 min").arg(estimatedMinutes);
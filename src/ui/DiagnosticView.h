@@ -104,6 +104,7 @@ class DiagnosticView : public QWidget {
   QCheckBox* runGpuTestsCheckbox;
   QCheckBox* runCpuBoostTestsCheckbox;
   QCheckBox* storageAnalysisCheckbox;
+  QCheckBox* fullMemoryStabilityCheckbox = nullptr;
   QCheckBox* useRecommendedCheckbox;
 
   // Remove from private members:
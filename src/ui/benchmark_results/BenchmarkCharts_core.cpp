@@ -1,4 +1,7 @@
+#include <cmath>
+
 #include "BenchmarkCharts.h"
+#include "ParsedRun.h"
 
 bool BenchmarkCharts::ensureOutputDirExists(QDir& outputDir) {
   if (!outputDir.exists()) {
@@ -39,33 +42,24 @@ QString BenchmarkCharts::getDatasetOptionsJson(bool isComparison) {
 QString BenchmarkCharts::processComparisonData(const QString& dataColumn,
                                                const QString& csvFilePath,
                                                bool includeLowPercentiles) {
-  QFile file(csvFilePath);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+  auto run = ParsedRun::load(csvFilePath);
+  if (!run) {
     return "";  // Empty string if we can't open the file
   }
 
-  QTextStream in(&file);
-  QString header = in.readLine();
-  QStringList headers = header.split(",");
-
-  int dataIndex = headers.indexOf(dataColumn);
+  int dataIndex = run->columnIndex(dataColumn);
   if (dataIndex < 0) {
-    file.close();
     return "";  // Column not found
   }
 
   QJsonArray dataPoints;
   int timeCounter = 0;
 
-  while (!in.atEnd()) {
-    QString line = in.readLine();
-    QStringList fields = line.split(",");
+  for (size_t row = 0; row < run->rowCount(); ++row) {
+    if (run->fieldCount(row) <= dataIndex) continue;
 
-    if (fields.size() <= dataIndex) continue;
-
-    bool ok;
-    double value = fields[dataIndex].toDouble(&ok);
-    if (ok) {
+    double value = run->value(row, dataIndex);
+    if (!std::isnan(value)) {
       QJsonObject point;
       point["x"] = timeCounter++;
       point["y"] = value;
@@ -73,8 +67,6 @@ QString BenchmarkCharts::processComparisonData(const QString& dataColumn,
     }
   }
 
-  file.close();
-
   QJsonDocument doc(dataPoints);
   return doc.toJson(QJsonDocument::Compact);
 }
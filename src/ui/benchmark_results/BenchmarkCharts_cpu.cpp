@@ -7,20 +7,19 @@
 #include <QRegularExpression>
 
 #include "BenchmarkCharts.h"
+#include "ParsedRun.h"
 #include "../../logging/Logger.h"
 
 QString BenchmarkCharts::generateCpuUsageChart(
   const QString& csvFilePath, const QString& comparisonCsvFilePath) {
   // Parse CPU core usage data from the CSV
-  QFile file(csvFilePath);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+  auto run = ParsedRun::load(csvFilePath);
+  if (!run) {
     LOG_ERROR << "Failed to open CSV file: [path hidden for privacy]";
     return "";
   }
 
-  QTextStream in(&file);
-  QString header = in.readLine();
-  QStringList headers = header.split(",");
+  const QStringList& headers = run->columnNames();
 
   // Find all CPU core usage columns using regex to avoid capturing clock metrics.
   // Matches current headers "PDH_Core 0 CPU (%)" and legacy "Core 0 (%)".
@@ -40,7 +39,6 @@ QString BenchmarkCharts::generateCpuUsageChart(
 
   if (coreIndices.isEmpty()) {
     LOG_WARN << "No CPU core usage columns found in CSV";
-    file.close();
     return "";
   }
 
@@ -52,11 +50,8 @@ QString BenchmarkCharts::generateCpuUsageChart(
 
   int timeCounter = 0;
 
-  while (!in.atEnd()) {
-    QString line = in.readLine();
-    QStringList fields = line.split(",");
-
-    if (fields.size() <=
+  for (size_t row = 0; row < run->rowCount(); ++row) {
+    if (run->fieldCount(row) <=
         *std::max_element(coreIndices.begin(), coreIndices.end()))
       continue;
 
@@ -66,11 +61,9 @@ QString BenchmarkCharts::generateCpuUsageChart(
     int validCores = 0;
 
     for (int i = 0; i < coreIndices.size(); i++) {
-      int idx = coreIndices[i];
-      bool ok;
-      double usage = fields[idx].toDouble(&ok);
+      double usage = run->value(row, coreIndices[i]);
 
-      if (ok && usage >= 0) {
+      if (usage >= 0) {
         coreData[i].append(usage);
         totalUsage += usage;
         maxUsage = std::max(maxUsage, usage);
@@ -86,10 +79,9 @@ QString BenchmarkCharts::generateCpuUsageChart(
     }
 
     // Total CPU usage (if present)
-    if (totalCpuIndex >= 0 && totalCpuIndex < fields.size()) {
-      bool ok = false;
-      double total = fields[totalCpuIndex].toDouble(&ok);
-      if (ok && total >= 0) {
+    if (totalCpuIndex >= 0 && totalCpuIndex < run->fieldCount(row)) {
+      double total = run->value(row, totalCpuIndex);
+      if (total >= 0) {
         totalCpuUsageData.append(QPointF(timeCounter, total));
       }
     }
@@ -97,8 +89,6 @@ QString BenchmarkCharts::generateCpuUsageChart(
     timeCounter++;
   }
 
-  file.close();
-
   // Create datasets container
   QVector<QVector<QPointF>> datasets;
   QStringList labels;
@@ -125,8 +115,8 @@ QString BenchmarkCharts::generateCpuUsageChart(
                              YAxisScaleType::Fixed_0_to_100);
   } else {
     // Parse comparison CPU core usage data
-    QFile compFile(comparisonCsvFilePath);
-    if (!compFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    auto compRun = ParsedRun::load(comparisonCsvFilePath);
+    if (!compRun) {
       LOG_ERROR << "Failed to open comparison CSV file: "
                 << comparisonCsvFilePath.toStdString();
       // Fall back to non-comparison chart
@@ -135,9 +125,7 @@ QString BenchmarkCharts::generateCpuUsageChart(
                                datasets, YAxisScaleType::Fixed_0_to_100);
     }
 
-    QTextStream compIn(&compFile);
-    QString compHeader = compIn.readLine();
-    QStringList compHeaders = compHeader.split(",");
+    const QStringList& compHeaders = compRun->columnNames();
 
     // Find all CPU core usage columns in comparison data
     QVector<int> compCoreIndices;
@@ -151,7 +139,6 @@ QString BenchmarkCharts::generateCpuUsageChart(
 
     if (compCoreIndices.isEmpty() && compTotalCpuIndex < 0) {
       LOG_WARN << "No CPU core usage columns found in comparison CSV";
-      compFile.close();
       // Fall back to non-comparison chart
       return generateHtmlChart("cpu_usage_chart", "CPU Core Usage Over Time",
                                "Time (sample)", "CPU Usage (%)", labels,
@@ -166,11 +153,8 @@ QString BenchmarkCharts::generateCpuUsageChart(
 
     int compTimeCounter = 0;
 
-    while (!compIn.atEnd()) {
-      QString line = compIn.readLine();
-      QStringList fields = line.split(",");
-
-      if (fields.size() <=
+    for (size_t row = 0; row < compRun->rowCount(); ++row) {
+      if (compRun->fieldCount(row) <=
           *std::max_element(compCoreIndices.begin(), compCoreIndices.end()))
         continue;
 
@@ -180,11 +164,9 @@ QString BenchmarkCharts::generateCpuUsageChart(
       int validCores = 0;
 
       for (int i = 0; i < compCoreIndices.size(); i++) {
-        int idx = compCoreIndices[i];
-        bool ok;
-        double usage = fields[idx].toDouble(&ok);
+        double usage = compRun->value(row, compCoreIndices[i]);
 
-        if (ok && usage >= 0) {
+        if (usage >= 0) {
           compCoreData[i].append(usage);
           totalUsage += usage;
           maxUsage = std::max(maxUsage, usage);
@@ -200,10 +182,10 @@ QString BenchmarkCharts::generateCpuUsageChart(
       }
 
       // Total CPU usage (if present)
-      if (compTotalCpuIndex >= 0 && compTotalCpuIndex < fields.size()) {
-        bool ok = false;
-        double total = fields[compTotalCpuIndex].toDouble(&ok);
-        if (ok && total >= 0) {
+      if (compTotalCpuIndex >= 0 &&
+          compTotalCpuIndex < compRun->fieldCount(row)) {
+        double total = compRun->value(row, compTotalCpuIndex);
+        if (total >= 0) {
           compTotalCpuUsageData.append(QPointF(compTimeCounter, total));
         }
       }
@@ -211,8 +193,6 @@ QString BenchmarkCharts::generateCpuUsageChart(
       compTimeCounter++;
     }
 
-    compFile.close();
-
     // Create comparison datasets container
     QVector<QVector<QPointF>> compDatasets;
     QStringList compLabels;
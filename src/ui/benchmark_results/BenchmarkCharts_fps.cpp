@@ -4,25 +4,21 @@
 #include <QJsonObject>
 
 #include "BenchmarkCharts.h"
+#include "ParsedRun.h"
 #include "../../logging/Logger.h"
 
 QString BenchmarkCharts::generateFpsChart(
   const QString& csvFilePath, const QString& comparisonCsvFilePath) {
   // Parse FPS data from the CSV
-  QFile file(csvFilePath);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+  auto run = ParsedRun::load(csvFilePath);
+  if (!run) {
     LOG_ERROR << "Failed to open CSV file: [path hidden for privacy]";
     return "";
   }
 
-  QTextStream in(&file);
-  QString header = in.readLine();
-  QStringList headers = header.split(",");
-
-  int fpsIndex = headers.indexOf("FPS");
+  int fpsIndex = run->columnIndex("FPS");
   if (fpsIndex < 0) {
     LOG_WARN << "FPS column not found in CSV";
-    file.close();
     return "";
   }
 
@@ -30,21 +26,15 @@ QString BenchmarkCharts::generateFpsChart(
   QVector<QPointF> fpsData;
   int timeCounter = 0;
 
-  while (!in.atEnd()) {
-    QString line = in.readLine();
-    QStringList fields = line.split(",");
-
-    if (fields.size() <= fpsIndex) continue;
+  for (size_t row = 0; row < run->rowCount(); ++row) {
+    if (run->fieldCount(row) <= fpsIndex) continue;
 
-    bool ok;
-    double fps = fields[fpsIndex].toDouble(&ok);
-    if (ok && fps > 0) {
+    double fps = run->value(row, fpsIndex);
+    if (fps > 0) {
       fpsData.append(QPointF(timeCounter++, fps));
     }
   }
 
-  file.close();
-
   // Create dataset container
   QVector<QVector<QPointF>> datasets;
   datasets.append(fpsData);
@@ -60,8 +50,8 @@ QString BenchmarkCharts::generateFpsChart(
                              YAxisScaleType::Automatic);
   } else {
     // Parse comparison FPS data
-    QFile compFile(comparisonCsvFilePath);
-    if (!compFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    auto compRun = ParsedRun::load(comparisonCsvFilePath);
+    if (!compRun) {
       LOG_ERROR << "Failed to open comparison CSV file: "
                 << comparisonCsvFilePath.toStdString();
       // Fall back to non-comparison chart
@@ -70,14 +60,9 @@ QString BenchmarkCharts::generateFpsChart(
                                YAxisScaleType::Automatic);
     }
 
-    QTextStream compIn(&compFile);
-    QString compHeader = compIn.readLine();
-    QStringList compHeaders = compHeader.split(",");
-
-    int compFpsIndex = compHeaders.indexOf("FPS");
+    int compFpsIndex = compRun->columnIndex("FPS");
     if (compFpsIndex < 0) {
       LOG_WARN << "FPS column not found in comparison CSV";
-      compFile.close();
       // Fall back to non-comparison chart
       return generateHtmlChart("fps_chart", "FPS Over Time", "Time (sample)",
                                "FPS", labels, datasets,
@@ -88,21 +73,15 @@ QString BenchmarkCharts::generateFpsChart(
     QVector<QPointF> compFpsData;
     int compTimeCounter = 0;
 
-    while (!compIn.atEnd()) {
-      QString line = compIn.readLine();
-      QStringList fields = line.split(",");
-
-      if (fields.size() <= compFpsIndex) continue;
+    for (size_t row = 0; row < compRun->rowCount(); ++row) {
+      if (compRun->fieldCount(row) <= compFpsIndex) continue;
 
-      bool ok;
-      double fps = fields[compFpsIndex].toDouble(&ok);
-      if (ok && fps > 0) {
+      double fps = compRun->value(row, compFpsIndex);
+      if (fps > 0) {
         compFpsData.append(QPointF(compTimeCounter++, fps));
       }
     }
 
-    compFile.close();
-
     // Create comparison dataset container
     QVector<QVector<QPointF>> compDatasets;
     compDatasets.append(compFpsData);
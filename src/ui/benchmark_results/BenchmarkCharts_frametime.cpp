@@ -4,27 +4,23 @@
 #include <QJsonObject>
 
 #include "BenchmarkCharts.h"
+#include "ParsedRun.h"
 #include "../../logging/Logger.h"
 
 QString BenchmarkCharts::generateFrameTimeMetricsChart(
   const QString& csvFilePath, const QString& comparisonCsvFilePath) {
   // Parse frame time data from the CSV
-  QFile file(csvFilePath);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+  auto run = ParsedRun::load(csvFilePath);
+  if (!run) {
     LOG_ERROR << "Failed to open CSV file: [path hidden for privacy]";
     return "";
   }
 
-  QTextStream in(&file);
-  QString header = in.readLine();
-  QStringList headers = header.split(",");
-
-  int frameTimeIndex = headers.indexOf("Frame Time");
-  int highestFrameTimeIndex = headers.indexOf("Highest Frame Time");
+  int frameTimeIndex = run->columnIndex("Frame Time");
+  int highestFrameTimeIndex = run->columnIndex("Highest Frame Time");
 
   if (frameTimeIndex < 0) {
     LOG_WARN << "Frame Time column not found in CSV";
-    file.close();
     return "";
   }
 
@@ -34,26 +30,20 @@ QString BenchmarkCharts::generateFrameTimeMetricsChart(
 
   int timeCounter = 0;
 
-  while (!in.atEnd()) {
-    QString line = in.readLine();
-    QStringList fields = line.split(",");
-
-    if (fields.size() <= std::max(frameTimeIndex, highestFrameTimeIndex))
+  for (size_t row = 0; row < run->rowCount(); ++row) {
+    if (run->fieldCount(row) <= std::max(frameTimeIndex, highestFrameTimeIndex))
       continue;
 
-    bool okFrameTime;
-    double frameTime = fields[frameTimeIndex].toDouble(&okFrameTime);
+    double frameTime = run->value(row, frameTimeIndex);
 
-    if (okFrameTime && frameTime > 0) {
+    if (frameTime > 0) {
       frameTimeData.append(QPointF(timeCounter, frameTime));
 
       // Add highest frame time if available in CSV
       if (highestFrameTimeIndex >= 0) {
-        bool okHighestFrameTime;
-        double highestFrameTime =
-          fields[highestFrameTimeIndex].toDouble(&okHighestFrameTime);
+        double highestFrameTime = run->value(row, highestFrameTimeIndex);
 
-        if (okHighestFrameTime && highestFrameTime > 0) {
+        if (highestFrameTime > 0) {
           highestFrameTimeData.append(QPointF(timeCounter, highestFrameTime));
         } else {
           // Fallback to using frame time if highest frame time is invalid
@@ -68,8 +58,6 @@ QString BenchmarkCharts::generateFrameTimeMetricsChart(
     }
   }
 
-  file.close();
-
   // Create dataset container
   QVector<QVector<QPointF>> datasets;
   datasets.append(frameTimeData);
@@ -86,8 +74,8 @@ QString BenchmarkCharts::generateFrameTimeMetricsChart(
                              datasets, YAxisScaleType::Automatic);
   } else {
     // Parse comparison frame time data
-    QFile compFile(comparisonCsvFilePath);
-    if (!compFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    auto compRun = ParsedRun::load(comparisonCsvFilePath);
+    if (!compRun) {
       LOG_ERROR << "Failed to open comparison CSV file: "
                 << comparisonCsvFilePath.toStdString();
       // Fall back to non-comparison chart
@@ -96,16 +84,11 @@ QString BenchmarkCharts::generateFrameTimeMetricsChart(
                                datasets, YAxisScaleType::Automatic);
     }
 
-    QTextStream compIn(&compFile);
-    QString compHeader = compIn.readLine();
-    QStringList compHeaders = compHeader.split(",");
-
-    int compFrameTimeIndex = compHeaders.indexOf("Frame Time");
-    int compHighestFrameTimeIndex = compHeaders.indexOf("Highest Frame Time");
+    int compFrameTimeIndex = compRun->columnIndex("Frame Time");
+    int compHighestFrameTimeIndex = compRun->columnIndex("Highest Frame Time");
 
     if (compFrameTimeIndex < 0) {
       LOG_WARN << "Frame Time column not found in comparison CSV";
-      compFile.close();
       // Fall back to non-comparison chart
       return generateHtmlChart("frame_time_chart", "Frame Time Distribution",
                                "Time (sample)", "Frame Time (ms)", labels,
@@ -118,27 +101,22 @@ QString BenchmarkCharts::generateFrameTimeMetricsChart(
 
     int compTimeCounter = 0;
 
-    while (!compIn.atEnd()) {
-      QString line = compIn.readLine();
-      QStringList fields = line.split(",");
-
-      if (fields.size() <=
+    for (size_t row = 0; row < compRun->rowCount(); ++row) {
+      if (compRun->fieldCount(row) <=
           std::max(compFrameTimeIndex, compHighestFrameTimeIndex))
         continue;
 
-      bool okFrameTime;
-      double frameTime = fields[compFrameTimeIndex].toDouble(&okFrameTime);
+      double frameTime = compRun->value(row, compFrameTimeIndex);
 
-      if (okFrameTime && frameTime > 0) {
+      if (frameTime > 0) {
         compFrameTimeData.append(QPointF(compTimeCounter, frameTime));
 
         // Add highest frame time if available in CSV
         if (compHighestFrameTimeIndex >= 0) {
-          bool okHighestFrameTime;
           double highestFrameTime =
-            fields[compHighestFrameTimeIndex].toDouble(&okHighestFrameTime);
+            compRun->value(row, compHighestFrameTimeIndex);
 
-          if (okHighestFrameTime && highestFrameTime > 0) {
+          if (highestFrameTime > 0) {
             compHighestFrameTimeData.append(
               QPointF(compTimeCounter, highestFrameTime));
           } else {
@@ -155,8 +133,6 @@ QString BenchmarkCharts::generateFrameTimeMetricsChart(
       }
     }
 
-    compFile.close();
-
     // Create comparison dataset container
     QVector<QVector<QPointF>> compDatasets;
     compDatasets.append(compFrameTimeData);
@@ -1,31 +1,30 @@
+#include <algorithm>
+#include <cmath>
+
 #include <QApplication>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 
 #include "BenchmarkCharts.h"
+#include "ParsedRun.h"
 #include "../../logging/Logger.h"
 
 QString BenchmarkCharts::generateGpuUsageChart(
   const QString& csvFilePath, const QString& comparisonCsvFilePath) {
   // Parse GPU usage and memory data from the CSV
-  QFile file(csvFilePath);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+  auto run = ParsedRun::load(csvFilePath);
+  if (!run) {
     LOG_ERROR << "Failed to open CSV file: [path hidden for privacy]";
     return "";
   }
 
-  QTextStream in(&file);
-  QString header = in.readLine();
-  QStringList headers = header.split(",");
-
-  int gpuUsageIndex = headers.indexOf("GPU Usage");
-  int gpuMemUsedIndex = headers.indexOf("GPU Mem Used");
-  int gpuMemTotalIndex = headers.indexOf("GPU Mem Total");
+  int gpuUsageIndex = run->columnIndex("GPU Usage");
+  int gpuMemUsedIndex = run->columnIndex("GPU Mem Used");
+  int gpuMemTotalIndex = run->columnIndex("GPU Mem Total");
 
   if (gpuUsageIndex < 0 || gpuMemUsedIndex < 0 || gpuMemTotalIndex < 0) {
     LOG_WARN << "Required GPU columns not found in CSV";
-    file.close();
     return "";
   }
 
@@ -35,28 +34,23 @@ QString BenchmarkCharts::generateGpuUsageChart(
 
   int timeCounter = 0;
 
-  while (!in.atEnd()) {
-    QString line = in.readLine();
-    QStringList fields = line.split(",");
-
-    if (fields.size() <=
+  for (size_t row = 0; row < run->rowCount(); ++row) {
+    if (run->fieldCount(row) <=
         std::max({gpuUsageIndex, gpuMemUsedIndex, gpuMemTotalIndex}))
       continue;
 
     // Process GPU Usage
-    bool usageOk;
-    double gpuUsage = fields[gpuUsageIndex].toDouble(&usageOk);
+    double gpuUsage = run->value(row, gpuUsageIndex);
 
     // Process GPU Memory
-    bool memUsedOk, memTotalOk;
-    double gpuMemUsed = fields[gpuMemUsedIndex].toDouble(&memUsedOk);
-    double gpuMemTotal = fields[gpuMemTotalIndex].toDouble(&memTotalOk);
+    double gpuMemUsed = run->value(row, gpuMemUsedIndex);
+    double gpuMemTotal = run->value(row, gpuMemTotalIndex);
 
-    if (usageOk && gpuUsage >= 0) {
+    if (gpuUsage >= 0) {
       gpuUsageData.append(QPointF(timeCounter, gpuUsage));
     }
 
-    if (memUsedOk && memTotalOk && gpuMemTotal > 0) {
+    if (!std::isnan(gpuMemUsed) && gpuMemTotal > 0) {
       // Calculate memory usage as a percentage
       double memUsagePercent = (gpuMemUsed / gpuMemTotal) * 100.0;
       gpuMemUsageData.append(QPointF(timeCounter, memUsagePercent));
@@ -65,8 +59,6 @@ QString BenchmarkCharts::generateGpuUsageChart(
     timeCounter++;
   }
 
-  file.close();
-
   // Create datasets container
   QVector<QVector<QPointF>> datasets;
   datasets.append(gpuUsageData);
@@ -83,8 +75,8 @@ QString BenchmarkCharts::generateGpuUsageChart(
                              YAxisScaleType::Fixed_0_to_100);
   } else {
     // Parse comparison GPU data
-    QFile compFile(comparisonCsvFilePath);
-    if (!compFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    auto compRun = ParsedRun::load(comparisonCsvFilePath);
+    if (!compRun) {
       LOG_ERROR << "Failed to open comparison CSV file: "
                 << comparisonCsvFilePath.toStdString();
       // Fall back to non-comparison chart
@@ -93,18 +85,13 @@ QString BenchmarkCharts::generateGpuUsageChart(
                                YAxisScaleType::Fixed_0_to_100);
     }
 
-    QTextStream compIn(&compFile);
-    QString compHeader = compIn.readLine();
-    QStringList compHeaders = compHeader.split(",");
-
-    int compGpuUsageIndex = compHeaders.indexOf("GPU Usage");
-    int compGpuMemUsedIndex = compHeaders.indexOf("GPU Mem Used");
-    int compGpuMemTotalIndex = compHeaders.indexOf("GPU Mem Total");
+    int compGpuUsageIndex = compRun->columnIndex("GPU Usage");
+    int compGpuMemUsedIndex = compRun->columnIndex("GPU Mem Used");
+    int compGpuMemTotalIndex = compRun->columnIndex("GPU Mem Total");
 
     if (compGpuUsageIndex < 0 || compGpuMemUsedIndex < 0 ||
         compGpuMemTotalIndex < 0) {
       LOG_WARN << "Required GPU columns not found in comparison CSV";
-      compFile.close();
       // Fall back to non-comparison chart
       return generateHtmlChart("gpu_usage_chart", "GPU Metrics Over Time",
                                "Time (sample)", "Usage (%)", labels, datasets,
@@ -117,28 +104,24 @@ QString BenchmarkCharts::generateGpuUsageChart(
 
     int compTimeCounter = 0;
 
-    while (!compIn.atEnd()) {
-      QString line = compIn.readLine();
-      QStringList fields = line.split(",");
-
-      if (fields.size() <= std::max({compGpuUsageIndex, compGpuMemUsedIndex,
-                                     compGpuMemTotalIndex}))
+    for (size_t row = 0; row < compRun->rowCount(); ++row) {
+      if (compRun->fieldCount(row) <= std::max({compGpuUsageIndex,
+                                                compGpuMemUsedIndex,
+                                                compGpuMemTotalIndex}))
         continue;
 
       // Process GPU Usage
-      bool usageOk;
-      double gpuUsage = fields[compGpuUsageIndex].toDouble(&usageOk);
+      double gpuUsage = compRun->value(row, compGpuUsageIndex);
 
       // Process GPU Memory
-      bool memUsedOk, memTotalOk;
-      double gpuMemUsed = fields[compGpuMemUsedIndex].toDouble(&memUsedOk);
-      double gpuMemTotal = fields[compGpuMemTotalIndex].toDouble(&memTotalOk);
+      double gpuMemUsed = compRun->value(row, compGpuMemUsedIndex);
+      double gpuMemTotal = compRun->value(row, compGpuMemTotalIndex);
 
-      if (usageOk && gpuUsage >= 0) {
+      if (gpuUsage >= 0) {
         compGpuUsageData.append(QPointF(compTimeCounter, gpuUsage));
       }
 
-      if (memUsedOk && memTotalOk && gpuMemTotal > 0) {
+      if (!std::isnan(gpuMemUsed) && gpuMemTotal > 0) {
         // Calculate memory usage as a percentage
         double memUsagePercent = (gpuMemUsed / gpuMemTotal) * 100.0;
         compGpuMemUsageData.append(QPointF(compTimeCounter, memUsagePercent));
@@ -147,8 +130,6 @@ QString BenchmarkCharts::generateGpuUsageChart(
       compTimeCounter++;
     }
 
-    compFile.close();
-
     // Create comparison datasets container
     QVector<QVector<QPointF>> compDatasets;
     compDatasets.append(compGpuUsageData);
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <QApplication>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -5,21 +7,20 @@
 #include <QRegularExpression>
 
 #include "BenchmarkCharts.h"
+#include "ParsedRun.h"
 #include "../../logging/Logger.h"
 
 QString BenchmarkCharts::generateGpuCpuUsageChart(
   const QString& csvFilePath, const QString& comparisonCsvFilePath) {
 
   // Parse data for GPU/CPU usage and FPS
-  QFile file(csvFilePath);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+  auto run = ParsedRun::load(csvFilePath);
+  if (!run) {
     LOG_ERROR << "Failed to open CSV file: [path hidden for privacy]";
     return "";
   }
 
-  QTextStream in(&file);
-  QString header = in.readLine();
-  QStringList headers = header.split(",");
+  const QStringList& headers = run->columnNames();
 
   int fpsIndex = headers.indexOf("FPS");
   int gpuUsageIndex = headers.indexOf("GPU Usage");
@@ -36,7 +37,6 @@ QString BenchmarkCharts::generateGpuCpuUsageChart(
 
   if (gpuUsageIndex < 0 || fpsIndex < 0 || coreIndices.isEmpty()) {
     LOG_WARN << "Required columns not found in CSV";
-    file.close();
     return "";
   }
 
@@ -47,42 +47,37 @@ QString BenchmarkCharts::generateGpuCpuUsageChart(
 
   int timeCounter = 0;
 
-  while (!in.atEnd()) {
-    QString line = in.readLine();
-    QStringList fields = line.split(",");
+  int maxField =
+    std::max({fpsIndex, gpuUsageIndex,
+              *std::max_element(coreIndices.begin(), coreIndices.end())});
 
-    int maxField =
-      std::max({fpsIndex, gpuUsageIndex,
-                *std::max_element(coreIndices.begin(), coreIndices.end())});
-    if (fields.size() <= maxField) continue;
+  for (size_t row = 0; row < run->rowCount(); ++row) {
+    if (run->fieldCount(row) <= maxField) continue;
 
     // Extract FPS
-    bool fpsOk;
-    double fps = fields[fpsIndex].toDouble(&fpsOk);
+    double fps = run->value(row, fpsIndex);
 
     // Extract GPU Usage
-    bool gpuOk;
-    double gpuUsage = fields[gpuUsageIndex].toDouble(&gpuOk);
+    double gpuUsage = run->value(row, gpuUsageIndex);
 
     // Find max CPU core usage
     double maxCpuUsage = 0.0;
     bool anyCpuValueOk = false;
 
     for (int coreIdx : coreIndices) {
-      bool cpuOk;
-      double cpuUsage = fields[coreIdx].toDouble(&cpuOk);
-      if (cpuOk && cpuUsage > 0) {
+      double cpuUsage = run->value(row, coreIdx);
+      if (cpuUsage > 0) {
         maxCpuUsage = std::max(maxCpuUsage, cpuUsage);
         anyCpuValueOk = true;
       }
     }
 
     // Add data points
-    if (fpsOk && fps > 0) {
+    if (fps > 0) {
       fpsData.append(QPointF(timeCounter, fps));
     }
 
-    if (gpuOk && gpuUsage >= 0) {
+    if (gpuUsage >= 0) {
       gpuUsageData.append(QPointF(timeCounter, gpuUsage));
     }
 
@@ -93,8 +88,6 @@ QString BenchmarkCharts::generateGpuCpuUsageChart(
     timeCounter++;
   }
 
-  file.close();
-
   // Create datasets container
   QVector<QVector<QPointF>> datasets;
   datasets.append(fpsData);
@@ -112,8 +105,8 @@ QString BenchmarkCharts::generateGpuCpuUsageChart(
       "Usage/FPS", labels, datasets, YAxisScaleType::Automatic);
   } else {
     // Parse comparison data
-    QFile compFile(comparisonCsvFilePath);
-    if (!compFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    auto compRun = ParsedRun::load(comparisonCsvFilePath);
+    if (!compRun) {
       LOG_ERROR << "Failed to open comparison CSV file: "
                 << comparisonCsvFilePath.toStdString();
       // Fall back to non-comparison chart
@@ -122,9 +115,7 @@ QString BenchmarkCharts::generateGpuCpuUsageChart(
         "Usage/FPS", labels, datasets, YAxisScaleType::Automatic);
     }
 
-    QTextStream compIn(&compFile);
-    QString compHeader = compIn.readLine();
-    QStringList compHeaders = compHeader.split(",");
+    const QStringList& compHeaders = compRun->columnNames();
 
     int compFpsIndex = compHeaders.indexOf("FPS");
     int compGpuUsageIndex = compHeaders.indexOf("GPU Usage");
@@ -141,7 +132,6 @@ QString BenchmarkCharts::generateGpuCpuUsageChart(
     if (compGpuUsageIndex < 0 || compFpsIndex < 0 ||
         compCoreIndices.isEmpty()) {
       LOG_WARN << "Required columns not found in comparison CSV";
-      compFile.close();
       // Fall back to non-comparison chart
       return generateHtmlChart(
         "gpu_cpu_chart", "GPU vs CPU Usage (With FPS Overlay)", "Time (sample)",
@@ -155,42 +145,37 @@ QString BenchmarkCharts::generateGpuCpuUsageChart(
 
     int compTimeCounter = 0;
 
-    while (!compIn.atEnd()) {
-      QString line = compIn.readLine();
-      QStringList fields = line.split(",");
+    int compMaxField = std::max(
+      {compFpsIndex, compGpuUsageIndex,
+       *std::max_element(compCoreIndices.begin(), compCoreIndices.end())});
 
-      int maxField = std::max(
-        {compFpsIndex, compGpuUsageIndex,
-         *std::max_element(compCoreIndices.begin(), compCoreIndices.end())});
-      if (fields.size() <= maxField) continue;
+    for (size_t row = 0; row < compRun->rowCount(); ++row) {
+      if (compRun->fieldCount(row) <= compMaxField) continue;
 
       // Extract FPS
-      bool fpsOk;
-      double fps = fields[compFpsIndex].toDouble(&fpsOk);
+      double fps = compRun->value(row, compFpsIndex);
 
       // Extract GPU Usage
-      bool gpuOk;
-      double gpuUsage = fields[compGpuUsageIndex].toDouble(&gpuOk);
+      double gpuUsage = compRun->value(row, compGpuUsageIndex);
 
       // Find max CPU core usage
       double maxCpuUsage = 0.0;
       bool anyCpuValueOk = false;
 
       for (int coreIdx : compCoreIndices) {
-        bool cpuOk;
-        double cpuUsage = fields[coreIdx].toDouble(&cpuOk);
-        if (cpuOk && cpuUsage > 0) {
+        double cpuUsage = compRun->value(row, coreIdx);
+        if (cpuUsage > 0) {
           maxCpuUsage = std::max(maxCpuUsage, cpuUsage);
           anyCpuValueOk = true;
         }
       }
 
       // Add data points
-      if (fpsOk && fps > 0) {
+      if (fps > 0) {
         compFpsData.append(QPointF(compTimeCounter, fps));
       }
 
-      if (gpuOk && gpuUsage >= 0) {
+      if (gpuUsage >= 0) {
         compGpuUsageData.append(QPointF(compTimeCounter, gpuUsage));
       }
 
@@ -201,8 +186,6 @@ QString BenchmarkCharts::generateGpuCpuUsageChart(
       compTimeCounter++;
     }
 
-    compFile.close();
-
     // Create comparison datasets container
     QVector<QVector<QPointF>> compDatasets;
     compDatasets.append(compFpsData);
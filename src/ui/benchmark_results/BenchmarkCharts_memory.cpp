@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cmath>
 
 #include <QApplication>
 #include <QJsonArray>
@@ -6,12 +7,10 @@
 #include <QJsonObject>
 
 #include "BenchmarkCharts.h"
+#include "ParsedRun.h"
 #include "../../logging/Logger.h"
 
-static double toMb(const QString& val, bool* ok) {
-  double bytes = val.toDouble(ok);
-  return bytes / 1048576.0;
-}
+static double toMb(double bytes) { return bytes / 1048576.0; }
 
 QString BenchmarkCharts::generateMemoryChart(
   const QString& csvFilePath, const QString& comparisonCsvFilePath) {
@@ -19,23 +18,20 @@ QString BenchmarkCharts::generateMemoryChart(
                              QVector<QPointF>& ramLoad,
                              QVector<QPointF>& gpuMemUsage,
                              QVector<QPointF>& gpuMemLoad) -> bool {
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    auto run = ParsedRun::load(path);
+    if (!run) {
       LOG_ERROR << "Failed to open CSV file: [path hidden for privacy]";
       return false;
     }
 
-    QTextStream in(&file);
-    QString header = in.readLine();
-    QStringList headers = header.split(",");
-
-    int memoryUsageIndex = headers.indexOf("Memory Usage (MB)");
-    int memoryLoadIndex = headers.indexOf("PDH_Memory_Load(%)");
-    if (memoryLoadIndex < 0) memoryLoadIndex = headers.indexOf("Memory Load");
-    int memoryAvailableIndex = headers.indexOf("PDH_Memory_Available(MB)");
-    int memoryCommitLimitIndex = headers.indexOf("PDH_Memory_Commit_Limit(bytes)");
-    int gpuMemUsedIndex = headers.indexOf("GPU Mem Used");
-    int gpuMemTotalIndex = headers.indexOf("GPU Mem Total");
+    int memoryUsageIndex = run->columnIndex("Memory Usage (MB)");
+    int memoryLoadIndex = run->columnIndex("PDH_Memory_Load(%)");
+    if (memoryLoadIndex < 0) memoryLoadIndex = run->columnIndex("Memory Load");
+    int memoryAvailableIndex = run->columnIndex("PDH_Memory_Available(MB)");
+    int memoryCommitLimitIndex =
+      run->columnIndex("PDH_Memory_Commit_Limit(bytes)");
+    int gpuMemUsedIndex = run->columnIndex("GPU Mem Used");
+    int gpuMemTotalIndex = run->columnIndex("GPU Mem Total");
 
     int maxIndex = -1;
     for (int idx : {memoryUsageIndex, memoryLoadIndex, memoryAvailableIndex,
@@ -45,52 +41,47 @@ QString BenchmarkCharts::generateMemoryChart(
 
     int timeCounter = 0;
 
-    while (!in.atEnd()) {
-      QStringList fields = in.readLine().split(",");
+    for (size_t row = 0; row < run->rowCount(); ++row) {
+      const int fieldCount = run->fieldCount(row);
 
-      if (maxIndex >= 0 && fields.size() <= maxIndex) {
+      if (maxIndex >= 0 && fieldCount <= maxIndex) {
         timeCounter++;
         continue;
       }
 
       // RAM usage (MB)
-      if (memoryUsageIndex >= 0 && memoryUsageIndex < fields.size()) {
-        bool ok = false;
-        double ram = fields[memoryUsageIndex].toDouble(&ok);
-        if (ok && ram >= 0) {
+      if (memoryUsageIndex >= 0 && memoryUsageIndex < fieldCount) {
+        double ram = run->value(row, memoryUsageIndex);
+        if (ram >= 0) {
           ramUsage.append(QPointF(timeCounter, ram));
         }
       } else if (memoryAvailableIndex >= 0 && memoryCommitLimitIndex >= 0 &&
-                 memoryAvailableIndex < fields.size() &&
-                 memoryCommitLimitIndex < fields.size()) {
-        bool availOk = false, limitOk = false;
-        double availMb = fields[memoryAvailableIndex].toDouble(&availOk);
-        double limitMb = toMb(fields[memoryCommitLimitIndex], &limitOk);
-        if (availOk && limitOk) {
+                 memoryAvailableIndex < fieldCount &&
+                 memoryCommitLimitIndex < fieldCount) {
+        double availMb = run->value(row, memoryAvailableIndex);
+        double limitMb = toMb(run->value(row, memoryCommitLimitIndex));
+        if (!std::isnan(availMb) && !std::isnan(limitMb)) {
           double usedMb = std::max(0.0, limitMb - availMb);
           ramUsage.append(QPointF(timeCounter, usedMb));
         }
       }
 
       // RAM load (%)
-      if (memoryLoadIndex >= 0 && memoryLoadIndex < fields.size()) {
-        bool ok = false;
-        double load = fields[memoryLoadIndex].toDouble(&ok);
-        if (ok && load >= 0) {
+      if (memoryLoadIndex >= 0 && memoryLoadIndex < fieldCount) {
+        double load = run->value(row, memoryLoadIndex);
+        if (load >= 0) {
           ramLoad.append(QPointF(timeCounter, load));
         }
       }
 
       // GPU memory usage and load
-      if (gpuMemUsedIndex >= 0 && gpuMemUsedIndex < fields.size()) {
-        bool ok = false;
-        double used = fields[gpuMemUsedIndex].toDouble(&ok);
-        if (ok && used >= 0) {
+      if (gpuMemUsedIndex >= 0 && gpuMemUsedIndex < fieldCount) {
+        double used = run->value(row, gpuMemUsedIndex);
+        if (used >= 0) {
           gpuMemUsage.append(QPointF(timeCounter, used));
-          if (gpuMemTotalIndex >= 0 && gpuMemTotalIndex < fields.size()) {
-            bool totOk = false;
-            double total = fields[gpuMemTotalIndex].toDouble(&totOk);
-            if (totOk && total > 0) {
+          if (gpuMemTotalIndex >= 0 && gpuMemTotalIndex < fieldCount) {
+            double total = run->value(row, gpuMemTotalIndex);
+            if (total > 0) {
               double pct = (used / total) * 100.0;
               gpuMemLoad.append(QPointF(timeCounter, pct));
             }
@@ -101,7 +92,6 @@ QString BenchmarkCharts::generateMemoryChart(
       timeCounter++;
     }
 
-    file.close();
     return !(ramUsage.isEmpty() && ramLoad.isEmpty() && gpuMemUsage.isEmpty() &&
              gpuMemLoad.isEmpty());
   };
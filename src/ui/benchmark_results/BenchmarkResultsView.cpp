@@ -11,6 +11,7 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QFutureWatcher>
 #include <QGridLayout>
 #include <QGroupBox>
 #include <QHBoxLayout>
@@ -28,9 +29,13 @@
 #include <QUrl>
 #include <QVBoxLayout>
 #include <QScrollArea>
+#include <QtConcurrent/QtConcurrentRun>
 #include <shlwapi.h>
 
 #include "HtmlReportGenerator.h"
+#include "ParsedRun.h"
+#include "RunLibraryIndex.h"
+#include "../../benchmark/BenchmarkRunFile.h"
 #include "../../network/api/BenchmarkApiClient.h"
 
 #include "logging/Logger.h"
@@ -51,6 +56,21 @@ BenchmarkResultsView::BenchmarkResultsView(QWidget* parent) : QWidget(parent) {
   gpuCpuUsageButton = nullptr;
   memoryButton = nullptr;
 
+  benchmarkIndex = new RunLibraryIndex("benchmark_results", this);
+  comparisonIndex = new RunLibraryIndex("comparison_data", this);
+  connect(benchmarkIndex, &RunLibraryIndex::updated, this, [this]() {
+    populateBenchmarkList();
+    // The average over all runs may have changed
+    if (resultsList->currentIndex() > 0) {
+      updateSummaryPanel(computeRunSummary(resultsList->currentData().toString()),
+                         currentComparisonSummary, computeUserAverageSummary());
+    }
+  });
+  connect(comparisonIndex, &RunLibraryIndex::updated, this, [this]() {
+    populateComparisonFilesList();
+    if (showingCachedLeaderboard) populateCachedLeaderboardRuns();
+  });
+
   try {
     LOG_INFO << "BenchmarkResultsView: Setting up UI";
     setupUI();
@@ -425,6 +445,38 @@ bool BenchmarkResultsView::loadComparisonData() {
   return true;
 }
 
+// A run is listed when its columns include FPS and frame time data
+static bool isBenchmarkRun(const BenchmarkRunFile& run) {
+  bool hasFps = false;
+  bool hasFrameTime = false;
+  for (const QString& name : run.columnNames()) {
+    hasFps = hasFps || name.contains("FPS");
+    hasFrameTime = hasFrameTime || name.contains("Frame Time");
+  }
+  return hasFps && hasFrameTime;
+}
+
+void BenchmarkResultsView::whenRunFileReady(const QString& csvPath,
+                                            std::function<void()> ready) {
+  if (BenchmarkRunFile().open(csvPath)) {
+    ready();
+    return;
+  }
+
+  // Building the sidecar parses the whole CSV, which would stall the UI
+  auto* watcher = new QFutureWatcher<bool>(this);
+  connect(watcher, &QFutureWatcher<bool>::finished, this,
+          [watcher, csvPath, ready = std::move(ready)]() {
+            watcher->deleteLater();
+            if (!watcher->result()) {
+              LOG_ERROR << "Failed to build run file for " << csvPath.toStdString();
+            }
+            ready();
+          });
+  watcher->setFuture(QtConcurrent::run(
+    [csvPath]() { return BenchmarkRunFile::writeFromCsv(csvPath); }));
+}
+
 bool BenchmarkResultsView::cacheIsFresh(int maxAgeMinutes) const {
   QDir comparisonDir("comparison_data");
   if (!comparisonDir.exists()) return false;
@@ -441,48 +493,51 @@ bool BenchmarkResultsView::cacheIsFresh(int maxAgeMinutes) const {
 }
 
 void BenchmarkResultsView::loadCachedLeaderboardRuns() {
-  QDir comparisonDir("comparison_data");
-  if (!comparisonDir.exists()) {
+  if (!QDir("comparison_data").exists()) {
     LOG_WARN << "No comparison_data directory found; skipping local comparison load";
     return;
   }
 
-  QStringList filters;
-  filters << "leader_*.csv";
-  QFileInfoList files =
-    comparisonDir.entryInfoList(filters, QDir::Files, QDir::Time);
+  // Runs saved since the last scan are read (and their sidecars built) on the
+  // thread pool; the list fills in again through RunLibraryIndex::updated
+  showingCachedLeaderboard = true;
+  comparisonIndex->refresh();
+  populateCachedLeaderboardRuns();
+}
 
+void BenchmarkResultsView::populateCachedLeaderboardRuns() {
+  const QString selectedPath = serverRunSelector->currentData().toString();
   serverRunSelector->blockSignals(true);
   serverRunSelector->clear();
   serverRunSelector->addItem("No comparison selected", QVariant());
 
   int added = 0;
-  for (const QFileInfo& file : files) {
-    QString path = file.filePath();
+  for (const RunLibraryIndex::Entry& run : comparisonIndex->entries()) {
+    const QFileInfo file(run.path);
+    if (!file.fileName().startsWith("leader_") || !run.isBenchmarkRun) continue;
 
-    QFile csv(path);
-    if (!csv.open(QIODevice::ReadOnly | QIODevice::Text)) continue;
-    QTextStream in(&csv);
-    QString header = in.readLine();
-    csv.close();
-    if (!header.contains("FPS") || !header.contains("Frame Time")) continue;
-
-    double avgFps = calculateAverageFps(path);
     QString label = QString("Cached: %1").arg(file.baseName());
-    if (avgFps > 0) {
-      label.append(QString(" (%1 FPS)").arg(QString::number(avgFps, 'f', 1)));
+    if (run.avgFps > 0) {
+      label.append(QString(" (%1 FPS)").arg(QString::number(run.avgFps, 'f', 1)));
     }
 
-    serverRunSelector->addItem(label, path);
+    serverRunSelector->addItem(label, run.path);
     added++;
   }
+
+  if (!selectedPath.isEmpty()) {
+    serverRunSelector->setCurrentIndex(
+      std::max(0, serverRunSelector->findData(selectedPath)));
+  }
   serverRunSelector->blockSignals(false);
 
-  if (added == 0) {
+  if (added == 0 && !comparisonIndex->isScanning()) {
     LOG_WARN << "No cached leaderboard data available";
   }
 
-  setDefaultComparisonFromSelector();
+  if (!hasComparisonData || serverRunSelector->findData(currentComparisonFile) <= 0) {
+    setDefaultComparisonFromSelector();
+  }
 }
 
 void BenchmarkResultsView::setDefaultComparisonFromSelector() {
@@ -521,7 +576,7 @@ void BenchmarkResultsView::onComparisonSelected(int index) {
     auto* api = new BenchmarkApiClient(this);
     connect(api, &BaseApiClient::requestStarted, this, [](const QString& p){ LOG_INFO << "GET public run started: " << p.toStdString(); });
     connect(api, &BaseApiClient::requestCompleted, this, [](const QString& p, bool ok){ LOG_INFO << "GET public run completed: " << p.toStdString() << ", ok=" << ok; });
-    api->getPublicRun(runId, [this, runId](bool ok, const QVariant& data, const QString& err){
+    api->getPublicRun(runId, [this, runId, index](bool ok, const QVariant& data, const QString& err){
       if (!ok) {
         LOG_ERROR << "Public run fetch failed: " << err.toStdString();
         return;
@@ -532,14 +587,18 @@ void BenchmarkResultsView::onComparisonSelected(int index) {
       QDir dir("comparison_data"); if (!dir.exists()) QDir().mkpath("comparison_data");
       QString outPath = dir.filePath(QString("server_%1.csv").arg(runId));
       if (savePublicRunToCsv(map, outPath)) {
-        currentComparisonFile = outPath;
-        hasComparisonData = true;
         LOG_INFO << "Saved server public run to CSV: " << outPath.toStdString();
-        // resultsList is a QComboBox: check currentIndex() and use currentData()
-        if (resultsList->currentIndex() > 0) {
-          QString filePath = resultsList->currentData().toString();
-          updateComparisonTable(filePath);
-        }
+        whenRunFileReady(outPath, [this, index, outPath]() {
+          // Another comparison was picked while the run file was built
+          if (comparisonSelector->currentIndex() != index) return;
+          currentComparisonFile = outPath;
+          hasComparisonData = true;
+          // resultsList is a QComboBox: check currentIndex() and use currentData()
+          if (resultsList->currentIndex() > 0) {
+            QString filePath = resultsList->currentData().toString();
+            updateComparisonTable(filePath);
+          }
+        });
       }
     });
     return;
@@ -625,6 +684,7 @@ void BenchmarkResultsView::onServerComparisonSelected(int index) {
 void BenchmarkResultsView::fetchAggregatedComparisons() {
   if (!serverRunSelector) return;
 
+  showingCachedLeaderboard = false;
   serverRunSelector->blockSignals(true);
   serverRunSelector->clear();
   serverRunSelector->addItem("No comparison selected", QVariant());
@@ -801,6 +861,7 @@ void BenchmarkResultsView::fetchLeaderboardForMode(const QString& mode) {
 
       serverRunSelector->blockSignals(true);
 
+      bool savedAny = false;
       for (const auto& v : runs) {
         QVariantMap run = v.toMap();
         QVariantMap meta = run.value("meta").toMap();
@@ -823,6 +884,7 @@ void BenchmarkResultsView::fetchLeaderboardForMode(const QString& mode) {
           dir.filePath(QString("leader_%1.csv").arg(runId));
 
         if (savePublicRunToCsv(run, outPath, &label)) {
+          savedAny = true;
           knownServerRunIds.insert(runId);
           serverRunSelector->addItem(label, outPath);
           lastServerRuns.append({label, outPath});
@@ -833,6 +895,11 @@ void BenchmarkResultsView::fetchLeaderboardForMode(const QString& mode) {
 
       serverRunSelector->blockSignals(false);
 
+      // Builds the new runs' sidecars on the thread pool before they're charted
+      if (savedAny) {
+        comparisonIndex->refresh();
+      }
+
       if (pendingLeaderboardRequests == 0 && !anyLeaderboardSuccess) {
         loadCachedLeaderboardRuns();
       } else if (pendingLeaderboardRequests == 0) {
@@ -920,142 +987,44 @@ bool BenchmarkResultsView::savePublicRunToCsv(const QVariantMap& runMap, const Q
 void BenchmarkResultsView::loadComparisonCSVFile(const QString& filePath) {
   LOG_INFO << "Loading comparison CSV file: " << filePath.toStdString();
 
-  QFile file(filePath);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-    LOG_ERROR << "Failed to open comparison file: " << filePath.toStdString();
-    return;
-  }
-
-  // Just verify that the file is valid, for now
-  QTextStream in(&file);
-  QString header = in.readLine();
-  if (!header.contains("FPS") || !header.contains("Frame Time")) {
-    file.close();
-    LOG_ERROR << "Invalid comparison file format";
-    return;
-  }
+  whenRunFileReady(filePath, [this, filePath]() {
+    // Another comparison was picked while the run file was built
+    if (currentComparisonFile != filePath) return;
 
-  // File is valid, the actual data reading will happen in the chart generation
-  // methods
-  file.close();
-  currentComparisonFile = filePath;
-  LOG_INFO << "Comparison file validated and set";
-}
+    BenchmarkRunFile run;
+    if (!run.open(filePath)) {
+      LOG_ERROR << "Failed to open comparison file: " << filePath.toStdString();
+      return;
+    }
 
-// Helper function to calculate average FPS from a CSV file
-double BenchmarkResultsView::calculateAverageFps(const QString& filePath) {
-  QFile file(filePath);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-    return -1.0;
-  }
-  
-  QTextStream in(&file);
-  QString header = in.readLine();
-  QStringList headers = header.split(",");
-  
-  int fpsIndex = headers.indexOf("FPS");
-  if (fpsIndex < 0) {
-    file.close();
-    return -1.0;
-  }
-  
-  double totalFps = 0.0;
-  int lineCount = 0;
-  
-  while (!in.atEnd()) {
-    QString line = in.readLine();
-    QStringList fields = line.split(",");
-    
-    if (fields.size() <= fpsIndex) continue;
-    
-    double fps = fields[fpsIndex].toDouble();
-    if (fps > 0) {
-      totalFps += fps;
-      lineCount++;
+    // Just verify that the file is valid, for now
+    if (!isBenchmarkRun(run)) {
+      LOG_ERROR << "Invalid comparison file format";
+      return;
     }
-  }
-  
-  file.close();
-  return lineCount > 0 ? totalFps / lineCount : -1.0;
+
+    // File is valid, the actual data reading will happen in the chart
+    // generation methods
+    LOG_INFO << "Comparison file validated and set";
+  });
 }
 
 BenchmarkResultsView::RunSummary BenchmarkResultsView::computeRunSummary(
   const QString& filePath) {
-  RunSummary summary;
-  QFile file(filePath);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-    return summary;
-  }
-
-  QTextStream in(&file);
-  QString header = in.readLine();
-  QStringList headers = header.split(",");
-
-  struct StatAccumulator {
-    double sum = 0.0;
-    double min = std::numeric_limits<double>::max();
-    double max = std::numeric_limits<double>::lowest();
-    int count = 0;
-  };
-
-  QMap<QString, StatAccumulator> accumulators;
-  const int memUsageIdx = headers.indexOf("Memory Usage (MB)");
-  const int memAvailIdx = headers.indexOf("PDH_Memory_Available(MB)");
-  const int memLimitIdx = headers.indexOf("PDH_Memory_Commit_Limit(bytes)");
-
-  auto addSample = [&](const QString& name, double value) {
-    if (!std::isfinite(value)) return;
-
-    StatAccumulator& acc = accumulators[name];
-    acc.sum += value;
-    acc.count++;
-    acc.min = (acc.count == 1) ? value : std::min(acc.min, value);
-    acc.max = (acc.count == 1) ? value : std::max(acc.max, value);
-  };
-
-  while (!in.atEnd()) {
-    QString line = in.readLine();
-    QStringList fields = line.split(",");
-    if (fields.size() < headers.size()) continue;
-
-    for (int i = 0; i < headers.size(); ++i) {
-      QString metricName = headers[i].trimmed();
-      if (metricName.isEmpty() || metricName.compare("Time", Qt::CaseInsensitive) == 0)
-        continue;
-      if (i >= fields.size()) continue;
-
-      bool ok = false;
-      double v = fields[i].toDouble(&ok);
-      if (!ok) continue;
-
-      addSample(metricName, v);
-    }
-
-    // Derive memory usage if explicit column is missing
-    if (memUsageIdx < 0 && memAvailIdx >= 0 && memLimitIdx >= 0 &&
-        memAvailIdx < fields.size() && memLimitIdx < fields.size()) {
-      bool okA = false, okL = false;
-      double avail = fields[memAvailIdx].toDouble(&okA);
-      double limitBytes = fields[memLimitIdx].toDouble(&okL);
-      if (okA && okL) {
-        double usedMb = (limitBytes / 1048576.0) - avail;
-        if (usedMb >= 0) {
-          addSample(QStringLiteral("Memory Usage (MB)"), usedMb);
-        }
-      }
-    }
+  // Only indexed runs are summarized; reading anything else here would block
+  // the GUI thread. Selecting a run that isn't indexed yet starts a rescan,
+  // and RunLibraryIndex::updated recomputes the summary when it lands.
+  RunLibraryIndex::Entry entry;
+  if (!benchmarkIndex->lookup(filePath, entry)) {
+    comparisonIndex->lookup(filePath, entry);
   }
 
-  file.close();
-
-  for (auto it = accumulators.constBegin(); it != accumulators.constEnd(); ++it) {
-    const StatAccumulator& acc = it.value();
-    if (acc.count == 0) continue;
-
+  RunSummary summary;
+  for (auto it = entry.metrics.constBegin(); it != entry.metrics.constEnd(); ++it) {
     MetricStats stats;
-    stats.avg = acc.sum / acc.count;
-    stats.min = acc.min;
-    stats.max = acc.max;
+    stats.min = it->min;
+    stats.avg = it->avg;
+    stats.max = it->max;
     summary.metrics.insert(it.key(), stats);
   }
 
@@ -1159,13 +1128,9 @@ BenchmarkResultsView::RunSummary BenchmarkResultsView::computeRunSummaryFromPubl
 
 BenchmarkResultsView::RunSummary BenchmarkResultsView::computeUserAverageSummary() {
   RunSummary agg;
-  QDir resultsDir("benchmark_results");
-  if (!resultsDir.exists()) return agg;
-
-  QStringList filters;
-  filters << "*.csv";
-  QFileInfoList files = resultsDir.entryInfoList(filters, QDir::Files, QDir::Time);
-  if (files.isEmpty()) return agg;
+  // Straight from the index: no file is opened here
+  const QVector<RunLibraryIndex::Entry> runs = benchmarkIndex->entries();
+  if (runs.isEmpty()) return agg;
 
   struct Aggregate {
     double sumMin = 0.0;
@@ -1178,10 +1143,9 @@ BenchmarkResultsView::RunSummary BenchmarkResultsView::computeUserAverageSummary
 
   QMap<QString, Aggregate> totals;
 
-  for (const QFileInfo& fi : files) {
-    RunSummary r = computeRunSummary(fi.filePath());
-    for (auto it = r.metrics.constBegin(); it != r.metrics.constEnd(); ++it) {
-      const MetricStats& ms = it.value();
+  for (const RunLibraryIndex::Entry& run : runs) {
+    for (auto it = run.metrics.constBegin(); it != run.metrics.constEnd(); ++it) {
+      const RunLibraryIndex::Stats& ms = it.value();
       Aggregate& aggEntry = totals[it.key()];
 
       if (ms.min >= 0) { aggEntry.sumMin += ms.min; aggEntry.countMin++; }
@@ -1309,55 +1273,56 @@ void BenchmarkResultsView::refreshBenchmarkList() {
     return;
   }
 
-  resultsList->clear();
-  resultsList->addItem("Select benchmark run", QVariant()); // Default item
-
   // Make sure benchmark_results directory exists
   QDir resultsDir("benchmark_results");
   if (!resultsDir.exists()) {
     LOG_INFO << "BenchmarkResultsView: benchmark_results directory does not "
                  "exist, creating it";
     QDir().mkpath("benchmark_results");
-    return;
   }
 
-  QStringList filters;
-  filters << "*.csv";
-  QFileInfoList files =
-    resultsDir.entryInfoList(filters, QDir::Files, QDir::Time);
+  // New or changed runs are scanned in the background and show up through
+  // RunLibraryIndex::updated; everything already indexed is listed right away
+  benchmarkIndex->refresh();
+  populateBenchmarkList();
+}
 
-  for (const QFileInfo& file : files) {
-    // Read first few lines to verify it's a valid benchmark file
-    QFile csvFile(file.filePath());
-    if (csvFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-      QTextStream in(&csvFile);
-      QString header = in.readLine();
+void BenchmarkResultsView::populateBenchmarkList() {
+  // Rebuilding the list shouldn't look like the user picked another run
+  const QString selectedPath = resultsList->currentData().toString();
+  resultsList->blockSignals(true);
+  resultsList->clear();
+  resultsList->addItem("Select benchmark run", QVariant()); // Default item
 
-      // Check if this is a valid benchmark file by looking for known headers
-      if (header.contains("FPS") && header.contains("Frame Time")) {
-        csvFile.close();
-        
-        // Calculate average FPS
-        double avgFps = calculateAverageFps(file.filePath());
-        
-        // Format display with avg FPS (orange) and date/time
-        QString displayDate = file.lastModified().toString("yyyy-MM-dd HH:mm");
-        QString displayText;
-        
-        if (avgFps > 0) {
-          displayText = QString("%1 FPS — %2")
-                          .arg(QString::number(avgFps, 'f', 1))
-                          .arg(displayDate);
-        } else {
-          displayText = QString("-- FPS — %1")
-                          .arg(displayDate);
-        }
-        
-        resultsList->addItem(displayText, file.filePath());
-      } else {
-        csvFile.close();
-      }
+  for (const RunLibraryIndex::Entry& run : benchmarkIndex->entries()) {
+    // Only files with the known benchmark columns
+    if (!run.isBenchmarkRun) continue;
+
+    // Format display with avg FPS (orange) and date/time
+    QString displayDate =
+      QDateTime::fromMSecsSinceEpoch(run.mtimeMs).toString("yyyy-MM-dd HH:mm");
+    QString displayText;
+    
+    if (run.avgFps > 0) {
+      displayText = QString("%1 FPS — %2")
+                      .arg(QString::number(run.avgFps, 'f', 1))
+                      .arg(displayDate);
+    } else {
+      displayText = QString("-- FPS — %1")
+                      .arg(displayDate);
     }
+    
+    resultsList->addItem(displayText, run.path);
+  }
+
+  if (!selectedPath.isEmpty()) {
+    resultsList->setCurrentIndex(std::max(0, resultsList->findData(selectedPath)));
+  }
+  resultsList->blockSignals(false);
+
+  // The selected run was deleted
+  if (!selectedPath.isEmpty() && resultsList->currentIndex() <= 0) {
+    onBenchmarkSelected();
   }
 }
 
@@ -1375,20 +1340,35 @@ void BenchmarkResultsView::onBenchmarkSelected() {
 
   LOG_INFO << "Selected benchmark file: " << filePath.toStdString();
 
+  RunLibraryIndex::Entry entry;
+  if (!benchmarkIndex->lookup(filePath, entry)) {
+    benchmarkIndex->refresh();  // the summary fills in through updated()
+  }
+
+  whenRunFileReady(filePath, [this, filePath]() {
+    // Another run was selected while the run file was built
+    if (resultsList->currentIndex() <= 0 ||
+        resultsList->currentData().toString() != filePath) {
+      return;
+    }
+    showBenchmarkRun(filePath);
+  });
+}
+
+void BenchmarkResultsView::showBenchmarkRun(const QString& filePath) {
   // Load the benchmark file and check available metrics to determine which
-  // buttons to enable
-  QFile file(filePath);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+  // buttons to enable. This also reads the run once for every chart and
+  // report generated from it while it stays selected.
+  auto run = ParsedRun::load(filePath);
+  if (!run) {
     LOG_ERROR << "Failed to open benchmark file: " << filePath.toStdString();
     return;
   }
 
   // Read header to identify available metrics
-  QTextStream in(&file);
-  QString header = in.readLine();
-  QStringList headers = header.split(",");
+  const QStringList& headers = run->columnNames();
 
-  LOG_INFO << "CSV Headers: " << header.toStdString();
+  LOG_INFO << "CSV Headers: " << headers.join(",").toStdString();
 
   // Check for performance metrics
   bool hasFpsData = headers.contains("FPS");
@@ -1433,8 +1413,6 @@ void BenchmarkResultsView::onBenchmarkSelected() {
     dashboardButton->setEnabled(hasFpsData || hasFrameTimeData || hasCpuData ||
                                 hasGpuData);
 
-  file.close();
-
   // Update summary panel
   RunSummary selectedSummary = computeRunSummary(filePath);
   RunSummary avgSummary = computeUserAverageSummary();
@@ -1442,15 +1420,13 @@ void BenchmarkResultsView::onBenchmarkSelected() {
 }
 
 void BenchmarkResultsView::updateComparisonTable(const QString& resultFile) {
-  QFile file(resultFile);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+  // Shared with the charts, so reselecting a comparison doesn't re-read it
+  auto run = ParsedRun::load(resultFile);
+  if (!run) {
     return;
   }
 
-  // Read and parse the CSV file
-  QTextStream in(&file);
-  QString header = in.readLine();
-  QStringList headers = header.split(",");
+  const QStringList& headers = run->columnNames();
 
   // Prepare for metrics calculation
   double totalFps = 0.0;
@@ -1510,68 +1486,71 @@ void BenchmarkResultsView::updateComparisonTable(const QString& resultFile) {
     }
   }
 
-  while (!in.atEnd()) {
-    QString line = in.readLine();
-    QStringList fields = line.split(",");
+  for (size_t row = 0; row < run->rowCount(); ++row) {
+    if (run->fieldCount(row) < headers.size()) continue;  // Skip incomplete lines
 
-    if (fields.size() < headers.size()) continue;  // Skip incomplete lines
+    // Unparseable cells count as 0
+    auto field = [&](int idx) {
+      double value = run->value(row, idx);
+      return std::isnan(value) ? 0.0 : value;
+    };
 
     // Skip invalid data points
-    if (fpsIndex >= 0 && fields[fpsIndex].toDouble() <= 0) continue;
+    if (fpsIndex >= 0 && field(fpsIndex) <= 0) continue;
 
     lineCount++;
 
     // Process each metric
-    if (fpsIndex >= 0) totalFps += fields[fpsIndex].toDouble();
+    if (fpsIndex >= 0) totalFps += field(fpsIndex);
     if (frameTimeIndex >= 0)
-      totalFrameTime += fields[frameTimeIndex].toDouble();
+      totalFrameTime += field(frameTimeIndex);
 
     if (highestFrameTimeIndex >= 0) {
-      double highFrameTime = fields[highestFrameTimeIndex].toDouble();
+      double highFrameTime = field(highestFrameTimeIndex);
       totalHighestFrameTime += highFrameTime;
       highestFrameTimeOverall =
         std::max(highestFrameTimeOverall, highFrameTime);
     }
 
-    if (cpuTimeIndex >= 0) totalCpuTime += fields[cpuTimeIndex].toDouble();
+    if (cpuTimeIndex >= 0) totalCpuTime += field(cpuTimeIndex);
 
     if (highestCpuTimeIndex >= 0) {
-      double highCpuTime = fields[highestCpuTimeIndex].toDouble();
+      double highCpuTime = field(highestCpuTimeIndex);
       totalHighestCpuTime += highCpuTime;
       highestCpuTimeOverall = std::max(highestCpuTimeOverall, highCpuTime);
     }
 
-    if (gpuTimeIndex >= 0) totalGpuTime += fields[gpuTimeIndex].toDouble();
+    if (gpuTimeIndex >= 0) totalGpuTime += field(gpuTimeIndex);
 
     if (highestGpuTimeIndex >= 0) {
-      double highGpuTime = fields[highestGpuTimeIndex].toDouble();
+      double highGpuTime = field(highestGpuTimeIndex);
       totalHighestGpuTime += highGpuTime;
       highestGpuTimeOverall = std::max(highestGpuTimeOverall, highGpuTime);
     }
 
     if (frameTimeVarianceIndex >= 0) {
-      double variance = fields[frameTimeVarianceIndex].toDouble();
+      double variance = field(frameTimeVarianceIndex);
       totalFrameTimeVariance += variance;
       highestFrameTimeVariance = std::max(highestFrameTimeVariance, variance);
     }
 
     if (gpuUsageIndex >= 0) {
-      double gpuUsage = fields[gpuUsageIndex].toDouble();
+      double gpuUsage = field(gpuUsageIndex);
       totalGpuUsage += gpuUsage;
       highestGpuUsage = std::max(highestGpuUsage, gpuUsage);
     }
 
     if (gpuMemUsedIndex >= 0)
-      totalGpuMemUsed += fields[gpuMemUsedIndex].toDouble();
+      totalGpuMemUsed += field(gpuMemUsedIndex);
     if (gpuMemTotalIndex >= 0)
       totalGpuMemTotal =
-        fields[gpuMemTotalIndex].toDouble();  // Just take the last one
+        field(gpuMemTotalIndex);  // Just take the last one
 
     if (memoryUsageIndex >= 0)
-      totalRamUsage += fields[memoryUsageIndex].toDouble();
+      totalRamUsage += field(memoryUsageIndex);
 
     if (cpuUsageIndex >= 0) {
-      double cpuUsage = fields[cpuUsageIndex].toDouble();
+      double cpuUsage = field(cpuUsageIndex);
       totalCpuUsage += cpuUsage;
       highestCpuUsage = std::max(highestCpuUsage, cpuUsage);
     }
@@ -1583,8 +1562,8 @@ void BenchmarkResultsView::updateComparisonTable(const QString& resultFile) {
       int validClocks = 0;
 
       for (int idx : coreClockIndices) {
-        if (idx < fields.size()) {
-          double clock = fields[idx].toDouble();
+        if (idx < run->fieldCount(row)) {
+          double clock = field(idx);
           if (clock > 0) {
             totalClockThisRow += clock;
             maxClockThisRow = std::max(maxClockThisRow, clock);
@@ -1601,8 +1580,6 @@ void BenchmarkResultsView::updateComparisonTable(const QString& resultFile) {
     }
   }
 
-  file.close();
-
   // Calculate final averages
   double avgFps = lineCount > 0 ? totalFps / lineCount : -1.0;
   double avgFrameTime = lineCount > 0 ? totalFrameTime / lineCount : -1.0;
@@ -2139,42 +2116,39 @@ void BenchmarkResultsView::generateDashboard() {
 
 // Add this new method to scan for comparison CSV files
 void BenchmarkResultsView::refreshComparisonFilesList() {
+  // Look for CSV files in the comparison_data directory; the index rescans
+  // only what changed and repopulates through RunLibraryIndex::updated
+  comparisonIndex->refresh();
+  populateComparisonFilesList();
+}
+
+void BenchmarkResultsView::populateComparisonFilesList() {
+  const QString selectedPath = comparisonSelector->currentData().toString();
+  comparisonSelector->blockSignals(true);
+
   // First add an empty option for no comparison
   comparisonSelector->clear();
   comparisonSelector->addItem("Select Comparison...");
+  comparisonFiles.clear();
 
-  // Look for CSV files in the comparison_data directory
-  QDir comparisonDir("comparison_data");
-  if (comparisonDir.exists()) {
-    QStringList filters;
-    filters << "*.csv";  // Only look for CSV files
-    QFileInfoList files =
-      comparisonDir.entryInfoList(filters, QDir::Files, QDir::Time);
-
-    comparisonFiles.clear();
-
-    for (const QFileInfo& file : files) {
-      // Check file extension first, before any further processing
-      if (file.suffix().toLower() != "csv") {
-        continue;
-      }
+  for (const RunLibraryIndex::Entry& run : comparisonIndex->entries()) {
+    // Check if this is a valid benchmark file by looking for known headers
+    if (!run.isBenchmarkRun) continue;
 
-      // Read first few lines to verify it's a valid benchmark file
-      QFile csvFile(file.filePath());
-      if (csvFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&csvFile);
-        QString header = in.readLine();
-
-        // Check if this is a valid benchmark file by looking for known headers
-        if (header.contains("FPS") && header.contains("Frame Time")) {
-          // Just display a formatted filename
-          QString displayName = file.baseName();
-          comparisonSelector->addItem(displayName, file.filePath());
-          comparisonFiles.append(file.filePath());
-        }
-        csvFile.close();
-      }
-    }
+    // Just display a formatted filename
+    QString displayName = QFileInfo(run.path).baseName();
+    comparisonSelector->addItem(displayName, run.path);
+    comparisonFiles.append(run.path);
+  }
+
+  if (!selectedPath.isEmpty()) {
+    comparisonSelector->setCurrentIndex(
+      std::max(0, comparisonSelector->findData(selectedPath)));
+  }
+  comparisonSelector->blockSignals(false);
+
+  if (!selectedPath.isEmpty() && comparisonSelector->currentIndex() <= 0) {
+    onComparisonSelected(0);
   }
 
   // Skip loading reference values from JSON for now
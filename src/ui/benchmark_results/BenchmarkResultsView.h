@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <vector>
 
 #include <QComboBox>
@@ -20,6 +21,7 @@
 #include <QWidget>
 
 #include "BenchmarkCharts.h"
+#include "RunLibraryIndex.h"
 
 class BenchmarkResultsView : public QWidget {
   Q_OBJECT
@@ -123,13 +125,19 @@ class BenchmarkResultsView : public QWidget {
   void updateComparisonTable(const QString& resultFile);
   void calculateOverallAverages();
   void refreshComparisonFilesList();
+  void populateBenchmarkList();        // from benchmarkIndex, keeps the selection
+  void populateComparisonFilesList();  // from comparisonIndex, keeps the selection
   void fetchAllComparisonSets();
   void fetchLeaderboardForMode(const QString& mode);
   void loadCachedLeaderboardRuns();
+  void populateCachedLeaderboardRuns();  // leader_*.csv from comparisonIndex
   bool cacheIsFresh(int maxAgeMinutes) const;
   void setDefaultComparisonFromSelector();
   bool savePublicRunToCsv(const QVariantMap& runMap, const QString& outPath, QString* outLabel = nullptr);
-  double calculateAverageFps(const QString& filePath);  // Helper to calculate average FPS from CSV
+  // Calls ready on the GUI thread once csvPath has a current BenchmarkRunFile
+  // sidecar, building it on the thread pool first if needed
+  void whenRunFileReady(const QString& csvPath, std::function<void()> ready);
+  void showBenchmarkRun(const QString& filePath);
 
   // UI components
   QComboBox* resultsList;  // Changed from QListWidget to QComboBox for user runs dropdown
@@ -157,6 +165,8 @@ class BenchmarkResultsView : public QWidget {
   QPushButton* dashboardButton;
 
   // Data storage
+  RunLibraryIndex* benchmarkIndex = nullptr;   // benchmark_results
+  RunLibraryIndex* comparisonIndex = nullptr;  // comparison_data
   QDir resultsDir;
   QString currentBenchmarkFile;
   QJsonObject comparisonData;
@@ -184,6 +194,7 @@ class BenchmarkResultsView : public QWidget {
   QVector<QPair<QString, QString>> lastServerRuns; // {label, path/identifier}
   int pendingLeaderboardRequests = 0;
   bool anyLeaderboardSuccess = false;
+  bool showingCachedLeaderboard = false;  // serverRunSelector lists leader_*.csv
   QSet<QString> knownServerRunIds;
 
   RunSummary computeRunSummary(const QString& filePath);
@@ -0,0 +1,89 @@
+#include "ParsedRun.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+#include <QDateTime>
+#include <QFileInfo>
+
+#include "../../benchmark/BenchmarkRunFile.h"
+
+namespace {
+// Primary + comparison plus a couple of recently viewed runs
+constexpr size_t MAX_CACHED_RUNS = 4;
+
+struct CacheEntry {
+  QString path;
+  qint64 size;
+  qint64 mtimeMs;
+  std::shared_ptr<const ParsedRun> run;
+};
+
+std::mutex g_cacheMutex;
+std::deque<CacheEntry> g_cache;  // most recently used first
+}  // namespace
+
+std::shared_ptr<const ParsedRun> ParsedRun::load(const QString& csvPath) {
+  QFileInfo info(csvPath);
+  if (!info.exists()) {
+    return nullptr;
+  }
+  const QString key = info.absoluteFilePath();
+  const qint64 size = info.size();
+  const qint64 mtimeMs = info.lastModified().toMSecsSinceEpoch();
+
+  {
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    auto it = std::find_if(g_cache.begin(), g_cache.end(),
+                           [&](const CacheEntry& e) { return e.path == key; });
+    if (it != g_cache.end()) {
+      if (it->size == size && it->mtimeMs == mtimeMs) {
+        CacheEntry entry = std::move(*it);
+        g_cache.erase(it);
+        g_cache.push_front(std::move(entry));
+        return g_cache.front().run;
+      }
+      g_cache.erase(it);  // file changed since it was parsed
+    }
+  }
+
+  // Read outside the lock; a concurrent load of the same file just reads twice
+  std::shared_ptr<ParsedRun> run(new ParsedRun());
+  if (!run->read(csvPath)) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(g_cacheMutex);
+  g_cache.erase(std::remove_if(g_cache.begin(), g_cache.end(),
+                               [&](const CacheEntry& e) { return e.path == key; }),
+                g_cache.end());
+  g_cache.push_front({key, size, mtimeMs, run});
+  if (g_cache.size() > MAX_CACHED_RUNS) {
+    g_cache.pop_back();
+  }
+  return run;
+}
+
+void ParsedRun::clearCache() {
+  std::lock_guard<std::mutex> lock(g_cacheMutex);
+  g_cache.clear();
+}
+
+bool ParsedRun::read(const QString& csvPath) {
+  BenchmarkRunFile file;
+  if (!file.open(csvPath)) {
+    return false;
+  }
+
+  m_columnNames = file.columnNames();
+  m_stride = file.rowCount();
+  const size_t cells = static_cast<size_t>(file.columnCount()) * m_stride;
+  if (cells > 0) {
+    const double* values = file.column(0);
+    m_values.assign(values, values + cells);
+  }
+  const uint32_t* fieldCounts = file.fieldCounts();
+  m_fieldCounts.assign(fieldCounts, fieldCounts + m_stride);
+  return true;
+}
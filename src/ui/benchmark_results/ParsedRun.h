@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief ParsedRun - Immutable numeric copy of one benchmark run
+ *
+ * load() reads the run's BenchmarkRunFile sidecar, so the columns come out of
+ * the same binary file the run list and summaries use and no text is parsed
+ * here. It only maps a sidecar that already exists and returns null
+ * otherwise; RunLibraryIndex and BenchmarkResultsView build missing ones on
+ * the thread pool before a run is shown. The result is kept in a small cache
+ * keyed by path, size and modification time of the CSV. The summary, every
+ * chart and the dashboard ask for the same path and get the same shared
+ * object back, so switching tabs or regenerating reports costs a stat() until
+ * the file changes on disk.
+ *
+ * The columns are copied out of the mapping (one memcpy, the data block is
+ * already column-major) and the file is closed again: on Windows a mapped
+ * sidecar could not be replaced when its CSV is rewritten.
+ *
+ * Every CSV line after the header is a row, blank lines included (with a
+ * fieldCount() of 1). Cells that are missing, empty or not numeric read as
+ * NaN, so they fail every comparison. fieldCount() is how many
+ * comma-separated fields the line really had, for callers that skip short
+ * (torn) rows.
+ */
+class ParsedRun {
+ public:
+  // nullptr if the file can't be read
+  static std::shared_ptr<const ParsedRun> load(const QString& csvPath);
+  static void clearCache();
+
+  const QStringList& columnNames() const { return m_columnNames; }
+  int columnIndex(const QString& name) const { return m_columnNames.indexOf(name); }
+
+  size_t rowCount() const { return m_fieldCounts.size(); }
+  int fieldCount(size_t row) const { return static_cast<int>(m_fieldCounts[row]); }
+
+  // column must be a valid header index
+  double value(size_t row, int column) const {
+    return m_values[static_cast<size_t>(column) * m_stride + row];
+  }
+
+ private:
+  ParsedRun() = default;
+  bool read(const QString& csvPath);
+
+  QStringList m_columnNames;
+  std::vector<double> m_values;  // column-major, m_stride per column
+  size_t m_stride = 0;
+  std::vector<uint32_t> m_fieldCounts;
+};
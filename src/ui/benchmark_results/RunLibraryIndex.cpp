@@ -0,0 +1,297 @@
+#include "RunLibraryIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSet>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include "../../benchmark/BenchmarkRunFile.h"
+
+#include "logging/Logger.h"
+
+namespace {
+const char* const INDEX_FILE_NAME = "run_index.dat";
+constexpr quint32 INDEX_MAGIC = 0x43524958;  // "CRIX"
+// Bump when scanFile() computes anything differently, or to rescan every run
+// once so sidecars in an older BenchmarkRunFile format are rebuilt
+constexpr quint32 INDEX_VERSION = 3;
+
+quint64 hashSchema(const QStringList& columnNames) {
+  quint64 hash = 14695981039346656037ull;
+  for (const QString& name : columnNames) {
+    const QByteArray bytes = name.toUtf8();
+    for (char c : bytes) {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    hash = (hash ^ ',') * 1099511628211ull;
+  }
+  return hash;
+}
+}  // namespace
+
+// Found by QMap's stream operators through ADL, so not in the anonymous namespace
+static QDataStream& operator<<(QDataStream& out, const RunLibraryIndex::Stats& s) {
+  return out << s.min << s.avg << s.max;
+}
+
+static QDataStream& operator>>(QDataStream& in, RunLibraryIndex::Stats& s) {
+  return in >> s.min >> s.avg >> s.max;
+}
+
+RunLibraryIndex::RunLibraryIndex(const QString& dirPath, QObject* parent)
+    : QObject(parent), m_dirPath(dirPath) {
+  connect(&m_watcher, &QFutureWatcher<Entry>::finished, this,
+          &RunLibraryIndex::onScanFinished);
+  load();
+}
+
+RunLibraryIndex::~RunLibraryIndex() {
+  m_watcher.disconnect(this);
+  m_watcher.cancel();
+  m_watcher.waitForFinished();
+}
+
+void RunLibraryIndex::refresh() {
+  if (m_watcher.isRunning()) {
+    // Picked up when the current scan lands
+    m_refreshPending = true;
+    return;
+  }
+
+  QDir dir(m_dirPath);
+  const QFileInfoList files =
+    dir.entryInfoList(QStringList() << "*.csv", QDir::Files, QDir::Time);
+
+  QHash<QString, Entry> kept;
+  QStringList changed;
+  m_order.clear();
+  for (const QFileInfo& file : files) {
+    const QString path = file.filePath();
+    m_order.append(path);
+
+    auto it = m_entries.constFind(path);
+    if (it != m_entries.constEnd()) {
+      // Keep the old entry visible until its rescan lands
+      kept.insert(path, it.value());
+      if (it->size == file.size() &&
+          it->mtimeMs == file.lastModified().toMSecsSinceEpoch()) {
+        continue;
+      }
+    }
+    changed.append(path);
+  }
+
+  const bool removed = kept.size() != m_entries.size();
+  m_entries = std::move(kept);
+  if (removed) {
+    save();
+  }
+
+  if (!changed.isEmpty()) {
+    LOG_INFO << "RunLibraryIndex: rescanning " << changed.size() << " of "
+             << files.size() << " files in " << m_dirPath.toStdString();
+    m_watcher.setFuture(QtConcurrent::mapped(changed, &RunLibraryIndex::scanFile));
+  }
+}
+
+void RunLibraryIndex::onScanFinished() {
+  if (!m_watcher.isCanceled()) {
+    const QList<Entry> results = m_watcher.future().results();
+    const QSet<QString> listed(m_order.begin(), m_order.end());
+    for (const Entry& entry : results) {
+      // Dropped if the file was deleted while it was being scanned
+      if (listed.contains(entry.path)) {
+        m_entries.insert(entry.path, entry);
+      }
+    }
+    save();
+    emit updated();
+  }
+
+  if (m_refreshPending) {
+    m_refreshPending = false;
+    refresh();
+  }
+}
+
+QVector<RunLibraryIndex::Entry> RunLibraryIndex::entries() const {
+  QVector<Entry> result;
+  result.reserve(m_order.size());
+  for (const QString& path : m_order) {
+    auto it = m_entries.constFind(path);
+    if (it != m_entries.constEnd() && it->readable) {
+      result.append(it.value());
+    }
+  }
+  return result;
+}
+
+bool RunLibraryIndex::lookup(const QString& path, Entry& entry) const {
+  auto it = m_entries.constFind(path);
+  if (it == m_entries.constEnd()) {
+    return false;
+  }
+  QFileInfo file(path);
+  if (!file.exists() || file.size() != it->size ||
+      file.lastModified().toMSecsSinceEpoch() != it->mtimeMs) {
+    return false;
+  }
+  entry = it.value();
+  return true;
+}
+
+RunLibraryIndex::Entry RunLibraryIndex::scanFile(const QString& path) {
+  Entry entry;
+  entry.path = path;
+
+  // Stat before reading so a write that lands mid-scan shows up as a change
+  QFileInfo file(path);
+  entry.size = file.size();
+  entry.mtimeMs = file.lastModified().toMSecsSinceEpoch();
+
+  BenchmarkRunFile run;
+  if (!run.openOrBuild(path)) {
+    return entry;
+  }
+  entry.readable = true;
+
+  const QStringList& headers = run.columnNames();
+  entry.schemaHash = hashSchema(headers);
+
+  bool hasFps = false;
+  bool hasFrameTime = false;
+  for (const QString& name : headers) {
+    hasFps = hasFps || name.contains("FPS");
+    hasFrameTime = hasFrameTime || name.contains("Frame Time");
+  }
+  entry.isBenchmarkRun = hasFps && hasFrameTime;
+
+  const int fpsIdx = run.columnIndex("FPS");
+  if (fpsIdx >= 0) {
+    double totalFps = 0.0;
+    int count = 0;
+    const double* fps = run.column(fpsIdx);
+    for (size_t row = 0; row < run.rowCount(); ++row) {
+      if (fps[row] > 0) {  // also skips missing (NaN) cells
+        totalFps += fps[row];
+        count++;
+      }
+    }
+    entry.avgFps = count > 0 ? totalFps / count : -1.0;
+  }
+
+  struct StatAccumulator {
+    double sum = 0.0;
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+    qint64 count = 0;
+  };
+  QMap<QString, StatAccumulator> accumulators;
+
+  // Per-column min/max/sum come straight from the run file footer. Columns
+  // whose names only differ by surrounding spaces are merged.
+  for (int i = 0; i < headers.size(); ++i) {
+    QString metricName = headers[i].trimmed();
+    if (metricName.isEmpty() || metricName.compare("Time", Qt::CaseInsensitive) == 0)
+      continue;
+
+    BenchmarkRunFile::ColumnStats stats = run.stats(i);
+    if (stats.count == 0) continue;
+
+    StatAccumulator& acc = accumulators[metricName];
+    acc.min = (acc.count == 0) ? stats.min : std::min(acc.min, stats.min);
+    acc.max = (acc.count == 0) ? stats.max : std::max(acc.max, stats.max);
+    acc.sum += stats.sum;
+    acc.count += static_cast<qint64>(stats.count);
+  }
+
+  // Derive memory usage if explicit column is missing
+  const int memUsageIdx = headers.indexOf("Memory Usage (MB)");
+  const int memAvailIdx = headers.indexOf("PDH_Memory_Available(MB)");
+  const int memLimitIdx = headers.indexOf("PDH_Memory_Commit_Limit(bytes)");
+  if (memUsageIdx < 0 && memAvailIdx >= 0 && memLimitIdx >= 0) {
+    const double* avail = run.column(memAvailIdx);
+    const double* limitBytes = run.column(memLimitIdx);
+    StatAccumulator& acc = accumulators[QStringLiteral("Memory Usage (MB)")];
+    for (size_t row = 0; row < run.rowCount(); ++row) {
+      double usedMb = (limitBytes[row] / 1048576.0) - avail[row];
+      if (!std::isfinite(usedMb) || usedMb < 0) continue;
+      acc.sum += usedMb;
+      acc.count++;
+      acc.min = (acc.count == 1) ? usedMb : std::min(acc.min, usedMb);
+      acc.max = (acc.count == 1) ? usedMb : std::max(acc.max, usedMb);
+    }
+  }
+
+  for (auto it = accumulators.constBegin(); it != accumulators.constEnd(); ++it) {
+    const StatAccumulator& acc = it.value();
+    if (acc.count == 0) continue;
+
+    Stats stats;
+    stats.avg = acc.sum / acc.count;
+    stats.min = acc.min;
+    stats.max = acc.max;
+    entry.metrics.insert(it.key(), stats);
+  }
+
+  return entry;
+}
+
+void RunLibraryIndex::load() {
+  QFile file(QDir(m_dirPath).filePath(INDEX_FILE_NAME));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return;
+  }
+
+  QDataStream in(&file);
+  in.setVersion(QDataStream::Qt_6_0);
+  quint32 magic = 0;
+  quint32 version = 0;
+  quint32 count = 0;
+  in >> magic >> version >> count;
+  if (magic != INDEX_MAGIC || version != INDEX_VERSION) {
+    return;  // everything is rescanned and the file rewritten
+  }
+
+  for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+    QString name;
+    Entry entry;
+    in >> name >> entry.size >> entry.mtimeMs >> entry.schemaHash >>
+      entry.readable >> entry.isBenchmarkRun >> entry.avgFps >> entry.metrics;
+    entry.path = QDir(m_dirPath).filePath(name);
+    m_entries.insert(entry.path, entry);
+  }
+
+  if (in.status() != QDataStream::Ok) {
+    LOG_WARN << "RunLibraryIndex: discarding corrupt index in "
+             << m_dirPath.toStdString();
+    m_entries.clear();
+  }
+}
+
+void RunLibraryIndex::save() const {
+  QSaveFile file(QDir(m_dirPath).filePath(INDEX_FILE_NAME));
+  if (!file.open(QIODevice::WriteOnly)) {
+    LOG_WARN << "RunLibraryIndex: cannot write index in " << m_dirPath.toStdString();
+    return;
+  }
+
+  QDataStream out(&file);
+  out.setVersion(QDataStream::Qt_6_0);
+  out << INDEX_MAGIC << INDEX_VERSION << static_cast<quint32>(m_entries.size());
+  for (const Entry& entry : m_entries) {
+    // Stored by file name so the directory can be moved
+    out << QFileInfo(entry.path).fileName() << entry.size << entry.mtimeMs
+        << entry.schemaHash << entry.readable << entry.isBenchmarkRun
+        << entry.avgFps << entry.metrics;
+  }
+  file.commit();
+}
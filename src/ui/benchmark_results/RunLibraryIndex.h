@@ -0,0 +1,74 @@
+#pragma once
+#include <QFutureWatcher>
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief RunLibraryIndex - Persistent per-directory index of benchmark CSVs
+ *
+ * One entry per "*.csv" in a directory: size, modification time, a hash of
+ * the header and the per-column min/avg/max the results view shows. The
+ * entries are saved to "run_index.dat" in the same directory, so opening the
+ * results view lists every run from the index without touching the CSVs.
+ *
+ * refresh() only lists the directory. Files whose size or mtime differ from
+ * their entry (or that have none) are rescanned in parallel on the global
+ * thread pool; the new entries are merged on the owning thread, saved, and
+ * announced with updated(). Until then entries() keeps returning the old
+ * ones, and files still being scanned for the first time are left out.
+ */
+class RunLibraryIndex : public QObject {
+  Q_OBJECT
+
+ public:
+  struct Stats {
+    double min = -1;
+    double avg = -1;
+    double max = -1;
+  };
+
+  struct Entry {
+    QString path;  // as listed, i.e. "<dir>/<name>.csv"
+    qint64 size = -1;
+    qint64 mtimeMs = 0;
+    quint64 schemaHash = 0;  // FNV-1a over the column names
+    bool readable = false;
+    bool isBenchmarkRun = false;  // has FPS and Frame Time columns
+    double avgFps = -1;           // over samples > 0
+    QMap<QString, Stats> metrics;  // column label -> stats, "Time" excluded
+  };
+
+  explicit RunLibraryIndex(const QString& dirPath, QObject* parent = nullptr);
+  ~RunLibraryIndex() override;
+
+  // Re-lists the directory and starts rescanning new or changed files
+  void refresh();
+  bool isScanning() const { return m_watcher.isRunning(); }
+
+  // Readable entries, newest first
+  QVector<Entry> entries() const;
+  // Current entry for path, if the file hasn't changed since it was indexed
+  bool lookup(const QString& path, Entry& entry) const;
+
+  // Reads one CSV through its BenchmarkRunFile sidecar, building the sidecar
+  // if needed, so it runs on the thread pool rather than the GUI thread
+  static Entry scanFile(const QString& path);
+
+ signals:
+  void updated();
+
+ private:
+  void onScanFinished();
+  void load();
+  void save() const;
+
+  QString m_dirPath;
+  QHash<QString, Entry> m_entries;  // by path
+  QStringList m_order;              // paths as last listed, newest first
+  QFutureWatcher<Entry> m_watcher;
+  bool m_refreshPending = false;
+};
@@ -0,0 +1,92 @@
+// Logger crash tail: entries still queued when a FATAL is logged are dumped
+// from their fixed-size record, so streamed (LOG_*) entries must carry their
+// text there too. Floods the queue with streamed entries, logs a FATAL and
+// checks that every queued entry in the crash file shows its message. Exits
+// non-zero on the first failed check.
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "logging/Logger.h"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition)                                                   \
+  do {                                                                     \
+    if (!(condition)) {                                                    \
+      std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, \
+                   #condition);                                            \
+      ++failures;                                                          \
+    }                                                                      \
+  } while (0)
+
+constexpr size_t QUEUE_SIZE = 8192;
+constexpr int BURST = 4096;
+constexpr int MAX_ATTEMPTS = 20;  // the worker may drain a burst before the dump
+
+// INFO lines of the last "queued log entries" section in the crash file,
+// i.e. the burst's entries and not an earlier FATAL marker
+std::vector<std::string> lastQueuedSection(const std::string& path) {
+  std::ifstream in(path);
+  std::vector<std::string> section;
+  bool inSection = false;
+  for (std::string line; std::getline(in, line);) {
+    if (line.find(" queued log entries ----") != std::string::npos) {
+      section.clear();
+      inSection = true;
+    } else if (line == "---- crash ----") {
+      inSection = false;
+    } else if (inSection && line.find("[INFO]") != std::string::npos) {
+      section.push_back(line);
+    }
+  }
+  return section;
+}
+
+void testStreamedEntriesInCrashTail(const std::string& crashPath) {
+  std::vector<std::string> queued;
+  for (int attempt = 0; attempt < MAX_ATTEMPTS && queued.empty(); ++attempt) {
+    for (int i = 0; i < BURST; ++i) {
+      LOG_INFO << "streamed entry " << i;
+    }
+    LOG_FATAL << "crash marker " << attempt;
+    queued = lastQueuedSection(crashPath);
+  }
+
+  CHECK(!queued.empty());
+  for (const std::string& line : queued) {
+    if (line.find("streamed entry ") == std::string::npos) {
+      std::fprintf(stderr, "queued entry without its text: %s\n", line.c_str());
+      CHECK(line.find("streamed entry ") != std::string::npos);
+      break;
+    }
+  }
+}
+
+}  // namespace
+
+int main() {
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  const std::string crashPath = (dir / "logger_crash_tail_test.crash.log").string();
+  std::filesystem::remove(crashPath);
+
+  // The worker also writes every line to stdout; keep the test output short
+  std::cout.rdbuf(nullptr);
+
+  Logger& logger = Logger::instance();
+  logger.init("", crashPath, INFO_LEVEL, QUEUE_SIZE);
+  testStreamedEntriesInCrashTail(crashPath);
+  logger.shutdown();
+
+  std::filesystem::remove(crashPath);
+  if (failures == 0) {
+    std::printf("logger_crash_tail_test: all checks passed\n");
+  }
+  return failures == 0 ? 0 : 1;
+}